@@ -1,12 +1,18 @@
 #include <sam/common/utility.hpp>
 #include <sam/common/options.hpp>
+#include <sam/common/jobs.hpp>
 
 #include <tuttle/host/Graph.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
 
 #include <detector.hpp>
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/bind.hpp>
 
 using namespace tuttle::host;
 namespace bfs = boost::filesystem;
@@ -17,6 +23,7 @@ static int _blackImage     = 0;
 static int _nullFileSize   = 0;
 static int _corruptedImage = 0;
 static int _missingFiles   = 0;
+static std::size_t _nbJobs = 0; ///< parallel jobs on sequences, 0: one per core
 enum EReturnCode
 {
 	eReturnCodeOK = 0,
@@ -66,10 +73,11 @@ EImageStatus checkImageStatus( Graph::Node& read, Graph::Node& stat, Graph& grap
 	}
 }
 
-EImageStatus checkFile( Graph::Node& read, Graph::Node& stat, Graph& graph, const bfs::path& filename )
+/**
+ * @brief Count and print the status of a file.
+ */
+void reportImageStatus( const EImageStatus s, const bfs::path& filename )
 {
-	EImageStatus s = checkImageStatus( read, stat, graph, filename );
-
 	std::string message = "";
 	switch( s )
 	{
@@ -93,23 +101,152 @@ EImageStatus checkFile( Graph::Node& read, Graph::Node& stat, Graph& graph, cons
 			break;
 	}
 	TUTTLE_LOG_INFO( message << filename );
+}
+
+EImageStatus checkFile( Graph::Node& read, Graph::Node& stat, Graph& graph, const bfs::path& filename )
+{
+	EImageStatus s = checkImageStatus( read, stat, graph, filename );
+	reportImageStatus( s, filename );
 	return s;
 }
 
-void checkSequence( Graph::Node& read, Graph::Node& stat, Graph& graph, const sequenceParser::Sequence& seq )
+/**
+ * @brief Check of a part of a sequence, with its own graph computed once on the frames of the job.
+ *
+ * The statistics of each frame are read at the end of the frame by the output callback.
+ * The jobs are computed at the same time, each one keeps its images in its own memory cache.
+ */
+class CheckJob
 {
-	for( sequenceParser::Time t = seq.getFirstTime(); t <= seq.getLastTime(); ++t )
+public:
+	CheckJob( const std::string& readerId, const sequenceParser::Sequence& seq, const sequenceParser::Time first, const sequenceParser::Time last )
+	: _first( first )
+	, _last( last )
+	, _status( last - first + 1, eImageStatusOK )
+	, _read( _graph.createNode( readerId ) )
+	, _stat( _graph.createNode( "tuttle.imagestatistics" ) )
+	{
+		_read.getParam( "explicitConversion" ).setValue( 3 ); // force reader to use float image buffer
+		_read.getParam( "filename" ).setValue( seq.getAbsoluteStandardPattern() );
+		_graph.connect( _read, _stat );
+
+		// the missing and empty files are not rendered
+		_options.setContinueOnError( true );
+		_options.setContinueOnMissingFile( true );
+		_options.setOutputCallback( boost::bind( &CheckJob::frameRendered, this, _1, _2 ) );
+
+		sequenceParser::Time rangeBegin = first;
+		for( sequenceParser::Time t = first; t <= last + 1; ++t )
+		{
+			EImageStatus s = eImageStatusOK;
+			if( t <= last )
+			{
+				const bfs::path filename = seq.getAbsoluteFilenameAt( t );
+				if( ! bfs::exists( filename ) )
+					s = eImageStatusNoFile;
+				else if( bfs::file_size( filename ) == 0 )
+					s = eImageStatusFileSizeError;
+				else
+					s = eImageStatusImageError; // until the frame is rendered
+				_status[t - first] = s;
+			}
+			if( t > last || s != eImageStatusImageError )
+			{
+				if( rangeBegin < t )
+					_options.addTimeRange( rangeBegin, t - 1 );
+				rangeBegin = t + 1;
+			}
+		}
+	}
+
+	void compute()
+	{
+		if( _options.getTimeRanges().empty() )
+			return;
+		memory::MemoryCache memoryCache;
+		core().setThreadMemoryCache( &memoryCache );
+		try
+		{
+			_graph.compute( _stat, _options );
+		}
+		catch( ... )
+		{
+			// the frames not rendered keep their image error status
+			TUTTLE_LOG_ERROR( boost::current_exception_diagnostic_information() );
+		}
+		core().setThreadMemoryCache( NULL );
+	}
+
+	sequenceParser::Time getFirst() const { return _first; }
+	sequenceParser::Time getLast() const { return _last; }
+	EImageStatus getStatus( const sequenceParser::Time t ) const { return _status[t - _first]; }
+
+private:
+	void frameRendered( const OfxTime time, const bool rendered )
 	{
-		checkFile( read, stat, graph, seq.getAbsoluteFilenameAt(t) );
+		EImageStatus& s = _status[static_cast<sequenceParser::Time>( time ) - _first];
+		if( ! rendered )
+		{
+			s = eImageStatusImageError;
+			return;
+		}
+		s = eImageStatusBlack;
+		for( unsigned int i = 0; i < 4; ++i )
+		{
+			if( _stat.getParam( "outputChannelMax" ).getDoubleValueAtTimeAndIndex( time, i ) != 0 ||
+			    _stat.getParam( "outputChannelMin" ).getDoubleValueAtTimeAndIndex( time, i ) != 0 )
+			{
+				s = eImageStatusOK;
+				break;
+			}
+		}
 	}
+
+private:
+	sequenceParser::Time _first;
+	sequenceParser::Time _last;
+	std::vector<EImageStatus> _status;
+	Graph _graph;
+	Graph::Node& _read;
+	Graph::Node& _stat;
+	ComputeOptions _options;
+};
+
+void computeCheckJob( boost::ptr_vector<CheckJob>& jobs, const std::size_t jobId )
+{
+	jobs[jobId].compute();
 }
 
-void checkSequence( Graph::Node& read, Graph::Node& stat, Graph& graph, const sequenceParser::Sequence& seq, const sequenceParser::Time first, const sequenceParser::Time last )
+/**
+ * @brief Check the frames [first, last] of a sequence, split in parallel jobs.
+ */
+void checkSequence( const std::string& readerId, const sequenceParser::Sequence& seq, const sequenceParser::Time first, const sequenceParser::Time last )
 {
-	for( sequenceParser::Time t = first; t <= last; ++t )
+	if( last < first )
+		return;
+	// the graphs are created in the main thread, only the computations are parallel
+	const std::size_t nbJobs = sam::nbJobs( _nbJobs, last - first + 1 );
+	boost::ptr_vector<CheckJob> jobs;
+	for( std::size_t i = 0; i < nbJobs; ++i )
 	{
-		checkFile( read, stat, graph, seq.getAbsoluteFilenameAt(t) );
+		sequenceParser::Time jobFirst, jobLast;
+		sam::jobRange( first, last, i, nbJobs, jobFirst, jobLast );
+		jobs.push_back( new CheckJob( readerId, seq, jobFirst, jobLast ) );
 	}
+	sam::runTasks( jobs.size(), nbJobs, boost::bind( &computeCheckJob, boost::ref( jobs ), _1 ) );
+
+	BOOST_FOREACH( const CheckJob& job, jobs )
+	{
+		for( sequenceParser::Time t = job.getFirst(); t <= job.getLast(); ++t )
+		{
+			reportImageStatus( job.getStatus( t ), seq.getAbsoluteFilenameAt( t ) );
+		}
+	}
+}
+
+void checkSequence( const std::string& readerId, const sequenceParser::Sequence& seq )
+{
+	checkSequence( readerId, seq, seq.getFirstTime(), seq.getLastTime() );
 }
 
 int main( int argc, char** argv )
@@ -138,6 +275,7 @@ int main( int argc, char** argv )
 			( kReaderOptionString, bpo::value(&readerId)/*->required()*/, kReaderOptionMessage )
 			( kInputOptionString,  bpo::value(&inputs)/*->required()*/,kInputOptionMessage )
 			( kRangeOptionString,  bpo::value(&range)->multitoken(), kRangeOptionMessage )
+			( kJobsOptionString,   bpo::value(&_nbJobs), kJobsOptionMessage )
 			( kBriefOptionString,  kBriefOptionMessage )
 			( kColorOptionString,  kColorOptionMessage )
 			( kScriptOptionString, kScriptOptionMessage );
@@ -229,6 +367,7 @@ int main( int argc, char** argv )
 		
 		TUTTLE_LOG_INFO( "Check if sequence have black images." );
 		TUTTLE_LOG_INFO( "This tools process the PSNR of an image, and if it's null, the image is considered black." );
+		TUTTLE_LOG_INFO( "Sequences are split in parallel jobs (see --jobs), each job computes its frames in one pass with its own graph." );
 		
 		TUTTLE_LOG_INFO( color->_blue  << "OPTIONS" << color->_std );
 		TUTTLE_LOG_INFO( "" );
@@ -281,7 +420,7 @@ int main( int argc, char** argv )
 						{
 							case sequenceParser::eMaskTypeSequence:
 							{
-								checkSequence( read, stat, graph, dynamic_cast<const sequenceParser::Sequence&>( fObj ) );
+								checkSequence( readerId, dynamic_cast<const sequenceParser::Sequence&>( fObj ) );
 								break;
 							}
 							case sequenceParser::eMaskTypeFile:
@@ -308,11 +447,11 @@ int main( int argc, char** argv )
 					sequenceParser::Sequence s( path );
 					if( hasRange )
 					{
-						checkSequence( read, stat, graph, s, range[0], range[1] );
+						checkSequence( readerId, s, range[0], range[1] );
 					}
 					else
 					{
-						checkSequence( read, stat, graph, s );
+						checkSequence( readerId, s );
 					}
 				}
 				catch( ... )
@@ -0,0 +1,122 @@
+#ifndef _SAM_FILEOPERATIONS_HPP_
+#define	_SAM_FILEOPERATIONS_HPP_
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/exception.hpp>
+#include <boost/system/error_code.hpp>
+
+#ifdef __linux__
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace sam {
+
+#ifdef __linux__
+namespace detail {
+
+/// The kernel copy is not available for these files, the copy must be done in user space.
+inline bool isKernelCopyUnsupported( const int error )
+{
+	return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == EBADF;
+}
+
+/**
+ * @brief Copy the content of the file descriptors in the kernel:
+ *        copy_file_range (server-side copy on network filesystems), else sendfile.
+ * @param[out] error errno of the copy, 0 on success
+ * @return false if the kernel copy is not supported for these files (nothing was copied)
+ */
+inline bool kernelCopy( const int in, const int out, const off_t size, int& error )
+{
+	error = 0;
+	off_t copied = 0;
+#if defined(__GLIBC__) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 27 ) )
+	while( copied < size )
+	{
+		const ssize_t n = ::copy_file_range( in, NULL, out, NULL, size - copied, 0 );
+		if( n < 0 )
+		{
+			if( copied == 0 && isKernelCopyUnsupported( errno ) )
+				break; // try sendfile
+			error = errno;
+			return true;
+		}
+		if( n == 0 )
+			return true; // the file was truncated during the copy
+		copied += n;
+	}
+	if( copied == size )
+		return true;
+#endif
+	while( copied < size )
+	{
+		const ssize_t n = ::sendfile( out, in, NULL, size - copied );
+		if( n < 0 )
+		{
+			if( copied == 0 && isKernelCopyUnsupported( errno ) )
+				return false;
+			error = errno;
+			return true;
+		}
+		if( n == 0 )
+			return true;
+		copied += n;
+	}
+	return true;
+}
+
+}
+#endif
+
+/**
+ * @brief Copy a file, the destination must not exist.
+ *
+ * On Linux, the data is copied by the kernel (and by the server on network filesystems
+ * which support it), without going through the memory of the process.
+ * @exception bfs::filesystem_error like boost::filesystem::copy_file
+ */
+inline void copyFile( const boost::filesystem::path& from, const boost::filesystem::path& to )
+{
+#ifdef __linux__
+	const int in = ::open( from.c_str(), O_RDONLY | O_CLOEXEC );
+	if( in < 0 )
+		throw boost::filesystem::filesystem_error( "sam::copyFile", from, to, boost::system::error_code( errno, boost::system::system_category() ) );
+	struct stat fromStat;
+	if( ::fstat( in, &fromStat ) != 0 )
+	{
+		const int error = errno;
+		::close( in );
+		throw boost::filesystem::filesystem_error( "sam::copyFile", from, to, boost::system::error_code( error, boost::system::system_category() ) );
+	}
+	const int out = ::open( to.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, fromStat.st_mode & 0777 );
+	if( out < 0 )
+	{
+		const int error = errno;
+		::close( in );
+		throw boost::filesystem::filesystem_error( "sam::copyFile", from, to, boost::system::error_code( error, boost::system::system_category() ) );
+	}
+	int error = 0;
+	const bool kernelCopied = detail::kernelCopy( in, out, fromStat.st_size, error );
+	if( ::close( out ) != 0 && error == 0 )
+		error = errno;
+	::close( in );
+	if( kernelCopied && error == 0 )
+		return;
+
+	// no partial file is kept
+	::unlink( to.c_str() );
+	if( kernelCopied )
+		throw boost::filesystem::filesystem_error( "sam::copyFile", from, to, boost::system::error_code( error, boost::system::system_category() ) );
+	// copy in user space
+#endif
+	boost::filesystem::copy_file( from, to );
+}
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef _SAM_JOBS_HPP_
+#define	_SAM_JOBS_HPP_
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace sam {
+
+/**
+ * @brief Number of jobs used to process nbFrames frames.
+ * @param requested value of the --jobs option (0: one job per core)
+ */
+inline std::size_t nbJobs( const std::size_t requested, const std::size_t nbFrames )
+{
+	const std::size_t jobs = requested ? requested : std::max( boost::thread::hardware_concurrency(), 1u );
+	return std::max( std::min( jobs, nbFrames ), std::size_t( 1 ) );
+}
+
+/**
+ * @brief Contiguous part [jobFirst, jobLast] of the frame range [first, last] processed by a job.
+ */
+template<typename Time>
+void jobRange( const Time first, const Time last, const std::size_t jobId, const std::size_t nbJobs, Time& jobFirst, Time& jobLast )
+{
+	const std::size_t nbFrames = last - first + 1;
+	jobFirst = first + static_cast<Time>( nbFrames * jobId / nbJobs );
+	jobLast  = first + static_cast<Time>( nbFrames * ( jobId + 1 ) / nbJobs ) - 1;
+}
+
+namespace detail {
+
+template<class Function>
+void runTasksWorker( std::size_t& nextTask, boost::mutex& mutex, const std::size_t nbTasks, Function& f )
+{
+	for(;;)
+	{
+		std::size_t task;
+		{
+			boost::mutex::scoped_lock lock( mutex );
+			if( nextTask >= nbTasks )
+				return;
+			task = nextTask++;
+		}
+		f( task );
+	}
+}
+
+}
+
+/**
+ * @brief Calls f( task ) for each task in [0, nbTasks), on a bounded pool of threads.
+ *
+ * The tasks are started in order, but executed concurrently,
+ * f must be thread-safe and handle its own errors.
+ * @param requested maximum number of threads (0: one per core)
+ */
+template<class Function>
+void runTasks( const std::size_t nbTasks, const std::size_t requested, Function f )
+{
+	const std::size_t nbThreads = nbJobs( requested, nbTasks );
+	std::size_t nextTask = 0;
+	boost::mutex mutex;
+	boost::thread_group threads;
+	for( std::size_t i = 1; i < nbThreads; ++i )
+	{
+		threads.create_thread( boost::bind( &detail::runTasksWorker<Function>, boost::ref( nextTask ), boost::ref( mutex ), nbTasks, boost::ref( f ) ) );
+	}
+	detail::runTasksWorker( nextTask, mutex, nbTasks, f );
+	threads.join_all();
+}
+
+}
+
+#endif
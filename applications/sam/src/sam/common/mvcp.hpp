@@ -1,5 +1,7 @@
 #include <sam/common/utility.hpp>
 #include <sam/common/options.hpp>
+#include <sam/common/jobs.hpp>
+#include <sam/common/fileOperations.hpp>
 
 #include <tuttle/common/exceptions.hpp>
 
@@ -10,10 +12,14 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/foreach.hpp>
 #include <boost/program_options.hpp>
+#include <boost/bind.hpp>
 
 #include <Sequence.hpp>
 
 #include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
 
 #ifndef SAM_MOVEFILES
 #define SAM_MV_OR_CP_OPTIONS    "SAM_CP_OPTIONS"
@@ -28,6 +34,66 @@ namespace bpo = boost::program_options;
 namespace bal = boost::algorithm;
 
 
+static std::size_t _nbJobs = 0; ///< concurrent file operations, 0: one per core
+
+typedef std::vector< std::pair<bfs::path, bfs::path> > FilePairs;
+
+/**
+ * @brief Copy or move one file of a sequence, called concurrently by the workers.
+ */
+void copy_file_of_sequence( const FilePairs& files, const std::size_t index )
+{
+	const bfs::path& sFile = files[index].first;
+	const bfs::path& dFile = files[index].second;
+	//TUTTLE_TLOG_VAR( TUTTLE_TRACE, sFile );
+	if( ! bfs::exists( sFile ) )
+		return;
+	//TUTTLE_TLOG( TUTTLE_TRACE, "do " << sFile << " -> " << dFile );
+#ifndef SAM_MOVEFILES // copy file(s)
+	if( bfs::exists(dFile) )
+	{
+		TUTTLE_LOG_ERROR( "Could not copy: " << dFile.string( ) );
+	}
+	else
+	{
+		try
+		{
+			//TUTTLE_LOG_TRACE( "copy " << sFile << " -> " << dFile );
+			sam::copyFile(sFile, dFile);
+		}
+		catch (const bpo::error& e)
+		{
+			TUTTLE_LOG_ERROR( "error : " << e.what() );
+		}
+		catch (...)
+		{
+			TUTTLE_LOG_ERROR( boost::current_exception_diagnostic_information( ) );
+		}
+	}
+#else // move file(s)
+	if( bfs::exists( dFile ) )
+	{
+		TUTTLE_LOG_ERROR( "Could not move: " << dFile.string( ) );
+	}
+	else
+	{
+		try
+		{
+			//TUTTLE_LOG_TRACE( "move " << sFile << " -> " << dFile );
+			bfs::rename( sFile, dFile );
+		}
+		catch( const bpo::error& e )
+		{
+			TUTTLE_LOG_ERROR( "error : " << e.what() );
+		}
+		catch( ... )
+		{
+			TUTTLE_LOG_ERROR( boost::current_exception_diagnostic_information( ) );
+		}
+	}
+#endif
+}
+
 void copy_sequence( const sequenceParser::Sequence& s, const sequenceParser::Time firstImage, const sequenceParser::Time lastImage, const sequenceParser::Sequence& d, int offset = 0 )
 {
 	sequenceParser::Time begin;
@@ -43,61 +109,28 @@ void copy_sequence( const sequenceParser::Sequence& s, const sequenceParser::Tim
 		step = s.getStep();
 	}
 	
+	FilePairs files;
+	std::set<bfs::path> sFiles;
 	for( sequenceParser::Time t = begin;
 		 (offset > 0) ? (t >= end) : (t <= end);
 		 t += step )
 	{
-		bfs::path sFile = s.getAbsoluteFilenameAt(t);
-		//TUTTLE_TLOG_VAR( TUTTLE_TRACE, sFile );
-		if( bfs::exists( sFile) )
+		files.push_back( std::make_pair( s.getAbsoluteFilenameAt(t), d.getAbsoluteFilenameAt(t + offset) ) );
+		sFiles.insert( files.back().first );
+	}
+
+	// When the destination files overlap the source files (renumbering in place),
+	// the order of the operations matters: the files are processed one by one.
+	bool overlap = false;
+	BOOST_FOREACH( const FilePairs::value_type& f, files )
+	{
+		if( sFiles.count( f.second ) )
 		{
-			bfs::path dFile = d.getAbsoluteFilenameAt(t + offset);
-			//TUTTLE_TLOG( TUTTLE_TRACE, "do " << sFile << " -> " << dFile );
-#ifndef SAM_MOVEFILES // copy file(s)
-			if( bfs::exists(dFile) )
-			{
-				TUTTLE_LOG_ERROR( "Could not copy: " << dFile.string( ) );
-			}
-			else
-			{
-				try
-				{
-					//TUTTLE_LOG_TRACE( "copy " << sFile << " -> " << dFile );
-					bfs::copy_file(sFile, dFile);
-				}
-				catch (const bpo::error& e)
-				{
-					TUTTLE_LOG_ERROR( "error : " << e.what() );
-				}
-				catch (...)
-				{
-					TUTTLE_LOG_ERROR( boost::current_exception_diagnostic_information( ) );
-				}
-			}
-#else // move file(s)
-			if( bfs::exists( dFile ) )
-			{
-				TUTTLE_LOG_ERROR( "Could not move: " << dFile.string( ) );
-			}
-			else
-			{
-				try
-				{
-					//TUTTLE_LOG_TRACE( "move " << sFile << " -> " << dFile );
-					bfs::rename( sFile, dFile );
-				}
-				catch( const bpo::error& e )
-				{
-					TUTTLE_LOG_ERROR( "error : " << e.what() );
-				}
-				catch( ... )
-				{
-					TUTTLE_LOG_ERROR( boost::current_exception_diagnostic_information( ) );
-				}
-			}
-#endif
+			overlap = true;
+			break;
 		}
 	}
+	sam::runTasks( files.size(), overlap ? 1 : _nbJobs, boost::bind( &copy_file_of_sequence, boost::cref( files ), _1 ) );
 }
 
 void copy_sequence( const sequenceParser::Sequence& s, const sequenceParser::Sequence& d, const sequenceParser::Time offset = 0 )
@@ -157,6 +190,7 @@ int sammvcp(int argc, char** argv)
 	mainOptions.add_options()
 			( kHelpOptionString,  kHelpOptionMessage )
 			( kOffsetOptionString,      bpo::value<std::ssize_t>(), kOffsetOptionMessage ) 
+			( kJobsOptionString,        bpo::value(&_nbJobs), kJobsOptionMessage )
 			//		( "force,f"     , bpo::value<bool>( )        , "if a destination file exists, replace it" )
 			( kVerboseOptionString,     bpo::value<int>()->default_value( 2 ), kVerboseOptionMessage )
 			( kQuietOptionString, kQuietOptionMessage )
@@ -274,6 +308,7 @@ int sammvcp(int argc, char** argv)
 #else
 		TUTTLE_LOG_INFO( "Move sequence of image files, and could remove trees (folder, files and sequences)." );
 #endif
+		TUTTLE_LOG_INFO( "The files of a sequence are processed concurrently (see --jobs)." );
 		TUTTLE_LOG_INFO( "" );
 		TUTTLE_LOG_INFO( color->_blue << "OPTIONS" << color->_std );
 		TUTTLE_LOG_INFO( mainOptions );
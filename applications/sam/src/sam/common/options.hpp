@@ -67,6 +67,11 @@ static const char* const kIgnoreOptionLongName = "ignore";
 static const char* const kIgnoreOptionString = "ignore,I";
 static const char* const kIgnoreOptionMessage = "ignore the specified sequence";
 
+//-j, --jobs
+static const char* const kJobsOptionLongName = "jobs";
+static const char* const kJobsOptionString = "jobs,j";
+static const char* const kJobsOptionMessage = "number of parallel jobs on sequences (0: one job per core)";
+
 //-l, --long-listing
 static const char* const kLongListingOptionLongName = "long-listing";
 static const char* const kLongListingOptionString = "long-listing,l";
@@ -224,6 +229,11 @@ static const char* const kLastImageOptionLongName = "last-image";
 static const char* const kLastImageOptionString = kLastImageOptionLongName;
 static const char* const kLastImageOptionMessage = "specify the last image";
 
+//--measure
+static const char* const kMeasureOptionLongName = "measure";
+static const char* const kMeasureOptionString = kMeasureOptionLongName;
+static const char* const kMeasureOptionMessage = "quality measure: mse, psnr, ssim or ms-ssim";
+
 //--nodes-list
 static const char* const kNodesListOptionLongName = "nodes-script";
 static const char* const kNodesListOptionString = kNodesListOptionLongName;
@@ -319,6 +329,16 @@ static const char* const kScriptOptionLongName = "script";
 static const char* const kScriptOptionString = kScriptOptionLongName;
 static const char* const kScriptOptionMessage = "format the output such as it could be dump in a file and be used as a script";
 
+//--server
+static const char* const kServerOptionLongName = "server";
+static const char* const kServerOptionString = kServerOptionLongName;
+static const char* const kServerOptionMessage = "run as a render server, listening for jobs on the given unix socket (must be in front of the first node)";
+
+//--connect
+static const char* const kConnectOptionLongName = "connect";
+static const char* const kConnectOptionString = kConnectOptionLongName;
+static const char* const kConnectOptionMessage = "send the job to the render server listening on the given unix socket, or to $SAM_DO_SERVER (must be in front of the first node)";
+
 }
 
 #endif
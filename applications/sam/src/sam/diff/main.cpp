@@ -1,14 +1,21 @@
 #include <sam/common/utility.hpp>
 #include <sam/common/options.hpp>
+#include <sam/common/jobs.hpp>
 
 #include <tuttle/host/Graph.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/bind.hpp>
 
 #include <Sequence.hpp>
 
+#include <algorithm>
 #include <limits>
 
 using namespace tuttle::host;
@@ -22,6 +29,49 @@ static int _corruptedImage = 0;
 static int _missingFiles = 0;
 static int _processedImages = 0;
 
+static const char* const kMeasureNames[] = { "mse", "psnr", "ssim", "ms-ssim" };
+static int _measureFunction = 1; ///< index of the measure in kMeasureNames, psnr by default
+static double _identicalQuality = 0.0; ///< quality of identical images (1 for ssim)
+static std::size_t _nbJobs = 0; ///< parallel jobs on sequences, 0: one per core
+
+/**
+ * @brief Aggregated quality of the frames of a sequence (rgb channels).
+ */
+struct QualityStatistics
+{
+	QualityStatistics()
+	: _nbFrames( 0 )
+	{
+		for( int i = 0; i < 3; ++i )
+		{
+			_min[i] = std::numeric_limits<double>::max();
+			_max[i] = - std::numeric_limits<double>::max();
+			_sum[i] = 0.0;
+			_maxError[i] = 0.0;
+		}
+	}
+
+	void add( const double* quality, const double* maxError )
+	{
+		for( int i = 0; i < 3; ++i )
+		{
+			_min[i] = std::min( _min[i], quality[i] );
+			_max[i] = std::max( _max[i], quality[i] );
+			_sum[i] += quality[i];
+			_maxError[i] = std::max( _maxError[i], maxError[i] );
+		}
+		++_nbFrames;
+	}
+
+	std::size_t _nbFrames;
+	double _min[3];
+	double _max[3];
+	double _sum[3];
+	double _maxError[3];
+};
+
+static QualityStatistics _qualityStatistics;
+
 enum EReturnCode {
 	eReturnCodeOK = 0,
 	eReturnCodeErrorInImages = 1,
@@ -65,7 +115,7 @@ EImageStatus diffImageStatus(Graph::Node& read1, Graph::Node& read2, Graph::Node
 
 		for (unsigned int i = 0; i < 3; ++i)
 		{
-			if (stat.getParam("quality").getDoubleValueAtIndex(i) != 0.0 )
+			if (stat.getParam("quality").getDoubleValueAtIndex(i) != _identicalQuality )
 				return eImageStatusDiffNotNull;
 		}
 		//TUTTLE_LOG_TRACE( stat );
@@ -163,7 +213,7 @@ EImageStatus diffImageStatus(Graph::Node& read1, Graph::Node& read2, Graph::Node
 
 		for (unsigned int i = 0; i < 3; ++i)
 		{
-			if (stat.getParam("quality").getDoubleValueAtIndex(i) != 0.0 )
+			if (stat.getParam("quality").getDoubleValueAtIndex(i) != _identicalQuality )
 				return eImageStatusDiffNotNull;
 		}
 		//TUTTLE_LOG_TRACE( stat );
@@ -179,12 +229,10 @@ EImageStatus diffImageStatus(Graph::Node& read1, Graph::Node& read2, Graph::Node
 }
 
 /**
- * @brief Difference between 2 reader's node associated at 2 files
+ * @brief Count and print the status of the difference between 2 files
  */
-EImageStatus diffFile(Graph::Node& read1, Graph::Node& read2, Graph::Node& stat, Graph& graph, const bfs::path& filename1, const bfs::path& filename2)
+void reportImageStatus(const EImageStatus s, const bfs::path& filename1, const bfs::path& filename2)
 {
-	EImageStatus s = diffImageStatus(read1, read2, stat, graph, filename1, filename2);
-
 	std::string message;
 	switch (s) {
 		case eImageStatusDiffNull:
@@ -208,6 +256,15 @@ EImageStatus diffFile(Graph::Node& read1, Graph::Node& read2, Graph::Node& stat,
 	}
 	++_processedImages;
 	TUTTLE_LOG_WARNING( message << filename1 << "  and: " << filename2 );
+}
+
+/**
+ * @brief Difference between 2 reader's node associated at 2 files
+ */
+EImageStatus diffFile(Graph::Node& read1, Graph::Node& read2, Graph::Node& stat, Graph& graph, const bfs::path& filename1, const bfs::path& filename2)
+{
+	EImageStatus s = diffImageStatus(read1, read2, stat, graph, filename1, filename2);
+	reportImageStatus(s, filename1, filename2);
 	return s;
 }
 
@@ -244,23 +301,164 @@ EImageStatus diffFile(Graph::Node& read1, Graph::Node& read2, Graph::Node& stat,
 	return s;
 }
 
-void diffSequence(Graph::Node& read1, Graph::Node& read2, Graph::Node& stat, Graph& graph, const sequenceParser::Sequence& seq1, const sequenceParser::Sequence& seq2)
+/**
+ * @brief Difference of a part of 2 sequences, with its own graph computed once on the frames of the job.
+ *
+ * The measures of each frame are read at the end of the frame by the output callback.
+ * The jobs are computed at the same time, each one keeps its images in its own memory cache.
+ */
+class DiffJob
 {
-	for (sequenceParser::Time t = seq1.getFirstTime(); t <= seq1.getLastTime(); ++t)
+public:
+	DiffJob(const std::vector<std::string>& nodeId, const sequenceParser::Sequence& seq1, const sequenceParser::Sequence& seq2, const sequenceParser::Time first,
+			const sequenceParser::Time last)
+	: _first(first)
+	, _last(last)
+	, _frames(last - first + 1)
+	, _read1(_graph.createNode(nodeId.at(0)))
+	, _read2(_graph.createNode(nodeId.at(1)))
+	, _stat(_graph.createNode("tuttle.diff"))
+	{
+		_read1.getParam("filename").setValue(seq1.getAbsoluteStandardPattern());
+		_read2.getParam("filename").setValue(seq2.getAbsoluteStandardPattern());
+		_stat.getParam("measureFunction").setValue(_measureFunction);
+		_stat.getParam("computeMaxError").setValue(true);
+		_graph.connect(_read1, _stat);
+		_graph.connect(_read2, _stat.getAttribute("SourceB"));
+
+		// the missing and empty files are not rendered
+		_options.setContinueOnError(true);
+		_options.setContinueOnMissingFile(true);
+		_options.setOutputCallback(boost::bind(&DiffJob::frameRendered, this, _1, _2));
+
+		sequenceParser::Time rangeBegin = first;
+		for (sequenceParser::Time t = first; t <= last + 1; ++t)
+		{
+			EImageStatus s = eImageStatusImageError; // until the frame is rendered
+			if (t <= last)
+			{
+				const bfs::path filename1 = seq1.getAbsoluteFilenameAt(t);
+				const bfs::path filename2 = seq2.getAbsoluteFilenameAt(t);
+				if (!bfs::exists(filename1) || !bfs::exists(filename2))
+					s = eImageStatusNoFile;
+				else if (bfs::file_size(filename1) == 0 || bfs::file_size(filename2) == 0)
+					s = eImageStatusFileSizeError;
+				_frames[t - first]._status = s;
+			}
+			if (t > last || s != eImageStatusImageError)
+			{
+				if (rangeBegin < t)
+					_options.addTimeRange(rangeBegin, t - 1);
+				rangeBegin = t + 1;
+			}
+		}
+	}
+
+	void compute()
+	{
+		if (_options.getTimeRanges().empty())
+			return;
+		memory::MemoryCache memoryCache;
+		core().setThreadMemoryCache(&memoryCache);
+		try
+		{
+			_graph.compute(_stat, _options);
+		}
+		catch (...)
+		{
+			// the frames not rendered keep their image error status
+			TUTTLE_LOG_ERROR(boost::current_exception_diagnostic_information());
+		}
+		core().setThreadMemoryCache(NULL);
+	}
+
+	/// Count and print the status of each frame, and aggregate the measures.
+	void report(const sequenceParser::Sequence& seq1, const sequenceParser::Sequence& seq2) const
+	{
+		for (sequenceParser::Time t = _first; t <= _last; ++t)
+		{
+			const FrameResult& frame = _frames[t - _first];
+			if (frame._status == eImageStatusDiffNull || frame._status == eImageStatusDiffNotNull)
+			{
+				TUTTLE_LOG_TRACE( "diff at frame " << t << " = " << frame._quality[0] << "  " << frame._quality[1] << "  " << frame._quality[2] );
+				_qualityStatistics.add(frame._quality, frame._maxError);
+			}
+			reportImageStatus(frame._status, seq1.getAbsoluteFilenameAt(t), seq2.getAbsoluteFilenameAt(t));
+		}
+	}
+
+private:
+	void frameRendered(const OfxTime time, const bool rendered)
 	{
-		diffFile(read1, read2, stat, graph, seq1.getAbsoluteFilenameAt(t), seq2.getAbsoluteFilenameAt(t));
+		FrameResult& frame = _frames[static_cast<sequenceParser::Time>(time) - _first];
+		if (!rendered)
+		{
+			frame._status = eImageStatusImageError;
+			return;
+		}
+		frame._status = eImageStatusDiffNull;
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			frame._quality[i] = _stat.getParam("quality").getDoubleValueAtTimeAndIndex(time, i);
+			frame._maxError[i] = _stat.getParam("maxError").getDoubleValueAtTimeAndIndex(time, i);
+			if (frame._quality[i] != _identicalQuality)
+				frame._status = eImageStatusDiffNotNull;
+		}
 	}
+
+private:
+	struct FrameResult
+	{
+		EImageStatus _status;
+		double _quality[3];
+		double _maxError[3];
+	};
+
+	sequenceParser::Time _first;
+	sequenceParser::Time _last;
+	std::vector<FrameResult> _frames;
+	Graph _graph;
+	Graph::Node& _read1;
+	Graph::Node& _read2;
+	Graph::Node& _stat;
+	ComputeOptions _options;
+};
+
+void computeDiffJob(boost::ptr_vector<DiffJob>& jobs, const std::size_t jobId)
+{
+	jobs[jobId].compute();
 }
 
-void diffSequence(Graph::Node& read1, Graph::Node& read2, Graph::Node& stat, Graph& graph, const sequenceParser::Sequence& seq1, const sequenceParser::Sequence& seq2, const sequenceParser::Time first,
+/**
+ * @brief Difference between the frames [first, last] of 2 sequences, split in parallel jobs.
+ */
+void diffSequence(const std::vector<std::string>& nodeId, const sequenceParser::Sequence& seq1, const sequenceParser::Sequence& seq2, const sequenceParser::Time first,
 				  const sequenceParser::Time last)
 {
-	for (sequenceParser::Time t = first; t <= last; ++t)
+	if (last < first)
+		return;
+	// the graphs are created in the main thread, only the computations are parallel
+	const std::size_t nbJobs = sam::nbJobs(_nbJobs, last - first + 1);
+	boost::ptr_vector<DiffJob> jobs;
+	for (std::size_t i = 0; i < nbJobs; ++i)
+	{
+		sequenceParser::Time jobFirst, jobLast;
+		sam::jobRange(first, last, i, nbJobs, jobFirst, jobLast);
+		jobs.push_back(new DiffJob(nodeId, seq1, seq2, jobFirst, jobLast));
+	}
+	sam::runTasks(jobs.size(), nbJobs, boost::bind(&computeDiffJob, boost::ref(jobs), _1));
+
+	BOOST_FOREACH(const DiffJob& job, jobs)
 	{
-		diffFile(read1, read2, stat, graph, seq1.getAbsoluteFilenameAt(t), seq2.getAbsoluteFilenameAt(t));
+		job.report(seq1, seq2);
 	}
 }
 
+void diffSequence(const std::vector<std::string>& nodeId, const sequenceParser::Sequence& seq1, const sequenceParser::Sequence& seq2)
+{
+	diffSequence(nodeId, seq1, seq2, seq1.getFirstTime(), seq1.getLastTime());
+}
+
 void displayHelp(bpo::options_description &desc)
 {
 	using namespace sam;
@@ -277,6 +475,9 @@ void displayHelp(bpo::options_description &desc)
 	TUTTLE_LOG_INFO( color->_blue << "DESCRIPTION" << color->_std);
 	TUTTLE_LOG_INFO( color->_green << "\tDiff if sequence have black images." << color->_std );
 	TUTTLE_LOG_INFO( color->_green << "\tThis tools process the PSNR of an image, and if it's null, the image is considered black." << color->_std );
+	TUTTLE_LOG_INFO( color->_green << "\tThe measure could also be the MSE, the SSIM or the MS-SSIM (identical images have a SSIM of 1)." << color->_std );
+	TUTTLE_LOG_INFO( color->_green << "\tSequences are split in parallel jobs (see --jobs), each job computes its frames in one pass with its own graph," << color->_std );
+	TUTTLE_LOG_INFO( color->_green << "\tand the quality of all the frames is summarized." << color->_std );
 	TUTTLE_LOG_INFO( color->_green << "\tOnly compare RGB layout, not Alpha." << color->_std );
 	TUTTLE_LOG_INFO( "" );
 	TUTTLE_LOG_INFO( color->_blue << "OPTIONS" << color->_std );
@@ -291,6 +492,8 @@ void displayHelp(bpo::options_description &desc)
 	SAM_EXAMPLE_LINE_COUT ( "", "sam-diff --reader tuttle.jpegreader --input path/image.jpg --reader tuttle.jpegreader --input anotherPath/image.jpg");
 	SAM_EXAMPLE_TITLE_COUT( "Compare two sequences: ");
 	SAM_EXAMPLE_LINE_COUT ( "", "sam-diff --reader tuttle.jpegreader --input path/seq.@.jpg --reader tuttle.jpegreader --input anotherPath/seq.@.jpg --range 677836 677839");
+	SAM_EXAMPLE_TITLE_COUT( "Compare two sequences with the structural similarity: ");
+	SAM_EXAMPLE_LINE_COUT ( "", "sam-diff --reader tuttle.dpxreader --input master/seq.@.dpx --reader tuttle.dpxreader --input delivery/seq.@.dpx --measure ms-ssim");
 	SAM_EXAMPLE_TITLE_COUT( "Compare one sequence with one generator (generator need to be every time the second node): ");
 	SAM_EXAMPLE_LINE_COUT ( "", "sam-diff --reader tuttle.jpegreader --input path/seq.@.jpg --reader tuttle.constant --generator-args width=500 components=rgb --range 677836 677839" );
 	TUTTLE_LOG_INFO( "" );
@@ -326,6 +529,8 @@ int main( int argc, char** argv )
 				( kInputOptionString,  bpo::value(&inputs), kInputOptionMessage )
 				( kRangeOptionString,  bpo::value(&range)->multitoken(), kRangeOptionMessage )
 				( kGeneratorArgsOptionString, bpo::value(&generator)->multitoken(),  kGeneratorArgsOptionMessage )
+				( kMeasureOptionString, bpo::value<std::string>(), kMeasureOptionMessage )
+				( kJobsOptionString,   bpo::value(&_nbJobs), kJobsOptionMessage )
 				( kVerboseOptionString,       bpo::value<int>()->default_value( 2 ), kVerboseOptionMessage )
 				( kQuietOptionString,  kQuietOptionMessage )
 				( kBriefOptionString,  kBriefOptionMessage )
@@ -438,6 +643,20 @@ int main( int argc, char** argv )
 			displayHelp(desc);
 			return 254;
 		}
+		if (vm.count(kMeasureOptionLongName))
+		{
+			const std::string measure = vm[kMeasureOptionLongName].as<std::string>();
+			const int nbMeasures = sizeof(kMeasureNames) / sizeof(kMeasureNames[0]);
+			_measureFunction = std::find(kMeasureNames, kMeasureNames + nbMeasures, measure) - kMeasureNames;
+			if( _measureFunction == nbMeasures )
+			{
+				TUTTLE_LOG_ERROR( "sam-diff : unknown measure " << measure << "." );
+				displayHelp(desc);
+				return 254;
+			}
+			// ssim and ms-ssim
+			_identicalQuality = ( _measureFunction >= 2 ) ? 1.0 : 0.0;
+		}
 		if (vm.count(kRangeOptionLongName))
 		{
 			range = vm[kRangeOptionLongName].as<std::vector<int> >();
@@ -454,6 +673,7 @@ int main( int argc, char** argv )
 		Graph::Node& read2 = graph.createNode(nodeId.at(1));
 		//Graph::Node& viewer = graph.createNode( "tuttle.viewer" );
 		Graph::Node& stat = graph.createNode("tuttle.diff");
+		stat.getParam("measureFunction").setValue(_measureFunction);
 		//graph.connect( viewer, stat );
 		graph.connect(read1, stat);
 		graph.connect(read2, stat.getAttribute("SourceB"));
@@ -542,11 +762,11 @@ int main( int argc, char** argv )
 						sequenceParser::Sequence s2(path2);
 						if (hasRange)
 						{
-							diffSequence(read1, read2, stat, graph, s1, s2, range[0], range[1]);
+							diffSequence(nodeId, s1, s2, range[0], range[1]);
 						}
 						else
 						{
-							diffSequence(read1, read2, stat, graph, s1, s2);
+							diffSequence(nodeId, s1, s2);
 						}
 					}
 					catch(...)
@@ -570,6 +790,15 @@ int main( int argc, char** argv )
 	TUTTLE_LOG_INFO( "Null file size: " << _nullFileSize);
 	TUTTLE_LOG_INFO( "Corrupted images: " << _corruptedImage);
 	TUTTLE_LOG_INFO( "Holes in sequence: " << _missingFiles);
+	if( _qualityStatistics._nbFrames )
+	{
+		const QualityStatistics& q = _qualityStatistics;
+		TUTTLE_LOG_INFO( "Quality (" << kMeasureNames[_measureFunction] << ") on " << q._nbFrames << " frames:" );
+		TUTTLE_LOG_INFO( "    min:  " << q._min[0] << "  " << q._min[1] << "  " << q._min[2] );
+		TUTTLE_LOG_INFO( "    mean: " << q._sum[0] / q._nbFrames << "  " << q._sum[1] / q._nbFrames << "  " << q._sum[2] / q._nbFrames );
+		TUTTLE_LOG_INFO( "    max:  " << q._max[0] << "  " << q._max[1] << "  " << q._max[2] );
+		TUTTLE_LOG_INFO( "Max error: " << q._maxError[0] << "  " << q._maxError[1] << "  " << q._maxError[2] );
+	}
 	TUTTLE_LOG_INFO( "________________________________________");
 
 	return _notNullImage + _nullFileSize + _corruptedImage + _missingFiles;
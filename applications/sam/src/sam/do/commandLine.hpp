@@ -20,21 +20,20 @@ static const std::string kpipe = SAM_DO_PIPE_STR;
 /**
  * @brief Decomposes command line arguments into a list of options and a list of node command lines. Groups the arguments without insterpretation at this step.
  * 
- * @param[in]	argc	number of arguments ont the command line
- * @param[in]	argv	list of string arguments
+ * @param[in]	args	list of string arguments, without the program name
  * @param[out]	cl_options	list of options for sam-do
  * @param[out]	cl_commands	list of node command lines (list of strings groups without insterpretation at this step)
  * @param[in]	pipe	pipe character
  */
-void decomposeCommandLine( const int argc, char** const argv, std::vector<std::string>& cl_options, std::vector< std::vector<std::string> >& cl_commands, const std::string& pipe = kpipe )
+void decomposeCommandLine( const std::vector<std::string>& args, std::vector<std::string>& cl_options, std::vector< std::vector<std::string> >& cl_commands, const std::string& pipe = kpipe )
 {
 	cl_commands.reserve(10);
 	cl_commands.resize(1); // first node for options
 
 	// split the command line to identify the multiple parts
-	for( int i = 1; i < argc; ++i )
+	for( std::size_t i = 0; i < args.size(); ++i )
 	{
-		const std::string s( argv[i] );
+		const std::string& s = args[i];
 		if( s == pipe )
 		{
 			cl_commands.resize( cl_commands.size()+1 );
@@ -91,6 +90,11 @@ void decomposeCommandLine( const int argc, char** const argv, std::vector<std::s
 	}
 }
 
+void decomposeCommandLine( const int argc, char** const argv, std::vector<std::string>& cl_options, std::vector< std::vector<std::string> >& cl_commands, const std::string& pipe = kpipe )
+{
+	decomposeCommandLine( std::vector<std::string>( argv + 1, argv + argc ), cl_options, cl_commands, pipe );
+}
+
 }
 }
 
@@ -11,6 +11,16 @@ namespace ttl = tuttle::host;
 namespace sam {
 namespace samdo {
 
+/**
+ * @brief Thrown to stop a command with an exit status.
+ * The commands don't call exit(), they may be executed by a render server.
+ */
+struct ExitRequest
+{
+	explicit ExitRequest( const int status ) : _status( status ) {}
+	int _status;
+};
+
 /*
 struct NodeCommand
 {
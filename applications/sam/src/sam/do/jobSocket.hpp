@@ -0,0 +1,219 @@
+#ifndef _SAM_DO_JOBSOCKET_HPP_
+#define	_SAM_DO_JOBSOCKET_HPP_
+
+#include <boost/cstdint.hpp>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace sam {
+namespace samdo {
+
+/**
+ * Protocol between "sam do --connect" and "sam do --server", on a unix stream socket.
+ *
+ * The client sends the job: the protocol version, the number of strings,
+ * then the client working directory and the sam do arguments.
+ * The server answers with messages (a type char and a string): the log
+ * of the job, then its exit status.
+ * Integers are 32 bits in network order, strings are prefixed with their size.
+ */
+static const boost::uint32_t kJobProtocolVersion = 1;
+static const boost::uint32_t kJobMaxStringSize = 16 * 1024 * 1024;
+/// Seconds the server waits for a client to send its job or to read its log
+static const int kJobSocketTimeout = 30;
+
+enum EJobMessage
+{
+	eJobMessageLog    = 'l', ///< log text of the job
+	eJobMessageStatus = 's'  ///< exit status of the job, ends the answer
+};
+
+inline bool writeAll( const int fd, const char* data, std::size_t size )
+{
+#ifdef MSG_NOSIGNAL
+	static const int flags = MSG_NOSIGNAL; // don't die if the other side is gone
+#else
+	static const int flags = 0;
+#endif
+	while( size )
+	{
+		const ssize_t n = ::send( fd, data, size, flags );
+		if( n < 0 )
+		{
+			if( errno == EINTR )
+				continue;
+			return false;
+		}
+		data += n;
+		size -= n;
+	}
+	return true;
+}
+
+inline bool readAll( const int fd, char* data, std::size_t size )
+{
+	while( size )
+	{
+		const ssize_t n = ::recv( fd, data, size, 0 );
+		if( n < 0 && errno == EINTR )
+			continue;
+		if( n <= 0 )
+			return false;
+		data += n;
+		size -= n;
+	}
+	return true;
+}
+
+inline bool writeUint32( const int fd, const boost::uint32_t v )
+{
+	const boost::uint32_t nv = htonl( v );
+	return writeAll( fd, reinterpret_cast<const char*>( &nv ), sizeof( nv ) );
+}
+
+inline bool readUint32( const int fd, boost::uint32_t& v )
+{
+	boost::uint32_t nv;
+	if( ! readAll( fd, reinterpret_cast<char*>( &nv ), sizeof( nv ) ) )
+		return false;
+	v = ntohl( nv );
+	return true;
+}
+
+inline bool writeString( const int fd, const std::string& s )
+{
+	return writeUint32( fd, static_cast<boost::uint32_t>( s.size() ) ) &&
+	       writeAll( fd, s.data(), s.size() );
+}
+
+inline bool readString( const int fd, std::string& s )
+{
+	boost::uint32_t size;
+	if( ! readUint32( fd, size ) || size > kJobMaxStringSize )
+		return false;
+	s.resize( size );
+	return size == 0 || readAll( fd, &s[0], size );
+}
+
+inline bool writeJobMessage( const int fd, const EJobMessage type, const std::string& s )
+{
+	const char t = static_cast<char>( type );
+	return writeAll( fd, &t, 1 ) && writeString( fd, s );
+}
+
+inline bool readJobMessage( const int fd, char& type, std::string& s )
+{
+	return readAll( fd, &type, 1 ) && readString( fd, s );
+}
+
+inline bool writeJobRequest( const int fd, const std::string& workingDirectory, const std::vector<std::string>& args )
+{
+	if( ! writeUint32( fd, kJobProtocolVersion ) ||
+	    ! writeUint32( fd, static_cast<boost::uint32_t>( args.size() + 1 ) ) ||
+	    ! writeString( fd, workingDirectory ) )
+		return false;
+	for( std::vector<std::string>::const_iterator it = args.begin(); it != args.end(); ++it )
+	{
+		if( ! writeString( fd, *it ) )
+			return false;
+	}
+	return true;
+}
+
+inline bool readJobRequest( const int fd, std::string& workingDirectory, std::vector<std::string>& args )
+{
+	boost::uint32_t version, nbStrings;
+	if( ! readUint32( fd, version ) || version != kJobProtocolVersion ||
+	    ! readUint32( fd, nbStrings ) || nbStrings == 0 ||
+	    ! readString( fd, workingDirectory ) )
+		return false;
+	args.resize( nbStrings - 1 );
+	for( std::vector<std::string>::iterator it = args.begin(); it != args.end(); ++it )
+	{
+		if( ! readString( fd, *it ) )
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Limit the time a send or a receive may block on a socket.
+ * When it expires, readAll() and writeAll() fail.
+ */
+inline bool setJobSocketTimeout( const int fd, const int seconds )
+{
+	timeval timeout;
+	timeout.tv_sec = seconds;
+	timeout.tv_usec = 0;
+	return ::setsockopt( fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof( timeout ) ) == 0 &&
+	       ::setsockopt( fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof( timeout ) ) == 0;
+}
+
+/**
+ * @brief The process at the other end of a unix socket is run by the same user as this process.
+ */
+inline bool isJobPeerSameUser( const int fd )
+{
+#ifdef SO_PEERCRED
+	ucred credentials;
+	socklen_t size = sizeof( credentials );
+	if( ::getsockopt( fd, SOL_SOCKET, SO_PEERCRED, &credentials, &size ) != 0 )
+		return false;
+	return credentials.uid == ::geteuid();
+#else
+	uid_t uid;
+	gid_t gid;
+	if( ::getpeereid( fd, &uid, &gid ) != 0 )
+		return false;
+	return uid == ::geteuid();
+#endif
+}
+
+/**
+ * @brief Fill a unix socket address.
+ * @return false if the path is too long
+ */
+inline bool jobSocketAddress( const std::string& path, sockaddr_un& address )
+{
+	std::memset( &address, 0, sizeof( address ) );
+	address.sun_family = AF_UNIX;
+	if( path.size() >= sizeof( address.sun_path ) )
+		return false;
+	std::strcpy( address.sun_path, path.c_str() );
+	return true;
+}
+
+/**
+ * @brief Connect to a job socket.
+ * @return the socket, or -1 if there is no server listening on @p path
+ */
+inline int connectJobSocket( const std::string& path )
+{
+	sockaddr_un address;
+	if( ! jobSocketAddress( path, address ) )
+		return -1;
+	const int fd = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+	if( fd < 0 )
+		return -1;
+	if( ::connect( fd, reinterpret_cast<sockaddr*>( &address ), sizeof( address ) ) != 0 )
+	{
+		::close( fd );
+		return -1;
+	}
+	return fd;
+}
+
+}
+}
+
+#endif
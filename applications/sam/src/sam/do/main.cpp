@@ -1,6 +1,7 @@
 #include "commandLine.hpp"
 #include "global.hpp"
 #include "nodeDummy.hpp"
+#include "server.hpp"
 
 #include <sam/common/node.hpp>
 #include <sam/common/node_io.hpp>
@@ -97,6 +98,11 @@ void displayHelp( bpo::options_description &infoOptions, bpo::options_descriptio
 	SAM_EXAMPLE_LINE_COUT ( "Multiple CPUs: ", "sam do reader in.@.dpx // writer out.@.exr // --nb-cores 4" );
 	SAM_EXAMPLE_LINE_COUT ( "Continues whatever happens: ", "sam do reader in.@.dpx // writer out.@.exr // --continueOnError" );
 
+	SAM_EXAMPLE_TITLE_COUT( "Render server" );
+	SAM_EXAMPLE_LINE_COUT ( "Start a server: ", "sam do --server /tmp/sam-do.socket" );
+	SAM_EXAMPLE_LINE_COUT ( "Send a job: ", "sam do --connect /tmp/sam-do.socket reader in.dpx // writer out.jpg" );
+	SAM_EXAMPLE_LINE_COUT ( "", "or set SAM_DO_SERVER=/tmp/sam-do.socket to send all the jobs" );
+
 	TUTTLE_LOG_INFO( "" );
 	TUTTLE_LOG_INFO( color->_blue << "DISPLAY OPTIONS (replace the process)" << color->_std );
 	TUTTLE_LOG_INFO( infoOptions );
@@ -232,6 +238,21 @@ std::string getAbsoluteFilename( const sequenceParser::FileObject& fo )
 	return "";
 }
 
+/// @brief Redirects a stream into another buffer, until the end of the scope.
+struct StreamRedirection
+{
+	StreamRedirection( std::ostream& stream, std::streambuf* buffer )
+	: _stream( stream )
+	, _previous( stream.rdbuf( buffer ) )
+	{}
+	~StreamRedirection() { restore(); }
+
+	void restore() { _stream.rdbuf( _previous ); }
+
+	std::ostream& _stream;
+	std::streambuf* _previous;
+};
+
 bool isContextSupported( const ttl::Graph::Node* node , const std::string& context )
 {
 	const ttl::ofx::property::OfxhProperty& prop = node->getProperties().fetchProperty( kOfxImageEffectPropSupportedContexts );
@@ -245,10 +266,8 @@ bool isContextSupported( const ttl::Graph::Node* node , const std::string& conte
 	return false;
 }
 
-int main( int argc, char** argv )
+int samDo( const std::vector<std::string>& args )
 {
-	signal(SIGINT, signal_callback_handler);
-
 	using namespace tuttle::common;
 	using namespace sam;
 	using namespace sam::samdo;
@@ -265,9 +284,7 @@ int main( int argc, char** argv )
 		std::vector<std::string> cl_options;
 		std::vector<std::vector<std::string> > cl_commands;
 
-		formatter->init_logging();
-		
-		decomposeCommandLine( argc, argv, cl_options, cl_commands );
+		decomposeCommandLine( args, cl_options, cl_commands );
 
 		// create the graph
 		ttl::Graph graph;
@@ -314,7 +331,9 @@ int main( int argc, char** argv )
 					( kRenderScaleOptionString, bpo::value<std::string >(), kRenderScaleOptionMessage )
 					( kVerboseOptionString,     bpo::value<int>()->default_value( 2 ), kVerboseOptionMessage )
 					( kQuietOptionString,       kQuietOptionMessage )
-					( kNbCoresOptionString,     bpo::value<std::size_t>(), kNbCoresOptionMessage );
+					( kNbCoresOptionString,     bpo::value<std::size_t>(), kNbCoresOptionMessage )
+					( kServerOptionString,      bpo::value<std::string>(), kServerOptionMessage )
+					( kConnectOptionString,     bpo::value<std::string>(), kConnectOptionMessage );
 
 				// describe hidden options
 				bpo::options_description hidden;
@@ -341,6 +360,12 @@ int main( int argc, char** argv )
 
 				bpo::notify( samdo_vm );
 
+				if( samdo_vm.count( kServerOptionLongName ) || samdo_vm.count( kConnectOptionLongName ) )
+				{
+					TUTTLE_LOG_ERROR( "sam do: the options " << kServerOptionLongName << " and " << kConnectOptionLongName << " must be in front of the first node." );
+					return 255;
+				}
+
 				if( samdo_vm.count( kScriptOptionLongName ) )
 				{
 					// disable color, disable directory printing and set relative path by default
@@ -392,13 +417,13 @@ int main( int argc, char** argv )
 				if( samdo_vm.count( kHelpOptionLongName ) )
 				{
 					displayHelp( infoOptions, confOptions );
-					exit( 0 );
+					return 0;
 				}
 
 				if( samdo_vm.count( kExpertOptionLongName ) )
 				{
 					displayHelp( infoOptions, confOptions, hidden );
-					exit( 0 );
+					return 0;
 				}
 
 				if( samdo_vm.count( kBriefOptionLongName ) )
@@ -410,7 +435,7 @@ int main( int argc, char** argv )
 				if( samdo_vm.count( kVersionOptionLongName ) )
 				{
 					TUTTLE_LOG_INFO( "TuttleOFX Host - version " << TUTTLE_HOST_VERSION_STR );
-					exit( 0 );
+					return 0;
 				}
 
 				// Missing operand check //
@@ -424,7 +449,7 @@ int main( int argc, char** argv )
 					// No display option and no sub-command to execute
 					TUTTLE_LOG_ERROR( "sam do: missing operand." );
 					//displayHelp( infoOptions, confOptions );
-					exit( 255 );
+					return 255;
 				}
 				
 				
@@ -432,8 +457,7 @@ int main( int argc, char** argv )
 				
 				const std::string logFilename = ( ttl::core().getPreferences().getTuttleHomePath() / "sam-do.log" ).string();
 				std::ofstream logFile( logFilename.c_str() );
-				std::streambuf* strm_buffer = std::cerr.rdbuf(); // save cerr's output buffer
-				std::cerr.rdbuf( logFile.rdbuf() ); // redirect output into the file
+				StreamRedirection cerrRedirection( std::cerr, logFile.rdbuf() ); // redirect output into the file
 				
 				if( samdo_vm.count( kNodesOptionLongName ) || samdo_vm.count( kNodesListOptionLongName ) )
 				{
@@ -457,14 +481,14 @@ int main( int argc, char** argv )
 					{
 						TUTTLE_LOG_INFO( indent << pluginName );
 					}
-					exit( 0 );
+					return 0;
 				}
 
 				{
 					if( samdo_vm.count( kRangeOptionLongName ) && ( samdo_vm.count( kFirstImageOptionLongName ) || samdo_vm.count( kLastImageOptionLongName ) ) )
 					{
 						TUTTLE_LOG_ERROR( color->_red << "sam do: could not use " << kRangeOptionLongName << "and " << kFirstImageOptionLongName << " or " << kLastImageOptionLongName << " option." << color->_std << std::endl );
-						exit( 255 );
+						return 255;
 					}
 					
 					if( samdo_vm.count( kFirstImageOptionLongName ) )
@@ -516,7 +540,7 @@ int main( int argc, char** argv )
 						renderscale.push_back( renderscale[0] );
 					}
 				}
-				std::cerr.rdbuf( strm_buffer ); // restore old output buffer
+				cerrRedirection.restore(); // restore old output buffer
 				if( samdo_vm.count( kContinueOnErrorOptionLongName ) )
 				{
 					continueOnError = samdo_vm[kContinueOnErrorOptionLongName].as< bool > ();
@@ -531,12 +555,12 @@ int main( int argc, char** argv )
 			catch( const boost::program_options::error& e )
 			{
 				TUTTLE_LOG_ERROR( "sam do: command line error: " << e.what() );
-				exit( 254 );
+				return 254;
 			}
 			catch( ... )
 			{
 				TUTTLE_LOG_ERROR( "sam do: error: " << boost::current_exception_diagnostic_information() );
-				exit( 254 );
+				return 254;
 			}
 
 			/// @todo Set all sam do options for rendering
@@ -638,7 +662,7 @@ int main( int argc, char** argv )
 								dummy.displayHelp( userNodeName );
 							else
 								displayNodeHelp( nodeFullName, currentNode, infoOptions, confOptions );
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kExpertOptionString ) )
 						{
@@ -646,7 +670,7 @@ int main( int argc, char** argv )
 								dummy.displayExpertHelp( userNodeName );
 							else
 								displayNodeHelp( nodeFullName, currentNode, infoOptions, confOptions, openfxOptions );
-							exit( 0 );
+							return 0;
 						}
 
 						if( node_vm.count( kVersionOptionLongName ) )
@@ -654,7 +678,7 @@ int main( int argc, char** argv )
 							TUTTLE_LOG_INFO( "\tsam do " << nodeFullName );
 							TUTTLE_LOG_INFO( "Version " << currentNode.getVersionStr() );
 							TUTTLE_LOG_INFO( "" );
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kAttributesOptionLongName ) )
 						{
@@ -668,7 +692,7 @@ int main( int argc, char** argv )
 							TUTTLE_LOG_INFO( color->_blue << "- PARAMETERS" << color->_std );
 							coutParametersWithDetails( currentNode );
 							TUTTLE_LOG_INFO( "" );
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kPropertiesOptionLongName ) )
 						{
@@ -681,7 +705,7 @@ int main( int argc, char** argv )
 							coutProperties( currentNode );
 							if( !script )
 								TUTTLE_LOG_INFO( "" );
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kClipsOptionLongName ) )
 						{
@@ -694,7 +718,7 @@ int main( int argc, char** argv )
 							coutClips( currentNode );
 							if( !script )
 								TUTTLE_LOG_INFO( "" );
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kClipOptionLongName ) )
 						{
@@ -736,7 +760,7 @@ int main( int argc, char** argv )
 								TUTTLE_LOG_INFO( clip.getNbComponents());
 							}
 							
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kParametersOptionLongName ) )
 						{
@@ -747,18 +771,18 @@ int main( int argc, char** argv )
 								TUTTLE_LOG_INFO( color->_blue << "PARAMETERS" << color->_std );
 								TUTTLE_LOG_INFO( "" );
 								coutParametersWithDetails( currentNode );
-								exit( 0 );
+								return 0;
 							}
 							else
 							{
 								coutParameters( currentNode );
-								exit( 0 );
+								return 0;
 							}
 						}
 						if( node_vm.count( kParametersReduxOptionLongName ) )
 						{
 							coutParameters( currentNode );
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kParamInfosOptionLongName ) )
 						{
@@ -775,7 +799,7 @@ int main( int argc, char** argv )
 								TUTTLE_LOG_INFO( "\t" << hint );
 							}
 							TUTTLE_LOG_INFO( "" );
-							exit( 0 );
+							return 0;
 						}
 
 						if( node_vm.count( kParamTypeOptionLongName ) )
@@ -783,7 +807,7 @@ int main( int argc, char** argv )
 							const std::string attributeName = node_vm[kParamTypeOptionLongName].as<std::string > ();
 							ttl::ofx::attribute::OfxhParam& param = currentNode.getParamByScriptName( attributeName );
 							TUTTLE_LOG_INFO( param.getParamTypeName() );
-							exit( 0 );
+							return 0;
 						}
 
 						if( node_vm.count( kParamPossibleValuesOptionLongName ) )
@@ -791,14 +815,14 @@ int main( int argc, char** argv )
 							const std::string attributeName = node_vm[kParamPossibleValuesOptionLongName].as<std::string > ();
 							ttl::ofx::attribute::OfxhParam& param = currentNode.getParamByScriptName( attributeName );
 							coutParameterValues( std::cout, param );
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kParamDefaultOptionLongName ) )
 						{
 							const std::string attributeName = node_vm[kParamDefaultOptionLongName].as<std::string > ();
 							ttl::ofx::attribute::OfxhParam& param = currentNode.getParamByScriptName( attributeName );
 							TUTTLE_LOG_INFO( getFormattedStringValue( param.getProperties().fetchProperty( kOfxParamPropDefault ) ) );
-							exit( 0 );
+							return 0;
 						}
 						if( node_vm.count( kParamGroupOptionLongName ) )
 						{
@@ -809,7 +833,7 @@ int main( int argc, char** argv )
 									TUTTLE_LOG_INFO( currentNode.asImageEffectNode().getPluginGrouping() );
 								}
 							}
-							exit( 0 );
+							return 0;
 						}
 
 						if( node_vm.count( kIdOptionLongName ) )
@@ -851,7 +875,7 @@ int main( int argc, char** argv )
 #else
 						TUTTLE_LOG_ERROR( "Debug: " << boost::current_exception_diagnostic_information() );
 #endif
-						exit( 254 );
+						return 254;
 					}
 					catch( tuttle::exception::Common& e )
 					{
@@ -862,7 +886,7 @@ int main( int argc, char** argv )
 						TUTTLE_LOG_ERROR( "Debug: " << boost::current_exception_diagnostic_information() );
 						TUTTLE_LOG_ERROR( "Backtrace: " << boost::trace( e ) );
 #endif
-						exit( 254 );
+						return 254;
 					}
 					catch( ... )
 					{
@@ -870,7 +894,7 @@ int main( int argc, char** argv )
 						TUTTLE_LOG_ERROR( "Unknown error." );
 						TUTTLE_LOG_ERROR( "\n" );
 						TUTTLE_LOG_ERROR( "Debug: " << boost::current_exception_diagnostic_information() );
-						exit( 254 );
+						return 254;
 					}
 				}
 			}
@@ -892,7 +916,7 @@ int main( int argc, char** argv )
 		
 		if( nodes.size() == 0 )
 			// nothing to do!
-			exit( 255 );
+			return 255;
 
 		// Setup compute options
 		if( range.size() >= 2 )
@@ -1211,6 +1235,10 @@ int main( int argc, char** argv )
 		}
 		
 		
+	}
+	catch( const ExitRequest& e )
+	{
+		return e._status;
 	}
 	catch( const tuttle::exception::Common& e )
 	{
@@ -1220,12 +1248,12 @@ int main( int argc, char** argv )
 		TUTTLE_LOG_ERROR( "[sam-do] Debug: " << boost::current_exception_diagnostic_information() );
 		TUTTLE_LOG_ERROR( "[sam-do] Backtrace: " << boost::trace( e ));
 #endif
-		exit( 254 );
+		return 254;
 	}
 	catch( const boost::program_options::error& e )
 	{
 		TUTTLE_LOG_ERROR( "[sam-do] Error: " << e.what());
-		exit( 254 );
+		return 254;
 	}
 	catch( ... )
 	{
@@ -1233,8 +1261,71 @@ int main( int argc, char** argv )
 #ifndef TUTTLE_PRODUCTION
 		TUTTLE_LOG_ERROR( boost::current_exception_diagnostic_information() );
 #endif
-		exit( 254 );
+		return 254;
 	}
 	return 0;
 }
 
+/**
+ * @brief Remove an option with a value from the options in front of the first node.
+ * @return if the option is found
+ */
+bool extractFrontOption( std::vector<std::string>& args, const std::string& name, std::string& value )
+{
+	const std::string option = "--" + name;
+	for( std::size_t i = 0; i < args.size() && args[i].size() && args[i][0] == '-' && args[i] != sam::samdo::kpipe; ++i )
+	{
+		if( args[i] == option && i + 1 < args.size() )
+		{
+			value = args[i + 1];
+			args.erase( args.begin() + i, args.begin() + i + 2 );
+			return true;
+		}
+		if( boost::algorithm::starts_with( args[i], option + "=" ) )
+		{
+			value = args[i].substr( option.size() + 1 );
+			args.erase( args.begin() + i );
+			return true;
+		}
+	}
+	return false;
+}
+
+int main( int argc, char** argv )
+{
+	signal(SIGINT, signal_callback_handler);
+
+	using namespace sam;
+	using namespace sam::samdo;
+	tuttle::common::formatters::Formatter::get()->init_logging();
+
+	std::vector<std::string> args( argv + 1, argv + argc );
+	std::string serverSocket;
+	std::string connectSocket;
+	if( extractFrontOption( args, kServerOptionLongName, serverSocket ) )
+	{
+		// the host is loaded once, before the first job
+		ttl::core().preload();
+		return runServer( serverSocket, &samDo );
+	}
+
+	const bool connect = extractFrontOption( args, kConnectOptionLongName, connectSocket );
+	if( ! connect )
+	{
+		if( const char* env_server = std::getenv( "SAM_DO_SERVER" ) )
+			connectSocket = env_server;
+	}
+	if( connectSocket.size() )
+	{
+		int status = 0;
+		if( runClient( connectSocket, args, status ) )
+			return status;
+		if( connect )
+		{
+			TUTTLE_LOG_ERROR( "sam do: no render server listening on " << connectSocket );
+			return 255;
+		}
+		// the server of the environment is not running, process locally
+	}
+	return samDo( args );
+}
@@ -182,7 +182,6 @@ std::vector<std::string> Dummy::getAllSupportedNodes( const std::string& context
 		try
 		{
 			const std::string pluginName = node->getRawIdentifier();
-			node->loadAndDescribeActions();
 			if( node->supportsContext( context ) )
 			{
 				listOfPlugins.push_back( pluginName );
@@ -208,7 +207,6 @@ std::vector<std::string> Dummy::getSupportedExtensions( const std::string& conte
 	{
 		try
 		{
-			node->loadAndDescribeActions();
 			if( node->supportsContext( context ) )
 			{
 				//TUTTLE_LOG_INFO( pluginName );
@@ -314,12 +312,12 @@ void Dummy::foundAssociateSpecificDummyNode( std::string& inputNode, const std::
 	if( node_vm.count( kHelpOptionLongName ) )
 	{
 		displayHelp( dummyNodeName );
-		exit( 0 );
+		throw ExitRequest( 0 );
 	}
 	if( node_vm.count( kExpertOptionLongName ) )
 	{
 		displayExpertHelp( dummyNodeName );
-		exit( 0 );
+		throw ExitRequest( 0 );
 	}
 	if( node_vm.count( kPluginsOptionLongName ) )
 	{
@@ -327,7 +325,7 @@ void Dummy::foundAssociateSpecificDummyNode( std::string& inputNode, const std::
 			printAllSupportedNodes( kOfxImageEffectContextReader );
 		if( isDummyWriterNode( dummyNodeName ) )
 			printAllSupportedNodes( kOfxImageEffectContextWriter );
-		exit( 0 );
+		throw ExitRequest( 0 );
 	}
 	
 	if( node_vm.count( kFormatOptionLongName ) )
@@ -336,7 +334,7 @@ void Dummy::foundAssociateSpecificDummyNode( std::string& inputNode, const std::
 			printAllSupportedExtensions( kOfxImageEffectContextReader );
 		if( isDummyWriterNode( dummyNodeName ) )
 			printAllSupportedExtensions( kOfxImageEffectContextWriter );
-		exit( 0 );
+		throw ExitRequest( 0 );
 	}
 	
 	if( node_vm.count( kVersionOptionLongName ) )
@@ -344,7 +342,7 @@ void Dummy::foundAssociateSpecificDummyNode( std::string& inputNode, const std::
 		TUTTLE_LOG_INFO( "\tsam do " << dummyNodeName );
 		TUTTLE_LOG_INFO( "Version 1.0" );
 		TUTTLE_LOG_INFO( "" );
-		exit( 0 );
+		throw ExitRequest( 0 );
 	}
 
 	if( nodeArgs.size() == 0 )
@@ -402,7 +400,6 @@ void Dummy::foundAssociateSpecificDummyNode( std::string& inputNode, const std::
 		if( boost::algorithm::find_first( pluginName, dummyNodeName ) )
 		{
 			tuttle::host::ofx::imageEffect::OfxhImageEffectPlugin* plugin = tuttle::host::core().getImageEffectPluginById( pluginName );
-			plugin->loadAndDescribeActions();
 			const tuttle::host::ofx::imageEffect::OfxhImageEffectPlugin::ContextSet contexts = plugin->getContexts();
 			const tuttle::host::ofx::property::OfxhSet& properties = plugin->getDescriptorInContext( *contexts.begin() ).getProperties();
 			if( properties.hasProperty( kTuttleOfxImageEffectPropSupportedExtensions ) )
@@ -0,0 +1,232 @@
+#include "server.hpp"
+#include "jobSocket.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+#include <tuttle/common/utils/formatters.hpp>
+#include <tuttle/common/utils/color.hpp>
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <sys/stat.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+
+namespace sam {
+namespace samdo {
+
+namespace {
+
+/// socket file of the running server, removed when the server is stopped
+std::string gServerSocketPath;
+
+void serverSignalHandler( int signum )
+{
+	if( ! gServerSocketPath.empty() )
+		::unlink( gServerSocketPath.c_str() );
+	std::_Exit( signum );
+}
+
+/**
+ * @brief Sends the text written in the stream to a client,
+ *        as log messages (one message per flush).
+ */
+class JobLogStreamBuf : public std::streambuf
+{
+public:
+	explicit JobLogStreamBuf( const int fd ) : _fd( fd ), _connected( true ) {}
+
+	bool connected() const { return _connected; }
+
+protected:
+	int_type overflow( int_type c )
+	{
+		if( traits_type::eq_int_type( c, traits_type::eof() ) )
+			return traits_type::not_eof( c );
+		_buffer += traits_type::to_char_type( c );
+		return c;
+	}
+
+	std::streamsize xsputn( const char* s, std::streamsize n )
+	{
+		_buffer.append( s, n );
+		return n;
+	}
+
+	int sync()
+	{
+		if( _buffer.empty() )
+			return 0;
+		// if the client is gone, the job continues without log
+		if( _connected )
+			_connected = writeJobMessage( _fd, eJobMessageLog, _buffer );
+		_buffer.clear();
+		return 0;
+	}
+
+private:
+	int _fd;
+	bool _connected;
+	std::string _buffer;
+};
+
+void runJob( const int fd, const Command& command )
+{
+	std::string workingDirectory;
+	std::vector<std::string> args;
+	if( ! readJobRequest( fd, workingDirectory, args ) )
+	{
+		TUTTLE_LOG_WARNING( "[sam-do server] invalid job request." );
+		return;
+	}
+	const boost::posix_time::ptime begin = boost::posix_time::microsec_clock::universal_time();
+
+	// the log of the job goes to the client, in addition to the server log
+	JobLogStreamBuf logBuffer( fd );
+	const boost::shared_ptr<std::ostream> logStream( new std::ostream( &logBuffer ) );
+	boost::shared_ptr<tuttle::common::formatters::Formatter> formatter( tuttle::common::formatters::Formatter::get() );
+	formatter->sink->locked_backend()->add_stream( logStream );
+
+	int status = 254;
+	const boost::filesystem::path serverDirectory = boost::filesystem::current_path();
+	try
+	{
+		// the options of the previous job are not kept
+		tuttle::common::Color::get()->disable();
+		boost::filesystem::current_path( workingDirectory );
+		status = command( args );
+	}
+	catch( ... )
+	{
+		TUTTLE_LOG_ERROR( "[sam-do server] Error: " << boost::current_exception_diagnostic_information() );
+	}
+	formatter->sink->locked_backend()->remove_stream( logStream );
+	// back to the server log level
+	formatter->setLogLevel( boost::log::trivial::info );
+	boost::system::error_code error;
+	boost::filesystem::current_path( serverDirectory, error );
+
+	const boost::posix_time::time_duration duration = boost::posix_time::microsec_clock::universal_time() - begin;
+	TUTTLE_LOG_INFO( "[sam-do server] job \"" << boost::algorithm::join( args, " " ) << "\" done in "
+	                 << duration.total_milliseconds() << " ms, exit status " << status << "." );
+
+	if( logBuffer.connected() )
+	{
+		std::ostringstream statusStr;
+		statusStr << status;
+		writeJobMessage( fd, eJobMessageStatus, statusStr.str() );
+	}
+}
+
+}
+
+int runServer( const std::string& socketPath, const Command& command )
+{
+	sockaddr_un address;
+	if( ! jobSocketAddress( socketPath, address ) )
+	{
+		TUTTLE_LOG_ERROR( "[sam-do server] socket path too long: " << socketPath );
+		return 255;
+	}
+	// an existing socket file without a server behind comes from a server which was killed
+	const int existing = connectJobSocket( socketPath );
+	if( existing >= 0 )
+	{
+		::close( existing );
+		TUTTLE_LOG_ERROR( "[sam-do server] a server is already listening on " << socketPath );
+		return 255;
+	}
+	::unlink( socketPath.c_str() );
+
+	const int fd = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+	bool bound = false;
+	if( fd >= 0 )
+	{
+		// the jobs run with the rights of the server: only its user may connect
+		const mode_t previousMask = ::umask( 077 );
+		bound = ::bind( fd, reinterpret_cast<sockaddr*>( &address ), sizeof( address ) ) == 0;
+		::umask( previousMask );
+	}
+	if( ! bound || ::listen( fd, SOMAXCONN ) != 0 )
+	{
+		TUTTLE_LOG_ERROR( "[sam-do server] unable to listen on " << socketPath << ": " << std::strerror( errno ) );
+		if( fd >= 0 )
+			::close( fd );
+		return 255;
+	}
+
+	tuttle::common::formatters::Formatter::get()->setLogLevel( boost::log::trivial::info );
+	gServerSocketPath = socketPath;
+	signal( SIGINT, serverSignalHandler );
+	signal( SIGTERM, serverSignalHandler );
+	signal( SIGPIPE, SIG_IGN );
+
+	TUTTLE_LOG_INFO( "[sam-do server] listening on " << socketPath );
+	for(;;)
+	{
+		const int client = ::accept( fd, NULL, NULL );
+		if( client < 0 )
+		{
+			if( errno != EINTR )
+				TUTTLE_LOG_WARNING( "[sam-do server] accept failed: " << std::strerror( errno ) );
+			continue;
+		}
+		if( ! isJobPeerSameUser( client ) )
+		{
+			TUTTLE_LOG_WARNING( "[sam-do server] connection refused: the client is run by another user." );
+			::close( client );
+			continue;
+		}
+		// a client which stops sending its job or reading its log doesn't block the server
+		setJobSocketTimeout( client, kJobSocketTimeout );
+		// the jobs share the host, so they are executed one at a time,
+		// the next clients wait in the listen queue
+		runJob( client, command );
+		::close( client );
+	}
+	return 0;
+}
+
+bool runClient( const std::string& socketPath, const std::vector<std::string>& args, int& status )
+{
+	const int fd = connectJobSocket( socketPath );
+	if( fd < 0 )
+		return false;
+
+	status = 254;
+	if( ! writeJobRequest( fd, boost::filesystem::current_path().string(), args ) )
+	{
+		TUTTLE_LOG_ERROR( "[sam-do] unable to send the job to the server " << socketPath );
+		::close( fd );
+		return true;
+	}
+	char type;
+	std::string message;
+	bool finished = false;
+	while( ! finished && readJobMessage( fd, type, message ) )
+	{
+		switch( type )
+		{
+			case eJobMessageLog:
+				std::clog << message << std::flush;
+				break;
+			case eJobMessageStatus:
+				status = std::atoi( message.c_str() );
+				finished = true;
+				break;
+		}
+	}
+	::close( fd );
+	if( ! finished )
+		TUTTLE_LOG_ERROR( "[sam-do] connection to the server " << socketPath << " lost." );
+	return true;
+}
+
+}
+}
@@ -0,0 +1,43 @@
+#ifndef _SAM_DO_SERVER_HPP_
+#define	_SAM_DO_SERVER_HPP_
+
+#include <boost/function.hpp>
+
+#include <string>
+#include <vector>
+
+namespace sam {
+namespace samdo {
+
+/// @brief Execute a sam do command line (without the program name), returns the exit status.
+typedef boost::function<int( const std::vector<std::string>& )> Command;
+
+/**
+ * @brief Run a render server on a unix socket.
+ *
+ * The jobs are executed one after the other in this process, so the host
+ * (plugin cache, loaded plugins, memory pool and caches) stays warm between
+ * jobs. The log of each job is streamed to its client, with its exit status.
+ * The socket is only accessible to the user of the server, and the clients
+ * of other users are refused.
+ * Only returns if the socket can't be created.
+ *
+ * @param[in] socketPath unix socket to listen on
+ * @param[in] command    executes a job
+ * @return exit status of the server
+ */
+int runServer( const std::string& socketPath, const Command& command );
+
+/**
+ * @brief Send a job to a render server, and print its log.
+ * @param[in] socketPath unix socket of the server
+ * @param[in] args       sam do command line (without the program name)
+ * @param[out] status    exit status of the job
+ * @return false if there is no server listening on @p socketPath
+ */
+bool runClient( const std::string& socketPath, const std::vector<std::string>& args, int& status );
+
+}
+}
+
+#endif
@@ -99,7 +99,6 @@ void getPluginProperties( const std::string& plugName )
 		return;
 	}
 
-	plug->loadAndDescribeActions();
 	TUTTLE_LOG_INFO("Identifier:\t\t"		<< plug->getIdentifier() );
 	TUTTLE_LOG_INFO("Raw identifier:\t\t"	<< plug->getRawIdentifier() );
 	TUTTLE_LOG_INFO("Minor version:\t\t"	<< plug->getVersionMinor() );
@@ -1,5 +1,6 @@
 #include <sam/common/utility.hpp>
 #include <sam/common/options.hpp>
+#include <sam/common/jobs.hpp>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/exception.hpp>
@@ -9,6 +10,7 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/program_options.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
 
 #include <detector.hpp>
 #include <Sequence.hpp>
@@ -23,6 +25,7 @@ namespace bal = boost::algorithm;
 bool         selectRange    = false;
 std::ssize_t firstImage     = 0;
 std::ssize_t lastImage      = 0;
+std::size_t  removeJobs     = 0; // concurrent removals, 0: one per core
 
 // A helper function to simplify the main part.
 template<class T>
@@ -32,6 +35,34 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& v)
 	return os;
 }
 
+/**
+ * @brief Remove one file of a sequence, called concurrently by the workers.
+ */
+void removeFileOfSequence( const std::vector<bfs::path>& files, const std::size_t index )
+{
+	const bfs::path& sFile = files[index];
+	if( !bfs::exists( sFile ) )
+	{
+		TUTTLE_LOG_ERROR( "Could not remove (file not exist): " << sFile.string() );
+	}
+	else
+	{
+		TUTTLE_LOG_TRACE( "remove: " << tuttle::common::Color::get()->_folder << sFile.string() << tuttle::common::Color::get()->_std );
+		try
+		{
+			bfs::remove( sFile );
+		}
+		catch( const boost::filesystem::filesystem_error& e )
+		{
+//			   if( e.code() == boost::system::errc::permission_denied )
+//				   "permission denied"
+			TUTTLE_LOG_ERROR( "sam-rm: Error:\t\n" << e.what() );
+			/// @todo cin
+//				TUTTLE_LOG_INFO( "sam-rm: Continue ? (Yes/No/Yes for All/No for All)" );
+		}
+	}
+}
+
 void removeSequence( const sequenceParser::Sequence& s )
 {
 	std::ssize_t first;
@@ -49,30 +80,12 @@ void removeSequence( const sequenceParser::Sequence& s )
 //	TUTTLE_TCOUT( "remove sequence." );
 //	TUTTLE_TCOUT("remove from " << first << " to " << last);
 
+	std::vector<bfs::path> files;
 	for( sequenceParser::Time t = first; t <= last; t += s.getStep() )
 	{
-		bfs::path sFile = s.getAbsoluteFilenameAt(t);
-		if( !bfs::exists( sFile ) )
-		{
-			TUTTLE_LOG_ERROR( "Could not remove (file not exist): " << sFile.string() );
-		}
-		else
-		{
-			TUTTLE_LOG_TRACE( "remove: " << tuttle::common::Color::get()->_folder << sFile.string() << tuttle::common::Color::get()->_std );
-			try
-			{
-				bfs::remove( sFile );
-			}
-			catch( const boost::filesystem::filesystem_error& e )
-			{
-//			   if( e.code() == boost::system::errc::permission_denied )
-//				   "permission denied"
-				TUTTLE_LOG_ERROR( "sam-rm: Error:\t\n" << e.what() );
-				/// @todo cin
-//				TUTTLE_LOG_INFO( "sam-rm: Continue ? (Yes/No/Yes for All/No for All)" );
-			}
-		}
+		files.push_back( s.getAbsoluteFilenameAt(t) );
 	}
+	sam::runTasks( files.size(), removeJobs, boost::bind( &removeFileOfSequence, boost::cref( files ), _1 ) );
 }
 
 void removeFileObject( boost::ptr_vector<sequenceParser::FileObject> &listing, std::vector<boost::filesystem::path> &notRemoved )
@@ -157,6 +170,7 @@ int main( int argc, char** argv )
 			( kFilesOptionString,       kFilesOptionMessage )
 			( kHelpOptionString,        kHelpOptionMessage )
 			( kIgnoreOptionString,      kIgnoreOptionMessage )
+			( kJobsOptionString,        bpo::value(&removeJobs), kJobsOptionMessage )
 			( kPathOptionString,        kPathOptionMessage )
 			( kRecursiveOptionString,   kRecursiveOptionMessage )
 			( kVerboseOptionString,     bpo::value<int>()->default_value( 2 ), kVerboseOptionMessage )
@@ -246,6 +260,7 @@ int main( int argc, char** argv )
 		TUTTLE_LOG_INFO( color->_blue  << "DESCRIPTION" << color->_std << std::endl );
 		TUTTLE_LOG_INFO( "" );
 		TUTTLE_LOG_INFO( "Remove sequence of files, and could remove trees (folder, files and sequences)." );
+		TUTTLE_LOG_INFO( "The files of a sequence are removed concurrently (see --jobs)." );
 		TUTTLE_LOG_INFO( "" );
 		TUTTLE_LOG_INFO( color->_blue  << "OPTIONS" << color->_std );
 		TUTTLE_LOG_INFO( "" );
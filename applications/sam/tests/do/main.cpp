@@ -0,0 +1,124 @@
+#define BOOST_TEST_MODULE sam_do_jobSocket
+#include <boost/test/unit_test.hpp>
+
+#include <sam/do/jobSocket.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+using namespace boost::unit_test;
+using namespace sam::samdo;
+
+namespace {
+
+/// Connected pair of unix stream sockets, closed at the end of the test
+struct SocketPair
+{
+	SocketPair()
+	{
+		BOOST_REQUIRE_EQUAL( ::socketpair( AF_UNIX, SOCK_STREAM, 0, _fds ), 0 );
+	}
+	~SocketPair()
+	{
+		::close( _fds[0] );
+		::close( _fds[1] );
+	}
+	int client() const { return _fds[0]; }
+	int server() const { return _fds[1]; }
+
+	int _fds[2];
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( sam_do_jobSocket_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( job_request )
+{
+	SocketPair sockets;
+	std::vector<std::string> args;
+	args.push_back( "reader" );
+	args.push_back( "in.####.dpx" );
+	args.push_back( "" );
+	args.push_back( "//" );
+	BOOST_REQUIRE( writeJobRequest( sockets.client(), "/tmp/work dir", args ) );
+
+	std::string workingDirectory;
+	std::vector<std::string> readArgs;
+	BOOST_REQUIRE( readJobRequest( sockets.server(), workingDirectory, readArgs ) );
+	BOOST_CHECK_EQUAL( workingDirectory, "/tmp/work dir" );
+	BOOST_CHECK_EQUAL_COLLECTIONS( readArgs.begin(), readArgs.end(), args.begin(), args.end() );
+}
+
+BOOST_AUTO_TEST_CASE( job_messages )
+{
+	SocketPair sockets;
+	BOOST_REQUIRE( writeJobMessage( sockets.server(), eJobMessageLog, "frame 1\n" ) );
+	BOOST_REQUIRE( writeJobMessage( sockets.server(), eJobMessageStatus, "0" ) );
+
+	char type;
+	std::string message;
+	BOOST_REQUIRE( readJobMessage( sockets.client(), type, message ) );
+	BOOST_CHECK_EQUAL( type, static_cast<char>( eJobMessageLog ) );
+	BOOST_CHECK_EQUAL( message, "frame 1\n" );
+	BOOST_REQUIRE( readJobMessage( sockets.client(), type, message ) );
+	BOOST_CHECK_EQUAL( type, static_cast<char>( eJobMessageStatus ) );
+	BOOST_CHECK_EQUAL( message, "0" );
+}
+
+BOOST_AUTO_TEST_CASE( invalid_job_request )
+{
+	{
+		// unknown protocol version
+		SocketPair sockets;
+		BOOST_REQUIRE( writeUint32( sockets.client(), kJobProtocolVersion + 1 ) );
+		BOOST_REQUIRE( writeUint32( sockets.client(), 1 ) );
+		BOOST_REQUIRE( writeString( sockets.client(), "/" ) );
+		std::string workingDirectory;
+		std::vector<std::string> args;
+		BOOST_CHECK( ! readJobRequest( sockets.server(), workingDirectory, args ) );
+	}
+	{
+		// string larger than the limit, without sending it
+		SocketPair sockets;
+		BOOST_REQUIRE( writeUint32( sockets.client(), kJobProtocolVersion ) );
+		BOOST_REQUIRE( writeUint32( sockets.client(), 1 ) );
+		BOOST_REQUIRE( writeUint32( sockets.client(), kJobMaxStringSize + 1 ) );
+		std::string workingDirectory;
+		std::vector<std::string> args;
+		BOOST_CHECK( ! readJobRequest( sockets.server(), workingDirectory, args ) );
+	}
+	{
+		// client gone in the middle of the request
+		SocketPair sockets;
+		BOOST_REQUIRE( writeUint32( sockets.client(), kJobProtocolVersion ) );
+		::shutdown( sockets.client(), SHUT_WR );
+		std::string workingDirectory;
+		std::vector<std::string> args;
+		BOOST_CHECK( ! readJobRequest( sockets.server(), workingDirectory, args ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( job_request_timeout )
+{
+	// a client which doesn't send its whole request
+	SocketPair sockets;
+	BOOST_REQUIRE( setJobSocketTimeout( sockets.server(), 1 ) );
+	BOOST_REQUIRE( writeUint32( sockets.client(), kJobProtocolVersion ) );
+	std::string workingDirectory;
+	std::vector<std::string> args;
+	BOOST_CHECK( ! readJobRequest( sockets.server(), workingDirectory, args ) );
+}
+
+BOOST_AUTO_TEST_CASE( job_peer_user )
+{
+	SocketPair sockets;
+	BOOST_CHECK( isJobPeerSameUser( sockets.server() ) );
+	BOOST_CHECK( isJobPeerSameUser( sockets.client() ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
@@ -490,6 +490,16 @@ void ClipDescriptor::setIsMask( bool v )
 	_clipProps.propSetInt( kOfxImageClipPropIsMask, int(v) );
 }
 
+/** @brief say whether the plugin reads the tiled images of this clip in tiles */
+void ClipDescriptor::setSupportsSparseInput( bool v )
+{
+	// only Tuttle support this property ( out of standard )
+	if( OFX::Private::gHostDescription.hostName == "TuttleOfx" )
+	{
+		_clipProps.propSetInt( kTuttleOfxImageClipPropSupportsSparseInput, int(v), false );
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // image effect descriptor
 
@@ -671,6 +681,16 @@ void ImageEffectDescriptor::setTemporalClipAccess( bool v )
 	_effectProps.propSetInt( kOfxImageEffectPropTemporalClipAccess, int(v) );
 }
 
+/** @brief Are the output images mostly empty or constant */
+void ImageEffectDescriptor::setSparseOutput( bool v )
+{
+	// only Tuttle support this property ( out of standard )
+	if( OFX::Private::gHostDescription.hostName == "TuttleOfx" )
+	{
+		_effectProps.propSetInt( kTuttleOfxImageEffectPropSparseOutput, int(v), false );
+	}
+}
+
 /** @brief Does the plugin want to have render called twice per frame in all circumanstances for fielded images ? */
 void ImageEffectDescriptor::setRenderTwiceAlways( bool v )
 {
@@ -747,11 +767,15 @@ ClipDescriptor* ImageEffectDescriptor::defineClip( const std::string& name )
 // wraps up an image
 Image::Image( OfxPropertySetHandle props )
 	: _imageProps( props )
+	, _pixelData( NULL )
+	, _pixelDataFetched( false )
 {
 	OFX::Validation::validateImageProperties( props );
 
 	// and fetch all the properties
-	_pixelData = _imageProps.propGetPointer( kOfxImagePropData );
+	// the pixel data is fetched on the first access, a constant image is
+	// allocated by the host only if the plugin needs its pixels
+	_constantSupported = _imageProps.propGetDimension( kTuttleOfxImagePropConstant, false ) != 0;
 
 	_rowDistanceBytes = _imageProps.propGetInt( kOfxImagePropRowBytes );
 	_pixelAspectRatio = _imageProps.propGetDouble( kOfxImagePropPixelAspectRatio );
@@ -880,6 +904,84 @@ std::size_t Image::getBoundsImageDataBytes() const
 	return getPixelBytes() * getBoundsNbPixels();
 }
 
+void* Image::getPixelData() const
+{
+	if( ! _pixelDataFetched )
+	{
+		_pixelData = _imageProps.propGetPointer( kOfxImagePropData );
+		_pixelDataFetched = true;
+	}
+	return _pixelData;
+}
+
+bool Image::isConstant() const
+{
+	return _constantSupported && _imageProps.propGetInt( kTuttleOfxImagePropConstant ) != 0;
+}
+
+OfxRGBAColourD Image::getConstantColor() const
+{
+	OfxRGBAColourD color;
+	color.r = _imageProps.propGetDouble( kTuttleOfxImagePropConstantColor, 0 );
+	color.g = _imageProps.propGetDouble( kTuttleOfxImagePropConstantColor, 1 );
+	color.b = _imageProps.propGetDouble( kTuttleOfxImagePropConstantColor, 2 );
+	color.a = _imageProps.propGetDouble( kTuttleOfxImagePropConstantColor, 3 );
+	return color;
+}
+
+bool Image::setConstantColor( const OfxRGBAColourD& color )
+{
+	if( ! _constantSupported )
+		return false;
+	_imageProps.propSetDouble( kTuttleOfxImagePropConstantColor, color.r, 0 );
+	_imageProps.propSetDouble( kTuttleOfxImagePropConstantColor, color.g, 1 );
+	_imageProps.propSetDouble( kTuttleOfxImagePropConstantColor, color.b, 2 );
+	_imageProps.propSetDouble( kTuttleOfxImagePropConstantColor, color.a, 3 );
+	_imageProps.propSetInt( kTuttleOfxImagePropConstant, 1 );
+	return true;
+}
+
+bool Image::isTiled() const
+{
+	return _imageProps.propGetDimension( kTuttleOfxImagePropTileSize, false ) != 0 &&
+	       _imageProps.propGetInt( kTuttleOfxImagePropTileSize, 0, false ) > 0;
+}
+
+OfxPointI Image::getTileSize() const
+{
+	OfxPointI size;
+	size.x = _imageProps.propGetInt( kTuttleOfxImagePropTileSize, 0 );
+	size.y = _imageProps.propGetInt( kTuttleOfxImagePropTileSize, 1 );
+	return size;
+}
+
+int Image::getNbTiles() const
+{
+	return _imageProps.propGetDimension( kTuttleOfxImagePropTileStates );
+}
+
+int Image::getTileState( const int tile ) const
+{
+	return _imageProps.propGetInt( kTuttleOfxImagePropTileStates, tile );
+}
+
+void* Image::getTileData( const int tile ) const
+{
+	return _imageProps.propGetPointer( kTuttleOfxImagePropTileData, tile );
+}
+
+OfxRectI Image::getTileBounds( const int tile ) const
+{
+	const OfxPointI tileSize = getTileSize();
+	const int nbTilesX = ( _bounds.x2 - _bounds.x1 + tileSize.x - 1 ) / tileSize.x;
+	OfxRectI tileBounds;
+	tileBounds.x1 = _bounds.x1 + ( tile % nbTilesX ) * tileSize.x;
+	tileBounds.y1 = _bounds.y1 + ( tile / nbTilesX ) * tileSize.y;
+	tileBounds.x2 = std::min( tileBounds.x1 + tileSize.x, _bounds.x2 );
+	tileBounds.y2 = std::min( tileBounds.y1 + tileSize.y, _bounds.y2 );
+	return tileBounds;
+}
+
 /** @brief return a pixel pointer
 *
 * No attempt made to be uber efficient here.
@@ -889,7 +991,7 @@ void* Image::getPixelAddress( int x, int y )
 	// are we in the image bounds
 	BOOST_ASSERT( x >= _bounds.x1 && x < _bounds.x2 && y >= _bounds.y1 && y < _bounds.y2 && _pixelBytes != 0 );
 
-	char* pix = ( char* )( ( (char*) _pixelData ) + ( y - _bounds.y1 ) * _rowDistanceBytes );
+	char* pix = ( char* )( ( (char*) getPixelData() ) + ( y - _bounds.y1 ) * _rowDistanceBytes );
 	pix += ( x - _bounds.x1 ) * _pixelBytes;
 	return (void*) pix;
 }
@@ -89,7 +89,7 @@ PropertySet::~PropertySet() {}
 int PropertySet::propGetDimension( const char* property, bool throwOnFailure ) const
 {
 	assert( _propHandle != 0 );
-	int dimension;
+	int dimension  = 0;
 	OfxStatus stat = gPropSuite->propGetDimension( _propHandle, property, &dimension );
 	Log::error( stat != kOfxStatOK, "Failed on fetching dimension for property %s, host returned status %s.", property, mapStatusToString( stat ).c_str() );
 	if( throwOnFailure )
@@ -155,7 +155,8 @@ void PropertyDescription::validate( bool         checkDefaults,
             switch( _ilk )
             {
                 case OFX::ePointer: {
-                    /*void* vP = */propSet.propGetPointer( _name );
+                    // not fetched: getting a pointer (like the image data)
+                    // may allocate memory on the host
                 }
                 break;
                 case OFX::eInt:     {
@@ -370,6 +370,12 @@ public:
 
     /** @brief say whether this clip is a 'mask', so the host can know to replace with a roto or similar, defaults to false */
     void setIsMask( bool v );
+
+    /** @brief tuttle extension: say whether the plugin reads the tiled images of this clip in tiles, defaults to false
+     *
+     * The output images of a plugin with sparse output are only kept in tiles if all the clips using them support it.
+     */
+    void setSupportsSparseInput( bool v );
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -446,6 +452,12 @@ public:
     /** @brief Does the plugin perform temporal clip access, defaults to false */
     void setTemporalClipAccess( bool v );
 
+    /** @brief tuttle extension: are the output images mostly empty or constant (like mattes), defaults to false
+     *
+     * The host may keep the output images in tiles, only the tiles which are not constant keep their pixels.
+     */
+    void setSparseOutput( bool v );
+
     /** @brief Does the plugin want to have render called twice per frame in all circumanstances for fielded images ? defaults to true */
     void setRenderTwiceAlways( bool v );
 
@@ -491,7 +503,9 @@ protected:
     /** @brief friend so we get access to ctor */
     friend class Clip;
 
-    void* _pixelData;                   /**< @brief the base address of the image */
+    mutable void* _pixelData;           /**< @brief the base address of the image, fetched on the first access */
+    mutable bool _pixelDataFetched;     /**< @brief the pixel data has been fetched from the host */
+    bool _constantSupported;              /**< @brief the host supports constant images */
     EPixelComponent _pixelComponents;     /**< @brief get the components in the image */
     int _rowDistanceBytes;                    /**< @brief the number of bytes per scanline */
 
@@ -534,8 +548,46 @@ public:
     /** @brief get the scale factor that has been applied to this image */
     double getPixelAspectRatio() const { return _pixelAspectRatio; }
 
-    /** @brief get the pixel data for this image */
-    void* getPixelData() const { return _pixelData; }
+    /** @brief get the pixel data for this image
+     *
+     * The data is fetched on the first call, the host may allocate the image at this moment.
+     */
+    void* getPixelData() const;
+
+    /** @brief tuttle extension: all the pixels of the image have the same value */
+    bool isConstant() const;
+
+    /** @brief tuttle extension: normalized color of a constant image */
+    OfxRGBAColourD getConstantColor() const;
+
+    /** @brief tuttle extension: set all the pixels of the image to a normalized color,
+     *         without writing the pixel data.
+     *
+     * @return false if the host doesn't support constant images, the pixels must be written.
+     */
+    bool setConstantColor( const OfxRGBAColourD& color );
+
+    /** @brief tuttle extension: the image is kept by the host in tiles,
+     *         the pixel data is still available (expanded by the host).
+     */
+    bool isTiled() const;
+
+    /** @brief tuttle extension: size of the tiles of a tiled image */
+    OfxPointI getTileSize() const;
+
+    /** @brief tuttle extension: number of tiles of a tiled image, ordered by rows from the bottom */
+    int getNbTiles() const;
+
+    /** @brief tuttle extension: state of a tile (kTuttleOfxImageTileEmpty, kTuttleOfxImageTileConstant or kTuttleOfxImageTilePopulated) */
+    int getTileState( const int tile ) const;
+
+    /** @brief tuttle extension: pixels of a populated tile (with a row size of the tile width),
+     *         pixel of a constant tile, NULL for an empty tile
+     */
+    void* getTileData( const int tile ) const;
+
+    /** @brief tuttle extension: pixels of the image covered by a tile (in pixel coordinates) */
+    OfxRectI getTileBounds( const int tile ) const;
 
     /** @brief get the region of definition (in pixel coordinates) of this image */
     OfxRectI getRegionOfDefinition() const { return _regionOfDefinition; }
@@ -0,0 +1,105 @@
+#ifndef _ofxImage_h_
+#define _ofxImage_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Indicates that all the pixels of an image have the same value.
+
+   - Type - int X 1
+   - Property Set - an image instance (read/write)
+   - Default - 0
+   - Valid Values - This must be one of 0 or 1
+
+The value of the pixels is given by ::kTuttleOfxImagePropConstantColor.
+An output image set as constant by a plugin is only allocated by the host
+when the pixel data of the image is requested.
+ */
+#define kTuttleOfxImagePropConstant "TuttleOfxImagePropConstant"
+
+/** @brief The value of the pixels of a constant image.
+
+   - Type - double X 4
+   - Property Set - an image instance (read/write)
+   - Default - 0, 0, 0, 0
+   - Valid Values - normalized red, green, blue and alpha.
+
+An Alpha image only uses the alpha value.
+ */
+#define kTuttleOfxImagePropConstantColor "TuttleOfxImagePropConstantColor"
+
+/** @brief Indicates that the output images of an effect are mostly empty or constant, like mattes.
+
+   - Type - int X 1
+   - Property Set - image effect descriptor (read/write)
+   - Default - 0
+   - Valid Values - This must be one of 0 or 1
+
+After the render, the host may split the output images in tiles of
+::kTuttleOfxImagePropTileSize pixels and only keep the memory of the tiles
+which are not constant (see ::kTuttleOfxImagePropTileStates). It is only
+done if all the clips using the output images support sparse input (see
+::kTuttleOfxImageClipPropSupportsSparseInput).
+ */
+#define kTuttleOfxImageEffectPropSparseOutput "TuttleOfxImageEffectPropSparseOutput"
+
+/** @brief Indicates that a plugin can read the images of an input clip in tiles.
+
+   - Type - int X 1
+   - Property Set - clip descriptor (read/write)
+   - Default - 0
+   - Valid Values - This must be one of 0 or 1
+
+The plugin uses the tiles of the tiled images of this clip, without
+accessing their pixel data (see ::kTuttleOfxImagePropTileStates).
+ */
+#define kTuttleOfxImageClipPropSupportsSparseInput "TuttleOfxImageClipPropSupportsSparseInput"
+
+/** @brief Size of the tiles of a tiled image.
+
+   - Type - int X 2
+   - Property Set - an image instance (read only)
+   - Default - 0, 0 if the image is not tiled
+
+The tiles cover the bounds of the image from the bottom left corner, the
+tiles of the last row and column may be partially outside of the bounds.
+The pixel data of a tiled image (::kOfxImagePropData) is still available,
+it is expanded by the host on the first access and the tiles are released:
+the image is not tiled anymore, so a plugin must not access the pixel data
+of an image while it reads its tiles.
+ */
+#define kTuttleOfxImagePropTileSize "TuttleOfxImagePropTileSize"
+
+/** @brief State of each tile of a tiled image.
+
+   - Type - int X N
+   - Property Set - an image instance (read only)
+   - Valid Values - ::kTuttleOfxImageTileEmpty, ::kTuttleOfxImageTileConstant or ::kTuttleOfxImageTilePopulated
+
+The tiles are ordered by rows, from the bottom of the image.
+ */
+#define kTuttleOfxImagePropTileStates "TuttleOfxImagePropTileStates"
+
+/** @brief All the bytes of the tile are zero, there is no data. */
+#define kTuttleOfxImageTileEmpty 0
+/** @brief All the pixels of the tile have the same value, the data is one pixel. */
+#define kTuttleOfxImageTileConstant 1
+/** @brief The data of the tile are all its pixels. */
+#define kTuttleOfxImageTilePopulated 2
+
+/** @brief Pixel data of each tile of a tiled image.
+
+   - Type - pointer X N
+   - Property Set - an image instance (read only)
+
+Same order as ::kTuttleOfxImagePropTileStates. The pixels of a populated
+tile are ordered from the bottom, with a row size of the tile width.
+ */
+#define kTuttleOfxImagePropTileData "TuttleOfxImagePropTileData"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
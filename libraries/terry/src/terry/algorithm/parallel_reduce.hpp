@@ -0,0 +1,180 @@
+#ifndef _TERRY_ALGORITHM_PARALLEL_REDUCE_HPP_
+#define	_TERRY_ALGORITHM_PARALLEL_REDUCE_HPP_
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace terry {
+namespace algorithm {
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// parallel_reduce
+///
+/// \defgroup ImageViewAlgorithmsParallelReduce parallel_reduce
+/// \brief Reduction of the rows of an image on several threads.
+///
+/// The rows are split in blocks of a fixed height. Each block is accumulated
+/// in its own copy of the initial accumulator, then the partial results are
+/// merged pairwise, in the rows order. So the result doesn't depend on the
+/// number of threads, and the float sums keep the precision of a pairwise
+/// summation.
+///
+/// RowAccumulator concept:
+///   - copy constructible, the initial value is the neutral element
+///   - void operator()( const std::ptrdiff_t y ): accumulate the row y
+///   - void merge( const RowAccumulator& next ): accumulate the result of the next rows
+///
+/// PixelAccumulator concept (for the view version):
+///   - copy constructible, the initial value is the neutral element
+///   - void operator()( const Pixel& p ): accumulate a pixel
+///   - void merge( const PixelAccumulator& next ): accumulate the result of the next pixels
+///
+/// Launcher concept:
+///   - void operator()( const boost::function<void( const unsigned int threadId, const unsigned int nbThreads )>& f ):
+///     calls f on each thread and waits the end of all calls
+////////////////////////////////////////////////////////////////////////////////
+
+typedef boost::function<void( const unsigned int threadId, const unsigned int nbThreads )> thread_function_t;
+
+/// \ingroup ImageViewAlgorithmsParallelReduce
+/// \brief Launcher using a boost::thread_group, the calling thread is used as the first thread.
+struct thread_group_launcher
+{
+	unsigned int _nbThreads; ///< 0: one thread per core
+
+	explicit thread_group_launcher( const unsigned int nbThreads = 0 )
+	: _nbThreads( nbThreads )
+	{}
+
+	void operator()( const thread_function_t& f ) const
+	{
+		const unsigned int nbThreads = _nbThreads ? _nbThreads : std::max( boost::thread::hardware_concurrency(), 1u );
+		boost::thread_group threads;
+		for( unsigned int i = 1; i < nbThreads; ++i )
+		{
+			threads.create_thread( boost::bind( f, i, nbThreads ) );
+		}
+		f( 0, nbThreads );
+		threads.join_all();
+	}
+};
+
+namespace detail {
+
+template <class RowAccumulator>
+struct reduce_blocks_t
+{
+	std::vector<RowAccumulator>& _partials;
+	const std::ptrdiff_t _height;
+	const std::ptrdiff_t _blockHeight;
+
+	reduce_blocks_t( std::vector<RowAccumulator>& partials, const std::ptrdiff_t height, const std::ptrdiff_t blockHeight )
+	: _partials( partials )
+	, _height( height )
+	, _blockHeight( blockHeight )
+	{}
+
+	void operator()( const unsigned int threadId, const unsigned int nbThreads ) const
+	{
+		// contiguous blocks for each thread
+		const std::size_t nbBlocks = _partials.size();
+		const std::size_t blockBegin = threadId * nbBlocks / nbThreads;
+		const std::size_t blockEnd = ( threadId + 1 ) * nbBlocks / nbThreads;
+		for( std::size_t b = blockBegin; b < blockEnd; ++b )
+		{
+			RowAccumulator& acc = _partials[b];
+			const std::ptrdiff_t yEnd = std::min( _height, std::ptrdiff_t( ( b + 1 ) * _blockHeight ) );
+			for( std::ptrdiff_t y = b * _blockHeight; y < yEnd; ++y )
+			{
+				acc( y );
+			}
+		}
+	}
+};
+
+/// \brief Adapts a PixelAccumulator to the RowAccumulator concept.
+template <class View, class PixelAccumulator>
+struct pixel_rows_accumulator_t
+{
+	View _view;
+	PixelAccumulator _acc;
+
+	pixel_rows_accumulator_t( const View& view, const PixelAccumulator& acc )
+	: _view( view )
+	, _acc( acc )
+	{}
+
+	void operator()( const std::ptrdiff_t y )
+	{
+		typename View::x_iterator it = _view.row_begin( y );
+		const typename View::x_iterator itEnd = _view.row_end( y );
+		for( ; it != itEnd; ++it )
+		{
+			_acc( *it );
+		}
+	}
+
+	void merge( const pixel_rows_accumulator_t& next )
+	{
+		_acc.merge( next._acc );
+	}
+};
+
+}
+
+/// \ingroup ImageViewAlgorithmsParallelReduce
+/// \brief Reduce the rows [0, height) on the threads of the launcher.
+template <class RowAccumulator, class Launcher>
+RowAccumulator parallel_reduce_rows( const std::ptrdiff_t height, const RowAccumulator& init, Launcher launcher, const std::ptrdiff_t blockHeight = 8 )
+{
+	if( height <= 0 )
+		return init;
+	std::vector<RowAccumulator> partials( ( height + blockHeight - 1 ) / blockHeight, init );
+	launcher( thread_function_t( detail::reduce_blocks_t<RowAccumulator>( partials, height, blockHeight ) ) );
+
+	// pairwise merge, each partial result absorbs the next one
+	for( std::size_t step = 1; step < partials.size(); step *= 2 )
+	{
+		for( std::size_t i = 0; i + step < partials.size(); i += 2 * step )
+		{
+			partials[i].merge( partials[i + step] );
+		}
+	}
+	return partials.front();
+}
+
+/// \ingroup ImageViewAlgorithmsParallelReduce
+/// \brief Reduce the rows [0, height) with one thread per core.
+template <class RowAccumulator>
+RowAccumulator parallel_reduce_rows( const std::ptrdiff_t height, const RowAccumulator& init )
+{
+	return parallel_reduce_rows( height, init, thread_group_launcher() );
+}
+
+/// \ingroup ImageViewAlgorithmsParallelReduce
+/// \brief Reduce the pixels of a view on the threads of the launcher.
+template <class View, class PixelAccumulator, class Launcher>
+PixelAccumulator parallel_reduce( const View& view, const PixelAccumulator& init, Launcher launcher )
+{
+	typedef detail::pixel_rows_accumulator_t<View, PixelAccumulator> RowAccumulator;
+	return parallel_reduce_rows( view.height(), RowAccumulator( view, init ), launcher )._acc;
+}
+
+/// \ingroup ImageViewAlgorithmsParallelReduce
+/// \brief Reduce the pixels of a view with one thread per core.
+template <class View, class PixelAccumulator>
+PixelAccumulator parallel_reduce( const View& view, const PixelAccumulator& init )
+{
+	return parallel_reduce( view, init, thread_group_launcher() );
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef _TERRY_COLOR_LUT_LUT1D_HPP_
+#define _TERRY_COLOR_LUT_LUT1D_HPP_
+
+#include <vector>
+#include <cstddef>
+
+namespace terry {
+namespace color {
+namespace lut {
+
+/**
+ * @brief Baked 1D function, linearly interpolated between regularly spaced samples.
+ *
+ * Inputs outside of the domain are clamped to the domain.
+ */
+class lut1d
+{
+public:
+	typedef float value_type;
+
+public:
+	lut1d()
+	: _min( 0.0f )
+	, _max( 1.0f )
+	, _scale( 0.0f )
+	{}
+
+	/**
+	 * @brief Sample the function @p f on [min, max].
+	 * @param[in] f  functor with a "double operator()( const double x )"
+	 */
+	template<class Function>
+	void bake( Function f, const std::size_t size, const float min = 0.0f, const float max = 1.0f )
+	{
+		_data.resize( size < 2 ? 2 : size );
+		_min = min;
+		_max = max;
+		const double step = ( max - min ) / double( _data.size() - 1 );
+		for( std::size_t i = 0; i < _data.size(); ++i )
+		{
+			_data[i] = static_cast<value_type>( f( min + i * step ) );
+		}
+		_scale = max > min ? ( _data.size() - 1 ) / ( max - min ) : 0.0f;
+	}
+
+	/// @brief Fill the LUT with a constant value.
+	void fill( const float value )
+	{
+		_data.assign( 2, value );
+		_scale = 0.0f;
+	}
+
+	std::size_t size() const { return _data.size(); }
+	bool empty() const { return _data.empty(); }
+	const value_type* data() const { return &_data.front(); }
+
+	float domainMin() const { return _min; }
+	float domainMax() const { return _max; }
+
+	value_type operator()( const float x ) const
+	{
+		const std::size_t last = _data.size() - 1;
+		float fx = ( x - _min ) * _scale;
+		if( !( fx > 0.0f ) ) // also catch NaN
+			return _data.front();
+		if( fx >= last )
+			return _data.back();
+		const std::size_t i = static_cast<std::size_t>( fx );
+		const float d = fx - i;
+		return _data[i] + d * ( _data[i + 1] - _data[i] );
+	}
+
+private:
+	std::vector<value_type> _data;
+	float _min;
+	float _max;
+	float _scale; ///< number of samples per unit of input
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef _TERRY_COLOR_LUT_LUT3D_HPP_
+#define _TERRY_COLOR_LUT_LUT3D_HPP_
+
+#include <boost/config.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace terry {
+namespace color {
+namespace lut {
+
+/**
+ * @brief Position of a point inside the lattice: index of the lower corner
+ *        of the enclosing cell and fractional position in this cell.
+ */
+struct lattice_cell
+{
+	std::size_t index; ///< offset of the lower corner node in the data buffer
+	float d[3];        ///< position inside the cell, in [0, 1]
+};
+
+/**
+ * @brief 3D lattice of float values, sampled on a regular grid.
+ *
+ * Nodes are stored interleaved (all the channels of a node are contiguous),
+ * with the first axis varying slowest and the last axis fastest, so
+ * the 8 corners of a cell are read from 4 contiguous pairs.
+ *
+ * @param NbChannels number of output values per node
+ */
+template<std::size_t NbChannels>
+class lut3d
+{
+public:
+	typedef float value_type;
+	BOOST_STATIC_CONSTANT( std::size_t, nb_channels = NbChannels );
+
+public:
+	lut3d()
+	: _size( 0 )
+	{
+		setDomain( 0.0f, 1.0f );
+	}
+
+	/// @brief Allocate @p size nodes on each axis.
+	void resize( const std::size_t size )
+	{
+		_size = size < 2 ? 2 : size;
+		_data.resize( _size * _size * _size * NbChannels );
+		_strides[2] = NbChannels;
+		_strides[1] = _size * _strides[2];
+		_strides[0] = _size * _strides[1];
+		updateScale();
+	}
+
+	/// @brief Same input domain on the 3 axes.
+	void setDomain( const float min, const float max )
+	{
+		const float mins[3] = { min, min, min };
+		const float maxs[3] = { max, max, max };
+		setDomain( mins, maxs );
+	}
+
+	void setDomain( const float min[3], const float max[3] )
+	{
+		for( std::size_t i = 0; i < 3; ++i )
+		{
+			_min[i] = min[i];
+			_max[i] = max[i];
+		}
+		updateScale();
+	}
+
+	/**
+	 * @brief Sample a function on each node of the lattice.
+	 * @param[in] f  functor with a "void operator()( const double x, const double y, const double z, float* out )"
+	 */
+	template<class Function>
+	void bake( Function f, const std::size_t size )
+	{
+		resize( size );
+		double step[3];
+		for( std::size_t a = 0; a < 3; ++a )
+			step[a] = ( _max[a] - _min[a] ) / double( _size - 1 );
+
+		value_type* out = &_data.front();
+		for( std::size_t i = 0; i < _size; ++i )
+		{
+			const double x = _min[0] + i * step[0];
+			for( std::size_t j = 0; j < _size; ++j )
+			{
+				const double y = _min[1] + j * step[1];
+				for( std::size_t k = 0; k < _size; ++k, out += NbChannels )
+				{
+					f( x, y, _min[2] + k * step[2], out );
+				}
+			}
+		}
+	}
+
+	std::size_t size() const { return _size; }
+	bool empty() const { return _data.empty(); }
+	std::size_t stride( const std::size_t axis ) const { return _strides[axis]; }
+	float domainMin( const std::size_t axis ) const { return _min[axis]; }
+	float domainMax( const std::size_t axis ) const { return _max[axis]; }
+	/// @brief Number of cells per unit of input on @p axis.
+	float scale( const std::size_t axis ) const { return _scale[axis]; }
+
+	value_type* data() { return &_data.front(); }
+	const value_type* data() const { return &_data.front(); }
+
+	value_type* node( const std::size_t i, const std::size_t j, const std::size_t k )
+	{
+		return &_data[ i * _strides[0] + j * _strides[1] + k * _strides[2] ];
+	}
+	const value_type* node( const std::size_t i, const std::size_t j, const std::size_t k ) const
+	{
+		return &_data[ i * _strides[0] + j * _strides[1] + k * _strides[2] ];
+	}
+
+	bool contains( const float x, const float y, const float z ) const
+	{
+		return x >= _min[0] && x <= _max[0] &&
+		       y >= _min[1] && y <= _max[1] &&
+		       z >= _min[2] && z <= _max[2];
+	}
+
+	/**
+	 * @brief Find the cell containing (x, y, z).
+	 * Values outside of the domain are clamped on the domain.
+	 */
+	void locate( const float x, const float y, const float z, lattice_cell& cell ) const
+	{
+		const float p[3] = { x, y, z };
+		cell.index = 0;
+		for( std::size_t a = 0; a < 3; ++a )
+		{
+			float f = ( p[a] - _min[a] ) * _scale[a];
+			if( !( f > 0.0f ) ) // also catch NaN
+				f = 0.0f;
+			else if( f > _size - 1 )
+				f = static_cast<float>( _size - 1 );
+			std::size_t i = static_cast<std::size_t>( f );
+			if( i > _size - 2 )
+				i = _size - 2;
+			cell.d[a] = f - i;
+			cell.index += i * _strides[a];
+		}
+	}
+
+	/**
+	 * @brief Evaluate the LUT at (x, y, z).
+	 * @param Interpolation trilinear_interpolation or tetrahedral_interpolation
+	 */
+	template<class Interpolation>
+	void evaluate( const float x, const float y, const float z, value_type* out ) const
+	{
+		lattice_cell cell;
+		locate( x, y, z, cell );
+		Interpolation()( *this, cell, out );
+	}
+
+private:
+	void updateScale()
+	{
+		for( std::size_t a = 0; a < 3; ++a )
+			_scale[a] = ( _size > 1 && _max[a] > _min[a] ) ? ( _size - 1 ) / ( _max[a] - _min[a] ) : 0.0f;
+	}
+
+private:
+	std::vector<value_type> _data;
+	std::size_t _size;
+	std::size_t _strides[3];
+	float _min[3];
+	float _max[3];
+	float _scale[3]; ///< number of cells per unit of input
+};
+
+/**
+ * @brief Interpolate between the 8 corners of the cell.
+ */
+struct trilinear_interpolation
+{
+	template<class Lut>
+	void operator()( const Lut& lut, const lattice_cell& cell, typename Lut::value_type* out ) const
+	{
+		typedef typename Lut::value_type T;
+		const T* p000 = lut.data() + cell.index;
+		const T* p100 = p000 + lut.stride( 0 );
+		const T* p010 = p000 + lut.stride( 1 );
+		const T* p110 = p100 + lut.stride( 1 );
+		const std::size_t sz = lut.stride( 2 );
+		const float dx = cell.d[0];
+		const float dy = cell.d[1];
+		const float dz = cell.d[2];
+
+		for( std::size_t c = 0; c < Lut::nb_channels; ++c )
+		{
+			const T c00 = p000[c] + dz * ( p000[c + sz] - p000[c] );
+			const T c01 = p010[c] + dz * ( p010[c + sz] - p010[c] );
+			const T c10 = p100[c] + dz * ( p100[c + sz] - p100[c] );
+			const T c11 = p110[c] + dz * ( p110[c + sz] - p110[c] );
+			const T c0 = c00 + dy * ( c01 - c00 );
+			const T c1 = c10 + dy * ( c11 - c10 );
+			out[c] = c0 + dx * ( c1 - c0 );
+		}
+	}
+};
+
+/**
+ * @brief Interpolate inside one of the 6 tetrahedra of the cell.
+ * Only 4 nodes are read, and the interpolation preserves the neutral axis.
+ */
+struct tetrahedral_interpolation
+{
+	template<class Lut>
+	void operator()( const Lut& lut, const lattice_cell& cell, typename Lut::value_type* out ) const
+	{
+		typedef typename Lut::value_type T;
+		const std::size_t sx = lut.stride( 0 );
+		const std::size_t sy = lut.stride( 1 );
+		const std::size_t sz = lut.stride( 2 );
+		const float dx = cell.d[0];
+		const float dy = cell.d[1];
+		const float dz = cell.d[2];
+
+		const T* p000 = lut.data() + cell.index;
+		const T* p111 = p000 + sx + sy + sz;
+		// nodes of the tetrahedron, visited from p000 to p111 along the axes
+		// sorted by decreasing position in the cell
+		const T* pA;
+		const T* pB;
+		float w1, w2, w3;
+		if( dx >= dy )
+		{
+			if( dy >= dz )      // x > y > z
+			{
+				pA = p000 + sx; pB = pA + sy;
+				w1 = dx; w2 = dy; w3 = dz;
+			}
+			else if( dx >= dz ) // x > z > y
+			{
+				pA = p000 + sx; pB = pA + sz;
+				w1 = dx; w2 = dz; w3 = dy;
+			}
+			else                // z > x > y
+			{
+				pA = p000 + sz; pB = pA + sx;
+				w1 = dz; w2 = dx; w3 = dy;
+			}
+		}
+		else
+		{
+			if( dx >= dz )      // y > x > z
+			{
+				pA = p000 + sy; pB = pA + sx;
+				w1 = dy; w2 = dx; w3 = dz;
+			}
+			else if( dy >= dz ) // y > z > x
+			{
+				pA = p000 + sy; pB = pA + sz;
+				w1 = dy; w2 = dz; w3 = dx;
+			}
+			else                // z > y > x
+			{
+				pA = p000 + sz; pB = pA + sy;
+				w1 = dz; w2 = dy; w3 = dx;
+			}
+		}
+
+		for( std::size_t c = 0; c < Lut::nb_channels; ++c )
+		{
+			out[c] = p000[c] + w1 * ( pA[c] - p000[c] ) + w2 * ( pB[c] - pA[c] ) + w3 * ( p111[c] - pB[c] );
+		}
+	}
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef _TERRY_COLOR_LUT_TRANSFORM_LUT3D_HPP_
+#define _TERRY_COLOR_LUT_TRANSFORM_LUT3D_HPP_
+
+#include "lut3d.hpp"
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace terry {
+namespace color {
+namespace lut {
+
+/// Number of pixels located at once by transform_lut3d()
+static const std::size_t lut3d_batch_size = 64;
+
+namespace detail {
+
+/**
+ * @brief Convert positions on one axis into lattice indices and fractional
+ *        positions inside the cells.
+ * Values outside of the domain (and NaN) are clamped on the domain.
+ */
+inline void locate_axis( const float* p, const std::size_t n,
+                         const float min, const float scale, const std::size_t size,
+                         boost::int32_t* index, float* d )
+{
+	const float last = static_cast<float>( size - 1 );
+	const float lastCell = static_cast<float>( size - 2 );
+	std::size_t i = 0;
+#ifdef __SSE2__
+	const __m128 vMin = _mm_set1_ps( min );
+	const __m128 vScale = _mm_set1_ps( scale );
+	const __m128 vZero = _mm_setzero_ps();
+	const __m128 vLast = _mm_set1_ps( last );
+	const __m128 vLastCell = _mm_set1_ps( lastCell );
+	for( ; i + 4 <= n; i += 4 )
+	{
+		__m128 f = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( p + i ), vMin ), vScale );
+		f = _mm_min_ps( _mm_max_ps( f, vZero ), vLast ); // max returns 0 for NaN
+		const __m128i fi = _mm_cvttps_epi32( f );
+		const __m128 cell = _mm_min_ps( _mm_cvtepi32_ps( fi ), vLastCell );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( index + i ), _mm_cvttps_epi32( cell ) );
+		_mm_storeu_ps( d + i, _mm_sub_ps( f, cell ) );
+	}
+#endif
+	for( ; i < n; ++i )
+	{
+		float f = ( p[i] - min ) * scale;
+		if( !( f > 0.0f ) ) // also catch NaN
+			f = 0.0f;
+		else if( f > last )
+			f = last;
+		const float cell = std::min( static_cast<float>( static_cast<boost::int32_t>( f ) ), lastCell );
+		index[i] = static_cast<boost::int32_t>( cell );
+		d[i] = f - cell;
+	}
+}
+
+}
+
+/**
+ * @brief Apply a 3D LUT on a buffer of interleaved float pixels.
+ *
+ * Pixels are processed by batches of lut3d_batch_size: the batch is first
+ * deinterleaved and located in the lattice (SSE2 when available), then each
+ * pixel is interpolated. Only the 3 first channels of each pixel are used
+ * and written, @p src and @p dst may be the same buffer.
+ *
+ * @param Interpolation trilinear_interpolation or tetrahedral_interpolation
+ * @param[in] srcStep  number of floats between two source pixels
+ * @param[in] dstStep  number of floats between two destination pixels
+ */
+template<class Interpolation, class Lut>
+void transform_lut3d( const Lut& lut, const float* src, const std::size_t srcStep,
+                      float* dst, const std::size_t dstStep, const std::size_t nbPixels )
+{
+	float p[3][lut3d_batch_size];
+	float d[3][lut3d_batch_size];
+	boost::int32_t index[3][lut3d_batch_size];
+	const std::size_t strides[3] = { lut.stride( 0 ), lut.stride( 1 ), lut.stride( 2 ) };
+	const Interpolation interpolation = Interpolation();
+
+	for( std::size_t begin = 0; begin < nbPixels; begin += lut3d_batch_size )
+	{
+		const std::size_t n = std::min( lut3d_batch_size, nbPixels - begin );
+		const float* s = src + begin * srcStep;
+		for( std::size_t i = 0; i < n; ++i, s += srcStep )
+		{
+			p[0][i] = s[0];
+			p[1][i] = s[1];
+			p[2][i] = s[2];
+		}
+		for( std::size_t a = 0; a < 3; ++a )
+		{
+			detail::locate_axis( p[a], n, lut.domainMin( a ), lut.scale( a ), lut.size(), index[a], d[a] );
+		}
+
+		float* out = dst + begin * dstStep;
+		lattice_cell cell;
+		for( std::size_t i = 0; i < n; ++i, out += dstStep )
+		{
+			cell.index = index[0][i] * strides[0] + index[1][i] * strides[1] + index[2][i] * strides[2];
+			cell.d[0] = d[0][i];
+			cell.d[1] = d[1][i];
+			cell.d[2] = d[2][i];
+			interpolation( lut, cell, out );
+		}
+	}
+}
+
+}
+}
+}
+
+#endif
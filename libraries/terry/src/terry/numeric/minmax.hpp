@@ -102,6 +102,14 @@ struct pixel_minmax_by_channel_t
 		pixel_assign_min_t<Pixel,CPixel>()( v, min );
 		pixel_assign_max_t<Pixel,CPixel>()( v, max );
 	}
+
+	/// @brief accumulate the result of other pixels (see terry::algorithm::parallel_reduce)
+	GIL_FORCEINLINE
+	void merge( const pixel_minmax_by_channel_t& other )
+	{
+		pixel_assign_min_t<CPixel,CPixel>()( other.min, min );
+		pixel_assign_max_t<CPixel,CPixel>()( other.max, max );
+	}
 };
 
 
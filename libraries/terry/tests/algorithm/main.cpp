@@ -0,0 +1,141 @@
+#include <terry/algorithm/parallel_reduce.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+
+#include <vector>
+#include <cstring>
+
+#define BOOST_TEST_MODULE terry_algorithm_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+/// Keeps the rows in the order they are accumulated and merged.
+struct rows_order_accumulator
+{
+	std::vector<std::ptrdiff_t> _rows;
+
+	void operator()( const std::ptrdiff_t y )
+	{
+		_rows.push_back( y );
+	}
+
+	void merge( const rows_order_accumulator& next )
+	{
+		_rows.insert( _rows.end(), next._rows.begin(), next._rows.end() );
+	}
+};
+
+template <typename T>
+struct sum_accumulator
+{
+	T _sum;
+
+	sum_accumulator() : _sum( 0 ) {}
+
+	template <class Pixel>
+	void operator()( const Pixel& p )
+	{
+		_sum += p[0];
+	}
+
+	void merge( const sum_accumulator& next )
+	{
+		_sum += next._sum;
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_algorithm_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( parallel_reduce_rows_order )
+{
+	using namespace terry::algorithm;
+	// the last block is not full, and some threads have more blocks than others
+	const std::ptrdiff_t height = 37;
+	const unsigned int nbThreads[] = { 1, 2, 3, 4, 7 };
+	for( std::size_t t = 0; t < sizeof( nbThreads ) / sizeof( nbThreads[0] ); ++t )
+	{
+		const rows_order_accumulator acc = parallel_reduce_rows( height, rows_order_accumulator(), thread_group_launcher( nbThreads[t] ), 8 );
+		BOOST_REQUIRE_EQUAL( acc._rows.size(), std::size_t( height ) );
+		for( std::ptrdiff_t y = 0; y < height; ++y )
+		{
+			BOOST_CHECK_EQUAL( acc._rows[y], y );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( parallel_reduce_rows_more_threads_than_blocks )
+{
+	using namespace terry::algorithm;
+	const rows_order_accumulator acc = parallel_reduce_rows( 5, rows_order_accumulator(), thread_group_launcher( 8 ), 2 );
+	BOOST_REQUIRE_EQUAL( acc._rows.size(), 5u );
+	for( std::ptrdiff_t y = 0; y < 5; ++y )
+	{
+		BOOST_CHECK_EQUAL( acc._rows[y], y );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( parallel_reduce_rows_empty )
+{
+	using namespace terry::algorithm;
+	rows_order_accumulator init;
+	init( 42 );
+	const rows_order_accumulator acc = parallel_reduce_rows( 0, init, thread_group_launcher( 4 ) );
+	BOOST_REQUIRE_EQUAL( acc._rows.size(), 1u );
+	BOOST_CHECK_EQUAL( acc._rows[0], 42 );
+}
+
+BOOST_AUTO_TEST_CASE( parallel_reduce_view_sum )
+{
+	using namespace boost::gil;
+	using namespace terry::algorithm;
+	gray32_image_t img( 53, 29 );
+	const gray32_view_t view = boost::gil::view( img );
+	boost::uint64_t serial = 0;
+	for( std::ptrdiff_t y = 0; y < view.height(); ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < view.width(); ++x )
+		{
+			const boost::uint32_t v = static_cast<boost::uint32_t>( ( y * 7919 + x * 104729 ) % 100003 );
+			view( x, y )[0] = v;
+			serial += v;
+		}
+	}
+
+	const unsigned int nbThreads[] = { 1, 3, 4 };
+	for( std::size_t t = 0; t < sizeof( nbThreads ) / sizeof( nbThreads[0] ); ++t )
+	{
+		const sum_accumulator<boost::uint64_t> acc = parallel_reduce( const_view( img ), sum_accumulator<boost::uint64_t>(), thread_group_launcher( nbThreads[t] ) );
+		BOOST_CHECK_EQUAL( acc._sum, serial );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( parallel_reduce_float_sum_independent_of_threads )
+{
+	using namespace boost::gil;
+	using namespace terry::algorithm;
+	gray32f_image_t img( 41, 67 );
+	const gray32f_view_t view = boost::gil::view( img );
+	for( std::ptrdiff_t y = 0; y < view.height(); ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < view.width(); ++x )
+		{
+			view( x, y )[0] = 1.f / ( 1 + x + 3 * y );
+		}
+	}
+
+	const sum_accumulator<float> reference = parallel_reduce( const_view( img ), sum_accumulator<float>(), thread_group_launcher( 1 ) );
+	const unsigned int nbThreads[] = { 2, 3, 5, 9 };
+	for( std::size_t t = 0; t < sizeof( nbThreads ) / sizeof( nbThreads[0] ); ++t )
+	{
+		const sum_accumulator<float> acc = parallel_reduce( const_view( img ), sum_accumulator<float>(), thread_group_launcher( nbThreads[t] ) );
+		// same blocks and same merge order: bitwise identical
+		BOOST_CHECK_EQUAL( std::memcmp( &acc._sum, &reference._sum, sizeof( float ) ), 0 );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
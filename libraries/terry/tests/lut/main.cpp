@@ -0,0 +1,153 @@
+#include <terry/color/lut/lut1d.hpp>
+#include <terry/color/lut/lut3d.hpp>
+#include <terry/color/lut/transform_lut3d.hpp>
+
+#include <vector>
+#include <cmath>
+
+#define BOOST_TEST_MODULE terry_lut_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+struct identity_3d
+{
+	void operator()( const double x, const double y, const double z, float* out ) const
+	{
+		out[0] = x; out[1] = y; out[2] = z;
+	}
+};
+
+struct affine_3d
+{
+	void operator()( const double x, const double y, const double z, float* out ) const
+	{
+		out[0] = 0.5 * x + 0.25 * y - z + 0.1;
+	}
+};
+
+struct warp_3d
+{
+	void operator()( const double x, const double y, const double z, float* out ) const
+	{
+		out[0] = x * x; out[1] = std::sqrt( y ); out[2] = 0.5 * ( x + z );
+	}
+};
+
+struct square_1d
+{
+	double operator()( const double x ) const
+	{
+		return x * x;
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_lut_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( lut3d_identity )
+{
+	using namespace terry::color::lut;
+	lut3d<3> lut;
+	lut.bake( identity_3d(), 17 );
+	BOOST_CHECK_EQUAL( lut.size(), std::size_t(17) );
+
+	const float points[][3] = {
+		{ 0.0f, 0.0f, 0.0f },
+		{ 1.0f, 1.0f, 1.0f },
+		{ 0.3f, 0.7f, 0.1f },
+		{ 0.9f, 0.2f, 0.55f },
+		{ 0.5f, 0.5f, 0.5f },
+	};
+	for( std::size_t i = 0; i < sizeof(points) / sizeof(points[0]); ++i )
+	{
+		const float* p = points[i];
+		float tri[3];
+		float tetra[3];
+		lut.evaluate<trilinear_interpolation>( p[0], p[1], p[2], tri );
+		lut.evaluate<tetrahedral_interpolation>( p[0], p[1], p[2], tetra );
+		for( std::size_t c = 0; c < 3; ++c )
+		{
+			BOOST_CHECK_CLOSE( tri[c] + 1.0f, p[c] + 1.0f, 1e-4 );
+			BOOST_CHECK_CLOSE( tetra[c] + 1.0f, p[c] + 1.0f, 1e-4 );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( lut3d_domain )
+{
+	using namespace terry::color::lut;
+	lut3d<1> lut;
+	const float min[3] = { -1.0f, 0.0f, 0.5f };
+	const float max[3] = { 1.0f, 2.0f, 0.75f };
+	lut.setDomain( min, max );
+	lut.bake( affine_3d(), 5 );
+
+	BOOST_CHECK( lut.contains( 0.0f, 1.0f, 0.6f ) );
+	BOOST_CHECK( ! lut.contains( 0.0f, 1.0f, 0.8f ) );
+
+	// affine functions are exactly reconstructed
+	float v;
+	lut.evaluate<tetrahedral_interpolation>( 0.3f, 1.3f, 0.6f, &v );
+	BOOST_CHECK_CLOSE( v, 0.5f * 0.3f + 0.25f * 1.3f - 0.6f + 0.1f, 1e-3 );
+	lut.evaluate<trilinear_interpolation>( -0.7f, 0.1f, 0.7f, &v );
+	BOOST_CHECK_CLOSE( v, 0.5f * -0.7f + 0.25f * 0.1f - 0.7f + 0.1f, 1e-3 );
+
+	// outside of the domain, values are clamped
+	float clamped;
+	lut.evaluate<trilinear_interpolation>( 5.0f, 1.0f, 0.6f, &v );
+	lut.evaluate<trilinear_interpolation>( 1.0f, 1.0f, 0.6f, &clamped );
+	BOOST_CHECK_EQUAL( v, clamped );
+}
+
+BOOST_AUTO_TEST_CASE( lut3d_transform_batch )
+{
+	using namespace terry::color::lut;
+	lut3d<3> lut;
+	lut.bake( warp_3d(), 9 );
+
+	// RGBA pixels, more than one batch and a partial batch, some outside of the domain
+	const std::size_t nbPixels = 2 * lut3d_batch_size + 7;
+	std::vector<float> src( nbPixels * 4 );
+	for( std::size_t i = 0; i < src.size(); ++i )
+		src[i] = ( ( i * 37 ) % 101 ) / 90.0f - 0.05f;
+	std::vector<float> dst( src );
+	transform_lut3d<tetrahedral_interpolation>( lut, &src.front(), 4, &dst.front(), 4, nbPixels );
+	std::vector<float> inplace( src );
+	transform_lut3d<trilinear_interpolation>( lut, &inplace.front(), 4, &inplace.front(), 4, nbPixels );
+
+	for( std::size_t i = 0; i < nbPixels; ++i )
+	{
+		const float* p = &src[i * 4];
+		float tetra[3];
+		float tri[3];
+		lut.evaluate<tetrahedral_interpolation>( p[0], p[1], p[2], tetra );
+		lut.evaluate<trilinear_interpolation>( p[0], p[1], p[2], tri );
+		for( std::size_t c = 0; c < 3; ++c )
+		{
+			BOOST_CHECK_CLOSE( dst[i * 4 + c] + 1.0f, tetra[c] + 1.0f, 1e-4 );
+			BOOST_CHECK_CLOSE( inplace[i * 4 + c] + 1.0f, tri[c] + 1.0f, 1e-4 );
+		}
+		// alpha is untouched
+		BOOST_CHECK_EQUAL( dst[i * 4 + 3], p[3] );
+		BOOST_CHECK_EQUAL( inplace[i * 4 + 3], p[3] );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( lut1d_interpolation )
+{
+	using namespace terry::color::lut;
+	lut1d lut;
+	lut.bake( square_1d(), 1025 );
+	BOOST_CHECK_CLOSE( lut( 0.5f ), 0.25f, 1e-3 );
+	BOOST_CHECK_CLOSE( lut( 0.3f ), 0.09f, 1e-2 );
+	BOOST_CHECK_EQUAL( lut( -1.0f ), 0.0f );
+	BOOST_CHECK_EQUAL( lut( 2.0f ), 1.0f );
+
+	lut.fill( 0.5f );
+	BOOST_CHECK_EQUAL( lut( 0.3f ), 0.5f );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,45 @@
+# scons: Checkerboard Constant Merge
+
+from pyTuttle import tuttle
+
+def setUp():
+	tuttle.core().preload(False)
+
+def testMergeStackUnion():
+
+	g = tuttle.Graph()
+	background = g.createNode( "tuttle.constant", size=[100,100], color=[0,0,0,1] ).asImageEffectNode()
+	layer1 = g.createNode( "tuttle.checkerboard", size=[150,50] ).asImageEffectNode()
+	layer2 = g.createNode( "tuttle.checkerboard", size=[20,200] ).asImageEffectNode()
+	stack = g.createNode( "tuttle.mergestack", mergingFunction="over", rod="union" ).asImageEffectNode()
+
+	g.connect( background, stack.getClip("B") )
+	g.connect( layer1, stack.getClip("A1") )
+	g.connect( layer2, stack.getClip("A2") )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, stack )
+
+	rodStack = outputCache.get(0).getROD()
+
+	print rodStack.x1, rodStack.y1, rodStack.x2, rodStack.y2
+	assert rodStack.x1 == 0
+	assert rodStack.y1 == 0
+	assert rodStack.x2 == 150
+	assert rodStack.y2 == 200
+
+
+def testMergeStackBackgroundOnly():
+
+	g = tuttle.Graph()
+	background = g.createNode( "tuttle.checkerboard", size=[64,32] ).asImageEffectNode()
+	stack = g.createNode( "tuttle.mergestack", mergingFunction="plus" ).asImageEffectNode()
+
+	g.connect( background, stack.getClip("B") )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, stack )
+
+	rodStack = outputCache.get(0).getROD()
+	assert rodStack.x2 == 64
+	assert rodStack.y2 == 32
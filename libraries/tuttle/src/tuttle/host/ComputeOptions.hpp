@@ -8,6 +8,7 @@
 #include <tuttle/common/utils/formatters.hpp>
 
 #include <boost/atomic.hpp>
+#include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <limits>
@@ -26,6 +27,16 @@ class IProgressHandle
 		virtual void endSequence() = 0;
 };
 
+/**
+ * @brief Called at the end of each frame of the compute.
+ * @param time     frame time
+ * @param rendered false if the frame was skipped on an error
+ *                 (see ComputeOptions::setContinueOnError and ComputeOptions::setContinueOnMissingFile)
+ *
+ * The output params of the nodes (like the results of an analysis) can be read at @p time.
+ */
+typedef boost::function<void( const OfxTime time, const bool rendered )> OutputCallback;
+
 struct TimeRange
 {
 	TimeRange()
@@ -110,6 +121,7 @@ public:
 		_forceIdentityNodesProcess = other._forceIdentityNodesProcess;
 		_returnBuffers = other._returnBuffers;
 		_isInteractive = other._isInteractive;
+		_outputCallback = other._outputCallback;
 
 		// don't modify the abort status?
 		//_abort.store( false, boost::memory_order_relaxed );
@@ -302,6 +314,20 @@ public:
 			_progressHandle.get()->endSequence();
 	}
 
+	/**
+	 * @brief Collect the result of each frame, without a compute per frame.
+	 */
+	This& setOutputCallback( const OutputCallback& callback )
+	{
+		_outputCallback = callback;
+		return *this;
+	}
+	void outputCallback( const OfxTime time, const bool rendered ) const
+	{
+		if( _outputCallback )
+			_outputCallback( time, rendered );
+	}
+
 private:
 	std::list<TimeRange> _timeRanges;
 	
@@ -319,6 +345,7 @@ private:
 	boost::atomic_bool _abort;
 
 	boost::shared_ptr<IProgressHandle> _progressHandle;
+	OutputCallback _outputCallback;
 };
 
 }
@@ -23,5 +23,9 @@ namespace host {
 }
 }
 
+// boost::function callback, not exposed
+%ignore tuttle::host::ComputeOptions::setOutputCallback;
+%ignore tuttle::host::ComputeOptions::outputCallback;
+
 %include <tuttle/host/ComputeOptions.hpp>
 
@@ -1,4 +1,5 @@
 #include "Core.hpp"
+#include "PluginCacheFile.hpp"
 
 #include <tuttle/host/ofx/OfxhImageEffectPlugin.hpp>
 #include <tuttle/host/memory/MemoryPool.hpp>
@@ -6,22 +7,9 @@
 
 #include <tuttle/common/system/system.hpp>
 
-#include <boost/archive/xml_oarchive.hpp>
-#include <boost/archive/binary_oarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
-#include <boost/archive/xml_iarchive.hpp>
-#include <boost/archive/binary_iarchive.hpp>
-#include <boost/archive/text_iarchive.hpp>
-
-#include <boost/serialization/serialization.hpp>
-#include <boost/serialization/nvp.hpp>
-
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_io.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
+#include <boost/thread/tss.hpp>
 
 #ifdef TUTTLE_HOST_WITH_PYTHON_EXPRESSION
 	#include <boost/python.hpp>
@@ -39,6 +27,10 @@ namespace host {
 namespace {
 memory::MemoryPool pool;
 memory::MemoryCache cache;
+
+/// the memory cache is owned by the thread, not deleted at the thread exit
+void keepThreadMemoryCache( memory::IMemoryCache* ) {}
+boost::thread_specific_ptr<memory::IMemoryCache> threadCache( &keepThreadMemoryCache );
 }
 
 Core::Core()
@@ -62,6 +54,23 @@ Core::Core()
 Core::~Core()
 {}
 
+memory::IMemoryCache& Core::getMemoryCache()
+{
+	memory::IMemoryCache* threadMemoryCache = threadCache.get();
+	return threadMemoryCache ? *threadMemoryCache : _memoryCache;
+}
+
+const memory::IMemoryCache& Core::getMemoryCache() const
+{
+	const memory::IMemoryCache* threadMemoryCache = threadCache.get();
+	return threadMemoryCache ? *threadMemoryCache : _memoryCache;
+}
+
+void Core::setThreadMemoryCache( memory::IMemoryCache* cache )
+{
+	threadCache.reset( cache );
+}
+
 void Core::preload( const bool useCache )
 {
 	if( _isPreloaded )
@@ -70,29 +79,18 @@ void Core::preload( const bool useCache )
 	_isPreloaded = true;
 	
 #ifndef __WINDOWS__
-	//	typedef boost::archive::binary_oarchive OArchive;
-	//	typedef boost::archive::binary_iarchive IArchive;
-	//	typedef boost::archive::text_oarchive OArchive;
-	//	typedef boost::archive::text_iarchive IArchive;
-	typedef boost::archive::xml_oarchive OArchive;
-	typedef boost::archive::xml_iarchive IArchive;
-	
 	std::string cacheFile;
 	if( useCache )
 	{
-		cacheFile = (getPreferences().getTuttleHomePath() / "tuttlePluginCacheSerialize.xml").string();
+		cacheFile = (getPreferences().getTuttleHomePath() / "tuttlePluginCache.bin").string();
 		
 		TUTTLE_LOG_DEBUG( TUTTLE_INFO, "plugin cache file = " << cacheFile );
 
 		try
 		{
-			std::ifstream ifsb( cacheFile.c_str(), std::ios::in );
-			if( ifsb.is_open() )
+			if( readPluginCache( cacheFile, _pluginCache ) )
 			{
 				TUTTLE_LOG_DEBUG( TUTTLE_INFO, "Read plugins cache." );
-				IArchive iArchive( ifsb );
-				iArchive >> BOOST_SERIALIZATION_NVP( _pluginCache );
-				ifsb.close();
 			}
 		}
 		catch( std::exception& e )
@@ -105,21 +103,13 @@ void Core::preload( const bool useCache )
 #ifndef __WINDOWS__
 	if( useCache && _pluginCache.isDirty() )
 	{
-		// generate unique name for writing
-		boost::uuids::random_generator gen;
-		boost::uuids::uuid u = gen();
-		const std::string tmpCacheFile( cacheFile + ".writing." + boost::uuids::to_string(u) + ".xml" );
-		
-		TUTTLE_LOG_DEBUG( TUTTLE_INFO, "Write plugins cache " << tmpCacheFile );
-		// serialize into a temporary file
-		std::ofstream ofsb( tmpCacheFile.c_str(), std::ios::out );
-		if( ofsb.is_open() )
+		try
+		{
+			writePluginCache( cacheFile, _pluginCache );
+		}
+		catch( std::exception& e )
 		{
-			OArchive oArchive( ofsb );
-			oArchive << BOOST_SERIALIZATION_NVP( _pluginCache );
-			ofsb.close();
-			// replace the cache file
-			boost::filesystem::rename( tmpCacheFile, cacheFile );
+			TUTTLE_LOG_ERROR( "Exception when writing cache file (" << e.what()  << ")." );
 		}
 	}
 #endif
@@ -59,8 +59,19 @@ public:
 
 	memory::IMemoryPool&        getMemoryPool()        { return _memoryPool; }
 	const memory::IMemoryPool&  getMemoryPool() const  { return _memoryPool; }
-	memory::IMemoryCache&       getMemoryCache()       { return _memoryCache; }
-	const memory::IMemoryCache& getMemoryCache() const { return _memoryCache; }
+	/**
+	 * @brief Memory cache of the images computed in the current thread,
+	 *        the memory cache of the host if the thread doesn't use its own.
+	 */
+	memory::IMemoryCache&       getMemoryCache();
+	const memory::IMemoryCache& getMemoryCache() const;
+
+	/**
+	 * @brief Use @p cache for the images computed in the current thread,
+	 *        so graphs can be computed at the same time in several threads.
+	 * @param cache NULL: use the memory cache of the host again
+	 */
+	void setThreadMemoryCache( memory::IMemoryCache* cache );
 
 public:
 	ofx::imageEffect::OfxhImageEffectPlugin* getImageEffectPluginById( const std::string& id, int vermaj = -1, int vermin = -1 )
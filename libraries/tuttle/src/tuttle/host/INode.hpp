@@ -108,6 +108,11 @@ public:
 
 	virtual std::size_t getLocalHashAtTime( const OfxTime time ) const = 0;
 
+	/**
+	 * @brief The node renders the same image at all times, as long as its inputs don't change.
+	 */
+	virtual bool isTimeInvariant() const = 0;
+
 #ifndef SWIG
 	virtual void connect( const INode&, attribute::Attribute& ) = 0;
 
@@ -139,6 +139,14 @@ std::size_t ImageEffectNode::getLocalHashAtTime( const OfxTime time ) const
 	return seed;
 }
 
+bool ImageEffectNode::isTimeInvariant() const
+{
+	// a writer has to write each frame
+	if( getContext() == kOfxImageEffectContextWriter )
+		return false;
+	return ! isFrameVarying() && ! getParamSet().isAnimated();
+}
+
 /// get default output fielding. This is passed into the clip prefs action
 /// and  might be mapped (if the host allows such a thing)
 const std::string& ImageEffectNode::getDefaultOutputFielding() const
@@ -912,7 +920,8 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 					attribute::Image::eImageOrientationFromBottomToTop,
 					0 )
 				);
-			imageCache->setPoolData( core().getMemoryPool().allocate( imageCache->getMemorySize() ) );
+			// the pixels are allocated by the image on the first access,
+			// never if the plugin sets the output as a constant image
 			memoryCache.put( clip.getClipIdentifier(), vData._time, imageCache );
 			
 			allNeededDatas.push_back( imageCache );
@@ -948,6 +957,21 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 	
 	debugOutputImage( vData._time );
 
+	if( hasSparseOutput() && vData._sparseOutput )
+	{
+		// only keep the populated tiles of the output images while they are in the cache,
+		// all the nodes using them read the tiles
+		BOOST_FOREACH( ClipImageMap::value_type& i, _clipImages )
+		{
+			attribute::ClipImage& clip = dynamic_cast<attribute::ClipImage&>( *( i.second ) );
+			if( ! clip.isOutput() )
+				continue;
+			memory::CACHE_ELEMENT imageCache = memoryCache.get( clip.getClipIdentifier(), vData._time );
+			if( imageCache.get() != NULL )
+				imageCache->splitInTiles();
+		}
+	}
+
 	// release input images
 	BOOST_FOREACH( const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair, vData._inEdges )
 	{
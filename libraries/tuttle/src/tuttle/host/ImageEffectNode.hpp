@@ -82,6 +82,8 @@ public:
 	const ofx::attribute::OfxhClipImageSet& getClipImageSet() const { return *this; }
 	
 	std::size_t getLocalHashAtTime( const OfxTime time ) const;
+
+	bool isTimeInvariant() const;
 	
 	OfxRectD getRegionOfDefinition( const OfxTime time ) const
 	{
@@ -19,8 +19,6 @@ INode* createNode( const std::string& pluginName )
 		    << exception::pluginIdentifier( pluginName ) );
 	}
 
-	plug->loadAndDescribeActions();
-
 	ofx::imageEffect::OfxhImageEffectNode* plugInst = NULL;
 	if( plug->supportsContext( kOfxImageEffectContextReader ) )
 	{
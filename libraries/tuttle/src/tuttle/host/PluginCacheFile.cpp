@@ -0,0 +1,116 @@
+#include "PluginCacheFile.hpp"
+#include "Core.hpp"
+
+#include <tuttle/host/ofx/OfxhPluginCache.hpp>
+#include <tuttle/host/ofx/OfxhImageEffectPlugin.hpp>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+#include <boost/serialization/serialization.hpp>
+#include <boost/serialization/nvp.hpp>
+
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <fstream>
+#include <streambuf>
+#include <cstring>
+
+namespace tuttle {
+namespace host {
+
+namespace {
+
+static const char kPluginCacheMagic[4] = { 'T', 'P', 'C', 'B' };
+static const boost::uint32_t kPluginCacheVersion = 1;
+
+/**
+ * @brief Plugin cache file header, followed by the binary archive of the
+ *        plugin cache. A binary archive is only readable by the same build,
+ *        so the cache is also identified by the host version.
+ */
+struct PluginCacheHeader
+{
+	char magic[4];
+	boost::uint32_t version;
+	char hostVersion[16];
+};
+
+/// Read only stream buffer on a memory block
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+	MemoryStreamBuf( const char* data, const std::size_t size )
+	{
+		char* begin = const_cast<char*>( data );
+		setg( begin, begin, begin + size );
+	}
+};
+
+PluginCacheHeader makePluginCacheHeader()
+{
+	PluginCacheHeader header;
+	std::memset( &header, 0, sizeof( PluginCacheHeader ) );
+	std::memcpy( header.magic, kPluginCacheMagic, sizeof( kPluginCacheMagic ) );
+	header.version = kPluginCacheVersion;
+	std::strncpy( header.hostVersion, TUTTLE_HOST_VERSION_STR, sizeof( header.hostVersion ) - 1 );
+	return header;
+}
+
+}
+
+bool readPluginCache( const std::string& cacheFile, ofx::OfxhPluginCache& pluginCache )
+{
+	namespace bip = boost::interprocess;
+	if( ! boost::filesystem::exists( cacheFile ) || boost::filesystem::file_size( cacheFile ) <= sizeof( PluginCacheHeader ) )
+		return false;
+
+	const bip::file_mapping file( cacheFile.c_str(), bip::read_only );
+	const bip::mapped_region region( file, bip::read_only );
+	const char* data = static_cast<const char*>( region.get_address() );
+
+	const PluginCacheHeader expectedHeader = makePluginCacheHeader();
+	if( std::memcmp( data, &expectedHeader, sizeof( PluginCacheHeader ) ) != 0 )
+		return false;
+
+	MemoryStreamBuf buffer( data + sizeof( PluginCacheHeader ), region.get_size() - sizeof( PluginCacheHeader ) );
+	boost::archive::binary_iarchive iArchive( buffer );
+	iArchive >> BOOST_SERIALIZATION_NVP( pluginCache );
+	return true;
+}
+
+void writePluginCache( const std::string& cacheFile, const ofx::OfxhPluginCache& pluginCache )
+{
+	// generate unique name for writing
+	boost::uuids::random_generator gen;
+	boost::uuids::uuid u = gen();
+	const std::string tmpCacheFile( cacheFile + ".writing." + boost::uuids::to_string(u) );
+
+	TUTTLE_LOG_DEBUG( TUTTLE_INFO, "Write plugins cache " << tmpCacheFile );
+	// serialize into a temporary file
+	std::ofstream ofsb( tmpCacheFile.c_str(), std::ios::out | std::ios::binary );
+	if( ! ofsb.is_open() )
+		return;
+
+	const PluginCacheHeader header = makePluginCacheHeader();
+	ofsb.write( reinterpret_cast<const char*>( &header ), sizeof( PluginCacheHeader ) );
+	{
+		boost::archive::binary_oarchive oArchive( ofsb );
+		oArchive << BOOST_SERIALIZATION_NVP( pluginCache );
+	}
+	ofsb.close();
+	// replace the cache file
+	boost::filesystem::rename( tmpCacheFile, cacheFile );
+}
+
+}
+}
@@ -0,0 +1,34 @@
+#ifndef _TUTTLE_HOST_PLUGINCACHEFILE_HPP_
+#define _TUTTLE_HOST_PLUGINCACHEFILE_HPP_
+
+#include <string>
+
+namespace tuttle {
+namespace host {
+
+namespace ofx {
+class OfxhPluginCache;
+}
+
+/**
+ * @brief Read the plugin cache file, written with writePluginCache().
+ *
+ * The file is a small header followed by a boost binary archive of the
+ * plugin cache, deserialized directly from the mapped file. The binaries
+ * are checked afterwards by OfxhPluginCache::scanPluginFiles(), only the
+ * modified ones are described again.
+ *
+ * @return false if there is no cache file or if it was written by another host version.
+ */
+bool readPluginCache( const std::string& cacheFile, ofx::OfxhPluginCache& pluginCache );
+
+/**
+ * @brief Write the plugin cache file.
+ * The cache is written in a unique temporary file, then renamed.
+ */
+void writePluginCache( const std::string& cacheFile, const ofx::OfxhPluginCache& pluginCache );
+
+}
+}
+
+#endif
@@ -154,11 +154,12 @@ public:
 
 		new_tv.time = time;
 		new_tv.value = v;
-		it = find( _key_frames.begin( ), _key_frames.end( ), new_tv );
-		if( it == _key_frames.end( ) )
+		// the key frames are sorted, output params set at each frame of a long range
+		// are appended at the end
+		it = std::lower_bound( _key_frames.begin( ), _key_frames.end( ), new_tv );
+		if( it == _key_frames.end( ) || it->time != time )
 		{
-			_key_frames.push_back( new_tv );
-			std::sort( _key_frames.begin( ), _key_frames.end( ) );
+			_key_frames.insert( it, new_tv );
 		}
 		else
 		{
@@ -202,6 +203,11 @@ public:
 		return new This( *this );
 	}
 
+	bool isAnimated() const
+	{
+		return _key_frames.size() > 1;
+	}
+
 	/* ======= BEGIN OfxhKeyframeParam functions =======
 
 	Since this implementation is backed by a set, indexes may change and
@@ -1,4 +1,5 @@
 #include "Image.hpp"
+#include "ImageTiles.hpp"
 #include <tuttle/host/attribute/ClipImage.hpp>
 #include <tuttle/host/Core.hpp>
 
@@ -8,6 +9,10 @@
 #include <boost/gil/image_view.hpp>
 #include <boost/gil/typedefs.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #ifndef TUTTLE_PRODUCTION
 #ifdef TUTTLE_PNG_EXPORT_BETWEEN_NODES
 #define int_p_NULL (int *)NULL
@@ -19,6 +24,41 @@ namespace tuttle {
 namespace host {
 namespace attribute {
 
+namespace {
+
+/// The tiles are kept if at most this ratio of the tiles is populated
+static const double kMaxPopulatedTilesRatio = 0.5;
+
+/**
+ * @brief Write the channels of a normalized color in a pixel.
+ * @param[in] maxValue maximum value of an integer channel, 0 for a float channel
+ */
+template<typename Channel>
+void colorToPixel( const std::vector<double>& channels, const double maxValue, boost::uint8_t* pixel )
+{
+	Channel* dst = reinterpret_cast<Channel*>( pixel );
+	for( std::size_t c = 0; c < channels.size(); ++c )
+	{
+		if( maxValue == 0.0 )
+			dst[c] = static_cast<Channel>( channels[c] );
+		else
+			dst[c] = static_cast<Channel>( std::min( std::max( channels[c], 0.0 ), 1.0 ) * maxValue + 0.5 );
+	}
+}
+
+}
+
+void* Image::PixelDataHook::getPointerProperty( const std::string& name, int index ) const OFX_EXCEPTION_SPEC
+{
+	return _image.getOrientedPixelData( eImageOrientationFromBottomToTop ); // OpenFX standard use BottomToTop
+}
+
+void Image::PixelDataHook::getPointerPropertyN( const std::string& name, void** values, int count ) const OFX_EXCEPTION_SPEC
+{
+	for( int i = 0; i < count; ++i )
+		values[i] = getPointerProperty( name, i );
+}
+
 Image::Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const EImageOrientation orientation, const int rowDistanceBytes )
 	: ofx::imageEffect::OfxhImage( clip, time ) ///< this ctor will set basic props on the image
 	, _memorySize( 0 )
@@ -26,7 +66,11 @@ Image::Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const
 	, _rowAbsDistanceBytes( 0 )
 	, _orientation( orientation )
 	, _fullname( clip.getFullName() )
+	, _pixelDataHook( *this )
 {
+	// the pixels are allocated on the first access
+	setGetHook( kOfxImagePropData, &_pixelDataHook );
+
 	// Set rod in canonical & pixel coord.
 	const double par = clip.getPixelAspectRatio();
 	_bounds.x1 = std::floor(bounds.x1 / par);
@@ -66,19 +110,131 @@ Image::~Image()
 	//TUTTLE_TLOG_VAR( TUTTLE_TRACE, getFullName() );
 }
 
+OfxRGBAColourD Image::getConstantColor() const
+{
+	OfxRGBAColourD color;
+	color.r = getDoubleProperty( kTuttleOfxImagePropConstantColor, 0 );
+	color.g = getDoubleProperty( kTuttleOfxImagePropConstantColor, 1 );
+	color.b = getDoubleProperty( kTuttleOfxImagePropConstantColor, 2 );
+	color.a = getDoubleProperty( kTuttleOfxImagePropConstantColor, 3 );
+	return color;
+}
+
+void Image::allocate()
+{
+	_data = core().getMemoryPool().allocate( getMemorySize() );
+	if( isConstant() )
+		fillConstantColor();
+	else if( _tiles )
+	{
+		_tiles->fill( getBottomRowData(), getOrientedRowDistanceBytes( eImageOrientationFromBottomToTop ) );
+		// don't keep the pixels twice, the plugins use the dense pixels now
+		_tiles.reset();
+		fetchLocalProperty( kTuttleOfxImagePropTileSize ).reset();
+		fetchLocalProperty( kTuttleOfxImagePropTileStates ).reset();
+		fetchLocalProperty( kTuttleOfxImagePropTileData ).reset();
+	}
+}
+
+boost::uint8_t* Image::getBottomRowData()
+{
+	boost::uint8_t* data = reinterpret_cast<boost::uint8_t*>( _data->data() );
+	if( _orientation == eImageOrientationFromBottomToTop )
+		return data;
+	return data + getRowAbsDistanceBytes() * ( _bounds.y2 - _bounds.y1 - 1 );
+}
+
+bool Image::splitInTiles()
+{
+	boost::mutex::scoped_lock lock( _dataMutex );
+	if( ! _data || _tiles || isConstant() )
+		return false;
+
+	const OfxPointI dimensions = { _bounds.x2 - _bounds.x1, _bounds.y2 - _bounds.y1 };
+	boost::scoped_ptr<ImageTiles> tiles( new ImageTiles( getBottomRowData(), getOrientedRowDistanceBytes( eImageOrientationFromBottomToTop ), dimensions, _pixelBytes, kMaxPopulatedTilesRatio ) );
+	if( ! tiles->isValid() )
+		return false;
+
+	TUTTLE_TLOG( TUTTLE_INFO, "[Image] " << getFullName() << ": " << tiles->getNbPopulatedTiles() << " populated tiles on " << tiles->getNbTiles() );
+	_tiles.swap( tiles );
+	setIntProperty( kTuttleOfxImagePropTileSize, _tiles->getTileSize().x, 0 );
+	setIntProperty( kTuttleOfxImagePropTileSize, _tiles->getTileSize().y, 1 );
+	setIntPropertyN( kTuttleOfxImagePropTileStates, &_tiles->getStates()[0], _tiles->getNbTiles() );
+	setPropertyN<ofx::property::OfxhPointerValue>( kTuttleOfxImagePropTileData, _tiles->getNbTiles(), &_tiles->getDatas()[0] );
+	// the dense pixels are rebuilt from the tiles if requested
+	_data.reset();
+	return true;
+}
+
+void Image::fillConstantColor()
+{
+	const OfxRGBAColourD color = getConstantColor();
+	std::vector<double> channels;
+	switch( getComponentsType() )
+	{
+		case ofx::imageEffect::ePixelComponentRGBA:
+			channels.push_back( color.r );
+			channels.push_back( color.g );
+			channels.push_back( color.b );
+			channels.push_back( color.a );
+			break;
+		case ofx::imageEffect::ePixelComponentRGB:
+			channels.push_back( color.r );
+			channels.push_back( color.g );
+			channels.push_back( color.b );
+			break;
+		case ofx::imageEffect::ePixelComponentAlpha:
+			channels.push_back( color.a );
+			break;
+		default:
+			BOOST_THROW_EXCEPTION( exception::Unsupported()
+				<< exception::user() + "Unsupported components type to fill the constant image " + quotes( getFullName() ) + "." );
+	}
+
+	std::vector<boost::uint8_t> pixel( _pixelBytes );
+	switch( getBitDepth() )
+	{
+		case ofx::imageEffect::eBitDepthUByte:
+			colorToPixel<boost::uint8_t>( channels, 255.0, &pixel[0] );
+			break;
+		case ofx::imageEffect::eBitDepthUShort:
+			colorToPixel<boost::uint16_t>( channels, 65535.0, &pixel[0] );
+			break;
+		case ofx::imageEffect::eBitDepthFloat:
+			colorToPixel<float>( channels, 0.0, &pixel[0] );
+			break;
+		default:
+			BOOST_THROW_EXCEPTION( exception::Unsupported()
+				<< exception::user() + "Unsupported bit depth to fill the constant image " + quotes( getFullName() ) + "." );
+	}
+
+	// fill the first row, and copy it to the others
+	const std::size_t width = _bounds.x2 - _bounds.x1;
+	const std::size_t height = _bounds.y2 - _bounds.y1;
+	boost::uint8_t* data = reinterpret_cast<boost::uint8_t*>( _data->data() );
+	for( std::size_t x = 0; x < width; ++x )
+		std::memcpy( data + x * _pixelBytes, &pixel[0], _pixelBytes );
+	for( std::size_t y = 1; y < height; ++y )
+		std::memcpy( data + y * getRowAbsDistanceBytes(), data, width * _pixelBytes );
+}
+
 boost::uint8_t* Image::getPixelData()
 {
+	// the pixels may be requested by several threads of a plugin
+	boost::mutex::scoped_lock lock( _dataMutex );
+	if( ! _data )
+		allocate();
 	return reinterpret_cast<boost::uint8_t*>( _data->data() );
 }
 
 void* Image::getVoidPixelData()
 {
-	return reinterpret_cast<void*>( _data->data() );
+	return reinterpret_cast<void*>( getPixelData() );
 }
 
 char* Image::getCharPixelData()
 {
-	return reinterpret_cast<char*>( _data->data() );
+	return reinterpret_cast<char*>( getPixelData() );
 }
 
 boost::uint8_t* Image::getOrientedPixelData( const EImageOrientation orientation )
@@ -2,8 +2,11 @@
 #define TUTTLE_HOST_CORE_IMAGE_HPP
 
 #include <tuttle/host/ofx/OfxhImage.hpp>
+#include <tuttle/host/ofx/property/OfxhGetHook.hpp>
 #include <tuttle/common/ofx/imageEffect.hpp>
 
+#include <ofxPixels.h>
+
 #include <tuttle/host/memory/IMemoryPool.hpp>
 
 /// @tuttle: remove include dependencies to gil
@@ -12,15 +15,29 @@
 #include <boost/gil/image_view_factory.hpp>
 
 #include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 
 namespace tuttle {
 namespace host {
 namespace attribute {
 
 class ClipImage;
+class ImageTiles;
 
 /**
  * make an image up
+ *
+ * The pixels are only allocated when the pixel data is requested, by the host
+ * or by a plugin (kOfxImagePropData). An image set as constant by a plugin
+ * (kTuttleOfxImagePropConstant) is filled with its color at this moment, so
+ * plugins which handle constant images never allocate it.
+ *
+ * The pixels of an image which is mostly empty or constant (like a matte)
+ * can be split in tiles (splitInTiles), only the populated tiles keep their
+ * pixels. The tiles are given to the plugins by the image properties
+ * (kTuttleOfxImagePropTileStates), the dense pixels are rebuilt from the
+ * tiles on the first access to the pixel data and the tiles are released.
  */
 class Image : public tuttle::host::ofx::imageEffect::OfxhImage
 {
@@ -39,6 +56,26 @@ protected:
 	EImageOrientation _orientation;
 	std::string _fullname;
 	memory::IPoolDataPtr _data; ///< where we are keeping our image data
+	boost::mutex _dataMutex; ///< Mutex for the allocation of the data.
+	boost::scoped_ptr<ImageTiles> _tiles; ///< pixels of a tiled image
+
+private:
+	/**
+	 * @brief Hook on kOfxImagePropData, to allocate the pixels on the first access.
+	 */
+	class PixelDataHook : public ofx::property::OfxhGetHook
+	{
+	public:
+		explicit PixelDataHook( Image& image ) : _image( image ) {}
+
+		void* getPointerProperty( const std::string& name, int index = 0 ) const OFX_EXCEPTION_SPEC;
+		void getPointerPropertyN( const std::string& name, void** values, int count ) const OFX_EXCEPTION_SPEC;
+		size_t getDimension( const std::string& name ) const OFX_EXCEPTION_SPEC { return 1; }
+
+	private:
+		Image& _image;
+	};
+	PixelDataHook _pixelDataHook;
 
 public:
 	Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const EImageOrientation orientation, const int rowDistanceBytes );
@@ -47,10 +84,26 @@ public:
 #ifndef SWIG
 	void setPoolData( const memory::IPoolDataPtr& pData )
 	{
+		boost::mutex::scoped_lock lock( _dataMutex );
 		_data = pData;
-		setPointerProperty( kOfxImagePropData, getOrientedPixelData( eImageOrientationFromBottomToTop ) ); // OpenFX standard use BottomToTop
 	}
 #endif
+	/**
+	 * @brief All the pixels have the same value, given by getConstantColor().
+	 */
+	bool isConstant() const { return getIntProperty( kTuttleOfxImagePropConstant ) != 0; }
+	/**
+	 * @brief Normalized color of a constant image.
+	 */
+	OfxRGBAColourD getConstantColor() const;
+
+	/**
+	 * @brief Split the pixels in tiles and release the dense pixels, if the
+	 *        image is mostly empty or constant.
+	 * @return the image is tiled
+	 */
+	bool splitInTiles();
+	bool isTiled() const { return _tiles.get() != NULL; }
 	
 	std::string getFullName() const { return _fullname; }
 
@@ -116,6 +169,17 @@ private:
 	template < class D_VIEW, class S_VIEW >
 	static void copy( D_VIEW& dst, S_VIEW& src, const OfxPointI& dstCorner,
 	                  const OfxPointI& srcCorner, const OfxPointI& count );
+
+	/**
+	 * @brief Allocate the pixels, filled with the color if the image is constant
+	 *        or with the tiles if the image is tiled.
+	 * @pre _dataMutex is locked
+	 */
+	void allocate();
+	/// First pixel of the bottom row of the allocated data
+	boost::uint8_t* getBottomRowData();
+	/// Color clamped and rounded to the nearest value for the integer channels (see constantColorToPixel)
+	void fillConstantColor();
 };
 
 
@@ -0,0 +1,137 @@
+#include "ImageTiles.hpp"
+
+#include <tuttle/host/Core.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tuttle {
+namespace host {
+namespace attribute {
+
+ImageTiles::ImageTiles( const boost::uint8_t* data, const int rowDistanceBytes, const OfxPointI& dimensions, const std::size_t pixelBytes, const double maxPopulatedRatio )
+	: _dimensions( dimensions )
+	, _pixelBytes( pixelBytes )
+	, _nbPopulated( 0 )
+	, _valid( false )
+{
+	_nbTiles.x = ( dimensions.x + kTileSize - 1 ) / kTileSize;
+	_nbTiles.y = ( dimensions.y + kTileSize - 1 ) / kTileSize;
+	const std::size_t nbTiles = _nbTiles.x * _nbTiles.y;
+	if( nbTiles == 0 )
+		return;
+
+	// first pass: only read the pixels, to not allocate the tiles of a dense image
+	_states.resize( nbTiles );
+	_constantPixels.resize( nbTiles * _pixelBytes );
+	for( std::size_t tile = 0; tile < nbTiles; ++tile )
+	{
+		const OfxRectI rect = getTileRect( tile );
+		_states[tile] = detectState( data, rowDistanceBytes, rect );
+		if( _states[tile] == eTilePopulated )
+			++_nbPopulated;
+		else
+			std::memcpy( &_constantPixels[tile * _pixelBytes], data + rect.y1 * rowDistanceBytes + rect.x1 * _pixelBytes, _pixelBytes );
+	}
+	if( _nbPopulated > maxPopulatedRatio * nbTiles )
+	{
+		_states.clear();
+		_constantPixels.clear();
+		return;
+	}
+
+	const std::size_t tileRowBytes = kTileSize * _pixelBytes;
+	const std::size_t tileBytes = tileRowBytes * kTileSize;
+	if( _nbPopulated )
+		_populatedData = core().getMemoryPool().allocate( _nbPopulated * tileBytes );
+
+	_tileData.resize( nbTiles, NULL );
+	char* populated = _populatedData ? _populatedData->data() : NULL;
+	for( std::size_t tile = 0; tile < nbTiles; ++tile )
+	{
+		switch( _states[tile] )
+		{
+			case eTileEmpty:
+				break;
+			case eTileConstant:
+				_tileData[tile] = &_constantPixels[tile * _pixelBytes];
+				break;
+			case eTilePopulated:
+			{
+				const OfxRectI rect = getTileRect( tile );
+				const std::size_t rowBytes = ( rect.x2 - rect.x1 ) * _pixelBytes;
+				for( int y = rect.y1; y < rect.y2; ++y )
+					std::memcpy( populated + ( y - rect.y1 ) * tileRowBytes, data + y * rowDistanceBytes + rect.x1 * _pixelBytes, rowBytes );
+				_tileData[tile] = populated;
+				populated += tileBytes;
+				break;
+			}
+		}
+	}
+	_valid = true;
+}
+
+OfxRectI ImageTiles::getTileRect( const std::size_t tile ) const
+{
+	OfxRectI rect;
+	rect.x1 = ( tile % _nbTiles.x ) * kTileSize;
+	rect.y1 = ( tile / _nbTiles.x ) * kTileSize;
+	rect.x2 = std::min( rect.x1 + kTileSize, _dimensions.x );
+	rect.y2 = std::min( rect.y1 + kTileSize, _dimensions.y );
+	return rect;
+}
+
+ImageTiles::ETileState ImageTiles::detectState( const boost::uint8_t* data, const int rowDistanceBytes, const OfxRectI& rect ) const
+{
+	const boost::uint8_t* first = data + rect.y1 * rowDistanceBytes + rect.x1 * _pixelBytes;
+	bool empty = true;
+	for( std::size_t b = 0; b < _pixelBytes; ++b )
+		empty = empty && first[b] == 0;
+
+	for( int y = rect.y1; y < rect.y2; ++y )
+	{
+		const boost::uint8_t* pixel = data + y * rowDistanceBytes + rect.x1 * _pixelBytes;
+		for( int x = rect.x1; x < rect.x2; ++x, pixel += _pixelBytes )
+		{
+			if( std::memcmp( pixel, first, _pixelBytes ) != 0 )
+				return eTilePopulated;
+		}
+	}
+	return empty ? eTileEmpty : eTileConstant;
+}
+
+void ImageTiles::fill( boost::uint8_t* data, const int rowDistanceBytes ) const
+{
+	const std::size_t tileRowBytes = kTileSize * _pixelBytes;
+	for( std::size_t tile = 0; tile < _states.size(); ++tile )
+	{
+		const OfxRectI rect = getTileRect( tile );
+		const std::size_t rowBytes = ( rect.x2 - rect.x1 ) * _pixelBytes;
+		boost::uint8_t* firstRow = data + rect.y1 * rowDistanceBytes + rect.x1 * _pixelBytes;
+		switch( _states[tile] )
+		{
+			case eTileEmpty:
+				for( int y = rect.y1; y < rect.y2; ++y )
+					std::memset( data + y * rowDistanceBytes + rect.x1 * _pixelBytes, 0, rowBytes );
+				break;
+			case eTileConstant:
+				// fill the first row, and copy it to the others
+				for( int x = rect.x1; x < rect.x2; ++x )
+					std::memcpy( firstRow + ( x - rect.x1 ) * _pixelBytes, &_constantPixels[tile * _pixelBytes], _pixelBytes );
+				for( int y = rect.y1 + 1; y < rect.y2; ++y )
+					std::memcpy( data + y * rowDistanceBytes + rect.x1 * _pixelBytes, firstRow, rowBytes );
+				break;
+			case eTilePopulated:
+			{
+				const boost::uint8_t* tileData = static_cast<const boost::uint8_t*>( _tileData[tile] );
+				for( int y = rect.y1; y < rect.y2; ++y )
+					std::memcpy( data + y * rowDistanceBytes + rect.x1 * _pixelBytes, tileData + ( y - rect.y1 ) * tileRowBytes, rowBytes );
+				break;
+			}
+		}
+	}
+}
+
+}
+}
+}
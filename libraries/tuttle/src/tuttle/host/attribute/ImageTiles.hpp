@@ -0,0 +1,93 @@
+#ifndef _TUTTLE_HOST_CORE_IMAGETILES_HPP_
+#define _TUTTLE_HOST_CORE_IMAGETILES_HPP_
+
+#include <tuttle/host/memory/IMemoryPool.hpp>
+
+#include <ofxCore.h>
+#include <extensions/tuttle/ofxImage.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+namespace host {
+namespace attribute {
+
+/**
+ * @brief Pixels of an image split in fixed-size tiles, where the empty and
+ *        constant tiles only keep one pixel.
+ *
+ * The tiles are ordered by rows from the bottom of the image (OpenFX
+ * orientation). The pixels of all the populated tiles are in one block of
+ * the memory pool, with a row size of the tile width.
+ */
+class ImageTiles : boost::noncopyable
+{
+public:
+	enum ETileState
+	{
+		eTileEmpty = kTuttleOfxImageTileEmpty, ///< all the bytes are zero
+		eTileConstant = kTuttleOfxImageTileConstant, ///< all the pixels are the same
+		eTilePopulated = kTuttleOfxImageTilePopulated
+	};
+
+	static const int kTileSize = 64;
+
+	/**
+	 * @brief Split dense pixels in tiles, only if the tiles use less than
+	 *        maxPopulatedRatio of the memory of the dense pixels.
+	 * @param[in] data first pixel of the bottom row
+	 * @param[in] rowDistanceBytes distance from a row to the row above (may be negative)
+	 * @see isValid()
+	 */
+	ImageTiles( const boost::uint8_t* data, const int rowDistanceBytes, const OfxPointI& dimensions, const std::size_t pixelBytes, const double maxPopulatedRatio );
+
+	/**
+	 * @brief The image was split in tiles.
+	 */
+	bool isValid() const { return _valid; }
+
+	OfxPointI getTileSize() const { OfxPointI size = { kTileSize, kTileSize }; return size; }
+	std::size_t getNbTiles() const { return _states.size(); }
+	std::size_t getNbPopulatedTiles() const { return _nbPopulated; }
+
+	ETileState getState( const std::size_t tile ) const { return static_cast<ETileState>( _states[tile] ); }
+	const std::vector<int>& getStates() const { return _states; }
+	/**
+	 * @brief Pixels of a populated tile, pixel of a constant tile, NULL for an empty tile.
+	 */
+	void* getData( const std::size_t tile ) { return _tileData[tile]; }
+	const std::vector<void*>& getDatas() const { return _tileData; }
+
+	/**
+	 * @brief Write all the pixels of the tiles in dense pixels.
+	 * @param[out] data first pixel of the bottom row
+	 * @param[in] rowDistanceBytes distance from a row to the row above (may be negative)
+	 */
+	void fill( boost::uint8_t* data, const int rowDistanceBytes ) const;
+
+private:
+	/// Pixels of a tile in the dense pixels (x1, y1, x2, y2)
+	OfxRectI getTileRect( const std::size_t tile ) const;
+	ETileState detectState( const boost::uint8_t* data, const int rowDistanceBytes, const OfxRectI& rect ) const;
+
+private:
+	OfxPointI _dimensions;
+	std::size_t _pixelBytes;
+	OfxPointI _nbTiles; ///< number of columns and rows of tiles
+	std::size_t _nbPopulated;
+	bool _valid;
+	std::vector<int> _states;
+	std::vector<void*> _tileData;
+	std::vector<boost::uint8_t> _constantPixels; ///< one pixel for each tile
+	memory::IPoolDataPtr _populatedData; ///< pixels of the populated tiles
+};
+
+}
+}
+}
+
+#endif
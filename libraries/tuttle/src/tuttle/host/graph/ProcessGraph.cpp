@@ -2,6 +2,7 @@
 #include "ProcessVisitors.hpp"
 #include <tuttle/common/utils/color.hpp>
 #include <tuttle/host/graph/GraphExporter.hpp>
+#include <tuttle/host/attribute/ClipImage.hpp>
 
 #include <boost/foreach.hpp>
 
@@ -161,6 +162,8 @@ void ProcessGraph::bakeGraphInformationToNodes( InternalGraphAtTimeImpl& _render
 
 		vData._outEdges.clear();
 		vData._outEdges.reserve( vData._outDegree );
+		// the output is only kept in tiles if all the clips using it read tiled images
+		vData._sparseOutput = ! vData._isFinalNode && vData._outDegree > 0;
 		BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getInEdges( vd ) )
 		{
 			const ProcessEdgeAtTime* e = &_renderGraphAtTime.instance(ed);
@@ -170,6 +173,10 @@ void ProcessGraph::bakeGraphInformationToNodes( InternalGraphAtTimeImpl& _render
 			
 			TUTTLE_TLOG( TUTTLE_INFO, "[bake graph information to nodes] in edge " << e->getInAttrName() << ", at time " << e->getInTime() );
 			vData._outEdges.push_back( e );
+
+			if( v.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect ||
+			    ! v.getProcessNode().getClip( e->getInAttrName() ).supportsSparseInput() )
+				vData._sparseOutput = false;
 		}
 		vData._inEdges.clear();
 		BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getOutEdges( vd ) )
@@ -184,6 +191,49 @@ void ProcessGraph::bakeGraphInformationToNodes( InternalGraphAtTimeImpl& _render
 
 }
 
+/**
+ * @brief The time invariant nodes already rendered with the same RoI reuse their output.
+ * Their input connections are removed, so the whole time invariant subgraph
+ * is processed only once per compute.
+ */
+void ProcessGraph::reuseTimeInvariantOutputs( const OfxTime time )
+{
+	std::vector<InternalGraphAtTimeImpl::edge_descriptor> toRemove;
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices() )
+	{
+		VertexAtTime& v = _renderGraphAtTime.instance( vd );
+		if( v.isFake() || ! v.getProcessData()._isTimeInvariant )
+			continue;
+
+		TimeInvariantOutputMap::const_iterator it = _timeInvariantOutputs.find( v._clipName );
+		if( it == _timeInvariantOutputs.end() )
+			continue;
+
+		ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+		const OfxRectD& roi = vData._apiImageEffect._renderRoI;
+		const OfxRectD& reusedRoi = it->second._renderRoI;
+		if( roi.x1 != reusedRoi.x1 || roi.y1 != reusedRoi.y1 ||
+		    roi.x2 != reusedRoi.x2 || roi.y2 != reusedRoi.y2 )
+			continue;
+
+		TUTTLE_TLOG( TUTTLE_INFO, "[Setup at time " << time << "] reuse time invariant output of " << quotes(v.getName()) );
+		vData._reuseOutput = true;
+		BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getOutEdges( vd ) )
+		{
+			toRemove.push_back( ed );
+		}
+	}
+	if( toRemove.empty() )
+		return;
+
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::edge_descriptor ed, toRemove )
+	{
+		_renderGraphAtTime.removeEdge( ed );
+	}
+	// Bake graph information again as the connections have changed.
+	bakeGraphInformationToNodes( _renderGraphAtTime );
+}
+
 void ProcessGraph::beginSequence( const TimeRange& timeRange )
 {
 	_options.beginSequenceHandle();
@@ -299,6 +349,12 @@ void ProcessGraph::setup()
 		graph::visitor::TimeDomain<InternalGraphImpl> timeDomainPropagationVisitor( _renderGraph );
 		_renderGraph.depthFirstVisit( timeDomainPropagationVisitor, _renderGraph.getVertexDescriptor( _outputId ) );
 	}
+
+	{
+		TUTTLE_TLOG( TUTTLE_INFO, "[Process render] Time invariance propagation" );
+		graph::visitor::TimeInvariance<InternalGraphImpl> timeInvarianceVisitor( _renderGraph );
+		_renderGraph.depthFirstVisit( timeInvarianceVisitor, _renderGraph.getVertexDescriptor( _outputId ) );
+	}
 }
 
 std::list<TimeRange> ProcessGraph::computeTimeRange()
@@ -463,6 +519,12 @@ void ProcessGraph::setupAtTime( const OfxTime time )
 		_renderGraphAtTime.depthFirstVisit( preProcess2Visitor, outputAtTime );
 	}
 
+	if( ! _timeInvariantOutputs.empty() )
+	{
+		TUTTLE_TLOG( TUTTLE_INFO, "[Setup at time " << time << "] reuse time invariant outputs" );
+		reuseTimeInvariantOutputs( time );
+	}
+
 #ifdef TUTTLE_EXPORT_PROCESSGRAPH_DOT
 	graph::exportDebugAsDOT( "graphProcessAtTime_c.dot", _renderGraphAtTime );
 #endif
@@ -543,7 +605,6 @@ void ProcessGraph::processAtTime( memory::MemoryCache& outCache, const OfxTime t
 	boost::timer::cpu_timer timer;
 #endif
 	
-	///@todo callback
 	TUTTLE_TLOG( TUTTLE_INFO, common::Color::get()->_blue << "process at time " << time << common::Color::get()->_std );
 	TUTTLE_TLOG( TUTTLE_INFO, "[Process at time " << time << "] output node : " << _renderGraph.getVertex( _outputId ).getName() );
 
@@ -557,6 +618,7 @@ void ProcessGraph::processAtTime( memory::MemoryCache& outCache, const OfxTime t
 		// accumulate output nodes buffers into the @p outCache MemoryCache
 		processVisitor.setOutputMemoryCache( outCache );
 	}
+	processVisitor.setTimeInvariantOutputs( _timeInvariantOutputs );
 
 	_renderGraphAtTime.depthFirstVisit( processVisitor, outputAtTime );
 
@@ -595,6 +657,7 @@ bool ProcessGraph::process( memory::MemoryCache& outCache )
 #endif
 	
 	setup();
+	_timeInvariantOutputs.clear();
 	
 	TUTTLE_TLOG_INFOS;
 	std::list<TimeRange> timeRanges = computeTimeRange();
@@ -622,6 +685,7 @@ bool ProcessGraph::process( memory::MemoryCache& outCache )
 			{
 				TUTTLE_LOG_ERROR( "[Process render] PROCESS ABORTED at time " << time << "." );
 				endSequence();
+				_timeInvariantOutputs.clear();
 				core().getMemoryCache().clearUnused();
 				return false;
 			}
@@ -643,6 +707,7 @@ bool ProcessGraph::process( memory::MemoryCache& outCache )
 #ifdef TUTTLE_EXPORT_WITH_TIMER
 				TUTTLE_LOG_WARNING( "[process timer] took " << boost::timer::format(processAtTime_timer.elapsed()) );
 #endif
+				_options.outputCallback( time, true );
 			}
 			catch( tuttle::exception::FileInSequenceNotExist& e ) // @todo tuttle: change that.
 			{
@@ -652,11 +717,13 @@ bool ProcessGraph::process( memory::MemoryCache& outCache )
 		#ifndef TUTTLE_PRODUCTION
 					TUTTLE_LOG_ERROR( boost::diagnostic_information(e) );
 		#endif
+					_options.outputCallback( time, false );
 				}
 				else
 				{
 					TUTTLE_TLOG( TUTTLE_ERROR, "[Process render] Undefined input at time " << time << "." );
 					endSequence();
+					_timeInvariantOutputs.clear();
 					core().getMemoryCache().clearUnused();
 					throw;
 				}
@@ -670,11 +737,13 @@ bool ProcessGraph::process( memory::MemoryCache& outCache )
 					TUTTLE_LOG_ERROR( "Skip frame " << time << "." );
 					TUTTLE_LOG_ERROR( boost::current_exception_diagnostic_information() );
 		#endif
+					_options.outputCallback( time, false );
 				}
 				else
 				{
 					TUTTLE_TLOG( TUTTLE_ERROR, "[Process render] Skip frame " << time << "." );
 					endSequence();
+					_timeInvariantOutputs.clear();
 					core().getMemoryCache().clearUnused();
 					throw;
 				}
@@ -683,6 +752,7 @@ bool ProcessGraph::process( memory::MemoryCache& outCache )
 		
 		endSequence();
 	}
+	_timeInvariantOutputs.clear();
 	
 #ifdef TUTTLE_EXPORT_WITH_TIMER
 	TUTTLE_LOG_WARNING( "[all process timer] " << boost::timer::format(all_process_timer.elapsed()) );
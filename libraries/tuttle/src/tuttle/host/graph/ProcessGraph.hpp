@@ -58,6 +58,7 @@ private:
 	
 	void relink();
 	void bakeGraphInformationToNodes( InternalGraphAtTimeImpl& renderGraphAtTime );
+	void reuseTimeInvariantOutputs( const OfxTime time );
 
 public:
 	void updateGraph( Graph& userGraph, const std::list<std::string>& outputNodes );
@@ -83,6 +84,8 @@ private:
 	
 	const ComputeOptions& _options;
 	ProcessVertexData _procOptions;
+
+	TimeInvariantOutputMap _timeInvariantOutputs; ///< outputs of the time invariant nodes read at each frame, kept during the process
 };
 
 }
@@ -25,6 +25,8 @@ std::ostream& operator<<( std::ostream& os, const ProcessVertexAtTimeData& vData
 
 	os << "out degree:" << vData._outDegree << std::endl;
 	os << "in degree:" << vData._inDegree << std::endl;
+	os << "reuse output:" << vData._reuseOutput << std::endl;
+	os << "sparse output:" << vData._sparseOutput << std::endl;
 
 	os << "__________" << std::endl;
 	os << "localInfos:" << std::endl << vData._localInfos;
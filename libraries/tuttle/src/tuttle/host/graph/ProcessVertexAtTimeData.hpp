@@ -3,9 +3,11 @@
 
 #include "ProcessVertexData.hpp"
 
+#include <tuttle/host/memory/IMemoryCache.hpp>
 #include <tuttle/host/ofx/attribute/OfxhClipImage.hpp>
 #include <tuttle/host/ofx/OfxhCore.hpp>
 
+#include <map>
 #include <string>
 
 namespace tuttle {
@@ -49,6 +51,8 @@ public:
 		, _isFinalNode( false )
 		, _outDegree( 0 )
 		, _inDegree( 0 )
+		, _reuseOutput( false )
+		, _sparseOutput( false )
 	{
 		_localInfos._nodes = 1; // local infos can contain only 1 node by definition...
 	}
@@ -59,6 +63,8 @@ public:
 		, _isFinalNode( false )
 		, _outDegree( 0 )
 		, _inDegree( 0 )
+		, _reuseOutput( false )
+		, _sparseOutput( false )
 	{
 		_localInfos._nodes = 1; // local infos can contain only 1 node by definition...
 	}
@@ -78,6 +84,8 @@ public:
 		_isFinalNode = v._isFinalNode;
 		_outDegree = v._outDegree;
 		_inDegree = v._inDegree;
+		_reuseOutput = v._reuseOutput;
+		_sparseOutput = v._sparseOutput;
 		_localInfos = v._localInfos;
 		_inputsInfos = v._inputsInfos;
 		_globalInfos = v._globalInfos;
@@ -112,6 +120,9 @@ public:
 	std::size_t _outDegree; ///< number of connected input clips
 	std::size_t _inDegree; ///< number of nodes using the output of this node
 
+	bool _reuseOutput; ///< the output of a time invariant node is reused from a previous frame, the node is not processed
+	bool _sparseOutput; ///< all the nodes using the output read tiled images, so the output can be kept in tiles
+
 	ProcessVertexAtTimeInfo _localInfos;
 	ProcessVertexAtTimeInfo _inputsInfos;
 	ProcessVertexAtTimeInfo _globalInfos;
@@ -135,6 +146,17 @@ public:
 
 };
 
+/**
+ * @brief Output of a time invariant node, reused by the next frames of a compute.
+ */
+struct TimeInvariantOutput
+{
+	memory::CACHE_ELEMENT _image;
+	OfxRectD _renderRoI; ///< the output is reused only for the same RoI
+};
+
+typedef std::map<std::string, TimeInvariantOutput> TimeInvariantOutputMap; ///< by node name
+
 }
 }
 }
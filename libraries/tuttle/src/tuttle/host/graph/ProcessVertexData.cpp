@@ -18,6 +18,8 @@ std::ostream& operator<<( std::ostream& os, const ProcessVertexData& vData )
 
 	os << "out degree:" << vData._outDegree << std::endl;
 	os << "in degree:" << vData._inDegree << std::endl;
+	os << "time invariant:" << vData._isTimeInvariant << std::endl;
+	os << "time invariant frontier:" << vData._isTimeInvariantFrontier << std::endl;
 
 	return os;
 }
@@ -22,6 +22,8 @@ public:
 		, _interactive( 0 )
 		, _outDegree( 0 )
 		, _inDegree( 0 )
+		, _isTimeInvariant( false )
+		, _isTimeInvariantFrontier( false )
 	{
 		_timeDomain.min = kOfxFlagInfiniteMin;
 		_timeDomain.max = kOfxFlagInfiniteMax;
@@ -58,6 +60,9 @@ public:
 	std::size_t _outDegree; ///< number of connected input clips
 	std::size_t _inDegree; ///< number of nodes using the output of this node
 
+	bool _isTimeInvariant; ///< the node and all its inputs render the same image at all times
+	bool _isTimeInvariantFrontier; ///< time invariant output used by a node which is not time invariant, or final node
+
 	///@brief All time dependant datas.
 	///@{
 	typedef std::set<OfxTime> TimesSet;
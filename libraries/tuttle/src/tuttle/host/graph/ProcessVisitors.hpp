@@ -2,7 +2,9 @@
 #define _TUTTLE_HOST_PROCESSVISITORS_HPP_
 
 #include "ProcessVertexData.hpp"
+#include "ProcessVertexAtTimeData.hpp"
 
+#include <tuttle/host/attribute/Image.hpp>
 #include <tuttle/host/memory/MemoryCache.hpp>
 
 #include <boost/graph/properties.hpp>
@@ -157,6 +159,67 @@ private:
 	TGraph& _graph;
 };
 
+/**
+ * @brief A node is time invariant if it renders the same image at all times
+ *        and all its inputs are time invariant.
+ */
+template<class TGraph>
+class TimeInvariance : public boost::default_dfs_visitor
+{
+public:
+	typedef typename TGraph::GraphContainer GraphContainer;
+	typedef typename TGraph::Vertex Vertex;
+
+	TimeInvariance( TGraph& graph )
+		: _graph( graph )
+	{}
+
+	template<class VertexDescriptor, class Graph>
+	void finish_vertex( VertexDescriptor vd, Graph& g )
+	{
+		Vertex& vertex = _graph.instance( vd );
+
+		TUTTLE_TLOG( TUTTLE_TRACE, "[Time Invariance] finish vertex " << vertex );
+		if( vertex.isFake() )
+		{
+			// the final nodes
+			markFrontierInputs( vd, false );
+			return;
+		}
+
+		// the inputs are already visited
+		bool isTimeInvariant = vertex.getProcessNode().isTimeInvariant();
+		BOOST_FOREACH( const typename TGraph::edge_descriptor ed, _graph.getOutEdges( vd ) )
+		{
+			const Vertex& input = _graph.targetInstance( ed );
+			if( ! input.isFake() && ! input.getProcessData()._isTimeInvariant )
+				isTimeInvariant = false;
+		}
+		vertex.getProcessData()._isTimeInvariant = isTimeInvariant;
+		// set by the nodes using this output, which are visited after
+		vertex.getProcessData()._isTimeInvariantFrontier = false;
+		markFrontierInputs( vd, isTimeInvariant );
+		TUTTLE_TLOG( TUTTLE_TRACE, "[Time Invariance] " << quotes(vertex.getName()) << ": " << isTimeInvariant );
+	}
+
+private:
+	/// The time invariant inputs of a node which is not time invariant are read at each frame.
+	void markFrontierInputs( const typename TGraph::vertex_descriptor vd, const bool isTimeInvariant )
+	{
+		if( isTimeInvariant )
+			return;
+		BOOST_FOREACH( const typename TGraph::edge_descriptor ed, _graph.getOutEdges( vd ) )
+		{
+			Vertex& input = _graph.targetInstance( ed );
+			if( ! input.isFake() && input.getProcessData()._isTimeInvariant )
+				input.getProcessData()._isTimeInvariantFrontier = true;
+		}
+	}
+
+private:
+	TGraph& _graph;
+};
+
 template<class TGraph>
 class ComputeHashAtTime : public boost::default_dfs_visitor
 {
@@ -650,6 +713,7 @@ public:
 		: _graph( graph )
 		, _cache( cache )
 		, _result( NULL )
+		, _timeInvariantOutputs( NULL )
 	{
 	}
 	
@@ -657,6 +721,7 @@ public:
 		: _graph( graph )
 		, _cache( cache )
 		, _result( &result )
+		, _timeInvariantOutputs( NULL )
 	{
 	}
 	
@@ -668,6 +733,15 @@ public:
 		_result = &result;
 	}
 
+	/**
+	 * Set the outputs of the time invariant nodes: the outputs marked as reused
+	 * are taken from there, and the new outputs are stored there.
+	 */
+	void setTimeInvariantOutputs( TimeInvariantOutputMap& outputs )
+	{
+		_timeInvariantOutputs = &outputs;
+	}
+
 	template<class VertexDescriptor, class Graph>
 	void finish_vertex( VertexDescriptor v, Graph& g )
 	{
@@ -681,17 +755,46 @@ public:
 
 		// check if abort ?
 
-		// launch the process
-		boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
-		vertex.getProcessNode().process( vertex.getProcessDataAtTime() );
-		boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
-		_cumulativeTime += t2 - t1;
-		
-		TUTTLE_TLOG( TUTTLE_TRACE, "[Process] " << quotes(vertex._name) << " " << vertex._data._time << " took: " << t2 - t1 << " (cumul: " << _cumulativeTime << ")" << vertex );
+		ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+		const std::string outputIdentifier = vertex._clipName + "." kOfxOutputAttributeName;
+		if( vData._reuseOutput )
+		{
+			// the output rendered at a previous frame, declared at this time for the next nodes
+			memory::CACHE_ELEMENT img = _timeInvariantOutputs->find( vertex._clipName )->second._image;
+			_cache.put( outputIdentifier, vData._time, img );
+			if( vData._outDegree > 0 )
+			{
+				img->addReference( ofx::imageEffect::OfxhImage::eReferenceOwnerHost, vData._outDegree );
+			}
+			TUTTLE_TLOG( TUTTLE_TRACE, "[Process] " << quotes(vertex._name) << " " << vertex._data._time << " reuse time invariant output" );
+		}
+		else
+		{
+			// launch the process
+			boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
+			vertex.getProcessNode().process( vData );
+			boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
+			_cumulativeTime += t2 - t1;
+
+			TUTTLE_TLOG( TUTTLE_TRACE, "[Process] " << quotes(vertex._name) << " " << vertex._data._time << " took: " << t2 - t1 << " (cumul: " << _cumulativeTime << ")" << vertex );
+
+			// only the outputs read by the next frames are kept, the outputs inside
+			// of a time invariant subgraph are released after their use at this frame
+			if( _timeInvariantOutputs && vData._nodeData->_isTimeInvariantFrontier )
+			{
+				memory::CACHE_ELEMENT img = _cache.get( outputIdentifier, vData._time );
+				if( img.get() )
+				{
+					TimeInvariantOutput& output = (*_timeInvariantOutputs)[vertex._clipName];
+					output._image = img;
+					output._renderRoI = vData._apiImageEffect._renderRoI;
+				}
+			}
+		}
 		
-		if( _result && vertex.getProcessDataAtTime()._isFinalNode )
+		if( _result && vData._isFinalNode )
 		{
-			memory::CACHE_ELEMENT img = _cache.get( vertex._clipName + "." kOfxOutputAttributeName, vertex._data._time );
+			memory::CACHE_ELEMENT img = _cache.get( outputIdentifier, vertex._data._time );
 			if( ! img.get() )
 			{
 				BOOST_THROW_EXCEPTION( exception::Logic()
@@ -707,6 +810,7 @@ private:
 	TGraph& _graph;
 	memory::IMemoryCache& _cache;
 	memory::IMemoryCache* _result;
+	TimeInvariantOutputMap* _timeInvariantOutputs;
 	boost::posix_time::time_duration _cumulativeTime;
 };
 
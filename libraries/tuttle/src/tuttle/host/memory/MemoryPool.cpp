@@ -102,6 +102,11 @@ void MemoryPool::referenced( PoolData* pData )
 	{
 		_dataUnused.erase( it );
 	}
+	else if( _dataUsed.find( pData ) != _dataUsed.end() )
+	{
+		// reused data, already reserved by allocate
+		return;
+	}
 	else // a really new data
 	{
 		_allDatas.push_back( pData );
@@ -162,13 +167,17 @@ boost::intrusive_ptr<IPoolData> MemoryPool::allocate( const std::size_t size )
 		boost::mutex::scoped_lock locker( _mutex );
 		// checking within unused data
 		pData = std::for_each( _dataUnused.begin(), _dataUnused.end(), DataFitSize( size ) ).bestMatch();
+		if( pData != NULL )
+		{
+			// reserved before being referenced, so another thread can't reuse it
+			_dataUnused.erase( pData );
+			_dataUsed.insert( pData );
+			pData->_size = size;
+		}
 	}
 
 	if( pData != NULL )
-	{
-		pData->_size = size;
 		return pData;
-	}
 
 	const std::size_t availableSize = getAvailableMemorySize();
 	if( size > availableSize )
@@ -56,6 +56,11 @@ static property::OfxhPropSpec imageStuffs[] = {
 	{ kOfxImagePropRowBytes, property::ePropTypeInt, 1, true, "0", },
 	{ kOfxImagePropField, property::ePropTypeString, 1, true, "", },
 	{ kOfxImagePropUniqueIdentifier, property::ePropTypeString, 1, true, "" },
+	{ kTuttleOfxImagePropConstant, property::ePropTypeInt, 1, false, "0" },
+	{ kTuttleOfxImagePropConstantColor, property::ePropTypeDouble, 4, false, "0" },
+	{ kTuttleOfxImagePropTileSize, property::ePropTypeInt, 2, true, "0" },
+	{ kTuttleOfxImagePropTileStates, property::ePropTypeInt, 0, true, "0" },
+	{ kTuttleOfxImagePropTileData, property::ePropTypePointer, 0, true, NULL },
 	{ 0 }
 };
 
@@ -143,6 +143,15 @@ bool OfxhImageEffectNodeBase::supportsTiles() const
 	return _properties.getIntProperty( kOfxImageEffectPropSupportsTiles ) != 0;
 }
 
+/// are the output images mostly empty or constant
+
+bool OfxhImageEffectNodeBase::hasSparseOutput() const
+{
+	// not in the descriptors loaded from an older plugin cache
+	return _properties.hasProperty( kTuttleOfxImageEffectPropSparseOutput ) &&
+	       _properties.getIntProperty( kTuttleOfxImageEffectPropSparseOutput ) != 0;
+}
+
 /// does this effect need random temporal access
 
 bool OfxhImageEffectNodeBase::temporalAccess() const
@@ -89,6 +89,9 @@ public:
 	/// does the effect support tiled rendering
 	bool supportsTiles() const;
 
+	/// are the output images mostly empty or constant
+	bool hasSparseOutput() const;
+
 	/// does this effect need random temporal access
 	bool temporalAccess() const;
 
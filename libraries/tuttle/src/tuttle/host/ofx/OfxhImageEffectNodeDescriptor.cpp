@@ -30,6 +30,7 @@ static property::OfxhPropSpec effectDescriptorStuff[] = {
     { kOfxImageEffectPropSupportsMultiResolution, property::ePropTypeInt, 1, false, "1" },
     { kOfxImageEffectPropSupportsTiles, property::ePropTypeInt, 1, false, "1" },
     { kOfxImageEffectPropTemporalClipAccess, property::ePropTypeInt, 1, false, "0" },
+    { kTuttleOfxImageEffectPropSparseOutput, property::ePropTypeInt, 1, false, "0" },
     { kOfxImageEffectPropSupportedPixelDepths, property::ePropTypeString, 0, false, "" },
     { kTuttleOfxImageEffectPropSupportedExtensions, property::ePropTypeString, 0, false, "" },
     { kOfxImageEffectPluginPropFieldRenderTwiceAlways, property::ePropTypeInt, 1, false, "1" },
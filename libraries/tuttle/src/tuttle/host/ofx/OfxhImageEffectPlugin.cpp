@@ -197,6 +197,7 @@ void OfxhImageEffectPlugin::loadAndDescribeActions()
 		return;
 	}
 	_pluginHandle.reset( new tuttle::host::ofx::OfxhPluginHandle( *this, getApiHandler().getHost() ) );
+	_describedContexts.clear();
 
 	OfxPlugin* op = _pluginHandle->getOfxPlugin();
 
@@ -247,10 +248,14 @@ OfxhImageEffectNodeDescriptor& OfxhImageEffectPlugin::getDescriptorInContext( co
 		    << exception::dev( "Context not found." )
 		    << exception::ofxContext( context ) );
 	}
-	return describeInContextAction( context );
+	// not in the cache
+	loadAndDescribeActions();
+	OfxhImageEffectNodeDescriptor& desc = describeInContextAction( *getPluginHandle()->getOfxPlugin(), context );
+	_describedContexts.insert( context );
+	return desc;
 }
 
-OfxhImageEffectNodeDescriptor& OfxhImageEffectPlugin::describeInContextAction( const std::string& context )
+OfxhImageEffectNodeDescriptor& OfxhImageEffectPlugin::describeInContextAction( OfxPlugin& op, const std::string& context )
 {
 	tuttle::host::ofx::property::OfxhPropSpec inargspec[] = {
 		{ kOfxImageEffectPropContext, tuttle::host::ofx::property::ePropTypeString, 1, true, context.c_str() },
@@ -259,19 +264,24 @@ OfxhImageEffectNodeDescriptor& OfxhImageEffectPlugin::describeInContextAction( c
 
 	tuttle::host::ofx::property::OfxhSet inarg( inargspec );
 
-	OfxhPluginHandle* ph = getPluginHandle();
-
 	std::auto_ptr<tuttle::host::ofx::imageEffect::OfxhImageEffectNodeDescriptor> newContext( core().getHost().makeDescriptor( getDescriptor(), *this ) );
-	int rval = kOfxStatFailed;
-	if( ph->getOfxPlugin() )
-		rval = ph->getOfxPlugin()->mainEntry( kOfxImageEffectActionDescribeInContext, newContext->getHandle(), inarg.getHandle(), 0 );
+	int rval = op.mainEntry( kOfxImageEffectActionDescribeInContext, newContext->getHandle(), inarg.getHandle(), 0 );
 
 	if( rval != kOfxStatOK && rval != kOfxStatReplyDefault )
 	{
 		BOOST_THROW_EXCEPTION( OfxhException( rval, "kOfxImageEffectActionDescribeInContext failed." ) );
 	}
-	std::string key( context ); // for constness
-	_contexts.insert( key, newContext.release() );
+	ContextMap::iterator it = _contexts.find( context );
+	if( it != _contexts.end() )
+	{
+		// the previous descriptor may still be referenced
+		_replacedContexts.push_back( _contexts.replace( it, newContext.release() ).release() );
+	}
+	else
+	{
+		std::string key( context ); // for constness
+		_contexts.insert( key, newContext.release() );
+	}
 	return _contexts.at( context );
 }
 
@@ -287,6 +297,18 @@ imageEffect::OfxhImageEffectNode* OfxhImageEffectPlugin::createInstance( const s
 	{
 		BOOST_THROW_EXCEPTION( exception::BadHandle() );
 	}
+	if( _knownContexts.find( context ) == _knownContexts.end() )
+	{
+		BOOST_THROW_EXCEPTION( exception::Bug()
+		    << exception::dev( "Context not found." )
+		    << exception::ofxContext( context ) );
+	}
+	// the cached descriptor is not enough, the plugin needs its own description in the context
+	if( _describedContexts.find( context ) == _describedContexts.end() )
+	{
+		describeInContextAction( *getPluginHandle()->getOfxPlugin(), context );
+		_describedContexts.insert( context );
+	}
 	OfxhImageEffectNodeDescriptor& desc        = getDescriptorInContext( context );
 	imageEffect::OfxhImageEffectNode* instance = core().getHost().newInstance( *this, desc, context ); /// @todo tuttle: don't use singleton here.
 	instance->createInstanceAction(); // Is it not possible to move this in a constructor ? In some cases it's interesting to initialize host side values before creation of plugin side objets (eg. node duplication or creation from file).
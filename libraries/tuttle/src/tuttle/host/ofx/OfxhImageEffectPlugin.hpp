@@ -41,6 +41,7 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <boost/ptr_container/serialize_ptr_map.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
 
 #include <boost/serialization/extended_type_info.hpp>
 #include <boost/serialization/serialization.hpp>
@@ -76,6 +77,10 @@ private:
 	/// map to store contexts in
 	ContextMap _contexts;
 	ContextSet _knownContexts;
+	ContextSet _describedContexts; ///< contexts described by the plugin since the binary is loaded (the others come from the cache)
+	/// descriptors from the cache replaced by a description of the plugin,
+	/// kept alive for the references given by getDescriptorInContext
+	boost::ptr_vector<OfxhImageEffectNodeDescriptor> _replacedContexts;
 	boost::scoped_ptr<OfxhPluginHandle> _pluginHandle;
 
 	// this comes off Descriptor's property set after a describe
@@ -117,7 +122,10 @@ public:
 	/// @brief get the base image effect descriptor, const version
 	const OfxhImageEffectNodeDescriptor& getDescriptor() const;
 
-	/// @brief get the image effect descriptor for the context
+	/**
+	 * @brief get the image effect descriptor for the context
+	 * The descriptor comes from the cache if possible, without loading the binary.
+	 */
 	OfxhImageEffectNodeDescriptor& getDescriptorInContext( const std::string& context );
 
 	#ifndef SWIG
@@ -136,15 +144,20 @@ public:
 
 	void unloadAction();
 
+	#ifndef SWIG
+	/**
+	 * @brief describe the plugin in a context with a loaded plugin, the new
+	 *        descriptor replaces the cached one.
+	 */
+	OfxhImageEffectNodeDescriptor& describeInContextAction( OfxPlugin& op, const std::string& context );
+	#endif
+
 	/**
 	 * @brief this is called to make an instance of the effect
 	 *  the client data ptr is what is passed back to the client creation function
 	 */
 	imageEffect::OfxhImageEffectNode* createInstance( const std::string& context );
 
-private:
-	OfxhImageEffectNodeDescriptor& describeInContextAction( const std::string& context );
-
 private:
 	friend class boost::serialization::access;
 	template<class Archive>
@@ -154,6 +167,12 @@ private:
 		ar& BOOST_SERIALIZATION_NVP( _baseDescriptor );
 		//ar & BOOST_SERIALIZATION_NVP(_pluginHandle); // don't save this
 		ar& BOOST_SERIALIZATION_NVP( _contexts );
+
+		if( typename Archive::is_loading() )
+		{
+			// the supported contexts are known without loading the binary
+			initContexts();
+		}
 	}
 };
 
@@ -151,6 +151,15 @@ void OfxhImageEffectPluginCache::loadFromPlugin( OfxhPlugin& op )
 	{
 		std::string context = eProps.getStringProperty( kOfxImageEffectPropSupportedContexts, j );
 		p.addContext( context );
+		// cache the description in each context, so the binary is only loaded to create an instance
+		try
+		{
+			p.describeInContextAction( *plug.getOfxPlugin(), context );
+		}
+		catch(... )
+		{
+			TUTTLE_LOG_WARNING( "Plugin " << quotes( op.getIdentifier() ) << ": unable to describe in the context " << quotes( context ) << ", it will be described at the first use." );
+		}
 	}
 
 	rval = plug->mainEntry( kOfxActionUnload, 0, 0, 0 );
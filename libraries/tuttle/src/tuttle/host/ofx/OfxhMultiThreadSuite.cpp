@@ -1,6 +1,8 @@
 #include "OfxhMultiThreadSuite.hpp"
 #include "OfxhCore.hpp"
 
+#include <tuttle/host/Core.hpp>
+
 #include <boost/thread/thread.hpp>
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/thread/tss.hpp>
@@ -28,9 +30,12 @@ boost::thread_specific_ptr<ThreadSpecificData> ptr;
 void launchThread( OfxThreadFunctionV1 func,
                    unsigned int        threadIndex,
                    unsigned int        threadMax,
-                   void*               customArg )
+                   void*               customArg,
+                   memory::IMemoryCache* memoryCache )
 {
 	ptr.reset( new ThreadSpecificData( threadIndex ) );
+	// the images fetched by the plugin are in the memory cache of the calling thread
+	core().setThreadMemoryCache( memoryCache );
 	func( threadIndex, threadMax, customArg );
 }
 
@@ -48,10 +53,11 @@ OfxStatus multiThread( OfxThreadFunctionV1 func,
 	}
 	else
 	{
+		memory::IMemoryCache* memoryCache = &core().getMemoryCache();
 		boost::thread_group group;
 		for( unsigned int i = 0; i < nThreads; ++i )
 		{
-			group.create_thread( boost::bind( launchThread, func, i, nThreads, customArg ) );
+			group.create_thread( boost::bind( launchThread, func, i, nThreads, customArg, memoryCache ) );
 		}
 		group.join_all();
 	}
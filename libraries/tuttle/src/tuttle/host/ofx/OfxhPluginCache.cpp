@@ -243,9 +243,10 @@ void OfxhPluginCache::scanDirectory( std::set<std::string>& foundBinFiles, const
 			std::string bundlepath = dir + DIRSEP + name;
 			std::string binpath    = bundlepath + DIRSEP "Contents" DIRSEP + ARCHSTR + DIRSEP + barename;
 
-			foundBinFiles.insert( binpath );
+			// the same binary may be found with different plugin paths
+			const bool firstFound = foundBinFiles.insert( binpath ).second;
 
-			if( _knownBinFiles.find( binpath ) == _knownBinFiles.end() )
+			if( firstFound && _knownBinFiles.find( binpath ) == _knownBinFiles.end() )
 			{
 				#ifdef CACHE_DEBUG
 				TUTTLE_TLOG( TUTTLE_INFO, "found non-cached binary " << binpath );
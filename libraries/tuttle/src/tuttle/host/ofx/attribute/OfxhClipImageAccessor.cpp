@@ -40,6 +40,13 @@ bool OfxhClipImageAccessor::isMask() const
 	return getProperties().getIntProperty( kOfxImageClipPropIsMask ) != 0;
 }
 
+/** does the plugin read the tiled images of the clip in tiles
+ */
+bool OfxhClipImageAccessor::supportsSparseInput() const
+{
+	return getProperties().getIntProperty( kTuttleOfxImageClipPropSupportsSparseInput ) != 0;
+}
+
 /** how does this clip like fielded images to be presented to it
  */
 const std::string& OfxhClipImageAccessor::getFieldExtraction() const
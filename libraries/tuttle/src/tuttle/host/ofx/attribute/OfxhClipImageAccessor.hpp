@@ -33,6 +33,9 @@ public:
 	/// @brief is the clip a nominal 'mask' clip
 	bool isMask() const;
 
+	/// @brief does the plugin read the tiled images of the clip in tiles
+	bool supportsSparseInput() const;
+
 	/// @brief how does this clip like fielded images to be presented to it
 	const std::string& getFieldExtraction() const;
 
@@ -34,6 +34,7 @@ void OfxhClipImageDescriptor::init( const std::string& name )
 		{ kOfxImageClipPropIsMask, property::ePropTypeInt, 1, false, "0" },
 		{ kOfxImageClipPropFieldExtraction, property::ePropTypeString, 1, false, kOfxImageFieldDoubled },
 		{ kOfxImageEffectPropSupportsTiles, property::ePropTypeInt, 1, false, "1" },
+		{ kTuttleOfxImageClipPropSupportsSparseInput, property::ePropTypeInt, 1, false, "0" },
 		{ 0 },
 	};
 
@@ -284,6 +284,16 @@ public:
 		}
 		return seed;
 	}
+
+	bool isAnimated() const
+	{
+		for( std::size_t i = 0; i < getSize(); ++i )
+		{
+			if( _controls[i].isAnimated() )
+				return true;
+		}
+		return false;
+	}
 	
 	std::ostream& displayValues( std::ostream& os ) const
 	{
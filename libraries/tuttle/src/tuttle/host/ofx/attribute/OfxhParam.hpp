@@ -154,6 +154,9 @@ public:
 
 	virtual std::size_t getHashAtTime( const OfxTime time ) const = 0;
 
+	/// @brief The value changes over time (the parameter has more than one keyframe).
+	virtual bool isAnimated() const { return false; }
+
 	/**
 	 * @todo tuttle: check values !!!
 	 */
@@ -77,6 +77,16 @@ std::size_t OfxhParamSet::getHashAtTime( const OfxTime time ) const
 	return seed;
 }
 
+bool OfxhParamSet::isAnimated() const
+{
+	BOOST_FOREACH( const OfxhParam& param, getParamVector() )
+	{
+		if( param.paramTypeHasData() && param.getEvaluateOnChange() && param.isAnimated() )
+			return true;
+	}
+	return false;
+}
+
 //void OfxhParamSet::referenceParam( const std::string& name, OfxhParam* instance ) OFX_EXCEPTION_SPEC
 //{
 	//	if( _allParams.find( name ) != _allParams.end() )
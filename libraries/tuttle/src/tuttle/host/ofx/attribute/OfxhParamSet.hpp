@@ -53,6 +53,9 @@ public:
 	bool operator!=( const This& other ) const { return !This::operator==( other ); }
 	
 	std::size_t getHashAtTime( const OfxTime time ) const;
+
+	/// @brief One of the parameters used in the hash is animated.
+	bool isAnimated() const;
 	
 	/// obtain a handle on this set for passing to the C api
 	OfxParamSetHandle getParamSetHandle() const { return ( OfxParamSetHandle ) this; }
@@ -3,6 +3,7 @@
 
 #include "ImageGilProcessor.hpp"
 
+#include <boost/gil/algorithm.hpp>
 #include <boost/scoped_ptr.hpp>
 
 namespace tuttle {
@@ -15,16 +16,31 @@ template <class SView, class DView = SView>
 class ImageGilFilterProcessor : public ImageGilProcessor<DView>
 {
 protected:
+	typedef typename terry::image_from_view<SView>::type SImage;
+
 	OFX::Clip* _clipSrc;       ///< Source image clip
 	boost::scoped_ptr<OFX::Image> _src;
 	OfxRectI _srcPixelRod;
 	SView _srcView; ///< @brief source clip (filters have only one input)
+	OFX::EPixelComponent _srcPixelComponents;
+	OFX::EBitDepth _srcPixelDepth;
+	boost::scoped_ptr<SImage> _srcBuffer; ///< copy of the source pixels, once the host images are released
 
 public:
 	ImageGilFilterProcessor( OFX::ImageEffect& effect, const EImageOrientation imageOrientation );
 	virtual ~ImageGilFilterProcessor();
 
 	virtual void setup( const OFX::RenderArguments& args );
+
+	/**
+	 * @brief Copy the source pixels in a buffer owned by the processor, set
+	 *        the output to the source (like the writers) and release the host images.
+	 *
+	 * Used to run the process after the render action (see WriteBehind): the host
+	 * may free its images as soon as the render action returns.
+	 * The process must not use _src, _dst and _dstView after this call.
+	 */
+	void releaseHostImages();
 };
 
 template<class SView, class DView>
@@ -69,6 +85,9 @@ void ImageGilFilterProcessor<SView, DView>::setup( const OFX::RenderArguments& a
 		_srcPixelRod = _src->getRegionOfDefinition();
 	}
 	_srcView = ImageGilProcessor<DView>::template getCustomView<SView>( _src.get(), _srcPixelRod );
+	_srcPixelComponents = _src->getPixelComponents();
+	_srcPixelDepth = _src->getPixelDepth();
+	_srcBuffer.reset();
 
 //	// Make sure bit depths are same
 //	if( this->_src->getPixelDepth() != this->_dst->getPixelDepth() ||
@@ -76,6 +95,20 @@ void ImageGilFilterProcessor<SView, DView>::setup( const OFX::RenderArguments& a
 //		BOOST_THROW_EXCEPTION( exception::BitDepthMismatch() );
 }
 
+template<class SView, class DView>
+void ImageGilFilterProcessor<SView, DView>::releaseHostImages()
+{
+	using namespace boost::gil;
+	_srcBuffer.reset( new SImage( _srcView.width(), _srcView.height() ) );
+	copy_pixels( _srcView, view( *_srcBuffer ) );
+	copy_and_convert_pixels( _srcView, this->_dstView );
+	_srcView = view( *_srcBuffer );
+
+	this->_dstView = DView();
+	this->_dst.reset();
+	_src.reset();
+}
+
 }
 }
 
@@ -101,6 +101,19 @@ public:
 
 	/** @brief fetch output and inputs clips */
 	virtual void setupAndProcess( const OFX::RenderArguments& args )
+	{
+		if( setupRender( args ) )
+		{
+			// Call the base class process member
+			this->process();
+		}
+	}
+
+	/**
+	 * @brief Setup the process for a render, without processing.
+	 * @return false if the host is aborting the rendering
+	 */
+	bool setupRender( const OFX::RenderArguments& args )
 	{
 		_renderArgs = args;
 		_renderWindowSize.x = ( _renderArgs.renderWindow.x2 - _renderArgs.renderWindow.x1 );
@@ -116,7 +129,7 @@ public:
 			// if the host is trying to abort the rendering return without error
 			if( _effect.abort() )
 			{
-				return;
+				return false;
 			}
 			throw;
 		}
@@ -127,13 +140,11 @@ public:
 			// if the host is trying to abort the rendering return without error
 			if( _effect.abort() )
 			{
-				return;
+				return false;
 			}
 			throw;
 		}
-
-		// Call the base class process member
-		this->process();
+		return true;
 	}
 
 	/** @brief overridden from OFX::MultiThread::Processor. This function is called once on each SMP thread by the base class */
@@ -0,0 +1,50 @@
+#ifndef _TUTTLE_PLUGIN_MULTITHREADLAUNCHER_HPP_
+#define _TUTTLE_PLUGIN_MULTITHREADLAUNCHER_HPP_
+
+#include <terry/algorithm/parallel_reduce.hpp>
+
+#include <ofxsMultiThread.h>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Launcher for terry parallel algorithms (like terry::algorithm::parallel_reduce),
+ *        running on the threads of the host multithread suite.
+ */
+class MultiThreadLauncher
+{
+public:
+	/// @param nbThreads 0: maximum allowable number of CPUs
+	explicit MultiThreadLauncher( const unsigned int nbThreads = 0 )
+	: _nbThreads( nbThreads )
+	{}
+
+	void operator()( const terry::algorithm::thread_function_t& f ) const
+	{
+		Processor processor( f );
+		processor.multiThread( _nbThreads );
+	}
+
+private:
+	class Processor : public OFX::MultiThread::Processor
+	{
+	public:
+		explicit Processor( const terry::algorithm::thread_function_t& f ) : _f( f ) {}
+
+		void multiThreadFunction( const unsigned int threadId, const unsigned int nThreads )
+		{
+			_f( threadId, nThreads );
+		}
+
+	private:
+		const terry::algorithm::thread_function_t& _f;
+	};
+
+	unsigned int _nbThreads;
+};
+
+}
+}
+
+#endif
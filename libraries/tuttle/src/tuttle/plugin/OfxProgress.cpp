@@ -15,7 +15,8 @@ void OfxProgress::progressBegin( const int numSteps, const std::string& msg )
 {
 	_counter = 0.0;
 	_stepSize = 1.0 / static_cast<double>( numSteps );
-	_effect.progressStart( msg );
+	if( _hostProgress )
+		_effect.progressStart( msg );
 }
 
 /**
@@ -31,6 +32,11 @@ bool OfxProgress::progressForward( const int nSteps )
 {
 	_mutex.lock();
 	_counter += _stepSize * static_cast<double>( nSteps );
+	if( ! _hostProgress )
+	{
+		_mutex.unlock();
+		return false;
+	}
 	/// @todo why not unlock the mutex here?
 	if( _effect.abort() )
 	{
@@ -45,6 +51,11 @@ bool OfxProgress::progressForward( const int nSteps )
 
 bool OfxProgress::progressUpdate( const double p )
 {
+	if( ! _hostProgress )
+	{
+		_counter = p;
+		return false;
+	}
 	if( _effect.abort() )
 	{
 		return true;
@@ -62,7 +73,8 @@ void OfxProgress::progressEnd()
 	// Wait for the end
 	_mutex.lock();
 	_mutex.unlock();
-	_effect.progressEnd();
+	if( _hostProgress )
+		_effect.progressEnd();
 }
 
 OfxProgress& OfxProgress::operator=( const OfxProgress& p )
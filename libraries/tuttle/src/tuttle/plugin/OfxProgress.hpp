@@ -29,6 +29,7 @@ private:
 protected:
 	double _stepSize; ///< Step size of progess bar
 	double _counter; ///< Current position in [0; 1]
+	bool _hostProgress; ///< Report the progression to the host
 
 public:
 	OfxProgress( OFX::ImageEffect& effect )
@@ -36,6 +37,7 @@ public:
 	, _mutex( 0 )
 	, _stepSize( 0 )
 	, _counter( 0 )
+	, _hostProgress( true )
 	{}
 
 	virtual ~OfxProgress() {}
@@ -45,6 +47,12 @@ public:
 	bool progressForward( const int nSteps );
 	
 	bool progressUpdate( const double p );
+
+	/**
+	 * @brief Disable the calls to the host progress and abort suites,
+	 *        needed when the process runs outside of the host render action.
+	 */
+	void setHostProgress( const bool enabled ) { _hostProgress = enabled; }
 	
 	OfxProgress& getOfxProgress() { return *this; }
 };
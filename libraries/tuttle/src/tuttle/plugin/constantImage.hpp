@@ -0,0 +1,104 @@
+#ifndef _TUTTLE_PLUGIN_CONSTANTIMAGE_HPP_
+#define _TUTTLE_PLUGIN_CONSTANTIMAGE_HPP_
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/numeric/rectOp.hpp>
+
+#include <ofxsImageEffect.h>
+
+#include <boost/gil/channel.hpp>
+#include <boost/gil/pixel.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <algorithm>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief The render action writes all the pixels of the output image,
+ *        so the output can be set as a constant image.
+ */
+inline bool isRenderingAllImage( const OFX::Image& dst, const OfxRectI& renderWindow )
+{
+	return rectangleAContainsB( renderWindow, dst.getBounds() );
+}
+
+/**
+ * @brief The source is a constant image which covers all the output image.
+ */
+inline bool isConstantOver( const OFX::Image* src, const OFX::Image& dst )
+{
+	return src != NULL &&
+	       src->isConstant() &&
+	       rectangleAContainsB( src->getBounds(), dst.getBounds() );
+}
+
+namespace detail {
+
+template<class Channel>
+Channel normalizedToChannel( const double v, const boost::true_type /*integral*/ )
+{
+	return static_cast<Channel>( std::min( std::max( v, 0.0 ), 1.0 ) * boost::gil::channel_traits<Channel>::max_value() + 0.5 );
+}
+
+template<class Channel>
+Channel normalizedToChannel( const double v, const boost::false_type /*integral*/ )
+{
+	return Channel( static_cast<float>( v ) );
+}
+
+template<class Channel>
+double channelToNormalized( const Channel c, const boost::true_type /*integral*/ )
+{
+	return c / double( boost::gil::channel_traits<Channel>::max_value() );
+}
+
+template<class Channel>
+double channelToNormalized( const Channel c, const boost::false_type /*integral*/ )
+{
+	return static_cast<float>( c );
+}
+
+}
+
+/**
+ * @brief Pixel of a constant image (with the same conversion as the host).
+ * The channels of an Alpha image are the alpha of the color.
+ */
+template<class Pixel>
+Pixel constantColorToPixel( const OfxRGBAColourD& color )
+{
+	typedef typename boost::gil::channel_type<Pixel>::type Channel;
+	const int nbChannels = boost::gil::num_channels<Pixel>::value;
+	const double rgba[4] = { color.r, color.g, color.b, color.a };
+	const double* values = nbChannels == 1 ? &rgba[3] : rgba;
+
+	Pixel pixel;
+	for( int c = 0; c < nbChannels; ++c )
+		pixel[c] = detail::normalizedToChannel<Channel>( values[c], typename boost::is_integral<Channel>::type() );
+	return pixel;
+}
+
+/**
+ * @brief Color of a constant image of pixel values.
+ */
+template<class Pixel>
+OfxRGBAColourD pixelToConstantColor( const Pixel& pixel )
+{
+	typedef typename boost::gil::channel_type<Pixel>::type Channel;
+	const int nbChannels = boost::gil::num_channels<Pixel>::value;
+	double rgba[4] = { 0.0, 0.0, 0.0, 1.0 };
+	double* values = nbChannels == 1 ? &rgba[3] : rgba;
+
+	for( int c = 0; c < nbChannels; ++c )
+		values[c] = detail::channelToNormalized<Channel>( pixel[c], typename boost::is_integral<Channel>::type() );
+
+	const OfxRGBAColourD color = { rgba[0], rgba[1], rgba[2], rgba[3] };
+	return color;
+}
+
+}
+}
+
+#endif
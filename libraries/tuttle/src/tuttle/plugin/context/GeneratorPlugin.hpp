@@ -49,6 +49,9 @@ public:
 protected:
 	void updateVisibleTools();
 
+	/// @brief The output changes with the time, even with the same parameters.
+	virtual bool varyOnTime() const { return true; }
+
 public:
 	OFX::Clip*              _clipSrc;  ///< Input image clip
 	OFX::Clip*              _clipDst;  ///< Destination image clip
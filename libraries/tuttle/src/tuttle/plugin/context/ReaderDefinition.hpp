@@ -6,6 +6,8 @@
 namespace tuttle {
 namespace plugin {
 
+static const std::string kParamReaderUniformFormat = "uniformFormat";
+
 enum EParamReaderBitDepth
 {
 	eParamReaderBitDepthAuto = 0,
@@ -0,0 +1,64 @@
+#include "ReaderHeaderCache.hpp"
+
+#include <limits>
+
+namespace tuttle {
+namespace plugin {
+
+namespace {
+
+/// Above this number of files, the cache is emptied
+static const std::size_t kMaxHeaders = 16384;
+
+}
+
+ReaderHeader::ReaderHeader()
+	: _nbChannels( 0 )
+	, _components( OFX::ePixelComponentNone )
+	, _bitDepth( OFX::eBitDepthNone )
+	, _pixelAspectRatio( 1.0 )
+{
+	_rod.x1 = _rod.y1 = _rod.x2 = _rod.y2 = 0.0;
+	_dataRod = _rod;
+}
+
+bool ReaderHeaderCache::find( const std::string& filename, ReaderHeader& header )
+{
+	const Key key = buildFileCacheKey( filename );
+
+	boost::mutex::scoped_lock lock( _mutex );
+	std::map<Key, ReaderHeader>::const_iterator it = _headers.find( key );
+	if( it == _headers.end() )
+		return false;
+	header = it->second;
+	return true;
+}
+
+void ReaderHeaderCache::insert( const std::string& filename, const ReaderHeader& header )
+{
+	const Key key = buildFileCacheKey( filename );
+
+	boost::mutex::scoped_lock lock( _mutex );
+	if( _headers.size() >= kMaxHeaders )
+		_headers.clear();
+
+	// the entries of a file are contiguous, as the path is the first criteria of the key
+	Key first;
+	first._path = key._path;
+	first._mtime = std::numeric_limits<boost::int64_t>::min();
+	first._size = 0;
+	std::map<Key, ReaderHeader>::iterator it = _headers.lower_bound( first );
+	while( it != _headers.end() && it->first._path == key._path )
+		_headers.erase( it++ );
+
+	_headers[key] = header;
+}
+
+void ReaderHeaderCache::clear()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_headers.clear();
+}
+
+}
+}
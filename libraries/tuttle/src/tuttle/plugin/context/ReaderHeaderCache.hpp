@@ -0,0 +1,66 @@
+#ifndef _TUTTLE_PLUGIN_CONTEXT_READERHEADERCACHE_HPP_
+#define _TUTTLE_PLUGIN_CONTEXT_READERHEADERCACHE_HPP_
+
+#include <tuttle/common/patterns/StaticSingleton.hpp>
+#include <tuttle/plugin/fileCache.hpp>
+
+#include <ofxsImageEffect.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <string>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Image informations read from the header of a file.
+ */
+struct ReaderHeader
+{
+	ReaderHeader();
+
+	OfxRectD             _rod;        ///< displayed region, in pixels (without pixel aspect ratio)
+	OfxRectD             _dataRod;    ///< stored region, in pixels (same as _rod for most formats)
+	std::size_t          _nbChannels; ///< number of channels in the file
+	OFX::EPixelComponent _components; ///< components of the file
+	OFX::EBitDepth       _bitDepth;   ///< best bit depth to read the file
+	double               _pixelAspectRatio;
+};
+
+/**
+ * @brief Process-wide cache of the file headers read by a reader plugin,
+ *        shared by all the nodes and all the render threads.
+ *
+ * Entries are keyed by the absolute path, the modification time and the
+ * size of the file, so a rewritten file is read again.
+ */
+class ReaderHeaderCache : public StaticSingleton<ReaderHeaderCache>
+{
+	MAKE_StaticSingleton( ReaderHeaderCache )
+
+public:
+	/**
+	 * @brief Get the header of a file.
+	 * @return false if the file isn't in the cache.
+	 */
+	bool find( const std::string& filename, ReaderHeader& header );
+
+	/// @brief Add the header of a file, replacing the entries of an older version of the file.
+	void insert( const std::string& filename, const ReaderHeader& header );
+
+	void clear();
+
+private:
+	typedef FileCacheKey Key;
+
+private:
+	boost::mutex _mutex;
+	std::map<Key, ReaderHeader> _headers;
+};
+
+}
+}
+
+#endif
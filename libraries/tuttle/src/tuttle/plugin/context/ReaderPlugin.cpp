@@ -1,5 +1,7 @@
 #include "ReaderPlugin.hpp"
 
+#include <boost/filesystem/operations.hpp>
+
 namespace tuttle {
 namespace plugin {
 
@@ -13,6 +15,7 @@ ReaderPlugin::ReaderPlugin( OfxImageEffectHandle handle )
 	_isSequence    = _filePattern.initFromDetection( _paramFilepath->getValue() );
 	_paramBitDepth = fetchChoiceParam( kTuttlePluginBitDepth );
 	_paramChannel  = fetchChoiceParam( kTuttlePluginChannel );
+	_paramUniformFormat = fetchBooleanParam( kParamReaderUniformFormat );
 }
 
 ReaderPlugin::~ReaderPlugin()
@@ -86,6 +89,75 @@ bool ReaderPlugin::getTimeDomain( OfxRangeD& range )
 	return true;
 }
 
+ReaderHeader ReaderPlugin::getHeaderAt( const OfxTime time )
+{
+	if( assumeUniformFormat() )
+		return getFirstHeader();
+	return getHeader( getAbsoluteFilenameAt( time ) );
+}
+
+ReaderHeader ReaderPlugin::getFirstHeader()
+{
+	return getHeader( getAbsoluteFirstFilename() );
+}
+
+ReaderHeader ReaderPlugin::getHeader( const std::string& filename )
+{
+	if( ! bfs::exists( filename ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileInSequenceNotExist()
+			<< exception::user( "Unable to open file" )
+			<< exception::filename( filename ) );
+	}
+	ReaderHeader header;
+	if( ReaderHeaderCache::instance().find( filename, header ) )
+		return header;
+
+	readHeader( filename, header );
+	ReaderHeaderCache::instance().insert( filename, header );
+	return header;
+}
+
+void ReaderPlugin::readHeader( const std::string& filename, ReaderHeader& header )
+{
+	BOOST_THROW_EXCEPTION( exception::NotImplemented()
+		<< exception::dev( "This reader doesn't read file headers." )
+		<< exception::filename( filename ) );
+}
+
+void ReaderPlugin::setClipPreferencesFromHeader( OFX::ClipPreferencesSetter& clipPreferences, const ReaderHeader& header )
+{
+	if( getExplicitBitDepthConversion() == eParamReaderBitDepthAuto && header._bitDepth != OFX::eBitDepthNone )
+	{
+		clipPreferences.setClipBitDepth( *this->_clipDst, header._bitDepth );
+	}
+	if( getExplicitChannelConversion() == eParamReaderChannelAuto )
+	{
+		switch( header._components )
+		{
+			case OFX::ePixelComponentAlpha:
+			{
+				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentAlpha );
+				break;
+			}
+			case OFX::ePixelComponentRGB:
+			{
+				if( OFX::getImageEffectHostDescription()->supportsPixelComponent( OFX::ePixelComponentRGB ) )
+					clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGB );
+				else
+					clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
+				break;
+			}
+			default:
+			{
+				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
+				break;
+			}
+		}
+	}
+	clipPreferences.setPixelAspectRatio( *this->_clipDst, header._pixelAspectRatio );
+}
+
 void ReaderPlugin::render( const OFX::RenderArguments& args )
 {
 	std::string filename =  getAbsoluteFilenameAt( args.time );
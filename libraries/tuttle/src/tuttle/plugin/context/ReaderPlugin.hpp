@@ -4,6 +4,7 @@
 #include <boost/gil/channel_algorithm.hpp> // force to use the boostHack version first
 
 #include "ReaderDefinition.hpp"
+#include "ReaderHeaderCache.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <Sequence.hpp>
@@ -94,9 +95,31 @@ public:
 		return OFX::eBitDepthNone;
 	}
 
+	bool assumeUniformFormat() const
+	{
+		return _isSequence && _paramUniformFormat->getValue();
+	}
+
+	/**
+	 * @brief Header of the file at @p time, read only once per file.
+	 * With the uniform format option, it's the header of the first file
+	 * of the sequence.
+	 */
+	ReaderHeader getHeaderAt( const OfxTime time );
+	ReaderHeader getFirstHeader();
+
 protected:
 	virtual inline bool varyOnTime() const { return _isSequence; }
 
+	/// @brief Read the header of a file, used by getHeaderAt() on cache miss.
+	virtual void readHeader( const std::string& filename, ReaderHeader& header );
+
+	/// @brief Output clip preferences of a file header, if not explicitly set by the user.
+	void setClipPreferencesFromHeader( OFX::ClipPreferencesSetter& clipPreferences, const ReaderHeader& header );
+
+private:
+	ReaderHeader getHeader( const std::string& filename );
+
 public:
 	OFX::Clip*           _clipDst;        ///< Destination image clip
 	/// @name user parameters
@@ -104,6 +127,7 @@ public:
 	OFX::StringParam*    _paramFilepath;  ///< File path
 	OFX::ChoiceParam*    _paramBitDepth;  ///< Explicit bit depth conversion
 	OFX::ChoiceParam*    _paramChannel;   ///< Explicit component conversion
+	OFX::BooleanParam*   _paramUniformFormat; ///< Same format for all the files
 	/// @}
 
 private:
@@ -41,6 +41,13 @@ void describeReaderParamsInContext( OFX::ImageEffectDescriptor& desc,
 	explicitConversion->setAnimates( false );
 	desc.addClipPreferencesSlaveParam( *explicitConversion );
 
+	OFX::BooleanParamDescriptor* uniformFormat = desc.defineBooleanParam( kParamReaderUniformFormat );
+	uniformFormat->setLabel( "Uniform format" );
+	uniformFormat->setHint( "All the files of the sequence have the format of the first one: only the header of the first file is read." );
+	uniformFormat->setDefault( false );
+	uniformFormat->setAnimates( false );
+	desc.addClipPreferencesSlaveParam( *uniformFormat );
+
 	if( OFX::getImageEffectHostDescription()->supportsMultipleClipDepths )
 	{
 		explicitConversion->setDefault( 0 );
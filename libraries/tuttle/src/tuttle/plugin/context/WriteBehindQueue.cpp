@@ -0,0 +1,151 @@
+#include "WriteBehindQueue.hpp"
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+
+namespace tuttle {
+namespace plugin {
+
+WriteBehindQueue::WriteBehindQueue()
+: _nbPending( 0 )
+, _maxPending( 0 )
+, _stop( false )
+{}
+
+WriteBehindQueue::~WriteBehindQueue()
+{
+	if( ! _thread )
+		return;
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_stop = true;
+		_cond.notify_all();
+	}
+	_thread->join();
+	if( _error )
+	{
+		try
+		{
+			boost::rethrow_exception( _error );
+		}
+		catch( ... )
+		{
+			TUTTLE_LOG_CURRENT_EXCEPTION;
+		}
+	}
+}
+
+void WriteBehindQueue::push( const OfxTime time, const Job& job, const std::size_t maxSize )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	rethrowError();
+	while( _nbPending >= std::max( maxSize, std::size_t( 1 ) ) )
+	{
+		_cond.wait( lock );
+		rethrowError();
+	}
+	if( ! _thread )
+	{
+		_thread.reset( new boost::thread( boost::bind( &WriteBehindQueue::run, this ) ) );
+	}
+	_jobs.push_back( std::make_pair( time, job ) );
+	++_nbPending;
+	_maxPending = std::max( _maxPending, _nbPending );
+	_cond.notify_all();
+}
+
+void WriteBehindQueue::flush()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	while( _nbPending > 0 )
+	{
+		_cond.wait( lock );
+	}
+	rethrowError();
+}
+
+std::size_t WriteBehindQueue::size() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _nbPending;
+}
+
+std::size_t WriteBehindQueue::maxSize() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _maxPending;
+}
+
+void WriteBehindQueue::resetMaxSize()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_maxPending = _nbPending;
+}
+
+/**
+ * @brief Rethrow (only once) the error of a job. _mutex must be locked.
+ */
+void WriteBehindQueue::rethrowError()
+{
+	if( ! _error )
+		return;
+	const boost::exception_ptr error = _error;
+	_error = boost::exception_ptr();
+	boost::rethrow_exception( error );
+}
+
+void WriteBehindQueue::run()
+{
+	for(;;)
+	{
+		std::pair<OfxTime, Job> job;
+		{
+			boost::mutex::scoped_lock lock( _mutex );
+			while( _jobs.empty() && ! _stop )
+			{
+				_cond.wait( lock );
+			}
+			if( _jobs.empty() )
+				return;
+			job = _jobs.front();
+			_jobs.pop_front();
+		}
+
+		boost::exception_ptr error;
+		try
+		{
+			job.second();
+		}
+		catch( boost::exception& e )
+		{
+			e << exception::time( job.first );
+			error = boost::current_exception();
+		}
+		catch( std::exception& e )
+		{
+			error = boost::copy_exception( exception::Failed()
+				<< exception::user() + e.what()
+				<< exception::time( job.first ) );
+		}
+		catch( ... )
+		{
+			error = boost::copy_exception( exception::Unknown()
+				<< exception::time( job.first ) );
+		}
+		// release the job (and the images it references) before signaling its end
+		job.second.clear();
+
+		boost::mutex::scoped_lock lock( _mutex );
+		if( error && ! _error )
+			_error = error;
+		--_nbPending;
+		_cond.notify_all();
+	}
+}
+
+}
+}
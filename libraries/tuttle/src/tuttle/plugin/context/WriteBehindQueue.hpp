@@ -0,0 +1,72 @@
+#ifndef _TUTTLE_PLUGIN_CONTEXT_WRITEBEHINDQUEUE_HPP_
+#define _TUTTLE_PLUGIN_CONTEXT_WRITEBEHINDQUEUE_HPP_
+
+#include <ofxCore.h>
+
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <deque>
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Bounded queue of write jobs executed by a background thread.
+ *
+ * Jobs are executed in order. An error in a job is kept with the time of
+ * its frame and rethrown by the next call to push() or flush().
+ */
+class WriteBehindQueue
+{
+public:
+	typedef boost::function<void()> Job;
+
+public:
+	WriteBehindQueue();
+	/// Wait for the pending jobs, errors are only logged.
+	~WriteBehindQueue();
+
+	/**
+	 * @brief Add a job, blocks while @p maxSize jobs are pending.
+	 * @exception rethrow the error of a previous job.
+	 */
+	void push( const OfxTime time, const Job& job, const std::size_t maxSize );
+
+	/**
+	 * @brief Wait for all the pending jobs.
+	 * @exception rethrow the error of a previous job.
+	 */
+	void flush();
+
+	/// @brief Number of pending jobs (including the running one).
+	std::size_t size() const;
+
+	/// @brief Maximum number of pending jobs since the last call to resetMaxSize().
+	std::size_t maxSize() const;
+	void resetMaxSize();
+
+private:
+	void run();
+	void rethrowError();
+
+private:
+	mutable boost::mutex _mutex;
+	boost::condition_variable _cond; ///< Signaled when a job is added or finished
+	boost::scoped_ptr<boost::thread> _thread;
+	std::deque<std::pair<OfxTime, Job> > _jobs;
+	std::size_t _nbPending;  ///< Jobs in the queue or running
+	std::size_t _maxPending; ///< High watermark of _nbPending
+	bool _stop;
+	boost::exception_ptr _error;
+};
+
+}
+}
+
+#endif
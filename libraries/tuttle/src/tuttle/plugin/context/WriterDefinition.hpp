@@ -9,6 +9,7 @@ namespace plugin {
 static const std::string kParamWriterRenderAlways   = "renderAlways";
 static const std::string kParamWriterRender         = "render";
 static const std::string kParamWriterForceNewRender = "forceNewRender";
+static const std::string kParamWriterWriteBehind    = "writeBehind";
 
 static const std::string kParamPremultiplied      = "premultiplied";
 static const std::string kParamPremultipliedLabel = "Premultiplied";
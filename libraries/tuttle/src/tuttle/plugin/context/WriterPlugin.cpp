@@ -4,6 +4,7 @@
 
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
 #include <cstdio>
 
 namespace tuttle {
@@ -24,6 +25,7 @@ WriterPlugin::WriterPlugin( OfxImageEffectHandle handle )
 	_paramBitDepth = fetchChoiceParam( kTuttlePluginBitDepth );
 	_paramPremult = fetchBooleanParam( kParamPremultiplied );
 	_paramForceNewRender = fetchIntParam( kParamWriterForceNewRender );
+	_paramWriteBehind = fetchIntParam( kParamWriterWriteBehind );
 	_isSequence = _filePattern.initFromDetection( _paramFilepath->getValue( ) );
 }
 
@@ -74,6 +76,8 @@ bool WriterPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& ide
 
 void WriterPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArguments& args )
 {
+	_writeBehindQueue.resetMaxSize();
+
 	boost::filesystem::path dir( getAbsoluteDirectory( ) );
 	if( !boost::filesystem::exists( dir ) )
 	{
@@ -85,7 +89,14 @@ void WriterPlugin::render( const OFX::RenderArguments& args )
 {
 	_oneRender = false;
 
-	TUTTLE_LOG_INFO( "        --> " << getAbsoluteFilenameAt( args.time ) );
+	if( getWriteBehindSize() )
+	{
+		TUTTLE_LOG_INFO( "        --> " << getAbsoluteFilenameAt( args.time ) << " (write-behind queue: " << _writeBehindQueue.size() << ")" );
+	}
+	else
+	{
+		TUTTLE_LOG_INFO( "        --> " << getAbsoluteFilenameAt( args.time ) );
+	}
 
 	boost::scoped_ptr<OFX::Image> src( _clipSrc->fetchImage( args.time ) );
 	boost::scoped_ptr<OFX::Image> dst( _clipDst->fetchImage( args.time ) );
@@ -117,5 +128,25 @@ void WriterPlugin::render( const OFX::RenderArguments& args )
 	}
 }
 
+void WriterPlugin::endSequenceRender( const OFX::EndSequenceRenderArguments& args )
+{
+	// all the files are written at the end of the sequence
+	_writeBehindQueue.flush();
+	if( getWriteBehindSize() )
+	{
+		TUTTLE_LOG_INFO( "        write-behind queue: maximum depth " << _writeBehindQueue.maxSize() << "/" << getWriteBehindSize() );
+	}
+}
+
+std::size_t WriterPlugin::getWriteBehindSize() const
+{
+	return std::max( _paramWriteBehind->getValue(), 0 );
+}
+
+void WriterPlugin::pushWriteBehind( const OfxTime time, const WriteBehindQueue::Job& job )
+{
+	_writeBehindQueue.push( time, job, getWriteBehindSize() );
+}
+
 }
 }
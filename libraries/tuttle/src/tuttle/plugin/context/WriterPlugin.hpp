@@ -4,6 +4,7 @@
 #include <boost/gil/channel_algorithm.hpp> // force to use the boostHack version first
 
 #include "WriterDefinition.hpp"
+#include "WriteBehindQueue.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
@@ -12,6 +13,8 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
 
 #include <boost/gil/gil_all.hpp>
 
@@ -34,6 +37,17 @@ public:
 
 	virtual void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
 	virtual void render( const OFX::RenderArguments& args );
+	virtual void endSequenceRender( const OFX::EndSequenceRenderArguments& args );
+
+	/// @brief Number of frames that can wait in the write-behind queue, 0 for synchronous writes.
+	virtual std::size_t getWriteBehindSize() const;
+
+	/**
+	 * @brief Push the write of a frame in the write-behind queue.
+	 * @param[in] job  owns everything needed by the write (including the source image)
+	 * @exception rethrow the error of a previous frame
+	 */
+	void pushWriteBehind( const OfxTime time, const WriteBehindQueue::Job& job );
 
 protected:
 	inline bool varyOnTime() const { return _isSequence; }
@@ -45,6 +59,8 @@ private:
 	bool _oneRender;                            ///<
 	OfxTime _oneRenderAtTime;                         ///<
 
+	WriteBehindQueue _writeBehindQueue;         ///< Background writes
+
 public:
 	std::string getAbsoluteFilenameAt( const OfxTime time ) const
 	{
@@ -104,9 +120,59 @@ public:
 	OFX::ChoiceParam*     _paramBitDepth;         ///< Bit depth
 	OFX::IntParam*        _paramForceNewRender;   ///< Hack parameter, to force a new rendering
 	OFX::BooleanParam*    _paramPremult;     ///< Premult
+	OFX::IntParam*        _paramWriteBehind; ///< Write-behind queue size
 	/// @}
 };
 
+/**
+ * @brief Used with doGilRender instead of the writer process, to run the
+ *        writes in the write-behind queue of the WriterPlugin.
+ *
+ * The process is setup in the render action: the source pixels are copied
+ * in a buffer owned by the process and the host images are released before
+ * the end of the render action (the host frees them at the end of the frame).
+ * The process itself runs in the queue thread, without calls to the host
+ * progress. So it must only use the data collected by setup() and the
+ * source view, not the images.
+ *
+ * @code doGilRender<WriteBehind<MyWriterProcess>::Launcher>( *this, args ); @endcode
+ */
+template< template<class> class WriterProcess >
+struct WriteBehind
+{
+	template<class View>
+	class Launcher
+	{
+	public:
+		typedef WriterProcess<View> Process;
+
+	public:
+		template<class Plugin>
+		Launcher( Plugin& plugin )
+		: _plugin( plugin )
+		, _process( new Process( plugin ) )
+		{}
+
+		void setupAndProcess( const OFX::RenderArguments& args )
+		{
+			if( _plugin.getWriteBehindSize() == 0 )
+			{
+				_process->setupAndProcess( args );
+				return;
+			}
+			if( ! _process->setupRender( args ) )
+				return;
+			_process->releaseHostImages();
+			_process->setHostProgress( false );
+			_plugin.pushWriteBehind( args.time, boost::bind( &Process::process, _process ) );
+		}
+
+	private:
+		WriterPlugin& _plugin;
+		boost::shared_ptr<Process> _process;
+	};
+};
+
 }
 }
 
@@ -47,6 +47,15 @@ void describeWriterParamsInContext( OFX::ImageEffectDescriptor& desc,
 //	renderAlways->setDefault( false );
 	renderAlways->setDefault( true ); // because tuttle is not declared as a background renderer
 
+	OFX::IntParamDescriptor* writeBehind = desc.defineIntParam( kParamWriterWriteBehind );
+	writeBehind->setLabel( "Write behind" );
+	writeBehind->setHint( "Number of frames that can be encoded and written in background, "
+	                      "while the next frames are rendered (0: synchronous writing)." );
+	writeBehind->setRange( 0, 64 );
+	writeBehind->setDisplayRange( 0, 8 );
+	writeBehind->setAnimates( false );
+	writeBehind->setDefault( 0 );
+
 	OFX::IntParamDescriptor* forceNewRender = desc.defineIntParam( kParamWriterForceNewRender );
 	forceNewRender->setLabel( "Force new render" );
 	forceNewRender->setEnabled( false );
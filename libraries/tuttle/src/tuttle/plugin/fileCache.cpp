@@ -0,0 +1,82 @@
+#include "fileCache.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <cstdlib>
+#include <sstream>
+
+namespace tuttle {
+namespace plugin {
+
+namespace bfs = boost::filesystem;
+
+bool FileCacheKey::operator<( const FileCacheKey& other ) const
+{
+	if( _path != other._path )
+		return _path < other._path;
+	if( _mtime != other._mtime )
+		return _mtime < other._mtime;
+	return _size < other._size;
+}
+
+FileCacheKey buildFileCacheKey( const bfs::path& filename )
+{
+	FileCacheKey key;
+	key._path = bfs::absolute( filename ).string();
+	key._mtime = bfs::last_write_time( filename );
+	key._size = bfs::file_size( filename );
+	return key;
+}
+
+bfs::path fileCacheDirectory( const std::string& cacheName )
+{
+	if( const char* env_tuttle_home = std::getenv( "TUTTLE_HOME" ) )
+		return bfs::path( env_tuttle_home ) / cacheName;
+	return bfs::temp_directory_path() / "tuttle" / cacheName;
+}
+
+bfs::path fileCacheFilename( const std::string& cacheName, const FileCacheKey& key, const std::string& extension )
+{
+	std::size_t seed = 0;
+	boost::hash_combine( seed, key._path );
+	boost::hash_combine( seed, key._mtime );
+	boost::hash_combine( seed, key._size );
+	std::ostringstream name;
+	name << std::hex << seed << extension;
+	return fileCacheDirectory( cacheName ) / name.str();
+}
+
+bool writeFileCache( const bfs::path& cacheFile, const boost::function<void( std::ostream& )>& writer )
+{
+	try
+	{
+		bfs::create_directories( cacheFile.parent_path() );
+
+		const bfs::path tmpFile = bfs::unique_path( cacheFile.string() + ".%%%%-%%%%-%%%%" );
+		{
+			bfs::ofstream file( tmpFile, std::ios::out | std::ios::binary );
+			writer( file );
+			if( ! file )
+			{
+				file.close();
+				bfs::remove( tmpFile );
+				TUTTLE_LOG_WARNING( "Unable to write the cache file " << cacheFile );
+				return false;
+			}
+		}
+		bfs::rename( tmpFile, cacheFile );
+	}
+	catch( std::exception& e )
+	{
+		TUTTLE_LOG_WARNING( "Unable to write the cache file " << cacheFile << ": " << e.what() );
+		return false;
+	}
+	return true;
+}
+
+}
+}
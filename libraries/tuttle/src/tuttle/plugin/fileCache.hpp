@@ -0,0 +1,56 @@
+#ifndef _TUTTLE_PLUGIN_FILECACHE_HPP_
+#define _TUTTLE_PLUGIN_FILECACHE_HPP_
+
+#include <boost/filesystem/path.hpp>
+#include <boost/function.hpp>
+#include <boost/cstdint.hpp>
+
+#include <ostream>
+#include <string>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Identify a version of a file: the absolute path,
+ *        the modification time and the size of the file.
+ */
+struct FileCacheKey
+{
+	std::string _path;
+	boost::int64_t _mtime;
+	boost::uint64_t _size;
+
+	bool operator<( const FileCacheKey& other ) const;
+};
+
+/**
+ * @brief Key of the current version of a file.
+ * @exception boost::filesystem::filesystem_error if the file doesn't exist.
+ */
+FileCacheKey buildFileCacheKey( const boost::filesystem::path& filename );
+
+/**
+ * @brief Directory of a cache of files built from other files:
+ *        $TUTTLE_HOME/@p cacheName, or <tmp>/tuttle/@p cacheName.
+ */
+boost::filesystem::path fileCacheDirectory( const std::string& cacheName );
+
+/**
+ * @brief Cache file of a version of a file, in fileCacheDirectory( @p cacheName ).
+ * Different keys may share a cache file, so the file content has to store the key.
+ */
+boost::filesystem::path fileCacheFilename( const std::string& cacheName, const FileCacheKey& key, const std::string& extension );
+
+/**
+ * @brief Write a cache file with @p writer, in a unique temporary file
+ *        renamed at the end, as concurrent processes may create the same file.
+ * Errors are only reported as warnings, the cache is an optimization.
+ * @return the file was written
+ */
+bool writeFileCache( const boost::filesystem::path& cacheFile, const boost::function<void( std::ostream& )>& writer );
+
+}
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef _TUTTLE_PLUGIN_IMAGETILES_HPP_
+#define _TUTTLE_PLUGIN_IMAGETILES_HPP_
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/ofxToGil/image.hpp>
+#include <tuttle/plugin/numeric/rectOp.hpp>
+
+#include <ofxsImageEffect.h>
+
+#include <boost/gil/color_base_algorithm.hpp>
+#include <boost/gil/image_view_factory.hpp>
+
+namespace tuttle {
+namespace plugin {
+
+namespace detail {
+
+/**
+ * @brief Range of the tiles over a window, as the rectangle of their indices.
+ */
+inline OfxRectI tilesOverWindow( const OFX::Image& img, const OfxRectI& window )
+{
+	const OfxRectI bounds = img.getBounds();
+	const OfxRectI crop = rectanglesIntersection( window, bounds );
+	const OfxPointI tileSize = img.getTileSize();
+	OfxRectI tiles = { 0, 0, 0, 0 };
+	if( crop.x1 == crop.x2 || crop.y1 == crop.y2 )
+		return tiles;
+	tiles.x1 = ( crop.x1 - bounds.x1 ) / tileSize.x;
+	tiles.y1 = ( crop.y1 - bounds.y1 ) / tileSize.y;
+	tiles.x2 = ( crop.x2 - bounds.x1 + tileSize.x - 1 ) / tileSize.x;
+	tiles.y2 = ( crop.y2 - bounds.y1 + tileSize.y - 1 ) / tileSize.y;
+	return tiles;
+}
+
+}
+
+/**
+ * @brief Call functor( tileView, tileBounds ) on each populated tile of an
+ *        image kept in tiles by the host (see OFX::Image::isTiled), cropped to
+ *        a window in pixel coordinates.
+ *
+ * The views are ordered from bottom to top and only contain the pixels of the
+ * image bounds. An image which is not tiled is given as one tile.
+ * The tiles are released when the pixel data of the image is requested, so
+ * the functor must not request it.
+ * @return the image is tiled, the empty and constant tiles are given by forEachConstantTile
+ */
+template<class View, class Functor>
+bool forEachPopulatedTile( OFX::Image& img, const OfxRectI& window, Functor& functor )
+{
+	typedef typename View::value_type Pixel;
+	if( ! img.isTiled() )
+	{
+		const OfxRectI bounds = img.getBounds();
+		const OfxRectI crop = rectanglesIntersection( window, bounds );
+		if( crop.x1 != crop.x2 && crop.y1 != crop.y2 )
+		{
+			const View view = getGilView<View>( &img, bounds, eImageOrientationFromBottomToTop );
+			functor( boost::gil::subimage_view( view, crop.x1 - bounds.x1, crop.y1 - bounds.y1, crop.x2 - crop.x1, crop.y2 - crop.y1 ), crop );
+		}
+		return false;
+	}
+
+	const OfxPointI tileSize = img.getTileSize();
+	const int nbTilesX = ( img.getBounds().x2 - img.getBounds().x1 + tileSize.x - 1 ) / tileSize.x;
+	const OfxRectI tiles = detail::tilesOverWindow( img, window );
+	for( int y = tiles.y1; y < tiles.y2; ++y )
+	{
+		for( int x = tiles.x1; x < tiles.x2; ++x )
+		{
+			const int tile = y * nbTilesX + x;
+			if( img.getTileState( tile ) != kTuttleOfxImageTilePopulated )
+				continue;
+			const OfxRectI tileBounds = img.getTileBounds( tile );
+			const OfxRectI crop = rectanglesIntersection( window, tileBounds );
+			const View tileView = boost::gil::interleaved_view( tileBounds.x2 - tileBounds.x1,
+			                                                    tileBounds.y2 - tileBounds.y1,
+			                                                    static_cast<Pixel*>( img.getTileData( tile ) ),
+			                                                    tileSize.x * sizeof( Pixel ) );
+			functor( boost::gil::subimage_view( tileView, crop.x1 - tileBounds.x1, crop.y1 - tileBounds.y1, crop.x2 - crop.x1, crop.y2 - crop.y1 ), crop );
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Call functor( tileView, tileBounds ) on each populated tile of an
+ *        image kept in tiles by the host.
+ * @see forEachPopulatedTile( img, window, functor )
+ */
+template<class View, class Functor>
+bool forEachPopulatedTile( OFX::Image& img, Functor& functor )
+{
+	return forEachPopulatedTile<View>( img, img.getBounds(), functor );
+}
+
+/**
+ * @brief Call functor( pixel, tileBounds ) on each empty or constant tile of
+ *        an image kept in tiles by the host, cropped to a window in pixel
+ *        coordinates. Nothing if the image is not tiled.
+ */
+template<class Pixel, class Functor>
+void forEachConstantTile( const OFX::Image& img, const OfxRectI& window, Functor& functor )
+{
+	if( ! img.isTiled() )
+		return;
+
+	const OfxPointI tileSize = img.getTileSize();
+	const int nbTilesX = ( img.getBounds().x2 - img.getBounds().x1 + tileSize.x - 1 ) / tileSize.x;
+	const OfxRectI tiles = detail::tilesOverWindow( img, window );
+	for( int y = tiles.y1; y < tiles.y2; ++y )
+	{
+		for( int x = tiles.x1; x < tiles.x2; ++x )
+		{
+			const int tile = y * nbTilesX + x;
+			const OfxRectI crop = rectanglesIntersection( window, img.getTileBounds( tile ) );
+			switch( img.getTileState( tile ) )
+			{
+				case kTuttleOfxImageTileEmpty:
+				{
+					Pixel pixel;
+					boost::gil::static_fill( pixel, typename boost::gil::channel_type<Pixel>::type( 0 ) );
+					functor( pixel, crop );
+					break;
+				}
+				case kTuttleOfxImageTileConstant:
+					functor( *static_cast<const Pixel*>( img.getTileData( tile ) ), crop );
+					break;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Call functor( pixel, tileBounds ) on each empty or constant tile of
+ *        an image kept in tiles by the host.
+ * @see forEachConstantTile( img, window, functor )
+ */
+template<class Pixel, class Functor>
+void forEachConstantTile( const OFX::Image& img, Functor& functor )
+{
+	forEachConstantTile<Pixel>( img, img.getBounds(), functor );
+}
+
+}
+}
+
+#endif
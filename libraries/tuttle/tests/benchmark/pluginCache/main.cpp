@@ -0,0 +1,88 @@
+/**
+ * Startup time of the host: scan of the plugins without cache, then read
+ * of the plugin cache file.
+ *
+ * usage: benchmark [pluginPath]
+ */
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/PluginCacheFile.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+namespace {
+
+using namespace tuttle::host;
+
+/// A plugin cache independent of the core one
+class BenchmarkCache
+{
+public:
+	BenchmarkCache( Host& host, const std::string& pluginPath )
+		: _imageEffectPluginCache( host )
+	{
+		_pluginCache.setCacheVersion( "tuttleV1" );
+		_pluginCache.registerAPICache( _imageEffectPluginCache );
+		_pluginCache.addDirectoryToPath( pluginPath );
+	}
+
+	ofx::OfxhPluginCache& get() { return _pluginCache; }
+
+private:
+	ofx::imageEffect::OfxhImageEffectPluginCache _imageEffectPluginCache;
+	ofx::OfxhPluginCache _pluginCache;
+};
+
+/// Wall clock
+class Chrono
+{
+public:
+	Chrono() : _start( boost::posix_time::microsec_clock::universal_time() ) {}
+	double elapsed() const
+	{
+		return ( boost::posix_time::microsec_clock::universal_time() - _start ).total_microseconds() * 1e-6;
+	}
+
+private:
+	boost::posix_time::ptime _start;
+};
+
+void print( const std::string& name, const double time, ofx::OfxhPluginCache& cache )
+{
+	std::cout << std::setw( 24 ) << name << " : "
+	          << std::setw( 8 ) << 1e3 * time << " ms, "
+	          << cache.getPlugins().size() << " plugins" << std::endl;
+}
+
+}
+
+int main( int argc, char** argv )
+{
+	const std::string pluginPath = argc > 1 ? argv[1] : BOOST_PP_STRINGIZE( TUTTLE_PLUGIN_PATH );
+	const std::string cacheFile = ( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "tuttlePluginCache-%%%%-%%%%.bin" ) ).string();
+
+	Host host;
+	{
+		BenchmarkCache cache( host, pluginPath );
+		Chrono t;
+		cache.get().scanPluginFiles();
+		print( "scan", t.elapsed(), cache.get() );
+
+		t = Chrono();
+		writePluginCache( cacheFile, cache.get() );
+		print( "write cache", t.elapsed(), cache.get() );
+	}
+	{
+		BenchmarkCache cache( host, pluginPath );
+		Chrono t;
+		readPluginCache( cacheFile, cache.get() );
+		cache.get().scanPluginFiles();
+		print( "read cache and scan", t.elapsed(), cache.get() );
+	}
+	boost::filesystem::remove( cacheFile );
+	return 0;
+}
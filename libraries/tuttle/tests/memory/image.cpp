@@ -0,0 +1,105 @@
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstring>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace {
+
+static const double kColor[4] = { 0.2, 0.5, 0.7, 0.9 };
+
+/// Expected value of a channel, rounded to the nearest integer value
+template<typename Channel>
+Channel expectedChannel( const double v, const double maxValue )
+{
+	if( maxValue == 0.0 )
+		return static_cast<Channel>( v );
+	return static_cast<Channel>( v * maxValue + 0.5 );
+}
+
+template<typename Channel>
+void checkConstantPixels( attribute::Image& img, const int nbChannels, const double maxValue )
+{
+	// the alpha of the color for an Alpha image
+	const double* color = nbChannels == 1 ? &kColor[3] : kColor;
+	const OfxRectI bounds = img.getBounds();
+	const boost::uint8_t* data = img.getPixelData();
+	for( int y = 0; y < bounds.y2 - bounds.y1; ++y )
+	{
+		const Channel* pixel = reinterpret_cast<const Channel*>( data + y * img.getRowAbsDistanceBytes() );
+		for( int x = 0; x < bounds.x2 - bounds.x1; ++x )
+		{
+			for( int c = 0; c < nbChannels; ++c, ++pixel )
+			{
+				BOOST_CHECK_EQUAL( *pixel, expectedChannel<Channel>( color[c], maxValue ) );
+			}
+		}
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( memory_tests_image )
+
+BOOST_AUTO_TEST_CASE( image_constant_lazy_allocation )
+{
+	// explicitConversion: 1 byte, 2 short, 3 float
+	// channel: 0 gray (alpha), 1 rgb, 2 rgba
+	for( int bitDepth = 1; bitDepth <= 3; ++bitDepth )
+	{
+		for( int components = 0; components <= 2; ++components )
+		{
+			Graph g;
+			Graph::Node& constant = g.createNode( "tuttle.constant" );
+			constant.getParam( "mode" ).setValue( 1 ); // size
+			constant.getParam( "width" ).setValue( 67 );
+			constant.getParam( "height" ).setValue( 5 );
+			constant.getParam( "explicitConversion" ).setValue( bitDepth );
+			constant.getParam( "channel" ).setValue( components );
+
+			memory::MemoryCache outputCache;
+			g.compute( outputCache, constant );
+			memory::CACHE_ELEMENT img = outputCache.get( constant.getName(), 0 );
+			BOOST_REQUIRE( img.get() );
+
+			// set as constant without pixels, as after the render of a constant image
+			img->setPoolData( memory::IPoolDataPtr() );
+			img->setIntProperty( kTuttleOfxImagePropConstant, 1 );
+			for( int c = 0; c < 4; ++c )
+				img->setDoubleProperty( kTuttleOfxImagePropConstantColor, kColor[c], c );
+			BOOST_CHECK( img->isConstant() );
+
+			// the pixels are allocated and filled on the first access
+			const std::size_t usedMemory = core().getMemoryPool().getUsedMemorySize();
+			const boost::uint8_t* data = img->getPixelData();
+			BOOST_REQUIRE( data != NULL );
+			BOOST_CHECK_GE( core().getMemoryPool().getUsedMemorySize(), usedMemory + img->getMemorySize() );
+			// and only once
+			BOOST_CHECK_EQUAL( img->getPixelData(), data );
+
+			const int nbChannels = components + ( components == 0 ? 1 : 2 );
+			switch( bitDepth )
+			{
+				case 1:
+					checkConstantPixels<boost::uint8_t>( *img, nbChannels, 255.0 );
+					break;
+				case 2:
+					checkConstantPixels<boost::uint16_t>( *img, nbChannels, 65535.0 );
+					break;
+				case 3:
+					checkConstantPixels<float>( *img, nbChannels, 0.0 );
+					break;
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/attribute/ImageTiles.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstring>
+#include <vector>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace {
+
+// 3 x 2 tiles, the last column and the last row are partial
+static const int kWidth = 2 * attribute::ImageTiles::kTileSize + 22;
+static const int kHeight = attribute::ImageTiles::kTileSize + 6;
+static const std::size_t kPixelBytes = 4;
+static const int kRowBytes = kWidth * kPixelBytes;
+
+/**
+ * Tiles, from the bottom:
+ *   empty,    constant, populated
+ *   empty,    constant, populated
+ */
+boost::uint8_t sparseChannel( const int x, const int y, const std::size_t c )
+{
+	const int tileX = x / attribute::ImageTiles::kTileSize;
+	const int tileY = y / attribute::ImageTiles::kTileSize;
+	switch( tileX )
+	{
+		case 0:
+			return 0;
+		case 1:
+			return static_cast<boost::uint8_t>( tileY * 10 + c + 1 );
+	}
+	return static_cast<boost::uint8_t>( x * 3 + y * 7 + c );
+}
+
+boost::uint8_t denseChannel( const int x, const int y, const std::size_t c )
+{
+	return static_cast<boost::uint8_t>( x + y * 5 + c + 1 );
+}
+
+/// Pixels with the rows ordered from the bottom, or from the top
+std::vector<boost::uint8_t> makePixels( boost::uint8_t (*channel)( const int, const int, const std::size_t ), const bool fromTop )
+{
+	std::vector<boost::uint8_t> pixels( kHeight * kRowBytes );
+	for( int y = 0; y < kHeight; ++y )
+	{
+		boost::uint8_t* row = &pixels[( fromTop ? kHeight - 1 - y : y ) * kRowBytes];
+		for( int x = 0; x < kWidth; ++x )
+			for( std::size_t c = 0; c < kPixelBytes; ++c )
+				row[x * kPixelBytes + c] = channel( x, y, c );
+	}
+	return pixels;
+}
+
+/// First pixel of the bottom row
+boost::uint8_t* bottomRow( std::vector<boost::uint8_t>& pixels, const bool fromTop )
+{
+	return &pixels[fromTop ? ( kHeight - 1 ) * kRowBytes : 0];
+}
+
+void checkSparseTiles( const bool fromTop )
+{
+	std::vector<boost::uint8_t> src = makePixels( &sparseChannel, fromTop );
+	const int rowDistanceBytes = fromTop ? -kRowBytes : kRowBytes;
+	const OfxPointI dimensions = { kWidth, kHeight };
+	attribute::ImageTiles tiles( bottomRow( src, fromTop ), rowDistanceBytes, dimensions, kPixelBytes, 0.5 );
+
+	BOOST_REQUIRE( tiles.isValid() );
+	BOOST_REQUIRE_EQUAL( 6U, tiles.getNbTiles() );
+	BOOST_CHECK_EQUAL( 2U, tiles.getNbPopulatedTiles() );
+	for( std::size_t tile = 0; tile < tiles.getNbTiles(); ++tile )
+	{
+		const std::size_t tileX = tile % 3;
+		const std::size_t tileY = tile / 3;
+		switch( tileX )
+		{
+			case 0:
+				BOOST_CHECK_EQUAL( attribute::ImageTiles::eTileEmpty, tiles.getState( tile ) );
+				BOOST_CHECK( tiles.getData( tile ) == NULL );
+				break;
+			case 1:
+			{
+				BOOST_CHECK_EQUAL( attribute::ImageTiles::eTileConstant, tiles.getState( tile ) );
+				const boost::uint8_t* pixel = static_cast<const boost::uint8_t*>( tiles.getData( tile ) );
+				BOOST_REQUIRE( pixel != NULL );
+				for( std::size_t c = 0; c < kPixelBytes; ++c )
+					BOOST_CHECK_EQUAL( int( tileY * 10 + c + 1 ), int( pixel[c] ) );
+				break;
+			}
+			case 2:
+			{
+				BOOST_CHECK_EQUAL( attribute::ImageTiles::eTilePopulated, tiles.getState( tile ) );
+				// the pixels inside of the image, with a row size of the tile width
+				const boost::uint8_t* data = static_cast<const boost::uint8_t*>( tiles.getData( tile ) );
+				BOOST_REQUIRE( data != NULL );
+				const int x1 = 2 * attribute::ImageTiles::kTileSize;
+				const int y1 = tileY * attribute::ImageTiles::kTileSize;
+				const int y2 = tileY ? kHeight : attribute::ImageTiles::kTileSize;
+				for( int y = y1; y < y2; ++y )
+				{
+					const boost::uint8_t* row = data + ( y - y1 ) * attribute::ImageTiles::kTileSize * kPixelBytes;
+					for( int x = x1; x < kWidth; ++x )
+						for( std::size_t c = 0; c < kPixelBytes; ++c )
+							BOOST_REQUIRE_EQUAL( int( sparseChannel( x, y, c ) ), int( row[( x - x1 ) * kPixelBytes + c] ) );
+				}
+				break;
+			}
+		}
+	}
+
+	// round trip, in a buffer with the same orientation
+	std::vector<boost::uint8_t> dst( src.size(), 0xAB );
+	tiles.fill( bottomRow( dst, fromTop ), rowDistanceBytes );
+	BOOST_CHECK( dst == src );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( memory_tests_imageTiles )
+
+BOOST_AUTO_TEST_CASE( imageTiles_fromBottomToTop )
+{
+	checkSparseTiles( false );
+}
+
+BOOST_AUTO_TEST_CASE( imageTiles_fromTopToBottom )
+{
+	checkSparseTiles( true );
+}
+
+BOOST_AUTO_TEST_CASE( imageTiles_dense )
+{
+	// all the tiles are populated, the image is not split
+	std::vector<boost::uint8_t> src = makePixels( &denseChannel, false );
+	const OfxPointI dimensions = { kWidth, kHeight };
+	attribute::ImageTiles tiles( &src[0], kRowBytes, dimensions, kPixelBytes, 0.5 );
+	BOOST_CHECK( ! tiles.isValid() );
+	BOOST_CHECK_EQUAL( 0U, tiles.getNbTiles() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
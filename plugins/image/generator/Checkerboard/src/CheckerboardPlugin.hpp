@@ -20,6 +20,9 @@ public:
 	void render( const OFX::RenderArguments& args );
 	void getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences );
 
+protected:
+	bool varyOnTime() const { return false; }
+
 public:
 	OFX::Int2DParam* _boxes;
 	OFX::RGBAParam* _color1;
@@ -44,6 +44,9 @@ public:
 	template<class View>
 	ColorGradientProcessParams<View> getProcessParams() const;
 
+protected:
+	bool varyOnTime() const { return false; }
+
 public:
 	typedef std::vector<OFX::Double2DParam*> Double2DParamVector;
 	typedef std::vector<OFX::RGBAParam*> RGBAParamVector;
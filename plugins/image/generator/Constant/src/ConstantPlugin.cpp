@@ -2,7 +2,10 @@
 #include "ConstantProcess.hpp"
 #include "ConstantDefinitions.hpp"
 
+#include <tuttle/plugin/constantImage.hpp>
+
 #include <boost/gil/gil_all.hpp>
+#include <boost/scoped_ptr.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -20,6 +23,16 @@ ConstantPlugin::ConstantPlugin( OfxImageEffectHandle handle )
  */
 void ConstantPlugin::render( const OFX::RenderArguments& args )
 {
+	// the output is set as a constant image, the host only allocates it
+	// if a node needs the pixels
+	if( _clipDst->getPixelComponents() == OFX::ePixelComponentRGBA )
+	{
+		boost::scoped_ptr<OFX::Image> dst( _clipDst->fetchImage( args.time ) );
+		if( dst.get() &&
+		    isRenderingAllImage( *dst, args.renderWindow ) &&
+		    dst->setConstantColor( _color->getValue() ) )
+			return;
+	}
 	doGilRender<ConstantProcess>( *this, args );
 }
 
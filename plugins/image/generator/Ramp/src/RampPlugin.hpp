@@ -23,6 +23,9 @@ public:
 	void getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences );
 	void render( const OFX::RenderArguments &args );
 	
+protected:
+	bool varyOnTime() const { return false; }
+
 public:
 	OFX::ChoiceParam*  _direction;
 	
@@ -1,6 +1,7 @@
 #include "SeExprPlugin.hpp"
 #include "SeExprProcess.hpp"
 #include "SeExprDefinitions.hpp"
+#include "SeExprProgram.hpp"
 
 #include <boost/gil/gil_all.hpp>
 #include <fstream>
@@ -63,6 +64,14 @@ SeExprProcessParams<SeExprPlugin::Scalar> SeExprPlugin::getProcessParams( const
 	return params;
 }
 
+boost::shared_ptr<SeExprProgram> SeExprPlugin::getProgram( const std::string& code )
+{
+	boost::shared_ptr<SeExprProgram> program = SeExprProgramCache::instance().get( code );
+	boost::mutex::scoped_lock lock( _programMutex );
+	_program = program;
+	return program;
+}
+
 void SeExprPlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName )
 {
 	GeneratorPlugin::changedParam( args, paramName );
@@ -103,6 +112,12 @@ void SeExprPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferenc
 	GeneratorPlugin::getClipPreferences( clipPreferences );
 }
 
+bool SeExprPlugin::varyOnTime() const
+{
+	// the program is kept for the render
+	return const_cast<SeExprPlugin*>( this )->getProgram( getProcessParams()._code )->isTimeVarying();
+}
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
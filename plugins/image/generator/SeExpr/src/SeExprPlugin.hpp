@@ -6,6 +6,9 @@
 #include <tuttle/plugin/context/GeneratorPlugin.hpp>
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace seExpr {
@@ -19,6 +22,8 @@ struct SeExprProcessParams
 	Point       _paramTextureOffset;
 };
 
+class SeExprProgram;
+
 /**
  * @brief SeExpr plugin
  */
@@ -32,10 +37,17 @@ public:
 public:
 	SeExprProcessParams<Scalar> getProcessParams( const OfxPointD& renderScale = OFX::kNoRenderScale ) const;
 
+	/// @brief The prepared program of the code, kept by the plugin for the next renders.
+	boost::shared_ptr<SeExprProgram> getProgram( const std::string& code );
+
 	void changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName );
 
 	void getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences );
 	void render( const OFX::RenderArguments &args );
+
+protected:
+	/// @brief The code uses the "frame" or the "time" variable.
+	bool varyOnTime() const;
 	
 public:
 	OFX::ChoiceParam*   _paramInput;
@@ -44,6 +56,9 @@ public:
 	OFX::Double2DParam* _paramTextureOffset;
 private:
 	OFX::InstanceChangedArgs _instanceChangedArgs;
+
+	boost::mutex _programMutex;
+	boost::shared_ptr<SeExprProgram> _program;
 };
 
 }
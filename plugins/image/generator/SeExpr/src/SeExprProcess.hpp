@@ -5,7 +5,9 @@
 
 #include <SeExpression.h>
 
-#include "SeExprAlgorithm.hpp"
+#include "SeExprProgram.hpp"
+
+#include <boost/shared_ptr.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -14,6 +16,9 @@ namespace seExpr {
 /**
  * @brief SeExpr process
  *
+ * Each render thread evaluates its own prepared copy of the expression.
+ * An expression which doesn't use the frame or the time is rendered once,
+ * and its colors are reused for the next frames.
  */
 template<class View>
 class SeExprProcess : public ImageGilProcessor<View>
@@ -32,9 +37,13 @@ public:
 	void setup( const OFX::RenderArguments& args );
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+	void postProcess();
 private:
-	OfxRectD rod;
-	size_t _time;
+	boost::shared_ptr<SeExprProgram> _program;
+	SeExprContext _context;
+	boost::shared_ptr<const SeExprFrame> _cachedFrame; ///< colors of a previous frame
+	boost::shared_ptr<SeExprFrame> _renderedFrame;     ///< colors of this frame, to reuse for the next frames
 };
 
 }
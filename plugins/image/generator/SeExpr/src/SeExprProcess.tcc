@@ -7,7 +7,6 @@ SeExprProcess<View>::SeExprProcess( SeExprPlugin &effect )
 	: ImageGilProcessor<View>( effect, eImageOrientationIndependant )
 	, _plugin( effect )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>
@@ -16,24 +15,37 @@ void SeExprProcess<View>::setup( const OFX::RenderArguments& args )
 	ImageGilProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.renderScale );
 
-	rod = _plugin._clipDst->getCanonicalRod( args.time );
+	const OfxRectD rod = _plugin._clipDst->getCanonicalRod( args.time );
 
-	_time = args.time;
-	
 	TUTTLE_TLOG( TUTTLE_INFO, _params._code );
 
-	ImageSynthExpr expr( _params._code );
-	expr.vars["u"] = ImageSynthExpr::Var( _params._paramTextureOffset.x );
-	expr.vars["v"] = ImageSynthExpr::Var( _params._paramTextureOffset.y );
-	expr.vars["w"] = ImageSynthExpr::Var( rod.x2 - rod.x1 );
-	expr.vars["h"] = ImageSynthExpr::Var( rod.y2 - rod.y1 );
-	expr.vars["frame"] = ImageSynthExpr::Var( _time );
-
-	bool valid = expr.isValid();
-	if( !valid )
+	_program = _plugin.getProgram( _params._code );
+	if( ! _program->isValid() )
 	{
 		TUTTLE_LOG( TUTTLE_ERROR, "Invalid expression" );
-		TUTTLE_LOG( TUTTLE_ERROR, expr.parseError() );
+		TUTTLE_LOG( TUTTLE_ERROR, _program->parseError() );
+	}
+
+	_context._width  = rod.x2 - rod.x1;
+	_context._height = rod.y2 - rod.y1;
+	_context._frame  = args.time;
+	_context._time   = args.time;
+
+	_cachedFrame.reset();
+	_renderedFrame.reset();
+	if( ! _program->isTimeVarying() )
+	{
+		SeExprFrame render;
+		render._rod = this->_dstPixelRod;
+		render._renderWindow = args.renderWindow;
+		render._offsetX = _params._paramTextureOffset.x;
+		render._offsetY = _params._paramTextureOffset.y;
+		_cachedFrame = _program->getFrame( render );
+		if( ! _cachedFrame )
+		{
+			_renderedFrame.reset( new SeExprFrame( render ) );
+			_renderedFrame->_rgb.resize( 3 * this->_renderWindowSize.x * this->_renderWindowSize.y );
+		}
 	}
 }
 
@@ -52,38 +64,64 @@ void SeExprProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRo
 		procWindowRoW.y2 - procWindowRoW.y1
 	};
 
-	ImageSynthExpr expr( _params._code );
-	expr.vars["u"] = ImageSynthExpr::Var( _params._paramTextureOffset.x );
-	expr.vars["v"] = ImageSynthExpr::Var( _params._paramTextureOffset.y );
-	expr.vars["w"] = ImageSynthExpr::Var( rod.x2 - rod.x1 );
-	expr.vars["h"] = ImageSynthExpr::Var( rod.y2 - rod.y1 );
-	expr.vars["frame"] = ImageSynthExpr::Var( _time );
+	if( _cachedFrame )
+	{
+		for( int y = procWindowRoW.y1; y < procWindowRoW.y2; ++y )
+		{
+			typename View::x_iterator dst_it = this->_dstView.x_at( procWindowOutput.x1, procWindowOutput.y1 + y - procWindowRoW.y1 );
+			const float* rgb = _cachedFrame->pixel( procWindowRoW.x1, y );
+			for( int x = procWindowRoW.x1; x < procWindowRoW.x2; ++x, ++dst_it, rgb += 3 )
+			{
+				color_convert( rgba32f_pixel_t( rgb[0], rgb[1], rgb[2], 1.0 ), *dst_it );
+			}
+			if( this->progressForward( procWindowSize.x ) )
+				return;
+		}
+		return;
+	}
+
+	// normalized coordinates in the image, independent of the rows processed by this thread
+	const double one_over_width  = 1.0 / this->_dstPixelRodSize.x;
+	const double one_over_height = 1.0 / this->_dstPixelRodSize.y;
 
-	double one_over_width  = 1.0 / procWindowSize.x;
-	double one_over_height = 1.0 / procWindowSize.y;
-	double& u = expr.vars["u"].val;
-	double& v = expr.vars["v"].val;
+	SeExprProgram::ScopedExpression expr( *_program, _context );
 
 	for( int y = procWindowOutput.y1;
 			 y < procWindowOutput.y2;
 			 ++y )
 	{
 		typename View::x_iterator dst_it = this->_dstView.x_at( procWindowOutput.x1, y );
+		float* rgb = _renderedFrame ? _renderedFrame->pixel( procWindowRoW.x1, procWindowRoW.y1 + y - procWindowOutput.y1 ) : NULL;
 		for( int x = procWindowOutput.x1;
 			 x < procWindowOutput.x2;
 			 ++x, ++dst_it )
 		{
-			u = one_over_width  * ( x + .5 - _params._paramTextureOffset.x );
-			v = one_over_height * ( y + .5 - _params._paramTextureOffset.y );
-			SeVec3d result = expr.evaluate();
+			const double u = one_over_width  * ( x + .5 - _params._paramTextureOffset.x );
+			const double v = one_over_height * ( y + .5 - _params._paramTextureOffset.y );
+			const SeVec3d result = expr( u, v );
 
 			color_convert( rgba32f_pixel_t( (float)result[0], (float)result[1], (float)result[2], 1.0 ), *dst_it );
+			if( rgb )
+			{
+				*rgb++ = (float)result[0];
+				*rgb++ = (float)result[1];
+				*rgb++ = (float)result[2];
+			}
 		}
 		if( this->progressForward( procWindowSize.x ) )
 			return;
 	}
 }
 
+template<class View>
+void SeExprProcess<View>::postProcess()
+{
+	// an aborted render is not complete
+	if( _renderedFrame && ! this->_effect.abort() )
+		_program->setFrame( _renderedFrame );
+	ImageGilProcessor<View>::postProcess();
+}
+
 }
 }
 }
@@ -0,0 +1,110 @@
+#include "SeExprProgram.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace seExpr {
+
+bool SeExprFrame::isSameRender( const SeExprFrame& other ) const
+{
+	return _rod.x1 == other._rod.x1 && _rod.y1 == other._rod.y1 &&
+	       _rod.x2 == other._rod.x2 && _rod.y2 == other._rod.y2 &&
+	       _renderWindow.x1 == other._renderWindow.x1 && _renderWindow.y1 == other._renderWindow.y1 &&
+	       _renderWindow.x2 == other._renderWindow.x2 && _renderWindow.y2 == other._renderWindow.y2 &&
+	       _offsetX == other._offsetX && _offsetY == other._offsetY;
+}
+
+SeExprProgram::SeExprProgram( const std::string& code )
+: _code( code )
+{
+	TUTTLE_TLOG( TUTTLE_INFO, "SeExpr -- Prepare code: " << _code );
+	boost::shared_ptr<ImageSynthExpr> expr = newExpression();
+	_valid = expr->isValid();
+	if( ! _valid )
+		_parseError = expr->parseError();
+	_timeVarying = expr->usesVar( "frame" ) || expr->usesVar( "time" );
+	_exprs.push_back( expr );
+}
+
+boost::shared_ptr<ImageSynthExpr> SeExprProgram::newExpression() const
+{
+	boost::shared_ptr<ImageSynthExpr> expr( new ImageSynthExpr( _code ) );
+	// the variables are bound when the expression is prepared,
+	// their values are set before each evaluation
+	expr->vars["u"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["v"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["w"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["h"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["frame"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["time"] = ImageSynthExpr::Var( 0.0 );
+	// parse and prepare
+	expr->isValid();
+	return expr;
+}
+
+SeExprProgram::ScopedExpression::ScopedExpression( SeExprProgram& program, const SeExprContext& context )
+: _program( program )
+{
+	{
+		boost::mutex::scoped_lock lock( _program._exprsMutex );
+		if( ! _program._exprs.empty() )
+		{
+			_expr = _program._exprs.back();
+			_program._exprs.pop_back();
+		}
+	}
+	if( ! _expr )
+		_expr = _program.newExpression();
+
+	_expr->vars["w"].val = context._width;
+	_expr->vars["h"].val = context._height;
+	_expr->vars["frame"].val = context._frame;
+	_expr->vars["time"].val = context._time;
+	_u = &_expr->vars["u"].val;
+	_v = &_expr->vars["v"].val;
+}
+
+SeExprProgram::ScopedExpression::~ScopedExpression()
+{
+	boost::mutex::scoped_lock lock( _program._exprsMutex );
+	_program._exprs.push_back( _expr );
+}
+
+boost::shared_ptr<const SeExprFrame> SeExprProgram::getFrame( const SeExprFrame& render ) const
+{
+	boost::mutex::scoped_lock lock( _frameMutex );
+	if( _frame && _frame->isSameRender( render ) )
+		return _frame;
+	return boost::shared_ptr<const SeExprFrame>();
+}
+
+void SeExprProgram::setFrame( const boost::shared_ptr<const SeExprFrame>& frame )
+{
+	boost::mutex::scoped_lock lock( _frameMutex );
+	_frame = frame;
+}
+
+boost::shared_ptr<SeExprProgram> SeExprProgramCache::get( const std::string& code )
+{
+	boost::mutex::scoped_lock lockerMap( _mutex );
+	boost::shared_ptr<SeExprProgram> program = _programs[code].lock();
+	if( program )
+		return program;
+
+	// remove the entries of the programs which are no longer used
+	for( std::map<std::string, boost::weak_ptr<SeExprProgram> >::iterator it = _programs.begin(); it != _programs.end(); )
+	{
+		if( it->second.expired() )
+			_programs.erase( it++ );
+		else
+			++it;
+	}
+	program.reset( new SeExprProgram( code ) );
+	_programs[code] = program;
+	return program;
+}
+
+}
+}
+}
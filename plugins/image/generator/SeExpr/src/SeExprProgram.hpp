@@ -0,0 +1,145 @@
+#ifndef _TUTTLE_PLUGIN_SEEXPR_PROGRAM_HPP_
+#define _TUTTLE_PLUGIN_SEEXPR_PROGRAM_HPP_
+
+#include <SeExpression.h>
+
+#include "SeExprAlgorithm.hpp"
+
+#include <tuttle/common/patterns/StaticSingleton.hpp>
+
+#include <ofxCore.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace seExpr {
+
+/**
+ * @brief Frame-independent variables of an evaluation.
+ */
+struct SeExprContext
+{
+	double _width;  ///< "w" variable
+	double _height; ///< "h" variable
+	double _frame;  ///< "frame" variable
+	double _time;   ///< "time" variable
+};
+
+/**
+ * @brief Colors rendered by a time-invariant expression, reused for the next frames.
+ */
+struct SeExprFrame
+{
+	OfxRectI _rod;          ///< pixel rod of the output
+	OfxRectI _renderWindow; ///< rendered pixels
+	double _offsetX;
+	double _offsetY;
+	std::vector<float> _rgb; ///< rgb of the render window, rows from renderWindow.y1
+
+	bool isSameRender( const SeExprFrame& other ) const;
+
+	float* pixel( const int x, const int y )
+	{
+		return &_rgb[3 * ( ( y - _renderWindow.y1 ) * ( _renderWindow.x2 - _renderWindow.x1 ) + ( x - _renderWindow.x1 ) )];
+	}
+	const float* pixel( const int x, const int y ) const
+	{
+		return &_rgb[3 * ( ( y - _renderWindow.y1 ) * ( _renderWindow.x2 - _renderWindow.x1 ) + ( x - _renderWindow.x1 ) )];
+	}
+};
+
+/**
+ * @brief A SeExpr program, parsed and prepared once for each render thread.
+ *
+ * An expression is evaluated by one thread at a time: the evaluation writes
+ * in the nodes of the expression. The prepared expressions are reused by
+ * the next renders.
+ */
+class SeExprProgram : boost::noncopyable
+{
+public:
+	explicit SeExprProgram( const std::string& code );
+
+	bool isValid() const { return _valid; }
+	const std::string& parseError() const { return _parseError; }
+
+	/// @brief The expression uses the "frame" or the "time" variable.
+	bool isTimeVarying() const { return _timeVarying; }
+
+	/**
+	 * @brief A prepared expression, used by one thread while this object is alive.
+	 */
+	class ScopedExpression : boost::noncopyable
+	{
+	public:
+		ScopedExpression( SeExprProgram& program, const SeExprContext& context );
+		~ScopedExpression();
+
+		/// @brief Evaluate the expression at the texture coordinates (u, v).
+		SeVec3d operator()( const double u, const double v )
+		{
+			*_u = u;
+			*_v = v;
+			return _expr->evaluate();
+		}
+
+	private:
+		SeExprProgram& _program;
+		boost::shared_ptr<ImageSynthExpr> _expr;
+		double* _u;
+		double* _v;
+	};
+
+	/// @brief The frame rendered with the same parameters, or NULL.
+	boost::shared_ptr<const SeExprFrame> getFrame( const SeExprFrame& render ) const;
+	/// @brief Keep a rendered frame (only the last one is kept).
+	void setFrame( const boost::shared_ptr<const SeExprFrame>& frame );
+
+private:
+	boost::shared_ptr<ImageSynthExpr> newExpression() const;
+
+private:
+	const std::string _code;
+	bool _valid;
+	std::string _parseError;
+	bool _timeVarying;
+
+	boost::mutex _exprsMutex;
+	std::vector<boost::shared_ptr<ImageSynthExpr> > _exprs; ///< expressions not used by a thread
+
+	mutable boost::mutex _frameMutex;
+	boost::shared_ptr<const SeExprFrame> _frame;
+};
+
+/**
+ * @brief Process-wide cache of the prepared SeExpr programs, identified by the code.
+ *
+ * A program is shared by all the SeExpr nodes using the same code, as long
+ * as one of them is alive.
+ */
+class SeExprProgramCache : public StaticSingleton<SeExprProgramCache>
+{
+	MAKE_StaticSingleton( SeExprProgramCache )
+
+public:
+	/// @brief Get the program of a code, the code is only parsed if it is not in memory.
+	boost::shared_ptr<SeExprProgram> get( const std::string& code );
+
+private:
+	boost::mutex _mutex; ///< Mutex for the programs map.
+	std::map<std::string, boost::weak_ptr<SeExprProgram> > _programs;
+};
+
+}
+}
+}
+
+#endif
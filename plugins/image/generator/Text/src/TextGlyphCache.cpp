@@ -0,0 +1,245 @@
+#include "TextGlyphCache.hpp"
+
+#include <terry/freetype/freegil.hpp>
+
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef __WINDOWS__
+#include <fontconfig/fontconfig.h>
+#endif
+
+namespace tuttle {
+namespace plugin {
+namespace text {
+
+namespace {
+
+/// Maximum number of layouts kept, texts which change at each frame are not reused
+static const std::size_t kMaxLayouts = 64;
+
+/// Glyph of the terry freetype functors
+struct FaceGlyph
+{
+	char ch;
+	FT_Face face;
+
+	FaceGlyph( const char c, FT_Face f ) : ch( c ), face( f ) {}
+};
+
+}
+
+bool TextFont::operator<( const TextFont& other ) const
+{
+	if( _file != other._file )
+		return _file < other._file;
+	if( _sizeX != other._sizeX )
+		return _sizeX < other._sizeX;
+	return _sizeY < other._sizeY;
+}
+
+bool TextGlyphCache::FontFileKey::operator<( const FontFileKey& other ) const
+{
+	if( _fontPath != other._fontPath )
+		return _fontPath < other._fontPath;
+	if( _font != other._font )
+		return _font < other._font;
+	if( _bold != other._bold )
+		return _bold < other._bold;
+	return _italic < other._italic;
+}
+
+bool TextGlyphCache::GlyphKey::operator<( const GlyphKey& other ) const
+{
+	if( _ch != other._ch )
+		return _ch < other._ch;
+	return _font < other._font;
+}
+
+bool TextGlyphCache::LayoutKey::operator<( const LayoutKey& other ) const
+{
+	if( _text != other._text )
+		return _text < other._text;
+	if( _letterSpacing != other._letterSpacing )
+		return _letterSpacing < other._letterSpacing;
+	return _font < other._font;
+}
+
+TextGlyphCache::TextGlyphCache()
+{
+	FT_Init_FreeType( &_library );
+}
+
+TextGlyphCache::~TextGlyphCache()
+{
+	// also releases the faces
+	FT_Done_FreeType( _library );
+}
+
+std::string TextGlyphCache::getFontFile( const TextProcessParams& params )
+{
+	FontFileKey key;
+	key._fontPath = params._fontPath;
+#ifndef __WINDOWS__
+	key._font = params._font;
+#else
+	key._font = 0;
+#endif
+	key._bold = params._bold;
+	key._italic = params._italic;
+
+	boost::mutex::scoped_lock lock( _mutex );
+	std::map<FontFileKey, std::string>::const_iterator it = _fontFiles.find( key );
+	if( it != _fontFiles.end() )
+		return it->second;
+
+	std::string selectedFont = "";
+
+	if( !boost::filesystem::exists( params._fontPath ) || boost::filesystem::is_directory( params._fontPath ) )
+	{
+#ifdef __WINDOWS__
+		BOOST_THROW_EXCEPTION( exception::FileNotExist( params._fontPath )
+							<< exception::user( "Text: Error in Font Path." )
+							<< exception::filename( params._fontPath ) );
+#else
+		FcInit();
+
+		FcChar8 *file;
+		FcResult result;
+		FcConfig *config = FcInitLoadConfigAndFonts();
+		FcPattern *p = FcPatternBuild(
+						   NULL,
+						   FC_WEIGHT, FcTypeInteger, FC_WEIGHT_BOLD,
+						   FC_SLANT, FcTypeInteger, FC_SLANT_ITALIC,
+						   NULL );
+
+		FcObjectSet *os = FcObjectSetBuild( FC_FAMILY, NULL );
+		FcFontSet   *fs = FcFontList( config, p, os );
+
+		selectedFont = (char*) FcNameUnparse( fs->fonts[params._font] );
+
+		int weight = ( params._bold   == 1) ? FC_WEIGHT_BOLD  : FC_WEIGHT_MEDIUM;
+		int slant  = ( params._italic == 1) ? FC_SLANT_ITALIC : FC_SLANT_ROMAN;
+
+		p  = FcPatternBuild( NULL,
+							 FC_FAMILY, FcTypeString, selectedFont.c_str(),
+							 FC_WEIGHT, FcTypeInteger, weight,
+							 FC_SLANT, FcTypeInteger, slant,
+							 NULL );
+
+		FcPatternGetString( FcFontMatch( 0, p, &result ), FC_FILE, 0, &file );
+		selectedFont = (char*) file;
+#endif
+	}
+	else
+	{
+		selectedFont = params._fontPath;
+	}
+	_fontFiles[key] = selectedFont;
+	return selectedFont;
+}
+
+FT_Face TextGlyphCache::getFace( const TextFont& font )
+{
+	std::map<TextFont, FT_Face>::const_iterator it = _faces.find( font );
+	if( it != _faces.end() )
+		return it->second;
+
+	FT_Face face;
+	if( FT_New_Face( _library, font._file.c_str(), 0, &face ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Text: Unable to load the font." )
+			<< exception::filename( font._file ) );
+	}
+	FT_Set_Pixel_Sizes( face, font._sizeX, font._sizeY );
+	_faces[font] = face;
+	return face;
+}
+
+boost::shared_ptr<const TextGlyph> TextGlyphCache::getGlyph( const TextFont& font, FT_Face face, const char ch )
+{
+	GlyphKey key;
+	key._font = font;
+	key._ch = ch;
+	boost::shared_ptr<const TextGlyph>& cached = _glyphs[key];
+	if( cached )
+		return cached;
+
+	boost::shared_ptr<TextGlyph> glyph( new TextGlyph() );
+	FT_GlyphSlot slot = face->glyph;
+	FT_Load_Glyph( face, FT_Get_Char_Index( face, ch ), FT_LOAD_DEFAULT );
+	FT_Render_Glyph( slot, FT_RENDER_MODE_NORMAL );
+
+	glyph->_metrics = slot->metrics;
+	glyph->_advance = slot->advance.x >> 6;
+	glyph->_width   = slot->bitmap.width;
+	glyph->_height  = slot->bitmap.rows;
+	glyph->_bitmap.resize( glyph->_width * glyph->_height );
+	for( int y = 0; y < glyph->_height; ++y )
+	{
+		std::memcpy( &glyph->_bitmap[y * glyph->_width], slot->bitmap.buffer + y * slot->bitmap.pitch, glyph->_width );
+	}
+	cached = glyph;
+	return glyph;
+}
+
+boost::shared_ptr<const TextLayout> TextGlyphCache::getLayout( const TextFont& font, const std::string& text, const double letterSpacing )
+{
+	LayoutKey key;
+	key._font = font;
+	key._text = text;
+	key._letterSpacing = letterSpacing;
+
+	boost::mutex::scoped_lock lock( _mutex );
+	std::map<LayoutKey, boost::shared_ptr<const TextLayout> >::const_iterator it = _layouts.find( key );
+	if( it != _layouts.end() )
+		return it->second;
+
+	boost::shared_ptr<const TextLayout> textLayout = layout( font, text, letterSpacing );
+	if( _layouts.size() >= kMaxLayouts )
+		_layouts.clear();
+	_layouts[key] = textLayout;
+	return textLayout;
+}
+
+boost::shared_ptr<TextLayout> TextGlyphCache::layout( const TextFont& font, const std::string& text, const double letterSpacing )
+{
+	FT_Face face = getFace( font );
+
+	boost::shared_ptr<TextLayout> textLayout( new TextLayout() );
+	std::vector<FT_Glyph_Metrics> metrics;
+	std::vector<int> kerning;
+	terry::make_kerning makeKerning;
+	for( std::string::const_iterator it = text.begin(); it != text.end(); ++it )
+	{
+		boost::shared_ptr<const TextGlyph> glyph = getGlyph( font, face, *it );
+		textLayout->_glyphs.push_back( glyph );
+		metrics.push_back( glyph->_metrics );
+		kerning.push_back( makeKerning( FaceGlyph( *it, face ) ) );
+	}
+
+	textLayout->_size.x = std::for_each( metrics.begin(), metrics.end(), kerning.begin(), terry::make_width() );
+	textLayout->_size.y = std::for_each( metrics.begin(), metrics.end(), terry::make_height() );
+	if( metrics.size() > 1 )
+		textLayout->_size.x += letterSpacing * ( metrics.size() - 1 );
+
+	// same positions as terry::render_glyph
+	int x = 0;
+	for( std::size_t i = 0; i < textLayout->_glyphs.size(); ++i )
+	{
+		x += kerning[i];
+		textLayout->_positions.push_back( x );
+		x += textLayout->_glyphs[i]->_advance;
+		x += letterSpacing;
+	}
+	return textLayout;
+}
+
+}
+}
+}
@@ -0,0 +1,135 @@
+#ifndef _TUTTLE_PLUGIN_TEXT_GLYPHCACHE_HPP_
+#define _TUTTLE_PLUGIN_TEXT_GLYPHCACHE_HPP_
+
+#include "TextPlugin.hpp"
+
+#include <tuttle/common/patterns/StaticSingleton.hpp>
+
+#include <boost/gil/utilities.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+
+namespace tuttle {
+namespace plugin {
+namespace text {
+
+/**
+ * @brief A font file at a pixel size.
+ */
+struct TextFont
+{
+	std::string _file;
+	int _sizeX;
+	int _sizeY;
+
+	bool operator<( const TextFont& other ) const;
+};
+
+/**
+ * @brief A glyph rasterized by FreeType.
+ */
+struct TextGlyph
+{
+	FT_Glyph_Metrics _metrics;
+	int _advance; ///< horizontal advance in pixels
+	int _width;
+	int _height;
+	std::vector<unsigned char> _bitmap; ///< 8 bits coverage, rows of _width pixels
+};
+
+/**
+ * @brief Position of the glyphs of a text.
+ * The glyph bitmaps are shared with the glyph cache.
+ */
+struct TextLayout
+{
+	std::vector<boost::shared_ptr<const TextGlyph> > _glyphs;
+	std::vector<int> _positions; ///< horizontal position of each glyph
+	boost::gil::point2<int> _size; ///< size of the text box (the baseline is at the bottom)
+};
+
+/**
+ * @brief Process-wide cache of the fonts, the rasterized glyphs and the text layouts.
+ *
+ * Glyphs are identified by the font file, the pixel size and the character,
+ * they are rasterized once and shared by all the Text nodes. The layouts of
+ * the last texts are kept, so a static text is not laid out again for each
+ * frame, and a text which changes (like a frame counter) only rasterizes
+ * its new characters.
+ */
+class TextGlyphCache : public StaticSingleton<TextGlyphCache>
+{
+	friend class StaticSingleton<TextGlyphCache>;
+
+private:
+	TextGlyphCache();
+	~TextGlyphCache();
+
+public:
+	/**
+	 * @brief The font file of the params: the font path if it exists, else the
+	 *        file found by fontconfig.
+	 * @exception exception::FileNotExist if the font path doesn't exist and fontconfig is not available
+	 */
+	std::string getFontFile( const TextProcessParams& params );
+
+	/**
+	 * @brief The layout of a text.
+	 * @exception exception::File if the font can't be loaded
+	 */
+	boost::shared_ptr<const TextLayout> getLayout( const TextFont& font, const std::string& text, const double letterSpacing );
+
+private:
+	struct FontFileKey
+	{
+		std::string _fontPath;
+		int _font;
+		bool _bold;
+		bool _italic;
+
+		bool operator<( const FontFileKey& other ) const;
+	};
+
+	struct GlyphKey
+	{
+		TextFont _font;
+		char _ch;
+
+		bool operator<( const GlyphKey& other ) const;
+	};
+
+	struct LayoutKey
+	{
+		TextFont _font;
+		std::string _text;
+		double _letterSpacing;
+
+		bool operator<( const LayoutKey& other ) const;
+	};
+
+	FT_Face getFace( const TextFont& font );
+	boost::shared_ptr<const TextGlyph> getGlyph( const TextFont& font, FT_Face face, const char ch );
+	boost::shared_ptr<TextLayout> layout( const TextFont& font, const std::string& text, const double letterSpacing );
+
+private:
+	boost::mutex _mutex; ///< Mutex for FreeType and the maps.
+	FT_Library _library;
+	std::map<FontFileKey, std::string> _fontFiles;
+	std::map<TextFont, FT_Face> _faces;
+	std::map<GlyphKey, boost::shared_ptr<const TextGlyph> > _glyphs;
+	std::map<LayoutKey, boost::shared_ptr<const TextLayout> > _layouts;
+};
+
+}
+}
+}
+
+#endif
@@ -45,6 +45,10 @@ public:
 	
 	void render( const OFX::RenderArguments& args );
 
+protected:
+	/// @brief An expression may use the time.
+	bool varyOnTime() const { return _paramIsExpression->getValue(); }
+
 private:
 	template< class View >
 	void render( const OFX::RenderArguments& args );
@@ -19,17 +19,11 @@
 #include <boost/gil/extension/color/hsl.hpp>
 #include <boost/gil/gil_all.hpp>
 
-#include <boost/filesystem.hpp>
-#include <boost/ptr_container/ptr_inserter.hpp>
-
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <iostream>
 
-#ifndef __WINDOWS__
-#include <fontconfig/fontconfig.h>
-#endif
-
 namespace tuttle {
 namespace plugin {
 namespace text {
@@ -41,7 +35,6 @@ TextProcess<View, Functor>::TextProcess( TextPlugin& instance )
 {
 //	Py_Initialize();
 	_clipSrc = instance.fetchClip( kOfxImageEffectSimpleSourceClipName );
-	this->setNoMultiThreading();
 }
 
 template<class View, class Functor>
@@ -150,90 +143,19 @@ void TextProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 	}
 	
 	
-	//Step 1. Create terry image
-	//Step 2. Initialize freetype
-	//Step 3. Make Glyphs Array
-	//Step 4. Make Metrics Array
-	//Step 5. Make Kerning Array
-	//Step 6. Get Coordinates (x,y)
-	//Step 7. Render Glyphs on GIL View
-	//Step 8. Save GIL Image
-
-	//Step 1. Create terry image -----------
-
-	//Step 2. Initialize freetype ---------------
-	FT_Library library;
-	FT_Init_FreeType( &library );
-
-	FT_Face face;
-
-	std::string selectedFont = "";
-
-	if( !boost::filesystem::exists( _params._fontPath ) || boost::filesystem::is_directory( _params._fontPath ) )
-	{
-#ifdef __WINDOWS__
-		BOOST_THROW_EXCEPTION( exception::FileNotExist( _params._fontPath )
-							<< exception::user( "Text: Error in Font Path." )
-							<< exception::filename( _params._fontPath ) );
-#else
-		FcInit();
-
-		FcChar8 *file;
-		FcResult result;
-		FcConfig *config = FcInitLoadConfigAndFonts();
-		FcPattern *p = FcPatternBuild(
-						   NULL,
-						   FC_WEIGHT, FcTypeInteger, FC_WEIGHT_BOLD,
-						   FC_SLANT, FcTypeInteger, FC_SLANT_ITALIC,
-						   NULL );
-
-		FcObjectSet *os = FcObjectSetBuild( FC_FAMILY, NULL );
-		FcFontSet   *fs = FcFontList( config, p, os );
-
-		selectedFont = (char*) FcNameUnparse( fs->fonts[_params._font] );
-
-		int weight = ( _params._bold   == 1) ? FC_WEIGHT_BOLD  : FC_WEIGHT_MEDIUM;
-		int slant  = ( _params._italic == 1) ? FC_SLANT_ITALIC : FC_SLANT_ROMAN;
-
-		p  = FcPatternBuild( NULL,
-							 FC_FAMILY, FcTypeString, selectedFont.c_str(),
-							 FC_WEIGHT, FcTypeInteger, weight,
-							 FC_SLANT, FcTypeInteger, slant,
-							 NULL );
-
-		FcPatternGetString( FcFontMatch( 0, p, &result ), FC_FAMILY, 0, &file );
-		FcPatternGetString( FcFontMatch( 0, p, &result ), FC_FILE, 0, &file );
-		selectedFont = (char*) file;
-#endif
-	}
-	else
-	{
-		selectedFont = _params._fontPath;
-	}
-	FT_New_Face( library, selectedFont.c_str(), 0, &face );
-	
-	FT_Set_Pixel_Sizes( face, _params._fontX, _params._fontY );	
+	TextFont font;
+	font._file  = TextGlyphCache::instance().getFontFile( _params );
+	font._sizeX = _params._fontX;
+	font._sizeY = _params._fontY;
+	_layout = TextGlyphCache::instance().getLayout( font, _text, _params._letterSpacing );
 
-	//Step 3. Make Glyphs Array ------------------
 	rgba32f_pixel_t rgba32f_foregroundColor( _params._fontColor.r,
 											 _params._fontColor.g,
 											 _params._fontColor.b,
 											 _params._fontColor.a );
 	color_convert( rgba32f_foregroundColor, _foregroundColor );
-	std::transform( _text.begin(), _text.end(), boost::ptr_container::ptr_back_inserter( _glyphs ), make_glyph( face ) );
-
-	//Step 4. Make Metrics Array --------------------
-	std::transform( _glyphs.begin(), _glyphs.end(), std::back_inserter( _metrics ), terry::make_metric() );
 
-	//Step 5. Make Kerning Array ----------------
-	std::transform( _glyphs.begin(), _glyphs.end(), std::back_inserter( _kerning ), terry::make_kerning() );
-
-	//Step 6. Get Coordinates (x,y) ----------------
-	_textSize.x   = std::for_each( _metrics.begin(), _metrics.end(), _kerning.begin(), terry::make_width() );
-	_textSize.y   = std::for_each( _metrics.begin(), _metrics.end(), terry::make_height() );
-
-	if( _metrics.size() > 1 )
-		_textSize.x   += _params._letterSpacing * (_metrics.size() - 1);
+	_textSize = _layout->_size;
 
 	switch( _params._vAlign )
 	{
@@ -294,41 +216,63 @@ template<class View, class Functor>
 void TextProcess<View, Functor>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
 	using namespace terry;
-	
+	typedef Rect<std::ptrdiff_t> rect_t;
+
+	// rows of this thread in the dst view (from top to bottom)
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const std::ptrdiff_t dstHeight = this->_dstView.height();
+	const rect_t procWindowView( procWindowOutput.x1, dstHeight - procWindowOutput.y2,
+	                             procWindowOutput.x2, dstHeight - procWindowOutput.y1 );
+	const point2<std::ptrdiff_t> procWindowSize = procWindowView.size();
+	View dstViewRoi = subimage_view( this->_dstView, procWindowView.x1, procWindowView.y1, procWindowSize.x, procWindowSize.y );
+
 	rgba32f_pixel_t backgroundColor( _params._backgroundColor.r,
 									 _params._backgroundColor.g,
 									 _params._backgroundColor.b,
 									 _params._backgroundColor.a );
-	fill_pixels( this->_dstView, backgroundColor );
+	fill_pixels( dstViewRoi, backgroundColor );
 	
 	if( _clipSrc->isConnected() )
 	{
-		//merge_views( this->_dstView, _srcView, this->_dstView, FunctorMatte<Pixel>() );
-		merge_views( this->_dstView, _srcView, this->_dstView, Functor() );
+		const rect_t srcRoi = rectanglesIntersection( procWindowView, rect_t( 0, 0, _srcView.width(), _srcView.height() ) );
+		const point2<std::ptrdiff_t> srcRoiSize = srcRoi.size();
+		if( srcRoiSize.x > 0 && srcRoiSize.y > 0 )
+		{
+			View dstViewMerge = subimage_view( this->_dstView, srcRoi.x1, srcRoi.y1, srcRoiSize.x, srcRoiSize.y );
+			const View srcViewMerge = subimage_view( _srcView, srcRoi.x1, srcRoi.y1, srcRoiSize.x, srcRoiSize.y );
+			//merge_views( dstViewMerge, srcViewMerge, dstViewMerge, FunctorMatte<Pixel>() );
+			merge_views( dstViewMerge, srcViewMerge, dstViewMerge, Functor() );
+		}
 	}
 	
 	//Step 7. Render Glyphs ------------------------
-	// if outside dstRod
-	// ...
-	// else
-	const OfxRectI textRod = { _textCorner.x, _textCorner.y, _textCorner.x + _textSize.x, _textCorner.y + _textSize.y + _textSize.y / 3};
-	const OfxRectI textRoi = rectanglesIntersection( textRod, procWindowRoW );
-	const OfxRectI textLocalRoi = translateRegion( textRoi, - _textCorner );
-	
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, _textSize );
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, _textCorner );
-	
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, textRod );
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, procWindowRoW );
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, textRoi );
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, textLocalRoi );
-	//TUTTLE_LOG_VAR2( TUTTLE_INFO, _dstViewForGlyphs.width(), _dstViewForGlyphs.height() );
+	// rows of this thread in the glyphs view
+	const rect_t glyphsRoi = _params._verticalFlip
+		? rect_t( procWindowView.x1, procWindowOutput.y1, procWindowView.x2, procWindowOutput.y2 )
+		: procWindowView;
 	
-	View tmpDstViewForGlyphs = subimage_view( _dstViewForGlyphs, _textCorner.x, _textCorner.y, _textSize.x, _textSize.y);
-	
-	std::for_each( _glyphs.begin(), _glyphs.end(), _kerning.begin(),
-	               render_glyph<View>( tmpDstViewForGlyphs, _foregroundColor, _params._letterSpacing, Rect<std::ptrdiff_t>(textLocalRoi) )
-	               );
+	for( std::size_t i = 0; i < _layout->_glyphs.size(); ++i )
+	{
+		const TextGlyph& glyph = *_layout->_glyphs[i];
+		// the baseline is at the bottom of the text box
+		const std::ptrdiff_t x = _textCorner.x + _layout->_positions[i];
+		const std::ptrdiff_t y = _textCorner.y + _textSize.y - ( glyph._metrics.horiBearingY >> 6 );
+		const rect_t glyphRod( x, y, x + glyph._width, y + glyph._height );
+		const rect_t glyphRoi = rectanglesIntersection( glyphRod, glyphsRoi );
+		const point2<std::ptrdiff_t> glyphRoiSize = glyphRoi.size();
+		if( glyphRoiSize.x <= 0 || glyphRoiSize.y <= 0 )
+			continue;
+
+		gray8c_view_t glyphView = interleaved_view( glyph._width, glyph._height,
+		                                            reinterpret_cast<const gray8_pixel_t*>( &glyph._bitmap[0] ),
+		                                            sizeof(unsigned char) * glyph._width );
+		gray8c_view_t glyphViewRoi = subimage_view( glyphView, glyphRoi.x1 - x, glyphRoi.y1 - y, glyphRoiSize.x, glyphRoiSize.y );
+		View outViewRoi = subimage_view( _dstViewForGlyphs, glyphRoi.x1, glyphRoi.y1, glyphRoiSize.x, glyphRoiSize.y );
+
+		copy_and_convert_alpha_blended_pixels( color_converted_view<gray32f_pixel_t>( glyphViewRoi ), _foregroundColor, outViewRoi );
+	}
+
+	this->progressForward( procWindowSize.x * procWindowSize.y );
 }
 
 }
@@ -0,0 +1,163 @@
+#include "LibAVVideoIndex.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tuttle {
+namespace plugin {
+namespace av {
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+static const char kIndexMagic[4] = { 'T', 'A', 'V', 'I' };
+static const boost::uint32_t kIndexVersion = 1;
+
+/**
+ * @brief Index file header, followed by the media file path
+ *        (pathSize chars) and the keyframes (nbKeyframes * 2 int64).
+ */
+struct IndexHeader
+{
+	char magic[4];
+	boost::uint32_t version;
+	boost::uint32_t pathSize;
+	boost::uint32_t padding;
+	boost::int64_t mtime;
+	boost::uint64_t fileSize;
+	boost::uint64_t nbKeyframes;
+};
+
+struct KeyframeFrameLess
+{
+	bool operator()( const boost::int64_t frame, const LibAVVideoIndex::Keyframe& k ) const
+	{
+		return frame < k._frame;
+	}
+};
+
+}
+
+void LibAVVideoIndex::clear()
+{
+	_keyframes.clear();
+}
+
+void LibAVVideoIndex::add( const boost::int64_t frame, const boost::int64_t timestamp )
+{
+	Keyframe k;
+	k._frame = frame;
+	k._timestamp = timestamp;
+	// packets are mostly in the frames order, so it's nearly always an append
+	std::vector<Keyframe>::iterator it = std::upper_bound( _keyframes.begin(), _keyframes.end(), frame, KeyframeFrameLess() );
+	_keyframes.insert( it, k );
+}
+
+const LibAVVideoIndex::Keyframe* LibAVVideoIndex::findPrevious( const boost::int64_t frame ) const
+{
+	std::vector<Keyframe>::const_iterator it = std::upper_bound( _keyframes.begin(), _keyframes.end(), frame, KeyframeFrameLess() );
+	if( it == _keyframes.begin() )
+		return NULL;
+	return &*( --it );
+}
+
+fs::path LibAVVideoIndex::cacheDirectory()
+{
+	return fileCacheDirectory( "avIndex" );
+}
+
+bool LibAVVideoIndex::load( const fs::path& mediaFile )
+{
+	clear();
+	try
+	{
+		const FileCacheKey key = buildFileCacheKey( mediaFile );
+		const fs::path indexFile = fileCacheFilename( "avIndex", key, ".tavi" );
+		if( ! fs::exists( indexFile ) )
+			return false;
+
+		fs::ifstream file( indexFile, std::ios::in | std::ios::binary );
+		IndexHeader header;
+		if( ! file.read( reinterpret_cast<char*>( &header ), sizeof( IndexHeader ) ) ||
+		    std::memcmp( header.magic, kIndexMagic, sizeof( kIndexMagic ) ) != 0 ||
+		    header.version != kIndexVersion ||
+		    header.mtime != key._mtime ||
+		    header.fileSize != key._size ||
+		    header.pathSize != key._path.size() )
+			return false;
+
+		std::string indexedPath( header.pathSize, '\0' );
+		if( ! file.read( &indexedPath[0], header.pathSize ) || indexedPath != key._path )
+			return false;
+
+		std::vector<boost::int64_t> values( header.nbKeyframes * 2 );
+		if( ! values.empty() &&
+		    ! file.read( reinterpret_cast<char*>( &values[0] ), values.size() * sizeof( boost::int64_t ) ) )
+			return false;
+
+		_keyframes.resize( header.nbKeyframes );
+		for( std::size_t i = 0; i < _keyframes.size(); ++i )
+		{
+			_keyframes[i]._frame = values[2 * i];
+			_keyframes[i]._timestamp = values[2 * i + 1];
+		}
+	}
+	catch( std::exception& e )
+	{
+		TUTTLE_LOG_WARNING( "avReader: unable to read the index of " << mediaFile << ": " << e.what() );
+		clear();
+		return false;
+	}
+	return ! empty();
+}
+
+void LibAVVideoIndex::save( const fs::path& mediaFile ) const
+{
+	try
+	{
+		const FileCacheKey key = buildFileCacheKey( mediaFile );
+		writeFileCache( fileCacheFilename( "avIndex", key, ".tavi" ),
+		                boost::bind( &LibAVVideoIndex::writeIndex, this, _1, boost::cref( key ) ) );
+	}
+	catch( std::exception& e )
+	{
+		TUTTLE_LOG_WARNING( "avReader: unable to write the index of " << mediaFile << ": " << e.what() );
+	}
+}
+
+void LibAVVideoIndex::writeIndex( std::ostream& file, const FileCacheKey& key ) const
+{
+	IndexHeader header;
+	std::memcpy( header.magic, kIndexMagic, sizeof( kIndexMagic ) );
+	header.version = kIndexVersion;
+	header.pathSize = static_cast<boost::uint32_t>( key._path.size() );
+	header.padding = 0;
+	header.mtime = key._mtime;
+	header.fileSize = key._size;
+	header.nbKeyframes = _keyframes.size();
+
+	std::vector<boost::int64_t> values;
+	values.reserve( _keyframes.size() * 2 );
+	for( std::vector<Keyframe>::const_iterator it = _keyframes.begin(); it != _keyframes.end(); ++it )
+	{
+		values.push_back( it->_frame );
+		values.push_back( it->_timestamp );
+	}
+
+	file.write( reinterpret_cast<const char*>( &header ), sizeof( IndexHeader ) );
+	file.write( key._path.c_str(), key._path.size() );
+	if( ! values.empty() )
+		file.write( reinterpret_cast<const char*>( &values[0] ), values.size() * sizeof( boost::int64_t ) );
+}
+
+}
+}
+}
@@ -0,0 +1,72 @@
+#ifndef _TUTTLE_PLUGIN_LIBAV_LIBAVVIDEOINDEX_HPP_
+#define _TUTTLE_PLUGIN_LIBAV_LIBAVVIDEOINDEX_HPP_
+
+#include <tuttle/plugin/fileCache.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/cstdint.hpp>
+
+#include <ostream>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace av {
+
+/**
+ * @brief Keyframes of the video stream of a media file.
+ *
+ * The index is built once by demuxing the whole file (without decoding),
+ * then stored in $TUTTLE_HOME/avIndex (or <tmp>/tuttle/avIndex). Index files
+ * are identified by the absolute path, the modification time and the size
+ * of the media file.
+ */
+class LibAVVideoIndex
+{
+public:
+	struct Keyframe
+	{
+		boost::int64_t _frame;     ///< frame number
+		boost::int64_t _timestamp; ///< packet timestamp, in the stream time base
+	};
+
+public:
+	void clear();
+	bool empty() const { return _keyframes.empty(); }
+	std::size_t size() const { return _keyframes.size(); }
+
+	/// @brief Add a keyframe, keyframes may be added in any order.
+	void add( const boost::int64_t frame, const boost::int64_t timestamp );
+
+	/**
+	 * @return the last keyframe before (or at) @p frame,
+	 *         or NULL if there is none.
+	 */
+	const Keyframe* findPrevious( const boost::int64_t frame ) const;
+
+	/**
+	 * @brief Read the index file of a media file.
+	 * @return false if there is no valid index file.
+	 */
+	bool load( const boost::filesystem::path& mediaFile );
+	/**
+	 * @brief Write the index file of a media file.
+	 * Errors are only reported as warnings, the index is an optimization.
+	 */
+	void save( const boost::filesystem::path& mediaFile ) const;
+
+	/// @brief Directory of the index files
+	static boost::filesystem::path cacheDirectory();
+
+private:
+	void writeIndex( std::ostream& file, const FileCacheKey& key ) const;
+
+private:
+	std::vector<Keyframe> _keyframes; ///< sorted by frame
+};
+
+}
+}
+}
+
+#endif
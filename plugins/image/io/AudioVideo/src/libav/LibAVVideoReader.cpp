@@ -20,7 +20,6 @@ LibAVVideoReader::LibAVVideoReader()
 	, _format( NULL )
 	, _avFrame( NULL )
 	, _videoCodec( NULL )
-	, _sws_context( NULL )
 	, _fpsNum( 0 )
 	, _fpsDen( 0 )
 	, _currVideoIdx( -1 )
@@ -32,6 +31,9 @@ LibAVVideoReader::LibAVVideoReader()
 	, _lastSearchPos( -1 )
 	, _lastDecodedPos( -1 )
 	, _lastDecodedFrame( -1 )
+	, _currFrame( 0 )
+	, _nextFrame( 0 )
+	, _indexed( false )
 	, _isOpen( false )
 {
 //	for( int i = 0; i < AVMEDIA_TYPE_NB; ++i )
@@ -104,7 +106,19 @@ bool LibAVVideoReader::open( const std::string& filename )
 	}
 	_bitRate = codecContext->bit_rate;
 
-	_data.resize( width() * height() * 3 );
+	// forget the frames of the previous file
+	freeDecodedFrames();
+	DecodedFrame emptyFrame;
+	emptyFrame._frame = -1;
+	emptyFrame._allocated = false;
+	_frames.assign( kDecodedFramesCacheSize, emptyFrame );
+	_currFrame = 0;
+	_nextFrame = 0;
+	_lastDecodedFrame = -1;
+
+	_filename = filename;
+	_index.clear();
+	_indexed = false;
 
 	// hack so seeking works from our intended position.
 	if( !strcmp( codecContext->codec->name, "mjpeg" ) || !strcmp( codecContext->codec->name, "dvvideo" ) )
@@ -140,6 +154,7 @@ bool LibAVVideoReader::open( const std::string& filename )
 void LibAVVideoReader::close()
 {
 	_isOpen = false;
+	freeDecodedFrames();
 	closeVideoCodec();
 	if( _avFormatOptions )
 	{
@@ -160,12 +175,25 @@ bool LibAVVideoReader::read( const int frame )
 	{
 		std::cerr << "Read outside the video range (time:" << frame << ", video size:" << _nbFrames << std::endl;
 	}
+	// recently decoded frame
+	for( std::size_t i = 0; i < _frames.size(); ++i )
+	{
+		if( _frames[i]._frame == frameNumber )
+		{
+			_currFrame = i;
+			return true;
+		}
+	}
+
 	if( _lastDecodedFrame + 1 != frameNumber )
 	{
-		seek( 0 );
-		seek( frameNumber );
+		seekToFrame( frameNumber );
 	}
 
+	// decode in the oldest frame of the ring buffer
+	DecodedFrame& decoded = _frames[_nextFrame];
+	decoded._frame = -1;
+
 	av_init_packet( &_pkt );
 
 	bool hasPicture = false;
@@ -187,8 +215,19 @@ bool LibAVVideoReader::read( const int frame )
 
 		av_free_packet( &_pkt );
 	}
+	if( !hasPicture && error == AVERROR_EOF )
+	{
+		hasPicture = drainImage( frameNumber );
+	}
 
 	_lastDecodedFrame = frameNumber;
+	if( hasPicture )
+	{
+		decoded._frame = frameNumber;
+		_currFrame = _nextFrame;
+		_nextFrame = ( _nextFrame + 1 ) % _frames.size();
+	}
+	// else end of file: keep the previous behaviour, the last decoded picture is returned
 
 	return true;
 }
@@ -341,6 +380,14 @@ void LibAVVideoReader::closeVideoCodec()
 		avcodec_close( stream->codec );
 }
 
+void LibAVVideoReader::reopenVideoCodec()
+{
+	closeVideoCodec();
+	openVideoCodec();
+	// the new decoder needs to restart from a keyframe
+	_lastDecodedFrame = -1;
+}
+
 boost::int64_t LibAVVideoReader::getTimeStamp( int pos ) const
 {
 	boost::int64_t timestamp = boost::numeric_cast<boost::int64_t>( ( (double) pos / fps() ) * AV_TIME_BASE );
@@ -374,6 +421,86 @@ bool LibAVVideoReader::seek( const std::size_t pos )
 	return true;
 }
 
+bool LibAVVideoReader::seekToFrame( const int frame )
+{
+	// building the index moves the demuxer position
+	const bool wasIndexed = _indexed;
+	if( ! ensureIndex() )
+	{
+		seek( 0 );
+		return seek( frame );
+	}
+	const LibAVVideoIndex::Keyframe* keyframe = _index.findPrevious( frame );
+	if( ! keyframe )
+	{
+		seek( 0 );
+		return seek( frame );
+	}
+	// no keyframe between the decoder position and the frame: decode forward
+	if( wasIndexed && frame > _lastDecodedFrame && keyframe->_frame <= _lastDecodedFrame )
+		return true;
+
+	AVStream* stream = getVideoStream();
+	if( !stream )
+		return false;
+
+	avcodec_flush_buffers( stream->codec );
+	_lastSearchPos = -1;
+	if( av_seek_frame( _avFormatOptions, stream->index, keyframe->_timestamp, AVSEEK_FLAG_BACKWARD ) < 0 )
+	{
+		seek( 0 );
+		return seek( frame );
+	}
+	return true;
+}
+
+bool LibAVVideoReader::ensureIndex()
+{
+	if( ! _indexed )
+	{
+		_indexed = true;
+		if( ! _index.load( _filename ) )
+		{
+			buildIndex();
+			if( ! _index.empty() )
+				_index.save( _filename );
+		}
+		TUTTLE_TLOG( TUTTLE_INFO, "avReader: " << _index.size() << " keyframes in " << _filename );
+	}
+	return ! _index.empty();
+}
+
+/**
+ * @brief Read all the packets of the video stream, without decoding them,
+ *        to find the keyframes.
+ * The frame numbers are computed like the pictures in decodeImage().
+ */
+void LibAVVideoReader::buildIndex()
+{
+	_index.clear();
+	AVStream* stream = getVideoStream();
+	if( !stream )
+		return;
+
+	if( ! seek( 0 ) )
+		return;
+
+	AVPacket pkt;
+	av_init_packet( &pkt );
+	while( av_read_frame( _avFormatOptions, &pkt ) >= 0 )
+	{
+		if( pkt.stream_index == stream->index && ( pkt.flags & AV_PKT_FLAG_KEY ) )
+		{
+			const boost::int64_t timestamp = pkt.dts != (int64_t)AV_NOPTS_VALUE ? pkt.dts : pkt.pts;
+			if( timestamp != (int64_t)AV_NOPTS_VALUE )
+			{
+				_index.add( positionFromTimestamp( timestamp ), timestamp );
+			}
+		}
+		av_free_packet( &pkt );
+	}
+}
+
 bool LibAVVideoReader::decodeImage( const int frame )
 {
 	// search for our picture.
@@ -396,59 +523,158 @@ bool LibAVVideoReader::decodeImage( const int frame )
 	if( _avFormatOptions->start_time != (int64_t)AV_NOPTS_VALUE )
 		curPos -= int(_avFormatOptions->start_time * fps() / AV_TIME_BASE);
 
-	int hasPicture   = 0;
-	int curSearch    = 0;
-	AVStream* stream = getVideoStream();
-	if( !stream )
-		return false;
-
-	AVCodecContext* codecContext = stream->codec;
-	if( curPos >= frame )
+	// the packets from the keyframe found by the seek are decoded even before
+	// the frame: the following pictures depend on them, only the pictures are discarded
+	int hasPicture = 0;
+	if( decodePacket( hasPicture ) < 0 || !hasPicture )
 	{
-		#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT( 52, 21, 0 )
-		avcodec_decode_video2( codecContext, _avFrame, &hasPicture, &_pkt );
-		#else
-		avcodec_decode_video( codecContext, _avFrame, &hasPicture, _pkt.data, _pkt.size );
-		#endif
+		return false;
 	}
-	else if( _offsetTime )
+	// with frame threading, the picture comes from a previous packet
+	if( _avFrame->pkt_dts != (int64_t)AV_NOPTS_VALUE )
 	{
-		#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT( 52, 21, 0 )
-		avcodec_decode_video2( codecContext, _avFrame, &curSearch, &_pkt );
-		#else
-		avcodec_decode_video( codecContext, _avFrame, &curSearch, _pkt.data, _pkt.size );
-		#endif
+		curPos = positionFromTimestamp( _avFrame->pkt_dts );
 	}
-
-	if( !hasPicture )
+	if( curPos < frame )
 	{
 		return false;
 	}
 
 	_lastDecodedPos = _lastSearchPos;
+	return storePicture();
+}
 
-	AVPicture output;
-	avpicture_fill( &output, &_data[0], PIX_FMT_RGB24, _width, _height );
+/**
+ * @brief Get the pictures delayed by the decoder (threads or B-frames) at the end of the file.
+ */
+bool LibAVVideoReader::drainImage( const int frame )
+{
+	if( !getVideoStream() )
+		return false;
+	for( ;; )
+	{
+		av_init_packet( &_pkt );
+		_pkt.data = NULL;
+		_pkt.size = 0;
+		int hasPicture = 0;
+		if( decodePacket( hasPicture ) < 0 || !hasPicture )
+		{
+			return false;
+		}
+		if( _avFrame->pkt_dts == (int64_t)AV_NOPTS_VALUE ||
+		    positionFromTimestamp( _avFrame->pkt_dts ) >= frame )
+		{
+			return storePicture();
+		}
+	}
+}
 
-	// patched to use swscale instead of img_convert:
-	PixelFormat in_pixelFormat  = codecContext->pix_fmt; // pixel format source
-	PixelFormat out_pixelFormat = PIX_FMT_RGB24; // pixel format dest
+int LibAVVideoReader::decodePacket( int& hasPicture )
+{
+	AVCodecContext* codecContext = getVideoStream()->codec;
+	#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT( 52, 21, 0 )
+	return avcodec_decode_video2( codecContext, _avFrame, &hasPicture, &_pkt );
+	#else
+	return avcodec_decode_video( codecContext, _avFrame, &hasPicture, _pkt.data, _pkt.size );
+	#endif
+}
 
-	_sws_context = sws_getCachedContext( _sws_context, width(), height(), in_pixelFormat, width(), height(), out_pixelFormat, SWS_BICUBIC, NULL, NULL, NULL );
+int LibAVVideoReader::positionFromTimestamp( const boost::int64_t timestamp )
+{
+	int pos = int(av_q2d( getVideoStream()->time_base ) * timestamp * fps() + 0.5f);
+	if( _avFormatOptions->start_time != (int64_t)AV_NOPTS_VALUE )
+		pos -= int(_avFormatOptions->start_time * fps() / AV_TIME_BASE);
+	return pos;
+}
 
-	if( !_sws_context )
+/**
+ * @brief Copy the decoded picture in the next frame of the ring buffer.
+ * The decoder reuses its buffers, and the conversion is done later by convert().
+ */
+bool LibAVVideoReader::storePicture()
+{
+	AVCodecContext* codecContext = getVideoStream()->codec;
+	DecodedFrame& decoded = _frames[_nextFrame];
+	if( decoded._allocated &&
+	    ( decoded._pixelFormat != codecContext->pix_fmt || decoded._width != _width || decoded._height != _height ) )
 	{
-		std::cerr << "avReader: libav-conversion failed (" << in_pixelFormat << "->" << out_pixelFormat << ")" << std::endl;
+		avpicture_free( &decoded._picture );
+		decoded._allocated = false;
+	}
+	if( !decoded._allocated )
+	{
+		if( avpicture_alloc( &decoded._picture, codecContext->pix_fmt, _width, _height ) < 0 )
+		{
+			std::cerr << "avReader: unable to allocate a picture" << std::endl;
+			return false;
+		}
+		decoded._allocated = true;
+		decoded._pixelFormat = codecContext->pix_fmt;
+		decoded._width = _width;
+		decoded._height = _height;
+	}
+	av_picture_copy( &decoded._picture, (const AVPicture*)_avFrame, decoded._pixelFormat, _width, _height );
+	return true;
+}
+
+void LibAVVideoReader::freeDecodedFrames()
+{
+	for( std::size_t i = 0; i < _frames.size(); ++i )
+	{
+		if( _frames[i]._allocated )
+			avpicture_free( &_frames[i]._picture );
+		_frames[i]._allocated = false;
+		_frames[i]._frame = -1;
+	}
+}
+
+int LibAVVideoReader::rowsAlignment() const
+{
+	const DecodedFrame& decoded = _frames[_currFrame];
+	if( !decoded._allocated )
+		return 1;
+	return 1 << av_pix_fmt_descriptors[decoded._pixelFormat].log2_chroma_h;
+}
+
+bool LibAVVideoReader::convert( boost::uint8_t* dst, const int dstLinesize, const PixelFormat dstFormat, const int rowBegin, const int rowEnd ) const
+{
+	const DecodedFrame& decoded = _frames[_currFrame];
+	if( !decoded._allocated || rowBegin >= rowEnd )
+		return false;
+
+	// source planes, starting at rowBegin
+	const AVPixFmtDescriptor& desc = av_pix_fmt_descriptors[decoded._pixelFormat];
+	const boost::uint8_t* src[4];
+	int srcLinesize[4];
+	for( int i = 0; i < 4; ++i )
+	{
+		srcLinesize[i] = decoded._picture.linesize[i];
+		src[i] = decoded._picture.data[i];
+		const bool isPalette = ( i == 1 ) && ( desc.flags & PIX_FMT_PAL );
+		if( src[i] && !isPalette )
+		{
+			const int shift = ( i == 1 || i == 2 ) ? desc.log2_chroma_h : 0;
+			src[i] += ( rowBegin >> shift ) * srcLinesize[i];
+		}
+	}
+
+	// a context per call, so bands can be converted concurrently
+	const int nbRows = rowEnd - rowBegin;
+	struct SwsContext* context = sws_getContext( decoded._width, nbRows, decoded._pixelFormat, decoded._width, nbRows, dstFormat, SWS_BICUBIC, NULL, NULL, NULL );
+	if( !context )
+	{
+		std::cerr << "avReader: libav-conversion failed (" << decoded._pixelFormat << "->" << dstFormat << ")" << std::endl;
 		return false;
 	}
-	int error = sws_scale( _sws_context, _avFrame->data, _avFrame->linesize, 0, height(), output.data, output.linesize );
+	boost::uint8_t* dstData[4] = { dst, NULL, NULL, NULL };
+	int dstLinesizes[4] = { dstLinesize, 0, 0, 0 };
+	const int error = sws_scale( context, src, srcLinesize, 0, nbRows, dstData, dstLinesizes );
+	sws_freeContext( context );
 	if( error < 0 )
 	{
-		std::cerr << "avReader: libav-conversion failed (" << in_pixelFormat << "->" << out_pixelFormat << ")" << std::endl;
+		std::cerr << "avReader: libav-conversion failed (" << decoded._pixelFormat << "->" << dstFormat << ")" << std::endl;
 		return false;
 	}
-
-	// std::cout << "decodeImage " << frame << " OK" << std::endl;
 	return true;
 }
 
@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_LIBAV_LIBAVVIDEOREADER_HPP_
 
 #include "LibAV.hpp"
+#include "LibAVVideoIndex.hpp"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/cstdint.hpp>
@@ -16,6 +17,9 @@ namespace av {
 
 enum EIntrelacment { eInterlacmentNone, eInterlacmentUpper, eInterlacmentLower };
 
+/// Number of decoded frames kept in memory by the reader
+static const std::size_t kDecodedFramesCacheSize = 4;
+
 class LibAVVideoReader : public LibAV
 {
 public:
@@ -24,8 +28,29 @@ public:
 
 	bool open( const std::string& filename );
 	void close();
+	/**
+	 * @brief Decode a frame, use convert() to get its pixels.
+	 */
 	bool read( const int frame );
 
+	/**
+	 * @brief Reopen the video codec, to apply the options set on the codec context
+	 *        (like the number of threads).
+	 */
+	void reopenVideoCodec();
+
+	/// @brief Number of rows converted by convert() should be a multiple of it (chroma subsampling).
+	int rowsAlignment() const;
+
+	/**
+	 * @brief Convert rows of the last read frame.
+	 * Can be called concurrently on different rows.
+	 * @param[out] dst          address of the first converted row
+	 * @param[in]  dstLinesize  bytes between two rows, may be negative
+	 * @param[in]  rowBegin, rowEnd  rows from the top of the picture
+	 */
+	bool convert( boost::uint8_t* dst, const int dstLinesize, const PixelFormat dstFormat, const int rowBegin, const int rowEnd ) const;
+
 private:
 	bool setupStreamInfo();
 
@@ -45,15 +70,28 @@ private:
 
 	/**
 	 * @brief Seek to the nearest previous keyframe from pos.
-	 * Write in _data the image result.
 	 * @param pos frame number to seek
 	 */
 	bool seek( size_t pos );
+	/**
+	 * @brief Seek before a frame using the keyframe index.
+	 * Doesn't seek if the frame can be reached by decoding forward.
+	 * Fallback to seek() if the file can't be indexed.
+	 */
+	bool seekToFrame( const int frame );
+	/// @brief Load or build the keyframe index, on the first random access.
+	bool ensureIndex();
+	void buildIndex();
 	/**
 	 * @brief Decode the current frame
 	 * @param the number of the current frame
 	 */
 	bool decodeImage( const int frame );
+	bool drainImage( const int frame );
+	int  decodePacket( int& hasPicture );
+	int  positionFromTimestamp( const boost::int64_t timestamp );
+	bool storePicture();
+	void freeDecodedFrames();
 
 public:
 	int width() const
@@ -105,11 +143,6 @@ public:
 		return _isOpen;
 	}
 
-	unsigned char* data()
-	{
-		return &_data[0];
-	}
-
 	std::string codecName( ) const
 	{
 		if( !_videoCodec )
@@ -159,7 +192,6 @@ public: // private:
 	AVCodec* _videoCodec;
 	AVPacket _pkt;
 
-	struct SwsContext* _sws_context;  ///< contexte de transformation swscale
 	std::vector<int> _videoIdx;
 	int _fpsNum;
 	int _fpsDen;
@@ -169,7 +201,22 @@ public: // private:
 	int _height;
 	double _aspect;
 	int _bitRate;
-	std::vector<unsigned char> _data;
+	/// @brief Copy of a decoded picture, in the codec pixel format
+	struct DecodedFrame
+	{
+		int _frame;
+		AVPicture _picture;
+		bool _allocated;
+		PixelFormat _pixelFormat;
+		int _width;
+		int _height;
+	};
+	std::vector<DecodedFrame> _frames; ///< Ring buffer of the last decoded frames
+	std::size_t _currFrame;            ///< Index in _frames of the last read frame
+	std::size_t _nextFrame;            ///< Index in _frames of the next decoded frame
+	std::string _filename;
+	LibAVVideoIndex _index;
+	bool _indexed;                     ///< The index has been loaded or built
 	bool _offsetTime;
 	int _lastSearchPos;
 	int _lastDecodedPos;
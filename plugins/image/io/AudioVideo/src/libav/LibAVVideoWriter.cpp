@@ -23,8 +23,6 @@ namespace av {
 #define snprintf _snprintf
 #endif
 
-static boost::int64_t pts = 0;
-
 LibAVVideoWriter::LibAVVideoWriter()
 	: LibAV()
 	, _avFormatOptions   ( NULL )
@@ -32,6 +30,10 @@ LibAVVideoWriter::LibAVVideoWriter()
 	, _avVideoOptions    ( NULL )
 	, _avAudioOptions    ( NULL )
 	, _sws_context       ( NULL )
+	, _in_frame          ( NULL )
+	, _out_frame         ( NULL )
+	, _out_buffer        ( NULL )
+	, _pts               ( 0 )
 	, _videoCodec        ( NULL )
 	, _audioCodec        ( NULL )
 	, _ofmt              ( NULL )
@@ -144,6 +146,13 @@ LibAVVideoWriter::LibAVVideoWriter()
 
 }
 
+LibAVVideoWriter::~LibAVVideoWriter()
+{
+	freeFrames();
+	if( _sws_context )
+		sws_freeContext( _sws_context );
+}
+
 int LibAVVideoWriter::start( )
 {
 	if( !_avFormatOptions )
@@ -297,9 +306,39 @@ bool LibAVVideoWriter::finishInit()
 		BOOST_THROW_EXCEPTION( exception::Format()
 							   << exception::user( "avWriter: unable to write header." ) );
 	}
+	allocFrames();
+	_pts = 0;
 	return true;
 }
 
+/**
+ * @brief Allocate the frames used by execute(), for the size and pixel format of the codec.
+ */
+void LibAVVideoWriter::allocFrames()
+{
+	freeFrames();
+	_in_frame = avcodec_alloc_frame();
+	_out_frame = avcodec_alloc_frame();
+	const int out_picSize = avpicture_get_size( _out_pixelFormat, getWidth(), getHeight() );
+	_out_buffer = (boost::uint8_t*) av_malloc( out_picSize );
+	if( !_in_frame || !_out_frame || !_out_buffer )
+	{
+		freeFrames();
+		BOOST_THROW_EXCEPTION( exception::Memory()
+			<< exception::user( "avWriter: unable to allocate frames." ) );
+	}
+	avcodec_get_frame_defaults( _in_frame );
+	avcodec_get_frame_defaults( _out_frame );
+	avpicture_fill( (AVPicture*) _out_frame, _out_buffer, _out_pixelFormat, getWidth(), getHeight() );
+}
+
+void LibAVVideoWriter::freeFrames()
+{
+	av_freep( &_out_buffer );
+	av_freep( &_out_frame );
+	av_freep( &_in_frame );
+}
+
 std::string LibAVVideoWriter::getErrorStr( const int errnum ) const
 {
 	static const std::size_t errbuf_size = 2048;
@@ -314,15 +353,15 @@ int LibAVVideoWriter::execute( boost::uint8_t* const in_buffer, const int in_wid
 	
 	_statusCode = eWriterStatusCleanup;
 	
-	AVFrame* in_frame = avcodec_alloc_frame();
-	avcodec_get_frame_defaults( in_frame );
+	if( !_out_frame )
+	{
+		BOOST_THROW_EXCEPTION( exception::Bug()
+			<< exception::dev( "avWriter: execute called before finishInit." ) );
+	}
+	AVFrame* in_frame = _in_frame;
 	avpicture_fill( (AVPicture*)in_frame, in_buffer, in_pixelFormat, in_width, in_height );
 
-	AVFrame* out_frame = avcodec_alloc_frame();
-	avcodec_get_frame_defaults( out_frame );
-	int out_picSize = avpicture_get_size( _out_pixelFormat, getWidth(), getHeight() );
-	boost::uint8_t* out_buffer = (boost::uint8_t*) av_malloc( out_picSize );
-	avpicture_fill( (AVPicture*) out_frame, out_buffer, _out_pixelFormat, getWidth(), getHeight() );
+	AVFrame* out_frame = _out_frame;
 
 	_sws_context = sws_getCachedContext( _sws_context, in_width, in_height, in_pixelFormat, getWidth(), getHeight(), _out_pixelFormat, SWS_BICUBIC, NULL, NULL, NULL );
 
@@ -333,7 +372,7 @@ int LibAVVideoWriter::execute( boost::uint8_t* const in_buffer, const int in_wid
 		BOOST_THROW_EXCEPTION( exception::Failed()
 			<< exception::user() + "libav-conversion failed (" + in_pixelFormat + "->" + _out_pixelFormat + ")." );
 	}
-	const int error = sws_scale( _sws_context, in_frame->data, in_frame->linesize, 0, getHeight(), out_frame->data, out_frame->linesize );
+	const int error = sws_scale( _sws_context, in_frame->data, in_frame->linesize, 0, in_height, out_frame->data, out_frame->linesize );
 	if( error < 0 )
 	{
 		BOOST_THROW_EXCEPTION( exception::Failed()
@@ -385,9 +424,9 @@ int LibAVVideoWriter::execute( boost::uint8_t* const in_buffer, const int in_wid
 			pkt.flags |= AV_PKT_FLAG_KEY;
 		}
 		
-		out_frame->pts = pts;
+		out_frame->pts = _pts;
 		out_frame->quality = _stream->codec->global_quality;
-		pts += _stream->codec->time_base.num;
+		_pts += _stream->codec->time_base.num;
 		ret = avcodec_encode_video2( _stream->codec, &pkt, out_frame, &_hasFrame );
 		if( ret < 0 )
 		{
@@ -408,10 +447,7 @@ int LibAVVideoWriter::execute( boost::uint8_t* const in_buffer, const int in_wid
 		}
 	}
 
-	av_free( out_buffer );
-	av_free( out_frame );
-	av_free( in_frame );
-	// in_buffer not free (function parameter)
+	// frames are reused by the next call, in_buffer not free (function parameter)
 
 	if( ret < 0 )
 	{
@@ -471,6 +507,7 @@ void LibAVVideoWriter::finish()
 
 void LibAVVideoWriter::freeFormat()
 {
+	freeFrames();
 	avcodec_close( _stream->codec );
 	for( int i = 0; i < static_cast<int>( _avFormatOptions->nb_streams ); ++i )
 		av_freep( &_avFormatOptions->streams[i] );
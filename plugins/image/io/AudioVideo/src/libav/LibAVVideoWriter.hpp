@@ -28,6 +28,7 @@ private:
 
 public:
 	explicit LibAVVideoWriter();
+	~LibAVVideoWriter();
 
 	bool movie() const
 	{
@@ -36,11 +37,18 @@ public:
 
 	int  start( );
 	bool finishInit();
+	/**
+	 * @brief Convert and encode a frame.
+	 * The conversion and encoding frames are allocated once by finishInit(),
+	 * @p in_buffer is only used during the call.
+	 */
 	int  execute( boost::uint8_t* const in_buffer, const int in_width, const int height, const PixelFormat in_fmt = PIX_FMT_RGB24 );
 	void finish();
 
 private:
 	void freeFormat();
+	void allocFrames();
+	void freeFrames();
 	std::string getErrorStr( const int errnum ) const;
 
 public:
@@ -214,6 +222,10 @@ private:
 	AVCodecContext*                _avVideoOptions;
 	AVCodecContext*                _avAudioOptions;
 	struct SwsContext*             _sws_context; ///< swscale: transformation context
+	AVFrame*                       _in_frame;    ///< reused input picture (data is not owned)
+	AVFrame*                       _out_frame;   ///< reused picture given to the encoder
+	boost::uint8_t*                _out_buffer;  ///< data of _out_frame
+	boost::int64_t                 _pts;         ///< presentation time of the next frame
 
 	AVCodec*                       _videoCodec;
 	AVCodec*                       _audioCodec;
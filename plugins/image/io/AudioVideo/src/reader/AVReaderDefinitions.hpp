@@ -21,6 +21,9 @@ static const std::string kParamMetaDetailledGroup        = "metaDetailledGroup";
 static const std::string kParamUseCustomSAR = "useCustomSAR";
 static const std::string kParamCustomSAR = "customSAR";
 
+/// Name of the libav decoding option for the number of threads
+static const std::string kParamThreads = "threads";
+
 }
 }
 }
@@ -70,6 +70,7 @@ void AVReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const s
 	if( paramName == kTuttlePluginFilename )
 	{
 		_errorInFile = false;
+		_initReader = false;
 	}
 	else if( paramName == kParamUseCustomSAR )
 	{
@@ -193,6 +194,10 @@ void AVReaderPlugin::render( const OFX::RenderArguments& args )
 		avCodecContext = avcodec_alloc_context3( avCodec );
 	#endif
 		setParameters( _reader, eAVParamVideo, (void*)avCodecContext, AV_OPT_FLAG_DECODING_PARAM | AV_OPT_FLAG_VIDEO_PARAM, 0 );
+
+		// codec options (like the number of threads) are only used when opening the codec
+		_reader.reopenVideoCodec();
+		_initReader = true;
 	}
 	
 	doGilRender<AVReaderProcess>( *this, args );
@@ -201,6 +206,7 @@ void AVReaderPlugin::render( const OFX::RenderArguments& args )
 void AVReaderPlugin::endSequenceRender( const OFX::EndSequenceRenderArguments& args )
 {
 	_reader.close();
+	_initReader = false;
 }
 
 }
@@ -124,6 +124,12 @@ void AVReaderPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	
 	addOptionsFromAVOption( desc, videoGroup, (void*)avCodecContext, AV_OPT_FLAG_DECODING_PARAM | AV_OPT_FLAG_VIDEO_PARAM, 0 );
 	
+	if( OFX::IntParamDescriptor* threads = dynamic_cast<OFX::IntParamDescriptor*>( desc.getParamDescriptor( kParamThreads ) ) )
+	{
+		threads->setDefault( 0 );
+		threads->setHint( "Number of decoding threads (0: automatic)." );
+	}
+	
 	OFX::BooleanParamDescriptor* useCustomSAR = desc.defineBooleanParam( kParamUseCustomSAR );
 	useCustomSAR->setLabel( "Override SAR" );
 	useCustomSAR->setDefault( false );
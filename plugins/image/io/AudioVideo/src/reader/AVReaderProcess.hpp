@@ -7,15 +7,54 @@
 #include <tuttle/plugin/exceptions.hpp>
 
 #include <boost/scoped_ptr.hpp>
+#include <boost/gil/gil_all.hpp>
 
 namespace tuttle {
 namespace plugin {
 namespace av {
 namespace reader {
 
+/**
+ * @brief libav pixel format matching a destination pixel type,
+ *        PIX_FMT_NONE if libav can't write it directly.
+ */
+template<class Pixel>
+struct DecodePixelFormat
+{
+	static PixelFormat value() { return PIX_FMT_NONE; }
+};
+
+template<>
+struct DecodePixelFormat<boost::gil::rgba8_pixel_t>
+{
+	static PixelFormat value() { return PIX_FMT_RGBA; }
+};
+
+template<>
+struct DecodePixelFormat<boost::gil::rgb8_pixel_t>
+{
+	static PixelFormat value() { return PIX_FMT_RGB24; }
+};
+
+template<>
+struct DecodePixelFormat<boost::gil::rgb16_pixel_t>
+{
+	static PixelFormat value() { return PIX_FMT_RGB48; }
+};
+
+#ifdef PIX_FMT_RGBA64
+template<>
+struct DecodePixelFormat<boost::gil::rgba16_pixel_t>
+{
+	static PixelFormat value() { return PIX_FMT_RGBA64; }
+};
+#endif
+
 /**
  * @brief Audio Video process
  *
+ * The decoded picture is converted by bands of rows on the host threads,
+ * directly in the output image when libav supports its pixel type.
  */
 template<class View>
 class AVReaderProcess : public ImageGilProcessor<View>
@@ -27,8 +66,14 @@ public:
 	AVReaderProcess( AVReaderPlugin& instance );
 
 	void setup( const OFX::RenderArguments& args );
+
+	/// @brief Split the rows on the aligned bands expected by the reader
+	void multiThreadFunction( const unsigned int threadId, const unsigned int nThreads );
 	// Do some processing
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	void convertRows( const int rowBegin, const int rowEnd );
 };
 
 }
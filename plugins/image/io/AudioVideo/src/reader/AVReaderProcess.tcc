@@ -2,6 +2,9 @@
 
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace av {
@@ -12,7 +15,6 @@ AVReaderProcess<View>::AVReaderProcess( AVReaderPlugin& instance )
 	: ImageGilProcessor<View>( instance, eImageOrientationFromTopToBottom )
 	, _plugin( instance )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>
@@ -32,6 +34,20 @@ void AVReaderProcess<View>::setup( const OFX::RenderArguments& args )
 	ImageGilProcessor<View>::setup( args );
 }
 
+template<class View>
+void AVReaderProcess<View>::multiThreadFunction( const unsigned int threadId, const unsigned int nThreads )
+{
+	const int height = this->_dstView.height();
+	const int alignment = _plugin._reader.rowsAlignment();
+	const int nbBlocks = ( height + alignment - 1 ) / alignment;
+	const int rowBegin = std::min( height, static_cast<int>( threadId * nbBlocks / nThreads ) * alignment );
+	const int rowEnd = std::min( height, static_cast<int>( ( threadId + 1 ) * nbBlocks / nThreads ) * alignment );
+	if( rowBegin < rowEnd )
+	{
+		convertRows( rowBegin, rowEnd );
+	}
+}
+
 /**
  * @brief Function called by rendering thread each time a process must be done.
  * @param[in] procWindowRoW  Processing window in RoW
@@ -39,15 +55,44 @@ void AVReaderProcess<View>::setup( const OFX::RenderArguments& args )
 template<class View>
 void AVReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
-	using namespace boost::gil;
 	BOOST_ASSERT( procWindowRoW == this->_dstPixelRod );
+	convertRows( 0, this->_dstView.height() );
+}
+
+/**
+ * @param[in] rowBegin, rowEnd  rows from the top of the image
+ */
+template<class View>
+void AVReaderProcess<View>::convertRows( const int rowBegin, const int rowEnd )
+{
+	using namespace boost::gil;
+	BOOST_ASSERT( this->_dstView.width() == _plugin._reader.width() );
+	BOOST_ASSERT( this->_dstView.height() == _plugin._reader.height() );
+
+	const PixelFormat directFormat = DecodePixelFormat<typename View::value_type>::value();
+	if( directFormat != PIX_FMT_NONE )
+	{
+		// write straight into the output image
+		boost::uint8_t* dst = reinterpret_cast<boost::uint8_t*>( &this->_dstView( 0, rowBegin ) );
+		const int dstLinesize = static_cast<int>( this->_dstView.pixels().row_size() );
+		if( !_plugin._reader.convert( dst, dstLinesize, directFormat, rowBegin, rowEnd ) )
+			BOOST_THROW_EXCEPTION( exception::Failed()
+			    << exception::user( "Unable to convert the decoded frame" )
+			    << exception::filename( _plugin._paramFilepath->getValue() ) );
+		return;
+	}
 
-	rgb8c_view_t avSrcView =
-	    interleaved_view( _plugin._reader.width(), _plugin._reader.height(),
-	                      (const rgb8c_pixel_t*)( _plugin._reader.data() ),
-	                      _plugin._reader.width() * 3 );
+	// convert to 16 bits, then to the output pixel type
+	const int width = this->_dstView.width();
+	const int nbRows = rowEnd - rowBegin;
+	std::vector<rgb16_pixel_t> buffer( std::size_t( width ) * nbRows );
+	if( !_plugin._reader.convert( reinterpret_cast<boost::uint8_t*>( &buffer[0] ), width * sizeof( rgb16_pixel_t ), PIX_FMT_RGB48, rowBegin, rowEnd ) )
+		BOOST_THROW_EXCEPTION( exception::Failed()
+		    << exception::user( "Unable to convert the decoded frame" )
+		    << exception::filename( _plugin._paramFilepath->getValue() ) );
 
-	copy_and_convert_pixels( avSrcView, this->_dstView );
+	const rgb16c_view_t avSrcView = interleaved_view( width, nbRows, &buffer[0], width * sizeof( rgb16_pixel_t ) );
+	copy_and_convert_pixels( avSrcView, subimage_view( this->_dstView, 0, rowBegin, width, nbRows ) );
 }
 
 }
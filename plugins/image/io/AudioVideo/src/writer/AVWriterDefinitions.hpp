@@ -38,6 +38,9 @@ static const std::string kParamUseCustomFps              = "useCustomFps";
 static const std::string kParamCustomFps                 = "customFps";
 static const std::string kParamVideoCodecPixelFmt        = "videoPixelFormat";
 
+/// Minimum number of frames waiting for the encoding thread
+static const std::size_t kEncodeQueueMinSize             = 2;
+
 }
 }
 }
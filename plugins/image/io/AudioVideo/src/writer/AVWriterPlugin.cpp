@@ -11,7 +11,9 @@
 
 #include <boost/gil/gil_all.hpp>
 #include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
 
+#include <algorithm>
 #include <cctype>
 
 namespace tuttle {
@@ -206,8 +208,6 @@ AVProcessParams AVWriterPlugin::getProcessParams()
 	params._videoCodec                     = _paramVideoCodec        ->getValue();
 	params._audioCodec                     = _paramAudioCodec        ->getValue();
 	params._videoPixelFormat               = static_cast<PixelFormat>( _paramVideoPixelFormat->getValue() );
-	
-	_writer.setVideoCodec( params._videoCodec );
 
 	return params;
 }
@@ -372,13 +372,15 @@ void AVWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 	
-	//OfxRangeD range = args.frameRange;
-	const OfxRectI bounds = _clipSrc->getPixelRod( args.time, args.renderScale );
-	_writer.setWidth ( bounds.x2 - bounds.x1 );
-	_writer.setHeight( bounds.y2 - bounds.y1 );
-	
 	if( !_initWriter )
 	{
+		// the encoding thread only starts after the first frame,
+		// the output size is fixed for the whole sequence
+		//OfxRangeD range = args.frameRange;
+		const OfxRectI bounds = _clipSrc->getPixelRod( args.time, args.renderScale );
+		_writer.setWidth ( bounds.x2 - bounds.x1 );
+		_writer.setHeight( bounds.y2 - bounds.y1 );
+		
 		_writer.start( );
 	
 		// set Format parameters
@@ -419,8 +421,44 @@ void AVWriterPlugin::render( const OFX::RenderArguments& args )
 
 void AVWriterPlugin::endSequenceRender( const OFX::EndSequenceRenderArguments& args )
 {
+	try
+	{
+		// wait for the frames in the encoding queue
+		WriterPlugin::endSequenceRender( args );
+	}
+	catch( ... )
+	{
+		_writer.finish();
+		_initWriter = false;
+		_encodeFrames.clear();
+		throw;
+	}
 	_writer.finish();
 	_initWriter = false;
+	_encodeFrames.clear();
+}
+
+std::size_t AVWriterPlugin::getWriteBehindSize() const
+{
+	return std::max( WriterPlugin::getWriteBehindSize(), kEncodeQueueMinSize );
+}
+
+boost::shared_ptr<AVEncodeFrame> AVWriterPlugin::acquireEncodeFrame()
+{
+	boost::mutex::scoped_lock lock( _encodeFramesMutex );
+	if( _encodeFrames.empty() )
+		return boost::make_shared<AVEncodeFrame>();
+	boost::shared_ptr<AVEncodeFrame> frame = _encodeFrames.back();
+	_encodeFrames.pop_back();
+	return frame;
+}
+
+void AVWriterPlugin::encodeFrame( const boost::shared_ptr<AVEncodeFrame>& frame )
+{
+	_writer.execute( &frame->_data[0], frame->_width, frame->_height, frame->_pixelFormat );
+
+	boost::mutex::scoped_lock lock( _encodeFramesMutex );
+	_encodeFrames.push_back( frame );
 }
 
 }
@@ -8,6 +8,9 @@
 #include <tuttle/plugin/context/WriterPlugin.hpp>
 
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
 
 #include <string>
 #include <vector>
@@ -30,6 +33,18 @@ struct AVProcessParams
 	PixelFormat _videoPixelFormat; /// videoPixelFormat
 };
 
+/**
+ * @brief Packed picture waiting to be encoded.
+ * Buffers are recycled by the plugin, so their allocation is done once per sequence.
+ */
+struct AVEncodeFrame
+{
+	std::vector<boost::uint8_t> _data;
+	int         _width;
+	int         _height;
+	PixelFormat _pixelFormat;
+};
+
 /**
  * @brief LibAV plugin
  */
@@ -51,6 +66,18 @@ public:
 	void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
 	void render( const OFX::RenderArguments& args );
 	void endSequenceRender( const OFX::EndSequenceRenderArguments& args );
+
+	/// @brief Frames are always encoded by the write-behind thread.
+	std::size_t getWriteBehindSize() const;
+
+	/// @brief Get an unused encode frame (recycled if possible).
+	boost::shared_ptr<AVEncodeFrame> acquireEncodeFrame();
+	/// @brief Encode a frame, called by the write-behind thread in the frames order.
+	void encodeFrame( const boost::shared_ptr<AVEncodeFrame>& frame );
+
+private:
+	boost::mutex _encodeFramesMutex;
+	std::vector<boost::shared_ptr<AVEncodeFrame> > _encodeFrames; ///< Unused encode frames
 	
 public:
 	OFX::ChoiceParam*   _paramFormat;
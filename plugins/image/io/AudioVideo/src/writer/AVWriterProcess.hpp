@@ -7,17 +7,44 @@
 #include <tuttle/plugin/exceptions.hpp>
 
 #include <terry/globals.hpp>
+#include <terry/channel.hpp>
 
 #include <boost/scoped_ptr.hpp>
+#include <boost/gil/gil_all.hpp>
 
 namespace tuttle {
 namespace plugin {
 namespace av {
 namespace writer {
 
+/**
+ * @brief Pixel type given to libav for a source channel type.
+ * 8 bits sources stay on 8 bits, deeper sources are given on 16 bits,
+ * so high bit depth codecs are not limited by an 8 bits conversion.
+ */
+template<class Channel>
+struct EncodePixel
+{
+#ifdef PIX_FMT_RGBA64
+	typedef boost::gil::rgba16_pixel_t type;
+	static PixelFormat pixelFormat() { return PIX_FMT_RGBA64; }
+#else
+	typedef boost::gil::rgb16_pixel_t type;
+	static PixelFormat pixelFormat() { return PIX_FMT_RGB48; }
+#endif
+};
+
+template<>
+struct EncodePixel<boost::gil::bits8>
+{
+	typedef boost::gil::rgba8_pixel_t type;
+	static PixelFormat pixelFormat() { return PIX_FMT_RGBA; }
+};
+
 /**
  * @brief FFMpeg process
  *
+ * Converts the source into a packed frame and gives it to the encoding thread.
  */
 template<class View>
 class AVWriterProcess : public ImageGilFilterProcessor<View>
@@ -30,6 +57,12 @@ public:
 	AVWriterProcess( AVWriterPlugin& instance );
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	template<class EncodeView>
+	void convert( const EncodeView& dst, boost::mpl::true_ /*scopedChannel*/ );
+	template<class EncodeView>
+	void convert( const EncodeView& dst, boost::mpl::false_ /*scopedChannel*/ );
 };
 
 }
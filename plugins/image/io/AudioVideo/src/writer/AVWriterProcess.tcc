@@ -1,6 +1,10 @@
 #include "AVWriterPlugin.hpp"
 #include "AVWriterProcess.hpp"
+
+#include <terry/clamp.hpp>
+
 #include <boost/filesystem.hpp>
+#include <boost/bind.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -23,24 +27,44 @@ AVWriterProcess<View>::AVWriterProcess( AVWriterPlugin& instance )
 template<class View>
 void AVWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
-	using namespace terry;
+	using namespace boost::gil;
+	typedef EncodePixel<typename channel_type<View>::type> Encode;
+	typedef typename Encode::type EncodePixelT;
+	typedef typename view_type_from_pixel<EncodePixelT>::type EncodeView;
 	BOOST_ASSERT( procWindowRoW == this->_dstPixelRod );
 
-	_plugin._writer.setWidth ( this->_srcView.width () );
-	_plugin._writer.setHeight( this->_srcView.height() );
+	// the destination is already filled by WriterPlugin::render
+	const int width = this->_srcView.width();
+	const int height = this->_srcView.height();
+	boost::shared_ptr<AVEncodeFrame> frame = _plugin.acquireEncodeFrame();
+	frame->_data.resize( std::size_t( width ) * height * sizeof( EncodePixelT ) );
+	frame->_width = width;
+	frame->_height = height;
+	frame->_pixelFormat = Encode::pixelFormat();
 
-	rgba8_image_t img ( this->_srcView.dimensions() );
-	rgba8_view_t  vw  ( view( img ) );
+	const EncodeView encodeView = interleaved_view( width, height,
+		reinterpret_cast<EncodePixelT*>( &frame->_data[0] ), width * sizeof( EncodePixelT ) );
+	convert( encodeView, typename terry::is_scoped_channel<typename channel_type<View>::type>::type() );
 
-	// Convert pixels in PIX_FMT_RGB24
-	copy_and_convert_pixels( this->_srcView, vw );
+	// encoded by the write-behind thread, in the frames order
+	_plugin.pushWriteBehind( this->_renderArgs.time, boost::bind( &AVWriterPlugin::encodeFrame, &_plugin, frame ) );
+}
 
-	// Convert pixels to destination
-	copy_and_convert_pixels( this->_srcView, this->_dstView );
-	uint8_t* pixels = (uint8_t*)boost::gil::interleaved_view_get_raw_data( vw );
+/**
+ * @brief Float sources are clamped before the integer conversion.
+ */
+template<class View>
+template<class EncodeView>
+void AVWriterProcess<View>::convert( const EncodeView& dst, boost::mpl::true_ )
+{
+	boost::gil::copy_and_convert_pixels( terry::clamp_view( this->_srcView ), dst );
+}
 
-	// Execute writing
-	_plugin._writer.execute( pixels, this->_srcView.width(), this->_srcView.height(), PIX_FMT_RGBA );
+template<class View>
+template<class EncodeView>
+void AVWriterProcess<View>::convert( const EncodeView& dst, boost::mpl::false_ )
+{
+	boost::gil::copy_and_convert_pixels( this->_srcView, dst );
 }
 
 }
@@ -2,7 +2,7 @@
 #define OFXPLUGIN_VERSION_MINOR 0
 
 #include <tuttle/plugin/Plugin.hpp>
-//#include "reader/DPXReaderPluginFactory.hpp"
+#include "reader/DPXReaderPluginFactory.hpp"
 #include "writer/DPXWriterPluginFactory.hpp"
 
 namespace OFX
@@ -11,7 +11,7 @@ namespace Plugin
 {
 void getPluginIDs( OFX::PluginFactoryArray& ids )
 {
-	//mAppendPluginFactory( ids, tuttle::plugin::dpx::reader::DPXReaderPluginFactory, "tuttle.dpxreader" );
+	mAppendPluginFactory( ids, tuttle::plugin::dpx::reader::DPXReaderPluginFactory, "tuttle.dpxreader" );
 	mAppendPluginFactory( ids, tuttle::plugin::dpx::writer::DPXWriterPluginFactory, "tuttle.dpxwriter" );
 }
 
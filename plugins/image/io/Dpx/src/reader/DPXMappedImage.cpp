@@ -0,0 +1,79 @@
+#include "DPXMappedImage.hpp"
+
+#include <libdpx/DPXHeader.h>
+
+#include <boost/filesystem/operations.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+namespace bip = boost::interprocess;
+
+DPXMappedImage::Rows::Rows( const DPXMappedImage& image, const std::size_t rowBegin, const std::size_t rowEnd )
+	: _region( *image._mapping, bip::read_only,
+	           image._dataOffset + rowBegin * image._rowSize,
+	           ( rowEnd - rowBegin ) * image._rowSize )
+	, _data( static_cast<const char*>( _region.get_address() ) )
+	, _rowBegin( rowBegin )
+	, _rowSize( image._rowSize )
+{}
+
+DPXMappedImage::DPXMappedImage()
+	: _width( 0 )
+	, _height( 0 )
+	, _dataOffset( 0 )
+	, _rowSize( 0 )
+	, _byteSwap( false )
+{}
+
+bool DPXMappedImage::open( const std::string& filename )
+{
+	close();
+
+	::dpx::Header header;
+	{
+		InStream stream;
+		if( ! stream.Open( filename.c_str() ) )
+			return false;
+		const bool valid = header.Read( &stream );
+		stream.Close();
+		if( ! valid )
+			return false;
+	}
+
+	if( header.NumberOfElements() < 1 ||
+	    header.ImageDescriptor( 0 ) != ::dpx::kRGB ||
+	    header.BitDepth( 0 ) != 10 ||
+	    header.ImagePacking( 0 ) != ::dpx::kFilledMethodA ||
+	    header.ImageEncoding( 0 ) != ::dpx::kNone ||
+	    header.ImageOrientation() != ::dpx::kLeftToRightTopToBottom )
+		return false;
+
+	_width = header.Width();
+	_height = header.Height();
+	_dataOffset = header.DataOffset( 0 );
+	if( _dataOffset == 0xffffffff )
+		_dataOffset = header.ImageOffset();
+	_rowSize = _width * sizeof( boost::uint32_t ) + header.EndOfLinePadding( 0 );
+	_byteSwap = header.RequiresByteSwap();
+
+	if( _width == 0 || _height == 0 ||
+	    boost::filesystem::file_size( filename ) < _dataOffset + _height * _rowSize )
+		return false;
+
+	_mapping.reset( new bip::file_mapping( filename.c_str(), bip::read_only ) );
+	return true;
+}
+
+void DPXMappedImage::close()
+{
+	_mapping.reset();
+	_width = _height = 0;
+}
+
+}
+}
+}
+}
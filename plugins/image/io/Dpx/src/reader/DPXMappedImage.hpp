@@ -0,0 +1,75 @@
+#ifndef _TUTTLE_PLUGIN_DPX_READER_MAPPEDIMAGE_HPP_
+#define _TUTTLE_PLUGIN_DPX_READER_MAPPEDIMAGE_HPP_
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/cstdint.hpp>
+
+#include <string>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+/**
+ * @brief Memory mapped access to the pixels of uncompressed 10 bits RGB
+ *        dpx files (filled with the method A, the common scan format).
+ *
+ * Only the rows needed are mapped, so each render thread maps its own part
+ * of the file and the pixels are unpacked straight from the page cache.
+ */
+class DPXMappedImage
+{
+public:
+	/// @brief Rows of the image mapped in memory
+	class Rows
+	{
+	public:
+		/// @param rowBegin, rowEnd  rows from the top of the image
+		Rows( const DPXMappedImage& image, const std::size_t rowBegin, const std::size_t rowEnd );
+
+		/// @return the pixel words of a row (from the top of the image)
+		const boost::uint32_t* row( const std::size_t y ) const
+		{
+			return reinterpret_cast<const boost::uint32_t*>( _data + ( y - _rowBegin ) * _rowSize );
+		}
+
+	private:
+		boost::interprocess::mapped_region _region;
+		const char* _data;
+		std::size_t _rowBegin;
+		std::size_t _rowSize;
+	};
+
+public:
+	DPXMappedImage();
+
+	/**
+	 * @brief Read the header of a dpx file.
+	 * @return false if the file can't use the mapped access.
+	 */
+	bool open( const std::string& filename );
+	void close();
+
+	std::size_t width() const  { return _width; }
+	std::size_t height() const { return _height; }
+	/// the file byte order isn't the native one
+	bool byteSwap() const      { return _byteSwap; }
+
+private:
+	boost::scoped_ptr<boost::interprocess::file_mapping> _mapping;
+	std::size_t _width;
+	std::size_t _height;
+	std::size_t _dataOffset; ///< offset of the first row in the file
+	std::size_t _rowSize;    ///< bytes per row, including the end of line padding
+	bool _byteSwap;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef _TUTTLE_PLUGIN_DPXREADER_ALGORITHM_HPP_
+#define _TUTTLE_PLUGIN_DPXREADER_ALGORITHM_HPP_
+
+#include <boost/cstdint.hpp>
+
+#ifdef __SSE2__
+#ifndef __SSSE3__
+#include <emmintrin.h>
+#else
+// SSSE3
+#include <tmmintrin.h>
+#endif
+#endif
+
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+/// @brief 10 bits value to 16 bits, replicating the most significant bits in the low bits
+inline boost::uint16_t channel10To16( const boost::uint32_t v )
+{
+	return static_cast<boost::uint16_t>( ( v << 6 ) | ( v >> 4 ) );
+}
+
+inline boost::uint32_t swapBytes32( const boost::uint32_t v )
+{
+	return ( v << 24 ) | ( ( v << 8 ) & 0x00ff0000 ) | ( ( v >> 8 ) & 0x0000ff00 ) | ( v >> 24 );
+}
+
+#ifdef __SSE2__
+
+inline __m128i swapBytes32( const __m128i v )
+{
+#ifdef __SSSE3__
+	return _mm_shuffle_epi8( v, _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 ) );
+#else
+	const __m128i mask = _mm_set1_epi32( 0x00ff00ff );
+	// swap the bytes of the 16 bits words, then the words
+	const __m128i v16 = _mm_or_si128( _mm_and_si128( _mm_srli_epi16( v, 8 ), mask ), _mm_slli_epi16( _mm_and_si128( v, mask ), 8 ) );
+	return _mm_or_si128( _mm_srli_epi32( v16, 16 ), _mm_slli_epi32( v16, 16 ) );
+#endif
+}
+
+/// @brief Channel at bit @p shift of 4 words, scaled to 16 bits
+inline __m128i channel10To16( const __m128i words, const int shift )
+{
+	const __m128i v = _mm_and_si128( _mm_srl_epi32( words, _mm_cvtsi32_si128( shift ) ), _mm_set1_epi32( 0x3ff ) );
+	return _mm_or_si128( _mm_slli_epi32( v, 6 ), _mm_srli_epi32( v, 4 ) );
+}
+
+/// @brief Pack two vectors of 4 unsigned values (< 65536) in 8 unsigned 16 bits values
+inline __m128i packUnsigned32To16( const __m128i a, const __m128i b )
+{
+	// SSE2 only has a signed saturation pack
+	const __m128i offset32 = _mm_set1_epi32( 0x8000 );
+	const __m128i offset16 = _mm_set1_epi16( static_cast<short>( 0x8000 ) );
+	return _mm_xor_si128( _mm_packs_epi32( _mm_sub_epi32( a, offset32 ), _mm_sub_epi32( b, offset32 ) ), offset16 );
+}
+
+#endif
+
+/**
+ * @brief Unpack 10 bits RGB pixels filled in 32 bits words with the method A
+ *        (red in the most significant bits, 2 padding bits at the end),
+ *        to interleaved 16 bits RGB pixels.
+ * @param[in] src      pixel words, in the file byte order
+ * @param[out] dst     3 * nbPixels values
+ * @param[in] byteSwap the file byte order isn't the native one
+ */
+inline void unpackRGB10FilledA( const boost::uint32_t* src, boost::uint16_t* dst, const std::size_t nbPixels, const bool byteSwap )
+{
+	std::size_t i = 0;
+#ifdef __SSE2__
+	for( ; i + 8 <= nbPixels; i += 8 )
+	{
+		__m128i words0 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i ) );
+		__m128i words1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i + 4 ) );
+		if( byteSwap )
+		{
+			words0 = swapBytes32( words0 );
+			words1 = swapBytes32( words1 );
+		}
+		const __m128i r = packUnsigned32To16( channel10To16( words0, 22 ), channel10To16( words1, 22 ) );
+		const __m128i g = packUnsigned32To16( channel10To16( words0, 12 ), channel10To16( words1, 12 ) );
+		const __m128i b = packUnsigned32To16( channel10To16( words0, 2 ), channel10To16( words1, 2 ) );
+		__m128i* out = reinterpret_cast<__m128i*>( dst + 3 * i );
+#ifdef __SSSE3__
+		// interleave the 8 r, g, b values in 3 vectors
+		const __m128i out0 = _mm_or_si128( _mm_or_si128(
+			_mm_shuffle_epi8( r, _mm_setr_epi8( 0, 1, -128, -128, -128, -128, 2, 3, -128, -128, -128, -128, 4, 5, -128, -128 ) ),
+			_mm_shuffle_epi8( g, _mm_setr_epi8( -128, -128, 0, 1, -128, -128, -128, -128, 2, 3, -128, -128, -128, -128, 4, 5 ) ) ),
+			_mm_shuffle_epi8( b, _mm_setr_epi8( -128, -128, -128, -128, 0, 1, -128, -128, -128, -128, 2, 3, -128, -128, -128, -128 ) ) );
+		const __m128i out1 = _mm_or_si128( _mm_or_si128(
+			_mm_shuffle_epi8( r, _mm_setr_epi8( -128, -128, 6, 7, -128, -128, -128, -128, 8, 9, -128, -128, -128, -128, 10, 11 ) ),
+			_mm_shuffle_epi8( g, _mm_setr_epi8( -128, -128, -128, -128, 6, 7, -128, -128, -128, -128, 8, 9, -128, -128, -128, -128 ) ) ),
+			_mm_shuffle_epi8( b, _mm_setr_epi8( 4, 5, -128, -128, -128, -128, 6, 7, -128, -128, -128, -128, 8, 9, -128, -128 ) ) );
+		const __m128i out2 = _mm_or_si128( _mm_or_si128(
+			_mm_shuffle_epi8( r, _mm_setr_epi8( -128, -128, -128, -128, 12, 13, -128, -128, -128, -128, 14, 15, -128, -128, -128, -128 ) ),
+			_mm_shuffle_epi8( g, _mm_setr_epi8( 10, 11, -128, -128, -128, -128, 12, 13, -128, -128, -128, -128, 14, 15, -128, -128 ) ) ),
+			_mm_shuffle_epi8( b, _mm_setr_epi8( -128, -128, 10, 11, -128, -128, -128, -128, 12, 13, -128, -128, -128, -128, 14, 15 ) ) );
+		_mm_storeu_si128( out, out0 );
+		_mm_storeu_si128( out + 1, out1 );
+		_mm_storeu_si128( out + 2, out2 );
+#else
+		boost::uint16_t planes[3][8];
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( planes[0] ), r );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( planes[1] ), g );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( planes[2] ), b );
+		boost::uint16_t* it = reinterpret_cast<boost::uint16_t*>( out );
+		for( int p = 0; p < 8; ++p )
+		{
+			*it++ = planes[0][p];
+			*it++ = planes[1][p];
+			*it++ = planes[2][p];
+		}
+#endif
+	}
+#endif
+	for( ; i < nbPixels; ++i )
+	{
+		const boost::uint32_t word = byteSwap ? swapBytes32( src[i] ) : src[i];
+		dst[3 * i]     = channel10To16( ( word >> 22 ) & 0x3ff );
+		dst[3 * i + 1] = channel10To16( ( word >> 12 ) & 0x3ff );
+		dst[3 * i + 2] = channel10To16( ( word >> 2 ) & 0x3ff );
+	}
+}
+
+}
+}
+}
+}
+
+#endif
@@ -2,18 +2,42 @@
 #include "DPXReaderProcess.hpp"
 #include "DPXReaderDefinitions.hpp"
 
+#include <libdpx/DPX.h>
+
 #include <boost/gil/gil_all.hpp>
-#include <boost/filesystem.hpp>
+
+#include <sstream>
 
 namespace tuttle {
 namespace plugin {
 namespace dpx {
 namespace reader {
 
-using namespace boost::filesystem;
-using namespace tuttle::io;
 using namespace boost::gil;
 
+namespace {
+
+void readDpxHeader( const std::string& filename, ::dpx::Header& header )
+{
+	InStream stream;
+	if( ! stream.Open( filename.c_str() ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to open file." )
+			<< exception::filename( filename ) );
+	}
+	const bool valid = header.Read( &stream );
+	stream.Close();
+	if( ! valid )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to read the file header." )
+			<< exception::filename( filename ) );
+	}
+}
+
+}
+
 DPXReaderPlugin::DPXReaderPlugin( OfxImageEffectHandle handle )
 	: ReaderPlugin( handle )
 {}
@@ -32,11 +56,18 @@ void DPXReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const
 	ReaderPlugin::changedParam( args, paramName );
 	if( paramName == kParamDisplayHeader )
 	{
-		tuttle::io::DpxImage dpxImg;
-		dpxImg.readHeader( getAbsoluteFilenameAt( args.time ) );
+		::dpx::Header header;
+		readDpxHeader( getAbsoluteFilenameAt( args.time ), header );
 		std::ostringstream headerStr;
 		headerStr << "DPX HEADER:" << std::endl;
-		headerStr << dpxImg.getHeader();
+		headerStr << "size: " << header.Width() << "x" << header.Height() << std::endl;
+		headerStr << "number of elements: " << header.NumberOfElements() << std::endl;
+		headerStr << "descriptor: " << int( header.ImageDescriptor( 0 ) ) << std::endl;
+		headerStr << "bit depth: " << int( header.BitDepth( 0 ) ) << std::endl;
+		headerStr << "packing: " << int( header.ImagePacking( 0 ) ) << std::endl;
+		headerStr << "encoding: " << int( header.ImageEncoding( 0 ) ) << std::endl;
+		headerStr << "orientation: " << int( header.ImageOrientation() ) << std::endl;
+		headerStr << "byte swap: " << header.RequiresByteSwap() << std::endl;
 
 		TUTTLE_TLOG( TUTTLE_INFO, headerStr.str() );
 
@@ -46,79 +77,53 @@ void DPXReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const
 	}
 }
 
-bool DPXReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
-{
-	tuttle::io::DpxImage dpxImg;
-
-	dpxImg.readHeader( getAbsoluteFilenameAt( args.time ) );
-	rod.x1 = 0;
-	rod.x2 = dpxImg.width() * this->_clipDst->getPixelAspectRatio();
-	rod.y1 = 0;
-	rod.y2 = dpxImg.height();
-	return true;
-}
-
-void DPXReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences )
+void DPXReaderPlugin::readHeader( const std::string& filename, ReaderHeader& header )
 {
-	ReaderPlugin::getClipPreferences( clipPreferences );
-	const std::string filename( getAbsoluteFirstFilename() );
-
-	DpxImage dpxImg;
-	dpxImg.readHeader( filename );
-
-	if( getExplicitConversion() == eParamReaderExplicitConversionAuto )
+	::dpx::Header dpxHeader;
+	readDpxHeader( filename, dpxHeader );
+
+	header._rod.x1 = 0;
+	header._rod.x2 = dpxHeader.Width();
+	header._rod.y1 = 0;
+	header._rod.y2 = dpxHeader.Height();
+	header._dataRod = header._rod;
+	header._nbChannels = dpxHeader.ImageElementComponentCount( 0 );
+	header._components = header._nbChannels == 3 ? OFX::ePixelComponentRGB : OFX::ePixelComponentRGBA;
+	switch( dpxHeader.BitDepth( 0 ) )
 	{
-		OFX::EBitDepth bd = OFX::eBitDepthNone;
-		switch( dpxImg.componentsType() )
+		case 8:
 		{
-			case DpxImage::eCompTypeR8G8B8:
-			case DpxImage::eCompTypeR8G8B8A8:
-			case DpxImage::eCompTypeA8B8G8R8:
-			{
-				bd = OFX::eBitDepthUByte;
-				break;
-			}
-			case DpxImage::eCompTypeR10G10B10:
-			case DpxImage::eCompTypeR10G10B10A10:
-			case DpxImage::eCompTypeA10B10G10R10:
-			case DpxImage::eCompTypeR12G12B12:
-			case DpxImage::eCompTypeR12G12B12A12:
-			case DpxImage::eCompTypeA12B12G12R12:
-			case DpxImage::eCompTypeR16G16B16:
-			case DpxImage::eCompTypeR16G16B16A16:
-			case DpxImage::eCompTypeA16B16G16R16:
-			{
-				bd = OFX::eBitDepthUShort;
-				break;
-			}
-			default:
-				bd = OFX::eBitDepthFloat;
-		}
-
-		clipPreferences.setClipBitDepth( *_clipDst, bd );
-	}
-	switch( dpxImg.components() )
-	{
-		case 3:
-		{
-			clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGB );
+			header._bitDepth = OFX::eBitDepthUByte;
 			break;
 		}
-
-		case 4:
+		case 10:
+		case 12:
+		case 16:
 		{
-			clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
+			header._bitDepth = OFX::eBitDepthUShort;
 			break;
 		}
 		default:
-		{
-			clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
-			break;
-		}
+			header._bitDepth = OFX::eBitDepthFloat;
 	}
+}
+
+bool DPXReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
+{
+	const ReaderHeader header = getHeaderAt( args.time );
+	rod.x1 = 0;
+	rod.x2 = ( header._rod.x2 - header._rod.x1 ) * this->_clipDst->getPixelAspectRatio();
+	rod.y1 = 0;
+	rod.y2 = header._rod.y2 - header._rod.y1;
+	return true;
+}
 
-	clipPreferences.setPixelAspectRatio( *this->_clipDst, 1.0 );
+void DPXReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences )
+{
+	ReaderPlugin::getClipPreferences( clipPreferences );
+	setClipPreferencesFromHeader( clipPreferences, getFirstHeader() );
 }
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
@@ -144,6 +149,10 @@ void DPXReaderPlugin::render( const OFX::RenderArguments& args )
 			return;
 		}
 		case OFX::ePixelComponentAlpha:
+		{
+			doGilRender<DPXReaderProcess, false, gray_layout_t>( *this, args, bitDepth );
+			return;
+		}
 		case OFX::ePixelComponentCustom:
 		case OFX::ePixelComponentNone:
 		{
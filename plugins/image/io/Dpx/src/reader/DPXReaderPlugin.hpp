@@ -29,6 +29,9 @@ public:
 	void                   getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences );
 
 	void              render( const OFX::RenderArguments& args );
+
+protected:
+	void readHeader( const std::string& filename, ReaderHeader& header );
 };
 
 }
@@ -1,13 +1,15 @@
 #ifndef _TUTTLE_PLUGIN_DPX_READER_PROCESS_HPP_
 #define _TUTTLE_PLUGIN_DPX_READER_PROCESS_HPP_
 
+#include "DPXMappedImage.hpp"
+
+#include <libdpx/DPX.h>
+
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
 #include <boost/gil/gil_all.hpp>
-#include <boost/scoped_ptr.hpp>
-#include <boost/filesystem/fstream.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -32,14 +34,21 @@ public:
 	View& readImage( View& dst );
 
 protected:
-	template<class T, class DST_V>
-	void bitStreamToView( DST_V& dst, const int nc, const int channelSize );
+	/// @brief Read the first image element with libdpx, in @p Channel values
+	template<class Channel>
+	void readElement( ::dpx::Reader& reader, const ::dpx::DataSize dataSize, View& dst );
+	template<class Pixel>
+	void readPixels( ::dpx::Reader& reader, const ::dpx::DataSize dataSize, View& dst );
+
+	/// @brief Unpack the rows of the window from the mapped file
+	void readMappedRows( const OfxRectI& procWindowRoW );
 
 protected:
 	DPXReaderPlugin&    _plugin;        ///< Rendering plugin
 	DPXReaderProcessParams _params;
-	
-	tuttle::io::DpxImage _dpxImage;
+
+	DPXMappedImage       _mappedImage;
+	bool                 _useMappedImage; ///< fast path for uncompressed 10 bits files
 
 };
 
@@ -1,5 +1,6 @@
 #include "DPXReaderPlugin.hpp"
 #include "DPXReaderDefinitions.hpp"
+#include "DPXReaderAlgorithm.hpp"
 
 #include <terry/globals.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -8,27 +9,38 @@
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
 
-#include <terry/typedefs.hpp>
 #include <boost/gil/gil_all.hpp>
-#include <boost/gil/packed_pixel.hpp>
 
-#include <boost/integer.hpp>  // for boost::uint_t
 #include <boost/cstdint.hpp>
-#include <boost/mpl/vector.hpp>
-#include <boost/scoped_ptr.hpp>
-#include <boost/filesystem/fstream.hpp>
+
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
 namespace dpx {
 namespace reader {
 
-namespace bfs = boost::filesystem;
+namespace detail {
+
+/// @return the row of the view if the 16 bits rgb pixels can be written in place, NULL otherwise
+template<class View>
+inline boost::uint16_t* rgb16Row( const View&, const std::ptrdiff_t, const std::ptrdiff_t )
+{
+	return NULL;
+}
+
+inline boost::uint16_t* rgb16Row( const boost::gil::rgb16_view_t& view, const std::ptrdiff_t x, const std::ptrdiff_t y )
+{
+	return reinterpret_cast<boost::uint16_t*>( &view( x, y ) );
+}
+
+}
 
 template<class View>
 DPXReaderProcess<View>::DPXReaderProcess( DPXReaderPlugin& instance )
 	: ImageGilProcessor<View>( instance, eImageOrientationFromTopToBottom )
 	, _plugin( instance )
+	, _useMappedImage( false )
 {
 	this->setNoMultiThreading();
 }
@@ -43,6 +55,13 @@ void DPXReaderProcess<View>::setup( const OFX::RenderArguments& args )
 	using namespace boost::gil;
 	ImageGilProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.time );
+
+	// uncompressed 10 bits files are unpacked from the file mapping, by all the render threads
+	_useMappedImage = _mappedImage.open( _params._filepath ) &&
+	                  this->_dstView.width() == static_cast<std::ptrdiff_t>( _mappedImage.width() ) &&
+	                  this->_dstView.height() == static_cast<std::ptrdiff_t>( _mappedImage.height() );
+	if( _useMappedImage )
+		this->setNbThreadsAuto();
 }
 
 /**
@@ -53,325 +72,136 @@ template<class View>
 void DPXReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
 	using namespace boost::gil;
+	if( _useMappedImage )
+	{
+		readMappedRows( procWindowRoW );
+		return;
+	}
 	readImage( this->_dstView );
 }
 
 template<class View>
-View& DPXReaderProcess<View>::readImage( View& dst )
+void DPXReaderProcess<View>::readMappedRows( const OfxRectI& procWindowRoW )
 {
-	using namespace boost;
-	using namespace mpl;
 	using namespace boost::gil;
-
-	_dpxImage.read( _params._filepath, true );
-
-	switch( _dpxImage.componentsType() )
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const std::ptrdiff_t x = procWindowOutput.x1;
+	const std::ptrdiff_t width = procWindowOutput.x2 - procWindowOutput.x1;
+	// the view and the file rows are from top to bottom
+	const std::ptrdiff_t rowBegin = this->_dstView.height() - procWindowOutput.y2;
+	const std::ptrdiff_t rowEnd = this->_dstView.height() - procWindowOutput.y1;
+	if( width <= 0 || rowBegin >= rowEnd )
+		return;
+
+	// only map the rows of the window
+	const DPXMappedImage::Rows rows( _mappedImage, rowBegin, rowEnd );
+	std::vector<rgb16_pixel_t> buffer;
+	for( std::ptrdiff_t y = rowBegin; y < rowEnd; ++y )
 	{
-		case tuttle::io::DpxImage::eCompTypeR8G8B8:
-		{
-			// Tests passed: fill, non fill, big endian, little endian
-			rgb8c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-							     (const rgb8_pixel_t*)( _dpxImage.data() ),
-							     _dpxImage.width() * 3 );
-			copy_and_convert_pixels( src, dst );
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR8G8B8A8:
-		{
-			// Tests passed: fill, non fill, big endian, little endian
-			rgba8c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-							      (const rgba8_pixel_t*)( _dpxImage.data() ),
-							      _dpxImage.width() * 4 );
-
-			copy_and_convert_pixels( src, dst );
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeA8B8G8R8:
+		boost::uint16_t* dst = detail::rgb16Row( this->_dstView, x, y );
+		if( dst )
 		{
-			// Untested (need images samples), quite sure it is working
-			abgr8c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-							      (const abgr8_pixel_t*)( _dpxImage.data() ),
-							      _dpxImage.width() * 4 );
-
-			copy_and_convert_pixels( src, dst );
-			break;
+			unpackRGB10FilledA( rows.row( y ) + x, dst, width, _mappedImage.byteSwap() );
+			continue;
 		}
-		case tuttle::io::DpxImage::eCompTypeR10G10B10:
-		{
-			// Tests passed: fill, non fill, big endian, little endian
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgb16_image_t img( dst.width(), dst.height() );
-					rgb16_view_t vw( view( img ) );
-					bitStreamToView<rgb10_stream_ptr_t>( vw, 3, 10 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					int width               = _dpxImage.width();
-					int height              = _dpxImage.height();
-					gray32_view_t src = interleaved_view( width, height,
-										    ( gray32_pixel_t* )( _dpxImage.rawData() ),
-										    width * sizeof( uint32_t ) );
-
-					rgb16_image_t img16( width, height );
-					rgb16_view_t vw16( view( img16 ) );
-					for( typename gray32_view_t::y_coord_t y = 0; y < height; ++y )
-					{
-						typename gray32_view_t::x_iterator sit = src.row_begin( y );
-						typename rgb16_view_t::x_iterator  dit = vw16.row_begin( y );
-						for( typename gray32_view_t::x_coord_t x = 0; x < width; ++x )
-						{
-							uint32_t pixel = (uint32_t) *sit;
-
-							short red   = ( ( pixel & 0xffc00000 ) >> 22 );
-							short green = ( ( pixel & 0x003ff000 ) >> 12 );
-							short blue  = ( ( pixel & 0x00000ffc ) >>  2 );
-
-							get_color( *dit, red_t()   ) = red ;
-							get_color( *dit, green_t() ) = green ;
-							get_color( *dit, blue_t()  ) = blue ;
-
-							++sit;
-							++dit;
-						}
-					}
-
-					copy_and_convert_pixels( vw16, dst );
-					break;
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR10G10B10A10:
-		{
-			// Tests passed: fill with big endian or little endian
-			// Tests failed: non fill
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgba16_image_t img( dst.width(), dst.height() );
-					rgba16_view_t vw( view( img ) );
-					bitStreamToView<rgba10_stream_ptr_t>( vw, 4, 10 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					BOOST_THROW_EXCEPTION( exception::Failed()
-						<< exception::dev() + "Unsupported dpx file format (RGBA10 byte packed). " );
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeA10B10G10R10:
-		{
-			// Untested (need images samples), quite sure it is not working :(
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgba16_image_t img( dst.width(), dst.height() );
-					rgba16_view_t vw( view( img ) );
-					bitStreamToView<abgr10_stream_ptr_t>( vw, 4, 10 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				case 1:
-				case 2:
-				{
-					BOOST_THROW_EXCEPTION( exception::Failed()
-						<< exception::dev() + "Unsupported dpx file format (ABGR10 byte packed). " );
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR12G12B12:
-		{
-			// Tests failed: all (sick) !
-			// Probable bug in gil...
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgb16_image_t img( dst.width(), dst.height() );
-					rgb16_view_t vw( view( img ) );
-					bitStreamToView<rgb12_stream_ptr_t>( vw, 3, 12 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					int width               = _dpxImage.width();
-					int height              = _dpxImage.height();
-					rgb12_packed_view_t src = interleaved_view( width, height,
-										    ( rgb12_packed_pixel_t* )( _dpxImage.data() ),
-										    _dpxImage.width() * 6 );
-					// This is temporary but needed because of a probable bug in gil
-					// Should be using copy_and_convert_pixels
-					rgb16_image_t img16( width, height );
-					rgb16_view_t vw16( view( img16 ) );
-					for( typename rgb12_packed_view_t::y_coord_t y = 0; y < height; ++y )
-					{
-						typename rgb12_packed_view_t::x_iterator sit = src.row_begin( y );
-						typename rgb16_view_t::x_iterator dit        = vw16.row_begin( y );
-						for( typename rgb12_packed_view_t::x_coord_t x = 0; x < width; ++x )
-						{
-							color_convert( *sit, *dit );
-							++sit;
-							++dit;
-						}
-					}
-					copy_and_convert_pixels( vw16, dst );
-					break;
+		buffer.resize( width );
+		unpackRGB10FilledA( rows.row( y ) + x, reinterpret_cast<boost::uint16_t*>( &buffer[0] ), width, _mappedImage.byteSwap() );
+		const rgb16c_view_t src = interleaved_view( width, 1, &buffer[0], width * sizeof( rgb16_pixel_t ) );
+		copy_and_convert_pixels( src, subimage_view( this->_dstView, x, y, width, 1 ) );
+	}
+}
 
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR12G12B12A12:
-		{
-			// Tests passed: fill big endian or little endian, non fill little endian or big endian
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgba16_image_t img( dst.width(), dst.height() );
-					rgba16_view_t vw( view( img ) );
-					bitStreamToView<rgba12_stream_ptr_t>( vw, 4, 12 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					BOOST_THROW_EXCEPTION( exception::Failed()
-						<< exception::dev() + "Unsupported dpx file format (RGBA12 byte packed). " );
-					rgba12_packed_view_t vw = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-										    ( rgba12_packed_pixel_t* )( _dpxImage.data() ),
-										    _dpxImage.width() * sizeof( uint64_t ) );
+template<class View>
+View& DPXReaderProcess<View>::readImage( View& dst )
+{
+	using namespace boost::gil;
 
-					//copy_and_convert_pixels( vw, dst );
-					break;
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeA12B12G12R12:
-		{
-			// Untested
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgba16_image_t img( dst.width(), dst.height() );
-					rgba16_view_t vw( view( img ) );
-					bitStreamToView<abgr12_stream_ptr_t>( vw, 4, 12 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					BOOST_THROW_EXCEPTION( exception::Failed()
-						<< exception::dev() + "Unsupported dpx file format (ABGR12 byte packed). " );
-/*
-					abgr12_packed_view_t vw = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-										    ( abgr12_packed_pixel_t* )( _dpxImage.data() ),
-										    _dpxImage.width() * sizeof( uint64_t ) );
+	InStream stream;
+	if( ! stream.Open( _params._filepath.c_str() ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to open file." )
+			<< exception::filename( _params._filepath ) );
+	}
+	::dpx::Reader reader;
+	reader.SetInStream( &stream );
+	if( ! reader.ReadHeader() )
+	{
+		stream.Close();
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to read the file header." )
+			<< exception::filename( _params._filepath ) );
+	}
 
-					//copy_and_convert_pixels( vw, dst );*/
-					break;
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR16G16B16:
+	// libdpx scales the 10 and 12 bits values to 16 bits by bit replication, like the mapped path
+	try
+	{
+		switch( reader.header.BitDepth( 0 ) )
 		{
-			/// @todo: bug here.
-			//TUTTLE_LOG_INFOS;
-			//TUTTLE_LOG_VAR( TUTTLE_INFO, _dpxImage.width() );
-			//TUTTLE_LOG_VAR( TUTTLE_INFO, _dpxImage.height() );
-			//TUTTLE_LOG_VAR( TUTTLE_INFO, sizeof( rgb16_pixel_t ) );
-			// Tests passed: fill, non fill, big endian, little endian
-			rgb16c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-							      (const rgb16_pixel_t*)( _dpxImage.data() ),
-							      _dpxImage.width() * sizeof( rgb16_pixel_t ) );
-			copy_and_convert_pixels( src, dst );
-			break;
+			case 8:
+				readElement<bits8>( reader, ::dpx::kByte, dst );
+				break;
+			case 10:
+			case 12:
+			case 16:
+				readElement<bits16>( reader, ::dpx::kWord, dst );
+				break;
+			case 32:
+				readElement<bits32f>( reader, ::dpx::kFloat, dst );
+				break;
+			default:
+				BOOST_THROW_EXCEPTION( exception::Unsupported()
+					<< exception::user() + "Dpx: Unsupported bit depth (" + int( reader.header.BitDepth( 0 ) ) + ")." );
 		}
-		case tuttle::io::DpxImage::eCompTypeR16G16B16A16:
-		{
-			// Tests passed: fill, non fill, big endian, little endian
-			rgba16c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-												   (const rgba16_pixel_t*)( _dpxImage.data() ),
-												   _dpxImage.width() * sizeof( uint64_t ) );
+	}
+	catch( ... )
+	{
+		stream.Close();
+		throw;
+	}
+	stream.Close();
+	return dst;
+}
 
-			copy_and_convert_pixels( src, dst );
+template<class View>
+template<class Channel>
+void DPXReaderProcess<View>::readElement( ::dpx::Reader& reader, const ::dpx::DataSize dataSize, View& dst )
+{
+	using namespace boost::gil;
+	switch( reader.header.ImageDescriptor( 0 ) )
+	{
+		case ::dpx::kRGB:
+			readPixels<pixel<Channel, rgb_layout_t> >( reader, dataSize, dst );
 			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeA16B16G16R16:
-		{
-			// Untested (need images samples), quite sure it is working
-			abgr16c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-												   (const abgr16_pixel_t*)( _dpxImage.data() ),
-												   _dpxImage.width() * sizeof( uint64_t ) );
-
-			copy_and_convert_pixels( src, dst );
+		case ::dpx::kRGBA:
+			readPixels<pixel<Channel, rgba_layout_t> >( reader, dataSize, dst );
 			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeUnknown:
-		{
-			BOOST_THROW_EXCEPTION( exception::Failed()
-				<< exception::dev() + "Unrecognized image type, bit depth is " + _dpxImage.getHeader().bitSize() + ", component type is: " + _dpxImage.getHeader().descriptor() + ".\n"
-						    + "DPX HEADER:\n"
-						    + _dpxImage.getHeader() );
+		case ::dpx::kABGR:
+			readPixels<pixel<Channel, abgr_layout_t> >( reader, dataSize, dst );
 			break;
-		}
+		default:
+			BOOST_THROW_EXCEPTION( exception::Unsupported()
+				<< exception::user() + "Dpx: Unsupported component type (" + int( reader.header.ImageDescriptor( 0 ) ) + ")." );
 	}
-
-	return dst;
 }
 
 template<class View>
-template<class T, class DST_V>
-void DPXReaderProcess<View>::bitStreamToView( DST_V& dst, const int nc, const int channelSize )
+template<class Pixel>
+void DPXReaderProcess<View>::readPixels( ::dpx::Reader& reader, const ::dpx::DataSize dataSize, View& dst )
 {
-	boost::uint8_t* pData = _dpxImage.data();
-
-	typedef unsigned char byte_t;
-	int width             = _dpxImage.width();
-	int height            = _dpxImage.height();
-	int scanline_in_bits  = width * nc * channelSize;
-	int scanline_in_bytes = scanline_in_bits / 8;
-	scanline_in_bytes += ( scanline_in_bits % 8 != 0 ) ? 1 : 0;
-	T p( pData, 0 );
-
-	for( typename DST_V::y_coord_t y = 0; y < height; ++y )
+	using namespace boost::gil;
+	const std::ptrdiff_t width = reader.header.Width();
+	const std::ptrdiff_t height = reader.header.Height();
+	std::vector<Pixel> buffer( width * height );
+	if( ! reader.ReadImage( &buffer[0], dataSize, reader.header.ImageDescriptor( 0 ) ) )
 	{
-		typename DST_V::x_iterator it = dst.row_begin( y );
-
-		for( typename DST_V::x_coord_t x = 0; x < width; ++x )
-		{
-			color_convert( *p, *it );
-			++p;
-			++it;
-		}
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to read the image." )
+			<< exception::filename( _params._filepath ) );
 	}
+	typedef typename type_from_x_iterator<const Pixel*>::view_t SrcView;
+	const SrcView src = interleaved_view( width, height, static_cast<const Pixel*>( &buffer[0] ), width * sizeof( Pixel ) );
+	copy_and_convert_pixels( src, dst );
 }
 
 }
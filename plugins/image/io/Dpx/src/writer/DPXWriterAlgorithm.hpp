@@ -10,7 +10,12 @@
 #include <tmmintrin.h>
 #endif
 
+#include "DPXWriterPack.hpp"
+
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
+
+#include <boost/cstdint.hpp>
+
 #include <vector>
 
 using namespace boost::gil;
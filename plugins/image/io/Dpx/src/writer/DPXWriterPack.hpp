@@ -0,0 +1,131 @@
+#ifndef _TUTTLE_PLUGIN_DPXWRITER_PACK_HPP_
+#define _TUTTLE_PLUGIN_DPXWRITER_PACK_HPP_
+
+#include <boost/cstdint.hpp>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace writer {
+
+inline boost::uint32_t swapBytes32( const boost::uint32_t v )
+{
+	return ( v << 24 ) | ( ( v << 8 ) & 0x00ff0000 ) | ( ( v >> 8 ) & 0x0000ff00 ) | ( v >> 24 );
+}
+
+/// @brief Number of 32 bits words of a row of 10 bits components filled with method A or B
+inline std::size_t filled10RowWords( const std::size_t nbComponents )
+{
+	return ( nbComponents + 2 ) / 3;
+}
+
+/// @brief Number of 32 bits words of a row of packed 12 bits components
+inline std::size_t packed12RowWords( const std::size_t nbComponents )
+{
+	return ( nbComponents * 12 + 31 ) / 32;
+}
+
+/**
+ * @brief Pack 16 bits components in 10 bits, 3 per 32 bits word, with the
+ *        layout of libdpx for the filled methods.
+ * @param[in] reverse     first component in the most significant bits (libdpx datum swap of RGB)
+ * @param[in] methodShift 2 for the method A (padding in the low bits), 0 for the method B
+ * @param[in] byteSwap    write the words in the non native byte order
+ */
+inline void packComponents10Filled( const boost::uint16_t* src, boost::uint32_t* dst, const std::size_t nbComponents,
+                                    const bool reverse, const int methodShift, const bool byteSwap )
+{
+	const int shift0 = ( reverse ? 20 : 0 ) + methodShift;
+	const int shift1 = 10 + methodShift;
+	const int shift2 = ( reverse ? 0 : 20 ) + methodShift;
+	std::size_t i = 0;
+#ifdef __SSSE3__
+	// 12 components in 4 words: gather the 1st, 2nd and 3rd component of each word in 32 bits lanes
+	const __m128i first0  = _mm_setr_epi8( 0, 1, -128, -128, 6, 7, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 );
+	const __m128i first1  = _mm_setr_epi8( -128, -128, -128, -128, -128, -128, -128, -128, 4, 5, -128, -128, 10, 11, -128, -128 );
+	const __m128i second0 = _mm_setr_epi8( 2, 3, -128, -128, 8, 9, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 );
+	const __m128i second1 = _mm_setr_epi8( -128, -128, -128, -128, -128, -128, -128, -128, 6, 7, -128, -128, 12, 13, -128, -128 );
+	const __m128i third0  = _mm_setr_epi8( 4, 5, -128, -128, 10, 11, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 );
+	const __m128i third1  = _mm_setr_epi8( -128, -128, -128, -128, -128, -128, -128, -128, 8, 9, -128, -128, 14, 15, -128, -128 );
+	const __m128i swapMask = _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+	const __m128i count0 = _mm_cvtsi32_si128( shift0 );
+	const __m128i count1 = _mm_cvtsi32_si128( shift1 );
+	const __m128i count2 = _mm_cvtsi32_si128( shift2 );
+	for( ; i + 12 <= nbComponents; i += 12 )
+	{
+		// components i..i+7 and i+4..i+11
+		const __m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i ) );
+		const __m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i + 4 ) );
+		const __m128i c0 = _mm_srli_epi32( _mm_or_si128( _mm_shuffle_epi8( a, first0 ), _mm_shuffle_epi8( b, first1 ) ), 6 );
+		const __m128i c1 = _mm_srli_epi32( _mm_or_si128( _mm_shuffle_epi8( a, second0 ), _mm_shuffle_epi8( b, second1 ) ), 6 );
+		const __m128i c2 = _mm_srli_epi32( _mm_or_si128( _mm_shuffle_epi8( a, third0 ), _mm_shuffle_epi8( b, third1 ) ), 6 );
+		__m128i words = _mm_or_si128( _mm_or_si128( _mm_sll_epi32( c0, count0 ), _mm_sll_epi32( c1, count1 ) ), _mm_sll_epi32( c2, count2 ) );
+		if( byteSwap )
+			words = _mm_shuffle_epi8( words, swapMask );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i / 3 ), words );
+	}
+#endif
+	for( ; i < nbComponents; i += 3 )
+	{
+		boost::uint32_t word = boost::uint32_t( src[i] >> 6 ) << shift0;
+		if( i + 1 < nbComponents )
+			word |= boost::uint32_t( src[i + 1] >> 6 ) << shift1;
+		if( i + 2 < nbComponents )
+			word |= boost::uint32_t( src[i + 2] >> 6 ) << shift2;
+		dst[i / 3] = byteSwap ? swapBytes32( word ) : word;
+	}
+}
+
+/**
+ * @brief Pack 16 bits components in a stream of 12 bits, from the least
+ *        significant bits of 32 bits words (libdpx packed method).
+ *        Each group of 8 components fills exactly 3 words.
+ */
+inline void packComponents12( const boost::uint16_t* src, boost::uint32_t* dst, const std::size_t nbComponents, const bool byteSwap )
+{
+	const std::size_t nbWords = packed12RowWords( nbComponents );
+	std::size_t i = 0;
+	std::size_t w = 0;
+	for( ; i + 8 <= nbComponents; i += 8, w += 3 )
+	{
+		boost::uint32_t c[8];
+		for( int k = 0; k < 8; ++k )
+			c[k] = src[i + k] >> 4;
+		const boost::uint32_t w0 = c[0] | ( c[1] << 12 ) | ( c[2] << 24 );
+		const boost::uint32_t w1 = ( c[2] >> 8 ) | ( c[3] << 4 ) | ( c[4] << 16 ) | ( c[5] << 28 );
+		const boost::uint32_t w2 = ( c[5] >> 4 ) | ( c[6] << 8 ) | ( c[7] << 20 );
+		dst[w]     = byteSwap ? swapBytes32( w0 ) : w0;
+		dst[w + 1] = byteSwap ? swapBytes32( w1 ) : w1;
+		dst[w + 2] = byteSwap ? swapBytes32( w2 ) : w2;
+	}
+	if( i == nbComponents )
+		return;
+	// last incomplete group
+	boost::uint64_t bits = 0;
+	int nbBits = 0;
+	for( ; w < nbWords; ++w )
+	{
+		while( nbBits < 32 && i < nbComponents )
+		{
+			bits |= boost::uint64_t( src[i++] >> 4 ) << nbBits;
+			nbBits += 12;
+		}
+		const boost::uint32_t word = static_cast<boost::uint32_t>( bits );
+		dst[w] = byteSwap ? swapBytes32( word ) : word;
+		bits >>= 32;
+		nbBits -= 32;
+	}
+}
+
+}
+}
+}
+}
+
+#endif
@@ -6,8 +6,12 @@
 #include <terry/globals.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
 
 #include <boost/scoped_ptr.hpp>
+#include <boost/cstdint.hpp>
+
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
@@ -27,11 +31,24 @@ protected:
 
 	void setup( const OFX::RenderArguments& args );
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+	void postProcess();
 	
 private:
+	bool canPackRows() const;
+	void startWriter( ::dpx::Writer& writer, OutStream& stream, const OfxPointI& imageSize );
+	void finishWriter( ::dpx::Writer& writer, OutStream& stream );
+
+	template<class WPixel>
+	void packRows( const OfxRectI& procWindowRoW );
 	template<class WPixel>
 	void writeImage( ::dpx::Writer& writer, View& src, ::dpx::DataSize& dataSize, size_t pixelSize );
 
+private:
+	typedef std::vector<boost::uint32_t, OfxAllocator<boost::uint32_t> > PackedVector;
+	bool         _packRows;    ///< 10 or 12 bits rgb(a) rows are packed in parallel, then written at once
+	std::size_t  _rowWords;    ///< size of a packed row, in 32 bits words
+	PackedVector _packedData;  ///< packed rows of the whole image, in the file layout
+
 public:
 	DPXWriterProcess( DPXWriterPlugin& instance );
 };
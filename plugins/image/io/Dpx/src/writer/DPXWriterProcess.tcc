@@ -19,6 +19,8 @@
 #include <boost/scoped_ptr.hpp>
 #include <boost/filesystem/fstream.hpp>
 
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace dpx {
@@ -26,10 +28,33 @@ namespace writer {
 
 using namespace boost::gil;
 
+namespace detail {
+
+/// @return the components of a row of the view if they can be packed in place, NULL otherwise
+template<class View, class WPixel>
+inline const boost::uint16_t* components16Row( const View&, const WPixel&, const std::ptrdiff_t, const std::ptrdiff_t )
+{
+	return NULL;
+}
+
+inline const boost::uint16_t* components16Row( const rgb16_view_t& view, const rgb16_pixel_t&, const std::ptrdiff_t x, const std::ptrdiff_t y )
+{
+	return reinterpret_cast<const boost::uint16_t*>( &view( x, y ) );
+}
+
+inline const boost::uint16_t* components16Row( const rgba16_view_t& view, const rgba16_pixel_t&, const std::ptrdiff_t x, const std::ptrdiff_t y )
+{
+	return reinterpret_cast<const boost::uint16_t*>( &view( x, y ) );
+}
+
+}
+
 template<class View>
 DPXWriterProcess<View>::DPXWriterProcess( DPXWriterPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationFromTopToBottom )
 	, _plugin( instance )
+	, _packRows( false )
+	, _rowWords( 0 )
 {
 	this->setNoMultiThreading();
 }
@@ -40,6 +65,88 @@ void DPXWriterProcess<View>::setup( const OFX::RenderArguments& args )
 	using namespace boost::gil;
 	ImageGilFilterProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.time );
+
+	_packRows = canPackRows();
+	if( _packRows )
+	{
+		const std::size_t nbComponents = this->_renderWindowSize.x * ( _params._descriptor == ::dpx::kRGB ? 3 : 4 );
+		_rowWords = ( _params._iBitDepth == 10 ) ? filled10RowWords( nbComponents ) : packed12RowWords( nbComponents );
+		_packedData.resize( _rowWords * this->_renderWindowSize.y );
+		this->setNbThreadsAuto();
+	}
+}
+
+/**
+ * @brief The rows are packed by our kernels for the uncompressed rgb(a)
+ *        10 bits filled (method A or B) and 12 bits packed formats,
+ *        the other formats are packed by libdpx.
+ */
+template<class View>
+bool DPXWriterProcess<View>::canPackRows() const
+{
+	if( _params._encoding != ::dpx::kNone )
+		return false;
+	if( _params._descriptor != ::dpx::kRGB && _params._descriptor != ::dpx::kRGBA )
+		return false;
+#ifndef TUTTLE_PRODUCTION
+	// libdpx swaps the width and the height of the rotated orientations
+	if( _params._orientation != ::dpx::kLeftToRightTopToBottom )
+		return false;
+#endif
+	switch( _params._bitDepth )
+	{
+		case eTuttlePluginBitDepth10:
+			return _params._packed == ::dpx::kFilledMethodA || _params._packed == ::dpx::kFilledMethodB;
+		case eTuttlePluginBitDepth12:
+			return _params._packed == ::dpx::kPacked;
+		default:
+			return false;
+	}
+}
+
+template<class View>
+void DPXWriterProcess<View>::startWriter( ::dpx::Writer& writer, OutStream& stream, const OfxPointI& imageSize )
+{
+	if( ! stream.Open( _params._filepath.c_str() ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to open output file" ) );
+	}
+
+	writer.SetOutStream( &stream );
+	writer.Start();
+	writer.SetFileInfo( _params._filepath.c_str(), 0, "TuttleOFX DPX Writer", _params._project.c_str(), _params._copyright.c_str(), ~0, _params._swapEndian );
+	writer.SetImageInfo( imageSize.x, imageSize.y );
+
+#ifndef TUTTLE_PRODUCTION
+	writer.header.SetImageOrientation( _params._orientation );
+#endif
+
+	writer.SetElement( 0,
+			_params._descriptor,
+			_params._iBitDepth,
+			_params._transfer,
+			_params._colorimetric,
+			_params._packed,
+			_params._encoding );
+
+	if( ! writer.WriteHeader() )
+	{
+		BOOST_THROW_EXCEPTION( exception::Data()
+			<< exception::user( "Dpx: Unable to write data (DPX Header)" ) );
+	}
+}
+
+template<class View>
+void DPXWriterProcess<View>::finishWriter( ::dpx::Writer& writer, OutStream& stream )
+{
+	if( ! writer.Finish() )
+	{
+		BOOST_THROW_EXCEPTION( exception::Data()
+			<< exception::user( "Dpx: Unable to write data (DPX finish)" ) );
+	}
+	
+	stream.Close();
 }
 
 /**
@@ -50,6 +157,15 @@ template<class View>
 void DPXWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
 	using namespace boost::gil;
+	if( _packRows )
+	{
+		if( _params._descriptor == ::dpx::kRGB )
+			packRows<rgb16_pixel_t>( procWindowRoW );
+		else
+			packRows<rgba16_pixel_t>( procWindowRoW );
+		return;
+	}
+
 	OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
 	OfxPointI procWindowSize  = {
 		procWindowRoW.x2 - procWindowRoW.x1,
@@ -62,23 +178,9 @@ void DPXWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 
 	::dpx::Writer   writer;
 	::dpx::DataSize dataSize = ::dpx::kByte;
-
 	OutStream       stream;
 
-	if( ! stream.Open( _params._filepath.c_str() ) )
-	{
-		BOOST_THROW_EXCEPTION( exception::File()
-			<< exception::user( "Dpx: Unable to open output file" ) );
-	}
-
-	writer.SetOutStream( &stream );
-	writer.Start();
-	writer.SetFileInfo( _params._filepath.c_str(), 0, "TuttleOFX DPX Writer", _params._project.c_str(), _params._copyright.c_str(), ~0, _params._swapEndian );
-	writer.SetImageInfo( procWindowSize.x, procWindowSize.y );
-
-#ifndef TUTTLE_PRODUCTION
-	writer.header.SetImageOrientation( _params._orientation );
-#endif
+	startWriter( writer, stream, procWindowSize );
 
 	switch ( _params._bitDepth )
 	{
@@ -97,21 +199,6 @@ void DPXWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 	}
 
 
-	writer.SetElement( 0,
-			_params._descriptor,
-			_params._iBitDepth,
-			_params._transfer,
-			_params._colorimetric,
-			_params._packed,
-			_params._encoding );
-
-	
-	if( ! writer.WriteHeader() )
-	{
-		BOOST_THROW_EXCEPTION( exception::Data()
-			<< exception::user( "Dpx: Unable to write data (DPX Header)" ) );
-	}
-
 	//TUTTLE_LOG_VAR( TUTTLE_INFO, _params._descriptor);
 	switch( _params._descriptor )
 	{
@@ -230,13 +317,79 @@ void DPXWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 			break;
 	}
 	
-	if( ! writer.Finish() )
+	finishWriter( writer, stream );
+}
+
+/**
+ * @brief Pack the rows of the processing window in the file layout.
+ * @param[in] procWindowRoW  Processing window in RoW
+ */
+template<class View>
+template<class WPixel>
+void DPXWriterProcess<View>::packRows( const OfxRectI& procWindowRoW )
+{
+	using namespace boost::gil;
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const OfxRectI renderWindowOutput = this->translateRoWToOutputClipCoordinates( this->_renderArgs.renderWindow );
+	const std::ptrdiff_t x = procWindowOutput.x1;
+	const std::ptrdiff_t width = procWindowOutput.x2 - procWindowOutput.x1;
+	// the view and the file rows are from top to bottom
+	const std::ptrdiff_t rowBegin = this->_srcView.height() - procWindowOutput.y2;
+	const std::ptrdiff_t rowEnd = this->_srcView.height() - procWindowOutput.y1;
+	const std::ptrdiff_t firstRow = this->_srcView.height() - renderWindowOutput.y2;
+	if( width <= 0 || rowBegin >= rowEnd )
+		return;
+
+	const std::size_t nbComponents = width * num_channels<WPixel>::value;
+	// libdpx stores the rgb 10 bits components in the reverse order (datum swap)
+	const bool reverse = ( _params._descriptor == ::dpx::kRGB );
+	const int methodShift = ( _params._packed == ::dpx::kFilledMethodA ) ? 2 : 0;
+	// same as the writer header RequiresByteSwap()
+	const bool byteSwap = _params._swapEndian;
+
+	std::vector<WPixel> buffer;
+	for( std::ptrdiff_t y = rowBegin; y < rowEnd; ++y )
 	{
-		BOOST_THROW_EXCEPTION( exception::Data()
-			<< exception::user( "Dpx: Unable to write data (DPX finish)" ) );
+		const boost::uint16_t* src = detail::components16Row( this->_srcView, WPixel(), x, y );
+		if( ! src )
+		{
+			buffer.resize( width );
+			const typename type_from_x_iterator<WPixel*>::view_t dst = interleaved_view( width, 1, &buffer[0], width * sizeof( WPixel ) );
+			copy_and_convert_pixels( subimage_view( this->_srcView, x, y, width, 1 ), dst );
+			src = reinterpret_cast<const boost::uint16_t*>( &buffer[0] );
+		}
+		boost::uint32_t* dst = &_packedData[( y - firstRow ) * _rowWords];
+		if( _params._iBitDepth == 10 )
+			packComponents10Filled( src, dst, nbComponents, reverse, methodShift, byteSwap );
+		else
+			packComponents12( src, dst, nbComponents, byteSwap );
 	}
-	
-	stream.Close();
+}
+
+/**
+ * @brief Write the packed rows with a single write.
+ */
+template<class View>
+void DPXWriterProcess<View>::postProcess()
+{
+	if( _packRows )
+	{
+		::dpx::Writer writer;
+		OutStream     stream;
+
+		startWriter( writer, stream, this->_renderWindowSize );
+
+		if( ! writer.WriteElement( 0, &_packedData.front(), static_cast<long>( _packedData.size() * sizeof( boost::uint32_t ) ) ) )
+		{
+			BOOST_THROW_EXCEPTION( exception::Data()
+				<< exception::user( "Dpx: Unable to write data (DPX User Data)" ) );
+		}
+		// only set by the libdpx packing functions
+		writer.header.SetImageOffset( writer.header.DataOffset( 0 ) );
+
+		finishWriter( writer, stream );
+	}
+	ImageGilFilterProcessor<View>::postProcess();
 }
 
 template<class View>
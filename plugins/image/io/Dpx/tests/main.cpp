@@ -5,18 +5,66 @@
 
 #include <tuttle/host/Graph.hpp>
 
+#include "../src/reader/DPXReaderAlgorithm.hpp"
+#include "../src/writer/DPXWriterPack.hpp"
+
 #include <boost/preprocessor/stringize.hpp>
 
 #include <boost/timer.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <vector>
+
 using namespace boost::unit_test;
 using namespace tuttle::host;
 
 BOOST_AUTO_TEST_SUITE( plugin_Dpx_reader )
 std::string pluginName = "tuttle.dpxreader";
 std::string filename = "dpx/flowers-1920x1080-RGB-10.dpx";
-//#include <tuttle/test/io/reader.hpp>
+#include <tuttle/test/io/reader.hpp>
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( plugin_Dpx_reader_algorithm )
+
+BOOST_AUTO_TEST_CASE( unpack_rgb10_filled_a )
+{
+	using namespace tuttle::plugin::dpx::reader;
+	// an odd number of pixels to also use the scalar tail of the vectorized loop
+	const std::size_t nbPixels = 37;
+	std::vector<boost::uint32_t> words( nbPixels );
+	boost::uint32_t seed = 12345;
+	for( std::size_t i = 0; i < nbPixels; ++i )
+	{
+		seed = seed * 1103515245 + 12345;
+		words[i] = seed & 0xfffffffc;
+	}
+	words[0] = 0xfffffffc; // white
+	words[1] = 0;          // black
+	std::vector<boost::uint32_t> swappedWords( nbPixels );
+	for( std::size_t i = 0; i < nbPixels; ++i )
+		swappedWords[i] = swapBytes32( words[i] );
+
+	std::vector<boost::uint16_t> expected( nbPixels * 3 );
+	for( std::size_t i = 0; i < nbPixels; ++i )
+	{
+		for( std::size_t c = 0; c < 3; ++c )
+		{
+			const boost::uint32_t v = ( words[i] >> ( 22 - 10 * c ) ) & 0x3ff;
+			expected[3 * i + c] = static_cast<boost::uint16_t>( ( v << 6 ) | ( v >> 4 ) );
+		}
+	}
+	BOOST_CHECK_EQUAL( expected[0], 65535 );
+	BOOST_CHECK_EQUAL( expected[3], 0 );
+
+	std::vector<boost::uint16_t> result( nbPixels * 3 );
+	unpackRGB10FilledA( &words[0], &result[0], nbPixels, false );
+	BOOST_CHECK_EQUAL_COLLECTIONS( result.begin(), result.end(), expected.begin(), expected.end() );
+
+	std::vector<boost::uint16_t> swappedResult( nbPixels * 3 );
+	unpackRGB10FilledA( &swappedWords[0], &swappedResult[0], nbPixels, true );
+	BOOST_CHECK_EQUAL_COLLECTIONS( swappedResult.begin(), swappedResult.end(), expected.begin(), expected.end() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -25,3 +73,105 @@ std::string pluginName = "tuttle.dpxwriter";
 std::string filename = "test-png.png";
 #include <tuttle/test/io/writer.hpp>
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( plugin_Dpx_writer_algorithm )
+
+namespace {
+
+std::vector<boost::uint16_t> randomComponents( const std::size_t nbComponents )
+{
+	std::vector<boost::uint16_t> components( nbComponents );
+	boost::uint32_t seed = 54321;
+	for( std::size_t i = 0; i < nbComponents; ++i )
+	{
+		seed = seed * 1103515245 + 12345;
+		components[i] = static_cast<boost::uint16_t>( seed >> 16 );
+	}
+	components[0] = 0xffff;
+	components[1] = 0;
+	return components;
+}
+
+boost::uint32_t referenceSwap( const boost::uint32_t v )
+{
+	const unsigned char* b = reinterpret_cast<const unsigned char*>( &v );
+	boost::uint32_t r;
+	unsigned char* rb = reinterpret_cast<unsigned char*>( &r );
+	rb[0] = b[3]; rb[1] = b[2]; rb[2] = b[1]; rb[3] = b[0];
+	return r;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( pack_components_10_filled )
+{
+	using namespace tuttle::plugin::dpx::writer;
+	// not a multiple of the 12 components of the vectorized loop, with an incomplete last word
+	const std::size_t nbComponents = 12 * 5 + 7;
+	const std::vector<boost::uint16_t> src = randomComponents( nbComponents );
+	const std::size_t nbWords = filled10RowWords( nbComponents );
+	BOOST_CHECK_EQUAL( nbWords, 23u );
+
+	for( int reverse = 0; reverse < 2; ++reverse )
+	{
+		for( int methodShift = 0; methodShift <= 2; methodShift += 2 )
+		{
+			for( int byteSwap = 0; byteSwap < 2; ++byteSwap )
+			{
+				std::vector<boost::uint32_t> expected( nbWords, 0 );
+				for( std::size_t i = 0; i < nbComponents; ++i )
+				{
+					const std::size_t posInWord = i % 3;
+					const int shift = ( reverse ? 20 - 10 * posInWord : 10 * posInWord ) + methodShift;
+					expected[i / 3] |= boost::uint32_t( src[i] >> 6 ) << shift;
+				}
+				if( byteSwap )
+				{
+					for( std::size_t w = 0; w < nbWords; ++w )
+						expected[w] = referenceSwap( expected[w] );
+				}
+
+				std::vector<boost::uint32_t> result( nbWords, 0xdeadbeef );
+				packComponents10Filled( &src[0], &result[0], nbComponents, reverse != 0, methodShift, byteSwap != 0 );
+				BOOST_CHECK_EQUAL_COLLECTIONS( result.begin(), result.end(), expected.begin(), expected.end() );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( pack_components_12 )
+{
+	using namespace tuttle::plugin::dpx::writer;
+	// not a multiple of the 8 components of a group
+	const std::size_t nbComponents = 8 * 4 + 5;
+	const std::vector<boost::uint16_t> src = randomComponents( nbComponents );
+	const std::size_t nbWords = packed12RowWords( nbComponents );
+	BOOST_CHECK_EQUAL( nbWords, 14u );
+
+	for( int byteSwap = 0; byteSwap < 2; ++byteSwap )
+	{
+		// bit stream of 12 bits values, from the least significant bit of the first word
+		std::vector<boost::uint32_t> expected( nbWords, 0 );
+		for( std::size_t i = 0; i < nbComponents; ++i )
+		{
+			const boost::uint32_t value = src[i] >> 4;
+			for( std::size_t bit = 0; bit < 12; ++bit )
+			{
+				const std::size_t streamBit = i * 12 + bit;
+				if( value & ( 1u << bit ) )
+					expected[streamBit / 32] |= 1u << ( streamBit % 32 );
+			}
+		}
+		if( byteSwap )
+		{
+			for( std::size_t w = 0; w < nbWords; ++w )
+				expected[w] = referenceSwap( expected[w] );
+		}
+
+		std::vector<boost::uint32_t> result( nbWords, 0xdeadbeef );
+		packComponents12( &src[0], &result[0], nbComponents, byteSwap != 0 );
+		BOOST_CHECK_EQUAL_COLLECTIONS( result.begin(), result.end(), expected.begin(), expected.end() );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
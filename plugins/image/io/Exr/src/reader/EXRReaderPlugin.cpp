@@ -23,7 +23,6 @@ using namespace boost::gil;
 EXRReaderPlugin::EXRReaderPlugin( OfxImageEffectHandle handle )
 	: ReaderPlugin( handle )
 	, _channels ( 0 )
-	, _par      ( 1.0 )
 {
 	_outComponents   = fetchChoiceParam( kTuttlePluginChannel );
 	_redComponents   = fetchChoiceParam( kParamOutputRedIs );
@@ -117,8 +116,6 @@ void EXRReaderPlugin::updateCombos()
 		const Header& h  = in.header();
 		const ChannelList& cl = h.channels();
 		
-		_par = h.pixelAspectRatio();
-		
 		// Hide output channel selection till we don't select a channel.
 		for( std::size_t i = 0; i < _vChannelChoice.size(); ++i )
 		{
@@ -126,6 +123,7 @@ void EXRReaderPlugin::updateCombos()
 			_vChannelChoice[i]->resetOptions();
 		}
 		_vChannelNames.clear();
+		_channels = 0;
 		for( ChannelList::ConstIterator it = cl.begin(); it != cl.end(); ++it )
 		{
 			_vChannelNames.push_back( it.name() );
@@ -161,69 +159,76 @@ void EXRReaderPlugin::updateCombos()
 	}
 }
 
-void EXRReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences )
-{
-	ReaderPlugin::getClipPreferences( clipPreferences );
-	
-	if( getExplicitChannelConversion() == eParamReaderChannelAuto )
-	{
-		switch( _channels )
-		{
-			case 1:
-			{
-				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentAlpha );
-				break;
-			}
-			case 3:
-			{
-				if( OFX::getImageEffectHostDescription()->supportsPixelComponent( OFX::ePixelComponentRGB ) )
-					clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGB );
-				else
-					clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
-				break;
-			}
-			case 4:
-			{
-				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
-				break;
-			}
-			default:
-			{
-				std::string msg = "EXR: not support ";
-				msg += _channels;
-				msg += " channels.";
-				BOOST_THROW_EXCEPTION( exception::FileNotExist()
-									   << exception::user( msg ) );
-				break;
-			}
-		}
-	}
-
-	clipPreferences.setPixelAspectRatio( *this->_clipDst, _par );
-}
-
-bool EXRReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
+void EXRReaderPlugin::readHeader( const std::string& filename, ReaderHeader& header )
 {
 	try
 	{
-		InputFile in( getAbsoluteFilenameAt( args.time ).c_str() );
-		const Header&      h      = in.header();
-		const Imath::Box2i window( ( _outputData->getValue() == 0 ) ? h.displayWindow() : h.dataWindow() );
-
-		std::cout << "getRegionOfDefinition " << ( window.size().x + 1 ) * _par << " x " << window.size().y + 1 << std::endl;
-		
-		rod.x1 = 0;
-		rod.x2 = window.size().x + 1;
-		rod.y1 = 0;
-		rod.y2 = window.size().y + 1;
+		InputFile in( filename.c_str() );
+		const Header& h = in.header();
+		const Imath::Box2i& displayWindow = h.displayWindow();
+		const Imath::Box2i& dataWindow = h.dataWindow();
+
+		header._rod.x1 = displayWindow.min.x;
+		header._rod.x2 = displayWindow.max.x + 1;
+		header._rod.y1 = displayWindow.min.y;
+		header._rod.y2 = displayWindow.max.y + 1;
+		header._dataRod.x1 = dataWindow.min.x;
+		header._dataRod.x2 = dataWindow.max.x + 1;
+		header._dataRod.y1 = dataWindow.min.y;
+		header._dataRod.y2 = dataWindow.max.y + 1;
+		header._pixelAspectRatio = h.pixelAspectRatio();
+		header._bitDepth = OFX::eBitDepthFloat;
 
+		const ChannelList& cl = h.channels();
+		header._nbChannels = 0;
+		for( ChannelList::ConstIterator it = cl.begin(); it != cl.end(); ++it )
+			++header._nbChannels;
 	}
 	catch( ... )
 	{
 		BOOST_THROW_EXCEPTION( exception::FileInSequenceNotExist()
 		<< exception::user( "EXR: Unable to open file." )
-		<< exception::filename( getAbsoluteFilenameAt( args.time ) ) );
+		<< exception::filename( filename ) );
+	}
+
+	switch( header._nbChannels )
+	{
+		case 1:
+			header._components = OFX::ePixelComponentAlpha;
+			break;
+		case 3:
+			header._components = OFX::ePixelComponentRGB;
+			break;
+		default:
+			header._components = OFX::ePixelComponentRGBA;
+			break;
 	}
+}
+
+void EXRReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences )
+{
+	ReaderPlugin::getClipPreferences( clipPreferences );
+
+	const ReaderHeader header = getFirstHeader();
+	if( getExplicitChannelConversion() == eParamReaderChannelAuto &&
+	    header._nbChannels != 1 && header._nbChannels != 3 && header._nbChannels != 4 )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileNotExist()
+							   << exception::user() + "EXR: not support " + header._nbChannels + " channels." );
+	}
+	// the bit depth stays float, the default of ReaderPlugin
+	setClipPreferencesFromHeader( clipPreferences, header );
+}
+
+bool EXRReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
+{
+	const ReaderHeader header = getHeaderAt( args.time );
+	const OfxRectD& window = ( _outputData->getValue() == 0 ) ? header._rod : header._dataRod;
+
+	rod.x1 = 0;
+	rod.x2 = window.x2 - window.x1;
+	rod.y1 = 0;
+	rod.y2 = window.y2 - window.y1;
 	return true;
 }
 
@@ -40,6 +40,9 @@ public:
 	const std::vector<std::string>&       channelNames() const  { return _vChannelNames; }
 	const std::vector<OFX::ChoiceParam*>& channelChoice() const { return _vChannelChoice; }
 
+protected:
+	void readHeader( const std::string& filename, ReaderHeader& header );
+
 private:
 	void updateCombos();
 
@@ -53,7 +56,6 @@ protected:
 	OFX::ChoiceParam*              _alphaComponents; ///< index of Alpha components
 	OFX::ChoiceParam*              _outputData;      ///< Output data
 	int                            _channels;        ///< number of channels in file
-	float                          _par;             ///< pixel aspect ratio
 };
 
 }
@@ -143,8 +143,9 @@ void EXRReaderProcess<View>::readImage( DView dst, const std::string& filepath )
 	using namespace boost::gil;
 	using namespace Imf;
 
-	EXRReaderProcessParams params = _plugin.getProcessParams( this->_renderArgs.time );
-	Imf::InputFile in( filepath.c_str() );
+	// file opened in setup
+	const EXRReaderProcessParams& params = _params;
+	Imf::InputFile& in = *_exrImage;
 	Imf::FrameBuffer frameBuffer;
 	const Imf::Header& header = in.header();
 	const Imath::Box2i& dw    = header.dataWindow();
@@ -38,7 +38,7 @@ void EXRWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<EXRWriterProcess>( *this, args );
+	doGilRender<WriteBehind<EXRWriterProcess>::Launcher>( *this, args );
 }
 
 }
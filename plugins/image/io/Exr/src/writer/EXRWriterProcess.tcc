@@ -58,7 +58,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_srcPixelComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeGrayImage<gray16h_pixel_t>( src, _params._filepath, Imf::HALF );
@@ -103,7 +103,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_srcPixelComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeGrayImage<gray32f_pixel_t>( src, _params._filepath, Imf::FLOAT );
@@ -148,7 +148,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_srcPixelComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeGrayImage<gray32_pixel_t>( src, _params._filepath, Imf::HALF );
@@ -202,7 +202,8 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 			<< exception::filename( _params._filepath ) );
 	}
 	// @todo: This is sometimes not neccessary... Checkbox it.
-	copy_and_convert_pixels( this->_srcView, this->_dstView );
+	if( this->_dst )
+		copy_and_convert_pixels( this->_srcView, this->_dstView );
 }
 
 template<class View>
@@ -42,7 +42,7 @@ void ImageMagickWriterPlugin::render( const OFX::RenderArguments& args )
 	{
 		case OFX::ePixelComponentRGBA:
 		{
-			doGilRender<ImageMagickWriterProcess, false, boost::gil::rgba_layout_t>( *this, args, bitDepth );
+			doGilRender<WriteBehind<ImageMagickWriterProcess>::Launcher, false, boost::gil::rgba_layout_t>( *this, args, bitDepth );
 			return;
 		}
 		case OFX::ePixelComponentRGB:
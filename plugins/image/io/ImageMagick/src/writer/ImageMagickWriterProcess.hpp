@@ -21,10 +21,13 @@ public:
 
 protected:
 	ImageMagickWriterPlugin&    _plugin;        ///< Rendering plugin
+	ImageMagickWriterProcessParams _params;
 
 public:
 	ImageMagickWriterProcess( ImageMagickWriterPlugin& instance );
 
+	void setup( const OFX::RenderArguments& args );
+
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
 	template<class Bits>
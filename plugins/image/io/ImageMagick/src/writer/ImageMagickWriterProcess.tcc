@@ -21,6 +21,13 @@ ImageMagickWriterProcess<View>::ImageMagickWriterProcess( ImageMagickWriterPlugi
 	this->setNoMultiThreading();
 }
 
+template<class View>
+void ImageMagickWriterProcess<View>::setup( const OFX::RenderArguments& args )
+{
+	ImageGilFilterProcessor<View>::setup( args );
+	_params = _plugin.getProcessParams( args.time );
+}
+
 /**
  * @brief Function called by rendering thread each time a process must be done.
  * @param[in] procWindowRoW  Processing window in RoW
@@ -31,14 +38,13 @@ void ImageMagickWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 {
 	BOOST_ASSERT( procWindowRoW == this->_srcPixelRod );
 	using namespace boost::gil;
-	ImageMagickWriterProcessParams params = _plugin.getProcessParams( this->_renderArgs.time );
 	try
 	{
-		writeImage<bits8>( this->_srcView, params._filepath );
+		writeImage<bits8>( this->_srcView, _params._filepath );
 	}
 	catch( exception::Common& e )
 	{
-		e << exception::filename( params._filepath );
+		e << exception::filename( _params._filepath );
 		throw;
 	}
 	catch(... )
@@ -46,9 +52,10 @@ void ImageMagickWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 		BOOST_THROW_EXCEPTION( exception::Unknown()
 			<< exception::user( "Unable to write image")
 			<< exception::dev( boost::current_exception_diagnostic_information() )
-			<< exception::filename(params._filepath) );
+			<< exception::filename(_params._filepath) );
 	}
-	copy_pixels( this->_srcView, this->_dstView ); /// @todo ?
+	if( this->_dst )
+		copy_pixels( this->_srcView, this->_dstView ); /// @todo ?
 }
 
 /**
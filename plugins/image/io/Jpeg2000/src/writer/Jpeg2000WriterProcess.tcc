@@ -52,7 +52,7 @@ void Jpeg2000WriterProcess<View>::multiThreadProcessImages( const OfxRectI& proc
 	{
 		case eTuttlePluginBitDepthAuto:
 		{
-			switch( _plugin._clipSrc->getPixelDepth() )
+			switch( this->_srcPixelDepth )
 			{
 				case OFX::eBitDepthUByte:
 				{
@@ -95,7 +95,8 @@ void Jpeg2000WriterProcess<View>::multiThreadProcessImages( const OfxRectI& proc
 		}
 	}
 	// Convert pixels to destination
-	copy_and_convert_pixels( this->_srcView, this->_dstView );
+	if( this->_dst )
+		copy_and_convert_pixels( this->_srcView, this->_dstView );
 }
 
 template< typename View >
@@ -34,17 +34,8 @@ void OpenImageIOReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args
 	ReaderPlugin::changedParam( args, paramName );
 }
 
-bool OpenImageIOReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
+void OpenImageIOReaderPlugin::readHeader( const std::string& filename, ReaderHeader& header )
 {
-	const std::string filename( getAbsoluteFilenameAt( args.time ) );
-
-	if( !bfs::exists( filename ) )
-	{
-		BOOST_THROW_EXCEPTION( exception::FileInSequenceNotExist()
-			<< exception::user( "OpenImageIO: Unable to open file" )
-			<< exception::filename( filename ) );
-	}
-
 	boost::scoped_ptr<OpenImageIO::ImageInput> in( OpenImageIO::ImageInput::create( filename ) );
 	if( !in )
 	{
@@ -60,13 +51,78 @@ bool OpenImageIOReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefiniti
 			<< exception::user( "OIIO Reader: " + in->geterror () )
 			<< exception::filename( filename ) );
 	}
-	
+	in->close();
+
+	header._rod.x1 = 0;
+	header._rod.x2 = spec.width;
+	header._rod.y1 = 0;
+	header._rod.y2 = spec.height;
+	header._dataRod = header._rod;
+	header._nbChannels = spec.nchannels;
+	header._pixelAspectRatio = 1.0;
+
+	switch( spec.format.basetype )
+	{
+		//			case TypeDesc::UCHAR:
+		case OpenImageIO::TypeDesc::UINT8:
+		//			case TypeDesc::CHAR:
+		case OpenImageIO::TypeDesc::INT8:
+			header._bitDepth = OFX::eBitDepthUByte;
+			break;
+		case OpenImageIO::TypeDesc::HALF:
+		//			case TypeDesc::USHORT:
+		case OpenImageIO::TypeDesc::UINT16:
+		//			case TypeDesc::SHORT:
+		case OpenImageIO::TypeDesc::INT16:
+			header._bitDepth = OFX::eBitDepthUShort;
+			break;
+		//			case TypeDesc::UINT:
+		case OpenImageIO::TypeDesc::UINT32:
+		//			case TypeDesc::INT:
+		case OpenImageIO::TypeDesc::INT32:
+		//			case TypeDesc::ULONGLONG:
+		case OpenImageIO::TypeDesc::UINT64:
+		//			case TypeDesc::LONGLONG:
+		case OpenImageIO::TypeDesc::INT64:
+		case OpenImageIO::TypeDesc::FLOAT:
+		case OpenImageIO::TypeDesc::DOUBLE:
+			header._bitDepth = OFX::eBitDepthFloat;
+			break;
+		case OpenImageIO::TypeDesc::STRING:
+		case OpenImageIO::TypeDesc::PTR:
+		case OpenImageIO::TypeDesc::LASTBASE:
+		case OpenImageIO::TypeDesc::UNKNOWN:
+		case OpenImageIO::TypeDesc::NONE:
+		default:
+		{
+			BOOST_THROW_EXCEPTION( exception::ImageFormat()
+								   << exception::user("bad input format")
+								   << exception::filename( filename ) );
+		}
+	}
+
+	switch( spec.nchannels )
+	{
+		case 1 :
+			header._components = OFX::ePixelComponentAlpha;
+			break;
+		case 3 :
+			header._components = OFX::ePixelComponentRGB;
+			break;
+		default:
+			header._components = OFX::ePixelComponentRGBA;
+			break;
+	}
+}
+
+bool OpenImageIOReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
+{
+	const ReaderHeader header = getHeaderAt( args.time );
+
 	rod.x1 = 0;
-	rod.x2 = spec.width * this->_clipDst->getPixelAspectRatio();
+	rod.x2 = header._rod.x2 * this->_clipDst->getPixelAspectRatio();
 	rod.y1 = 0;
-	rod.y2 = spec.height;
-
-	in->close();
+	rod.y2 = header._rod.y2;
 	return true;
 }
 
@@ -76,13 +132,6 @@ void OpenImageIOReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& cl
 
 	const std::string filename( getAbsoluteFirstFilename() );
 
-	if( !bfs::exists( filename ) )
-	{
-		BOOST_THROW_EXCEPTION( exception::FileInSequenceNotExist()
-			<< exception::user( "OpenImageIO: Unable to open file" )
-			<< exception::filename( filename ) );
-	}
-
 	// if no filename
 	if( filename.size() == 0 )
 	{
@@ -92,96 +141,7 @@ void OpenImageIOReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& cl
 		return;
 	}
 
-	OpenImageIO::ImageInput *in = OpenImageIO::ImageInput::create( filename );
-
-	if( !in )
-	{
-		BOOST_THROW_EXCEPTION( exception::Unknown()
-			<< exception::user( "OIIO Reader: " + in->geterror () )
-			<< exception::filename( filename ) );
-	}
-
-	OpenImageIO::ImageSpec spec;
-	if( ! in->open( filename, spec ) )
-	{
-		BOOST_THROW_EXCEPTION( exception::Unknown()
-			<< exception::user( "OIIO Reader: " + in->geterror () )
-			<< exception::filename( filename ) );
-	}
-
-	if( getExplicitBitDepthConversion() == eParamReaderBitDepthAuto )
-	{
-		OFX::EBitDepth bd = OFX::eBitDepthNone;
-		switch( spec.format.basetype )
-		{
-			//			case TypeDesc::UCHAR:
-			case OpenImageIO::TypeDesc::UINT8:
-			//			case TypeDesc::CHAR:
-			case OpenImageIO::TypeDesc::INT8:
-				bd = OFX::eBitDepthUByte;
-				break;
-			case OpenImageIO::TypeDesc::HALF:
-			//			case TypeDesc::USHORT:
-			case OpenImageIO::TypeDesc::UINT16:
-			//			case TypeDesc::SHORT:
-			case OpenImageIO::TypeDesc::INT16:
-				bd = OFX::eBitDepthUShort;
-				break;
-			//			case TypeDesc::UINT:
-			case OpenImageIO::TypeDesc::UINT32:
-			//			case TypeDesc::INT:
-			case OpenImageIO::TypeDesc::INT32:
-			//			case TypeDesc::ULONGLONG:
-			case OpenImageIO::TypeDesc::UINT64:
-			//			case TypeDesc::LONGLONG:
-			case OpenImageIO::TypeDesc::INT64:
-			case OpenImageIO::TypeDesc::FLOAT:
-			case OpenImageIO::TypeDesc::DOUBLE:
-				bd = OFX::eBitDepthFloat;
-				break;
-			case OpenImageIO::TypeDesc::STRING:
-			case OpenImageIO::TypeDesc::PTR:
-			case OpenImageIO::TypeDesc::LASTBASE:
-			case OpenImageIO::TypeDesc::UNKNOWN:
-			case OpenImageIO::TypeDesc::NONE:
-			default:
-			{
-				in->close();
-				BOOST_THROW_EXCEPTION( exception::ImageFormat()
-									   << exception::user("bad input format") );
-			}
-		}
-		clipPreferences.setClipBitDepth( *this->_clipDst, bd );
-	}
-
-	if( getExplicitChannelConversion() == eParamReaderChannelAuto )
-	{
-		switch( spec.nchannels )
-		{
-			case 1 :
-				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentAlpha );
-				break;
-			case 3 :
-				if( OFX::getImageEffectHostDescription()->supportsPixelComponent( OFX::ePixelComponentRGB ) )
-				{
-					clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGB );
-				}
-				else
-				{
-					clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
-				}
-				break;
-			case 4 :
-				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
-				break;
-			default:
-				clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
-				break;
-		}
-	}
-
-	clipPreferences.setPixelAspectRatio( *this->_clipDst, 1.0 );
-	in->close();
+	setClipPreferencesFromHeader( clipPreferences, getFirstHeader() );
 }
 
 /**
@@ -36,6 +36,7 @@ protected:
 public:
 	OpenImageIOWriterProcess( OpenImageIOWriterPlugin& instance );
 
+	void setup( const OFX::RenderArguments& args );
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
 	template<class WImage>
@@ -31,6 +31,13 @@ OpenImageIOWriterProcess<View>::OpenImageIOWriterProcess( OpenImageIOWriterPlugi
 	this->setNoMultiThreading();
 }
 
+template<class View>
+void OpenImageIOWriterProcess<View>::setup( const OFX::RenderArguments& args )
+{
+	ImageGilFilterProcessor<View>::setup( args );
+	params = _plugin.getProcessParams( args.time );
+}
+
 /**
  * Deduce the best bitdepth when it hasn't been set by the user
  */
@@ -68,8 +75,6 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 	BOOST_ASSERT( procWindowRoW == this->_srcPixelRod );
 	using namespace boost::gil;
 	using namespace terry;
-	params = _plugin.getProcessParams( this->_renderArgs.time );
-
 	ETuttlePluginBitDepth finalBitDepth = getDefaultBitDepth(params._filepath,params._bitDepth);
 
 	try
@@ -82,7 +87,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				std::string ext = p.extension().string();
 				if( ext == ".cin" )
 				{
-					switch ( _plugin._clipSrc->getPixelComponents() )
+					switch ( this->_srcPixelComponents )
 					{
 						case OFX::ePixelComponentAlpha:
 							writeImage<gray16_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth10 );
@@ -122,7 +127,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				}
 				if( ext == ".tif" || ext == ".tiff" )
 				{
-					switch ( _plugin._clipSrc->getPixelComponents() )
+					switch ( this->_srcPixelComponents )
 					{
 						case OFX::ePixelComponentAlpha:
 							writeImage<gray16_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth16 );
@@ -141,7 +146,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 					break;
 				}
 				
-				switch( _plugin._clipSrc->getPixelDepth() )
+				switch( this->_srcPixelDepth )
 				{
 					case OFX::eBitDepthUByte:
 					{
@@ -149,7 +154,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 						{
 							case eTuttlePluginComponentsAuto:
 							{
-								switch ( _plugin._clipSrc->getPixelComponents() )
+								switch ( this->_srcPixelComponents )
 								{
 									case OFX::ePixelComponentAlpha:
 										writeImage<gray8_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth8 );
@@ -185,7 +190,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 						{
 							case eTuttlePluginComponentsAuto:
 							{
-								switch ( _plugin._clipSrc->getPixelComponents() )
+								switch ( this->_srcPixelComponents )
 								{
 									case OFX::ePixelComponentAlpha:
 										writeImage<gray16_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth16 );
@@ -222,7 +227,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 						{
 							case eTuttlePluginComponentsAuto:
 							{
-								switch ( _plugin._clipSrc->getPixelComponents() )
+								switch ( this->_srcPixelComponents )
 								{
 									case OFX::ePixelComponentAlpha:
 										writeImage<gray32f_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth32f );
@@ -266,7 +271,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_srcPixelComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray8_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -304,7 +309,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_srcPixelComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray16_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -340,7 +345,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_srcPixelComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray16h_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -376,7 +381,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_srcPixelComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray32_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -412,7 +417,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( this->_srcPixelComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray32f_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -456,7 +461,8 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 			<< exception::dev( boost::current_exception_diagnostic_information() )
 			<< exception::filename(params._filepath) );
 	}
-	copy_pixels( this->_srcView, this->_dstView ); // @todo ?
+	if( this->_dst )
+		copy_pixels( this->_srcView, this->_dstView ); // @todo ?
 }
 
 /**
@@ -37,7 +37,7 @@ void PngWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<PngWriterProcess>( *this, args );
+	doGilRender<WriteBehind<PngWriterProcess>::Launcher>( *this, args );
 }
 
 }
@@ -68,7 +68,8 @@ void PngWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 			<< exception::dev( boost::current_exception_diagnostic_information() )
 			<< exception::filename( _params._filepath ) );
 	}
-	copy_pixels( this->_srcView, this->_dstView ); /// @todo ?
+	if( this->_dst )
+		copy_pixels( this->_srcView, this->_dstView ); /// @todo ?
 }
 
 /**
@@ -85,7 +86,7 @@ void PngWriterProcess<View>::writeImage( View& src )
 	{
 		case eTuttlePluginComponentsAuto:
 		{
-			switch ( _plugin._clipSrc->getPixelComponents() )
+			switch ( this->_srcPixelComponents )
 			{
 				case OFX::ePixelComponentAlpha:
 				{
@@ -37,7 +37,7 @@ TurboJpegWriterProcessParams TurboJpegWriterPlugin::getProcessParams( const OfxT
 void TurboJpegWriterPlugin::render( const OFX::RenderArguments &args )
 {
 	WriterPlugin::render( args );
-	doGilRender<TurboJpegWriterProcess>( *this, args );
+	doGilRender<WriteBehind<TurboJpegWriterProcess>::Launcher>( *this, args );
 }
 
 }
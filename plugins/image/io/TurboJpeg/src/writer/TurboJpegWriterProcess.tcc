@@ -38,7 +38,8 @@ void TurboJpegWriterProcess<View>::multiThreadProcessImages( const OfxRectI& pro
 	using namespace boost::gil;
 
 	View srcView = this->_srcView;	
-	copy_pixels( this->_srcView, this->_dstView );
+	if( this->_dst )
+		copy_pixels( this->_srcView, this->_dstView );
 	
 	try
 	{
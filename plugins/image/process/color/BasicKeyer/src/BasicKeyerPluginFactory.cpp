@@ -31,6 +31,8 @@ void BasicKeyerPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	// the mattes are mostly empty or full
+	desc.setSparseOutput( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
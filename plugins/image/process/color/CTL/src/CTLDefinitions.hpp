@@ -22,6 +22,23 @@ enum EParamChooseInput
 
 static const std::string kParamCTLCode               ( "code" );
 
+static const std::string kParamBake                  ( "bake" );
+static const std::string kParamBakeShaper            ( "bakeShaper" );
+static const std::string kParamBakeShaperLinear      ( "linear" );
+static const std::string kParamBakeShaperLog2        ( "log2" );
+static const std::string kParamBakeDomain            ( "bakeDomain" );
+static const std::string kParamBakeLutSize           ( "bakeLutSize" );
+static const std::string kParamBakeMaxError          ( "bakeMaxError" );
+
+enum EParamBakeShaper
+{
+	eParamBakeShaperLinear = 0,
+	eParamBakeShaperLog2,
+};
+
+/// Smallest input of the log2 shaper (the lower values use the LUT at this input)
+static const double kBakeLog2ShaperMin = 1.0 / 65536.0;
+
 }
 }
 }
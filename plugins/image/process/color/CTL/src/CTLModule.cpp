@@ -0,0 +1,341 @@
+#include "CTLModule.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <Iex.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/make_shared.hpp>
+
+#include <cstring>
+
+namespace tuttle {
+namespace plugin {
+namespace ctl {
+
+namespace {
+
+/// Maximum number of cells per axis used to measure the error of a baked LUT
+static const std::size_t kBakeErrorCells = 16;
+
+template<class Type>
+void fillInputArg( Ctl::FunctionArgPtr& arg, const std::string& argStr, const Type& v, const std::size_t n )
+{
+	if( !arg ||
+//		!arg->type().cast<half>() ||
+		!arg->isVarying( ) )
+	{
+		// The CTL function has no argument argStr, the argument
+		// is not of type half, or the argument is not varying
+		BOOST_THROW_EXCEPTION( Iex::ArgExc( std::string("Cannot set value of argument ")+argStr ) );
+	}
+
+	memcpy( arg->data(), &v, n*sizeof(Type) );
+}
+
+template<class Type>
+void retrieveOutputArg( const Ctl::FunctionArgPtr& arg, const std::string& argStr, Type& v, const std::size_t n )
+{
+	if( !arg ||
+//		!arg->type( ).cast<half>() ||
+		!arg->isVarying( ) )
+	{
+		// The CTL function has no argument argStr, the argument
+		// is not of type half, or the argument is not varying
+		BOOST_THROW_EXCEPTION( Iex::ArgExc( std::string("Cannot set value of argument ")+argStr ) );
+	}
+
+	memcpy( &v, arg->data(), n*sizeof(Type) );
+}
+
+template<class Type>
+void callCtlChunk(
+	Ctl::FunctionCallPtr call,
+	const std::size_t n,
+	Type& rOut,
+	Type& gOut,
+	Type& bOut,
+	Type& aOut,
+	const Type& r,
+	const Type& g,
+	const Type& b,
+	const Type& a )
+{
+	// First set the input arguments for the function call:
+	Ctl::FunctionArgPtr rArg = call->findInputArg( "rIn" );
+	fillInputArg( rArg, "rIn", r, n );
+	Ctl::FunctionArgPtr gArg = call->findInputArg( "gIn" );
+	fillInputArg( gArg, "gIn", g, n );
+	Ctl::FunctionArgPtr bArg = call->findInputArg( "bIn" );
+	fillInputArg( bArg, "bIn", b, n );
+	Ctl::FunctionArgPtr aArg = call->findInputArg( "aIn" );
+	fillInputArg( aArg, "aIn", a, n );
+
+	// Now we can call the CTL function for
+	// pixels 0, through n-1
+	call->callFunction( n );
+
+	// Retrieve the results
+	Ctl::FunctionArgPtr rOutArg = call->findOutputArg( "rOut" );
+	retrieveOutputArg( rOutArg, "rOut", rOut, n );
+	Ctl::FunctionArgPtr gOutArg = call->findOutputArg( "gOut" );
+	retrieveOutputArg( gOutArg, "gOut", gOut, n );
+	Ctl::FunctionArgPtr bOutArg = call->findOutputArg( "bOut" );
+	retrieveOutputArg( bOutArg, "bOut", bOut, n );
+	Ctl::FunctionArgPtr aOutArg = call->findOutputArg( "aOut" );
+	retrieveOutputArg( aOutArg, "aOut", aOut, n );
+}
+
+}
+
+bool CTLBakeParams::operator<( const CTLBakeParams& other ) const
+{
+	if( _shaper != other._shaper )
+		return _shaper < other._shaper;
+	if( _domainMin != other._domainMin )
+		return _domainMin < other._domainMin;
+	if( _domainMax != other._domainMax )
+		return _domainMax < other._domainMax;
+	return _lutSize < other._lutSize;
+}
+
+CTLShaper::CTLShaper( const CTLBakeParams& params )
+: _type( params._shaper )
+{
+	double min = params._domainMin;
+	double max = params._domainMax;
+	if( _type == eParamBakeShaperLog2 )
+	{
+		min = std::log( std::max( min, kBakeLog2ShaperMin ) );
+		max = std::log( std::max( max, kBakeLog2ShaperMin ) );
+	}
+	_offset = static_cast<float>( min );
+	_scale = max > min ? static_cast<float>( 1.0 / ( max - min ) ) : 0.0f;
+}
+
+double CTLShaper::inverse( const double u ) const
+{
+	const double v = _scale != 0.0f ? _offset + u / _scale : _offset;
+	if( _type == eParamBakeShaperLog2 )
+		return std::exp( v );
+	return v;
+}
+
+CTLModule::CTLModule( const CTLProcessParams<float>& params )
+{
+	switch( params._inputType )
+	{
+		case eParamChooseInputCode:
+		{
+			TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Load code: " << params._code );
+			loadModule( _interpreter, params._module, params._code );
+			break;
+		}
+		case eParamChooseInputFile:
+		{
+			_interpreter.setModulePaths( params._paths );
+			TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Load module: " << params._module );
+			_interpreter.loadModule( params._module );
+			break;
+		}
+	}
+}
+
+CTLModule::ScopedCall::ScopedCall( CTLModule& module )
+: _module( module )
+{
+	{
+		boost::mutex::scoped_lock lock( _module._callsMutex );
+		if( ! _module._calls.empty() )
+		{
+			_call = _module._calls.back();
+			_module._calls.pop_back();
+		}
+	}
+	if( ! _call )
+		_call = _module._interpreter.newFunctionCall( "main" );
+}
+
+CTLModule::ScopedCall::~ScopedCall()
+{
+	boost::mutex::scoped_lock lock( _module._callsMutex );
+	_module._calls.push_back( _call );
+}
+
+void CTLModule::ScopedCall::operator()( const std::size_t size,
+                                        float* rOut, float* gOut, float* bOut, float* aOut,
+                                        const float* r, const float* g, const float* b, const float* a )
+{
+	std::size_t n = size;
+	while( n > 0 )
+	{
+		const std::size_t m = std::min( n, _module._interpreter.maxSamples() );
+		callCtlChunk( _call, m, *rOut, *gOut, *bOut, *aOut, *r, *g, *b, *a );
+
+		n    -= m;
+		rOut += m;
+		gOut += m;
+		bOut += m;
+		aOut += m;
+		r    += m;
+		g    += m;
+		b    += m;
+		a    += m;
+	}
+}
+
+boost::shared_ptr<const CTLBakedLut> CTLModule::getBakedLut( const CTLBakeParams& params )
+{
+	// the first render thread bakes, the others wait for the LUT
+	boost::mutex::scoped_lock lock( _bakedLutsMutex );
+	boost::shared_ptr<const CTLBakedLut>& bakedLut = _bakedLuts[params];
+	if( ! bakedLut )
+		bakedLut = bake( params );
+	return bakedLut;
+}
+
+/**
+ * @brief Sample the CTL transform on the nodes of the LUT (alpha input is 1),
+ *        and measure the error of the LUT at the center of the cells.
+ */
+boost::shared_ptr<CTLBakedLut> CTLModule::bake( const CTLBakeParams& params )
+{
+	boost::shared_ptr<CTLBakedLut> baked = boost::make_shared<CTLBakedLut>();
+	baked->_shaper = CTLShaper( params );
+	const CTLShaper& shaper = baked->_shaper;
+
+	// nodes of the LUT: first axis (red) varying slowest
+	const std::size_t size = std::max( params._lutSize, std::size_t( 2 ) );
+	std::vector<double> nodeInputs( size );
+	for( std::size_t i = 0; i < size; ++i )
+		nodeInputs[i] = shaper.inverse( i / double( size - 1 ) );
+
+	const std::size_t nbNodes = size * size * size;
+	std::vector<float> in( 4 * nbNodes );
+	std::vector<float> out( 4 * nbNodes );
+	float* r = &in[0];
+	float* g = r + nbNodes;
+	float* b = g + nbNodes;
+	float* a = b + nbNodes;
+	std::size_t n = 0;
+	for( std::size_t i = 0; i < size; ++i )
+	{
+		for( std::size_t j = 0; j < size; ++j )
+		{
+			for( std::size_t k = 0; k < size; ++k, ++n )
+			{
+				r[n] = static_cast<float>( nodeInputs[i] );
+				g[n] = static_cast<float>( nodeInputs[j] );
+				b[n] = static_cast<float>( nodeInputs[k] );
+				a[n] = 1.0f;
+			}
+		}
+	}
+	ScopedCall call( *this );
+	call( nbNodes, &out[0], &out[nbNodes], &out[2 * nbNodes], &out[3 * nbNodes], r, g, b, a );
+
+	baked->_lut.resize( size );
+	baked->_lut.setDomain( 0.0f, 1.0f );
+	float* node = baked->_lut.data();
+	for( n = 0; n < nbNodes; ++n, node += 3 )
+	{
+		node[0] = out[n];
+		node[1] = out[nbNodes + n];
+		node[2] = out[2 * nbNodes + n];
+	}
+
+	// error at the center of the cells (the farthest points from the nodes),
+	// on a subset of the cells of each axis
+	const std::size_t nbCells = std::min( size - 1, kBakeErrorCells );
+	const std::size_t nbTests = nbCells * nbCells * nbCells;
+	std::vector<double> cellCenters( nbCells );
+	for( std::size_t i = 0; i < nbCells; ++i )
+		cellCenters[i] = shaper.inverse( ( i * ( size - 1 ) / nbCells + 0.5 ) / double( size - 1 ) );
+	n = 0;
+	for( std::size_t i = 0; i < nbCells; ++i )
+	{
+		for( std::size_t j = 0; j < nbCells; ++j )
+		{
+			for( std::size_t k = 0; k < nbCells; ++k, ++n )
+			{
+				r[n] = static_cast<float>( cellCenters[i] );
+				g[n] = static_cast<float>( cellCenters[j] );
+				b[n] = static_cast<float>( cellCenters[k] );
+				a[n] = 1.0f;
+			}
+		}
+	}
+	call( nbTests, &out[0], &out[nbTests], &out[2 * nbTests], &out[3 * nbTests], r, g, b, a );
+
+	baked->_maxError = 0.0;
+	for( n = 0; n < nbTests; ++n )
+	{
+		float rgb[3];
+		baked->_lut.evaluate<terry::color::lut::tetrahedral_interpolation>( shaper( r[n] ), shaper( g[n] ), shaper( b[n] ), rgb );
+		for( std::size_t c = 0; c < 3; ++c )
+			baked->_maxError = std::max( baked->_maxError, std::abs( double( rgb[c] ) - out[c * nbTests + n] ) );
+	}
+	TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Baked LUT of size " << size << ", max error " << baked->_maxError );
+	return baked;
+}
+
+bool CTLModuleCache::Key::operator<( const Key& other ) const
+{
+	if( _inputType != other._inputType )
+		return _inputType < other._inputType;
+	if( _module != other._module )
+		return _module < other._module;
+	if( _code != other._code )
+		return _code < other._code;
+	if( _paths != other._paths )
+		return _paths < other._paths;
+	if( _mtime != other._mtime )
+		return _mtime < other._mtime;
+	return _size < other._size;
+}
+
+CTLModuleCache::Key CTLModuleCache::buildKey( const CTLProcessParams<float>& params )
+{
+	Key key;
+	key._inputType = params._inputType;
+	key._module = params._module;
+	key._code = params._code;
+	key._paths = params._paths;
+	key._mtime = 0;
+	key._size = 0;
+	if( params._inputType == eParamChooseInputFile && ! params._paths.empty() )
+	{
+		// a modified file is loaded again
+		const boost::filesystem::path filename = boost::filesystem::path( params._paths.front() ) / ( params._module + ".ctl" );
+		boost::system::error_code error;
+		key._mtime = boost::filesystem::last_write_time( filename, error );
+		key._size = boost::filesystem::file_size( filename, error );
+	}
+	return key;
+}
+
+boost::shared_ptr<CTLModule> CTLModuleCache::get( const CTLProcessParams<float>& params )
+{
+	const Key key = buildKey( params );
+
+	boost::mutex::scoped_lock lockerMap( _mutex );
+	boost::shared_ptr<CTLModule> module = _modules[key].lock();
+	if( module )
+		return module;
+
+	// remove the entries of the programs which are no longer used
+	for( std::map<Key, boost::weak_ptr<CTLModule> >::iterator it = _modules.begin(); it != _modules.end(); )
+	{
+		if( it->second.expired() )
+			_modules.erase( it++ );
+		else
+			++it;
+	}
+	module.reset( new CTLModule( params ) );
+	_modules[key] = module;
+	return module;
+}
+
+}
+}
+}
@@ -0,0 +1,164 @@
+#ifndef _TUTTLE_PLUGIN_CTL_MODULE_HPP_
+#define _TUTTLE_PLUGIN_CTL_MODULE_HPP_
+
+#include "CTLPlugin.hpp"
+
+#include <terry/color/lut/lut3d.hpp>
+
+#include <tuttle/common/patterns/StaticSingleton.hpp>
+
+#include <CtlSimdInterpreter.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace ctl {
+
+/**
+ * @brief HACK: workaround CTL limitation to load a module which source code
+ * comes from a string and not a file.
+ */
+void loadModule( Ctl::Interpreter& interpreter, const std::string &moduleName, const std::string& code );
+void loadModuleRecursive( Ctl::Interpreter& interpreter,const std::string &moduleName, const std::string& code );
+
+/**
+ * @brief 1D shaper of a baked LUT: maps the input domain to the [0, 1] domain of the 3D LUT,
+ *        linearly or in log2 (more nodes in the dark values of scene linear images).
+ */
+class CTLShaper
+{
+public:
+	CTLShaper() : _type( eParamBakeShaperLinear ), _offset( 0.0f ), _scale( 1.0f ) {}
+	explicit CTLShaper( const CTLBakeParams& params );
+
+	float operator()( const float x ) const
+	{
+		if( _type == eParamBakeShaperLog2 )
+			return ( std::log( std::max( x, static_cast<float>( kBakeLog2ShaperMin ) ) ) - _offset ) * _scale;
+		return ( x - _offset ) * _scale;
+	}
+
+	/// @brief Input value of a position in the 3D LUT.
+	double inverse( const double u ) const;
+
+private:
+	EParamBakeShaper _type;
+	float _offset;
+	float _scale;
+};
+
+/**
+ * @brief CTL transform sampled in a 1D shaper followed by a 3D LUT.
+ * The alpha channel is not baked.
+ */
+struct CTLBakedLut
+{
+	CTLShaper _shaper;
+	terry::color::lut::lut3d<3> _lut;
+	double _maxError; ///< maximum difference with the CTL transform on the rgb channels, measured inside the cells
+};
+
+/**
+ * @brief A CTL program loaded in its own interpreter.
+ *
+ * The program is parsed once, the "main" function calls are reused
+ * (a call is used by one thread at a time).
+ */
+class CTLModule : boost::noncopyable
+{
+public:
+	/// @brief Load the program. @exception Iex::BaseExc on CTL errors
+	explicit CTLModule( const CTLProcessParams<float>& params );
+
+	/**
+	 * @brief A "main" function call, used by one thread while this object is alive.
+	 */
+	class ScopedCall : boost::noncopyable
+	{
+	public:
+		explicit ScopedCall( CTLModule& module );
+		~ScopedCall();
+
+		/// @brief Transform @p n pixels (planar values).
+		void operator()( const std::size_t n,
+		                 float* rOut, float* gOut, float* bOut, float* aOut,
+		                 const float* r, const float* g, const float* b, const float* a );
+
+	private:
+		CTLModule& _module;
+		Ctl::FunctionCallPtr _call;
+	};
+
+	/// @brief The LUT baked with these params, computed on the first request.
+	boost::shared_ptr<const CTLBakedLut> getBakedLut( const CTLBakeParams& params );
+
+private:
+	boost::shared_ptr<CTLBakedLut> bake( const CTLBakeParams& params );
+
+private:
+	Ctl::SimdInterpreter _interpreter;
+
+	boost::mutex _callsMutex;
+	std::vector<Ctl::FunctionCallPtr> _calls; ///< function calls not used by a thread
+
+	boost::mutex _bakedLutsMutex;
+	std::map<CTLBakeParams, boost::shared_ptr<const CTLBakedLut> > _bakedLuts;
+};
+
+/**
+ * @brief Process-wide cache of the loaded CTL programs.
+ *
+ * A module is shared by all the CTL nodes using the same program, as long
+ * as one of them is alive. Entries are identified by the code, the module
+ * name and the module paths (and the modification time and size of the file,
+ * for programs read from a file).
+ */
+class CTLModuleCache : public StaticSingleton<CTLModuleCache>
+{
+	MAKE_StaticSingleton( CTLModuleCache )
+
+public:
+	struct Key
+	{
+		EParamChooseInput _inputType;
+		std::string _module;
+		std::string _code;
+		std::vector<std::string> _paths;
+		std::time_t _mtime;
+		boost::uintmax_t _size;
+
+		bool operator<( const Key& other ) const;
+	};
+
+public:
+	/**
+	 * @brief Get the module of a CTL program, the program is only loaded if it is not in memory.
+	 * @exception Iex::BaseExc on CTL errors
+	 */
+	boost::shared_ptr<CTLModule> get( const CTLProcessParams<float>& params );
+
+private:
+	static Key buildKey( const CTLProcessParams<float>& params );
+
+private:
+	boost::mutex _mutex; ///< Mutex for the modules map.
+	std::map<Key, boost::weak_ptr<CTLModule> > _modules;
+};
+
+}
+}
+}
+
+#endif
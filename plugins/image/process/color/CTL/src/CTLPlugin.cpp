@@ -1,5 +1,6 @@
 #include "CTLPlugin.hpp"
 #include "CTLProcess.hpp"
+#include "CTLModule.hpp"
 #include "CTLDefinitions.hpp"
 
 #include <boost/gil/gil_all.hpp>
@@ -20,8 +21,14 @@ CTLPlugin::CTLPlugin( OfxImageEffectHandle handle )
 	_paramCode         = fetchStringParam     ( kParamCTLCode );
 	_paramFile         = fetchStringParam     ( kTuttlePluginFilename );
 	_paramUpdateRender = fetchPushButtonParam ( kParamChooseInputCodeUpdate );
+	_paramBake         = fetchBooleanParam    ( kParamBake );
+	_paramBakeShaper   = fetchChoiceParam     ( kParamBakeShaper );
+	_paramBakeDomain   = fetchDouble2DParam   ( kParamBakeDomain );
+	_paramBakeLutSize  = fetchIntParam        ( kParamBakeLutSize );
+	_paramBakeMaxError = fetchDoubleParam     ( kParamBakeMaxError );
 
 	changedParam ( _instanceChangedArgs, kParamChooseInput );
+	changedParam ( _instanceChangedArgs, kParamBake );
 }
 
 CTLProcessParams<CTLPlugin::Scalar> CTLPlugin::getProcessParams( const OfxPointD& renderScale ) const
@@ -48,9 +55,23 @@ CTLProcessParams<CTLPlugin::Scalar> CTLPlugin::getProcessParams( const OfxPointD
 			break;
 		}
 	}
+	params._bake = _paramBake->getValue();
+	params._bakeParams._shaper = static_cast<EParamBakeShaper>( _paramBakeShaper->getValue() );
+	const OfxPointD domain = _paramBakeDomain->getValue();
+	params._bakeParams._domainMin = domain.x;
+	params._bakeParams._domainMax = domain.y;
+	params._bakeParams._lutSize = _paramBakeLutSize->getValue();
 	return params;
 }
 
+boost::shared_ptr<CTLModule> CTLPlugin::getModule( const CTLProcessParams<Scalar>& params )
+{
+	boost::shared_ptr<CTLModule> module = CTLModuleCache::instance().get( params );
+	boost::mutex::scoped_lock lock( _moduleMutex );
+	_module = module;
+	return module;
+}
+
 void CTLPlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName )
 {
 	if( paramName == kParamChooseInput )
@@ -74,6 +95,14 @@ void CTLPlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::s
 			}
 		}
 	}
+	else if( paramName == kParamBake )
+	{
+		const bool bake = _paramBake->getValue();
+		_paramBakeShaper  -> setIsSecretAndDisabled( ! bake );
+		_paramBakeDomain  -> setIsSecretAndDisabled( ! bake );
+		_paramBakeLutSize -> setIsSecretAndDisabled( ! bake );
+		_paramBakeMaxError-> setIsSecret( ! bake );
+	}
 	else if( paramName == kParamCTLCode )
 	{
 		_paramInput->setValue( eParamChooseInputCode );
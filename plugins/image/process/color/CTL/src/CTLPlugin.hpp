@@ -5,10 +5,26 @@
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace ctl {
 
+/**
+ * @brief Sampling of the CTL transform in a baked LUT.
+ */
+struct CTLBakeParams
+{
+	EParamBakeShaper _shaper;
+	double _domainMin;
+	double _domainMax;
+	std::size_t _lutSize;
+
+	bool operator<( const CTLBakeParams& other ) const;
+};
+
 template<typename Scalar>
 struct CTLProcessParams
 {
@@ -16,8 +32,13 @@ struct CTLProcessParams
 	std::vector<std::string> _paths;
 	std::string _module;
 	std::string _code;
+
+	bool _bake; ///< apply a baked LUT, instead of interpreting the CTL on each pixel
+	CTLBakeParams _bakeParams;
 };
 
+class CTLModule;
+
 /**
  * @brief CTL plugin
  */
@@ -37,14 +58,28 @@ public:
 	bool isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime );
 
     void render( const OFX::RenderArguments &args );
+
+	/**
+	 * @brief Compiled module of the CTL program, shared by the nodes with the same program.
+	 * The last module is kept loaded for the next frames.
+	 */
+	boost::shared_ptr<CTLModule> getModule( const CTLProcessParams<Scalar>& params );
 	
 public:
 	OFX::ChoiceParam*        _paramInput;
 	OFX::StringParam*        _paramCode;
 	OFX::StringParam*        _paramFile;
 	OFX::PushButtonParam*    _paramUpdateRender;
+	OFX::BooleanParam*       _paramBake;
+	OFX::ChoiceParam*        _paramBakeShaper;
+	OFX::Double2DParam*      _paramBakeDomain;
+	OFX::IntParam*           _paramBakeLutSize;
+	OFX::DoubleParam*        _paramBakeMaxError;
 private:
 	OFX::InstanceChangedArgs _instanceChangedArgs;
+
+	boost::mutex _moduleMutex;
+	boost::shared_ptr<CTLModule> _module;
 };
 
 }
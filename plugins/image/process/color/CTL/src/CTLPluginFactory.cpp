@@ -112,6 +112,39 @@ void CTLPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	file->setHint ( "CTL source code file." );
 	file->setStringType( OFX::eStringTypeFilePath );
 
+	OFX::BooleanParamDescriptor* bake = desc.defineBooleanParam( kParamBake );
+	bake->setLabel( "Bake LUT" );
+	bake->setHint( "Sample the CTL transform in a 1D shaper and a 3D LUT, and apply the LUT instead of interpreting the CTL on each pixel.\n"
+	               "The CTL is sampled with an alpha of 1, the alpha channel is not modified." );
+	bake->setDefault( false );
+
+	OFX::ChoiceParamDescriptor* bakeShaper = desc.defineChoiceParam( kParamBakeShaper );
+	bakeShaper->setLabel( "Shaper" );
+	bakeShaper->setHint( "Distribution of the LUT nodes on the input domain.\n"
+	                     "log2: more nodes in the dark values, for scene linear images." );
+	bakeShaper->appendOption( kParamBakeShaperLinear );
+	bakeShaper->appendOption( kParamBakeShaperLog2 );
+	bakeShaper->setDefault( eParamBakeShaperLinear );
+
+	OFX::Double2DParamDescriptor* bakeDomain = desc.defineDouble2DParam( kParamBakeDomain );
+	bakeDomain->setLabel( "Domain" );
+	bakeDomain->setHint( "Input range sampled by the LUT (min, max), the values outside of the range are clamped." );
+	bakeDomain->setDefault( 0.0, 1.0 );
+
+	OFX::IntParamDescriptor* bakeLutSize = desc.defineIntParam( kParamBakeLutSize );
+	bakeLutSize->setLabel( "LUT size" );
+	bakeLutSize->setHint( "Number of nodes on each axis of the 3D LUT." );
+	bakeLutSize->setDefault( 33 );
+	bakeLutSize->setRange( 2, 65 );
+	bakeLutSize->setDisplayRange( 17, 65 );
+
+	OFX::DoubleParamDescriptor* bakeMaxError = desc.defineDoubleParam( kParamBakeMaxError );
+	bakeMaxError->setLabel( "Max error" );
+	bakeMaxError->setHint( "Maximum difference between the baked LUT and the CTL transform, measured at the center of the LUT cells." );
+	bakeMaxError->setDefault( 0.0 );
+	bakeMaxError->setEvaluateOnChange( false );
+	bakeMaxError->setEnabled( false );
+
 
 }
 
@@ -1,9 +1,11 @@
 #ifndef _TUTTLE_PLUGIN_CTL_PROCESS_HPP_
 #define _TUTTLE_PLUGIN_CTL_PROCESS_HPP_
 
+#include "CTLModule.hpp"
+
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 
-#include <CtlSimdInterpreter.h>
+#include <boost/shared_ptr.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -24,7 +26,8 @@ protected:
     CTLPlugin&    _plugin;            ///< Rendering plugin
 	CTLProcessParams<Scalar> _params; ///< parameters
 
-	Ctl::SimdInterpreter _interpreter;
+	boost::shared_ptr<CTLModule> _module;
+	boost::shared_ptr<const CTLBakedLut> _bakedLut; ///< only in bake mode
 
 public:
     CTLProcess( CTLPlugin& effect );
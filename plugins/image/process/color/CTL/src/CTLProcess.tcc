@@ -6,18 +6,15 @@
 #include <Iex.h>
 #include <CtlMessage.h>
 
+#include <terry/color/lut/transform_lut3d.hpp>
+
+#include <vector>
+
 
 namespace tuttle {
 namespace plugin {
 namespace ctl {
 
-/**
- * @brief HACK: workaround CTL limitation to load a module which source code
- * comes from a string and not a file.
- */
-void loadModule( Ctl::Interpreter& interpreter, const std::string &moduleName, const std::string& code );
-void loadModuleRecursive( Ctl::Interpreter& interpreter,const std::string &moduleName, const std::string& code );
-
 namespace {
 
 CTLPlugin* ctlPlugin;
@@ -30,106 +27,6 @@ void ctlMessageOutput( const std::string& message )
 	}
 }
 
-template<class Type>
-void fillInputArg( Ctl::FunctionArgPtr& arg, const std::string& argStr, const Type& v, const std::size_t n )
-{
-	if( !arg ||
-//		!arg->type().cast<half>() ||
-		!arg->isVarying( ) )
-	{
-		// The CTL function has no argument argStr, the argument
-		// is not of type half, or the argument is not varying
-		BOOST_THROW_EXCEPTION( Iex::ArgExc( std::string("Cannot set value of argument ")+argStr ) );
-	}
-
-	memcpy( arg->data(), &v, n*sizeof(Type) );
-}
-
-template<class Type>
-void retrieveOutputArg( const Ctl::FunctionArgPtr& arg, const std::string& argStr, Type& v, const std::size_t n )
-{
-	if( !arg ||
-//		!arg->type( ).cast<half>() ||
-		!arg->isVarying( ) )
-	{
-		// The CTL function has no argument argStr, the argument
-		// is not of type half, or the argument is not varying
-		BOOST_THROW_EXCEPTION( Iex::ArgExc( std::string("Cannot set value of argument ")+argStr ) );
-	}
-
-	memcpy( &v, arg->data(), n*sizeof(Type) );
-}
-
-template<class Type>
-void callCtlChunk(
-	Ctl::FunctionCallPtr call,
-	const std::size_t n,
-	Type& rOut,
-	Type& gOut,
-	Type& bOut,
-	Type& aOut,
-	const Type& r,
-	const Type& g,
-	const Type& b,
-	const Type& a )
-{
-	// First set the input arguments for the function call:
-	Ctl::FunctionArgPtr rArg = call->findInputArg( "rIn" );
-	fillInputArg( rArg, "rIn", r, n );
-	Ctl::FunctionArgPtr gArg = call->findInputArg( "gIn" );
-	fillInputArg( gArg, "gIn", g, n );
-	Ctl::FunctionArgPtr bArg = call->findInputArg( "bIn" );
-	fillInputArg( bArg, "bIn", b, n );
-	Ctl::FunctionArgPtr aArg = call->findInputArg( "aIn" );
-	fillInputArg( aArg, "aIn", a, n );
-
-	// Now we can call the CTL function for
-	// pixels 0, through n-1
-	call->callFunction( n );
-
-	// Retrieve the results
-	Ctl::FunctionArgPtr rOutArg = call->findOutputArg( "rOut" );
-	retrieveOutputArg( rOutArg, "rOut", rOut, n );
-	Ctl::FunctionArgPtr gOutArg = call->findOutputArg( "gOut" );
-	retrieveOutputArg( gOutArg, "gOut", gOut, n );
-	Ctl::FunctionArgPtr bOutArg = call->findOutputArg( "bOut" );
-	retrieveOutputArg( bOutArg, "bOut", bOut, n );
-	Ctl::FunctionArgPtr aOutArg = call->findOutputArg( "aOut" );
-	retrieveOutputArg( aOutArg, "aOut", aOut, n );
-}
-
-template<class Type>
-void callCtl(
-	Ctl::Interpreter &interp,
-	Ctl::FunctionCallPtr call,
-	const std::size_t size,
-	Type* rOut,
-	Type* gOut,
-	Type* bOut,
-	Type* aOut,
-	const Type* r,
-	const Type* g,
-	const Type* b,
-	const Type* a )
-{
-	std::size_t n = size;
-	while( n > 0 )
-	{
-		const std::size_t m = std::min( n, interp.maxSamples() );
-		callCtlChunk( call, m, *rOut, *gOut, *bOut, *aOut, *r, *g, *b, *a );
-
-		n    -= m;
-		rOut += m;
-		gOut += m;
-		bOut += m;
-		aOut += m;
-		r    += m;
-		g    += m;
-		b    += m;
-		a    += m;
-	}
-}
-
 }
 
 template<class View>
@@ -147,19 +44,12 @@ void CTLProcess<View>::setup( const OFX::RenderArguments& args )
 	ImageGilFilterProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.renderScale );
 
-	switch( _params._inputType )
+	// the program is loaded once, for all the frames and the nodes using it
+	_module = _plugin.getModule( _params );
+	if( _params._bake )
 	{
-		case eParamChooseInputCode:
-		{
-			TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Load code: " << _params._code );
-			loadModule( _interpreter, _params._module, _params._code );
-		}
-		case eParamChooseInputFile:
-		{
-			_interpreter.setModulePaths( _params._paths );
-			TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Load module: " << _params._module );
-			_interpreter.loadModule( _params._module );
-		}
+		_bakedLut = _module->getBakedLut( _params._bakeParams );
+		_plugin._paramBakeMaxError->setValueAtTime( args.time, _bakedLut->_maxError );
 	}
 	Ctl::setMessageOutputFunction( ctlMessageOutput );
 }
@@ -173,7 +63,7 @@ void CTLProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
 	using namespace boost::gil;
 
-	Ctl::FunctionCallPtr call = _interpreter.newFunctionCall( "main" );
+	CTLModule::ScopedCall call( *_module );
 
 	const OfxPointI procWindowSize = {
 		procWindowRoW.x2 - procWindowRoW.x1,
@@ -184,6 +74,7 @@ void CTLProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 	rgba32f_planar_view_t  srcWorkLineV = view( srcWorkLine );
 	rgba32f_planar_image_t dstWorkLine( procWindowSize.x, 1, alignment );
 	rgba32f_planar_view_t  dstWorkLineV = view( dstWorkLine );
+	std::vector<float> rgb( _bakedLut ? 3 * procWindowSize.x : 0 );
 
 	for( int y = procWindowRoW.y1;
 			 y < procWindowRoW.y2;
@@ -203,9 +94,29 @@ void CTLProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 		const float* b = reinterpret_cast<float*>( &srcWorkLineV(0,0)[2] );
 		const float* a = reinterpret_cast<float*>( &srcWorkLineV(0,0)[3] );
 
-		callCtl<float>(
-				_interpreter,
-				call,
+		if( _bakedLut )
+		{
+			// 1D shaper then 3D LUT on the rgb channels, alpha is not modified
+			const CTLShaper& shaper = _bakedLut->_shaper;
+			for( int x = 0; x < procWindowSize.x; ++x )
+			{
+				rgb[3 * x]     = shaper( r[x] );
+				rgb[3 * x + 1] = shaper( g[x] );
+				rgb[3 * x + 2] = shaper( b[x] );
+			}
+			terry::color::lut::transform_lut3d<terry::color::lut::tetrahedral_interpolation>(
+				_bakedLut->_lut, &rgb.front(), 3, &rgb.front(), 3, procWindowSize.x );
+			for( int x = 0; x < procWindowSize.x; ++x )
+			{
+				rOut[x] = rgb[3 * x];
+				gOut[x] = rgb[3 * x + 1];
+				bOut[x] = rgb[3 * x + 2];
+				aOut[x] = a[x];
+			}
+		}
+		else
+		{
+			call(
 				procWindowSize.x,
 				rOut,
 				gOut,
@@ -216,6 +127,7 @@ void CTLProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 				b,
 				a
 			);
+		}
 
 		copy_pixels( dstWorkLineV, dstLineV );
 
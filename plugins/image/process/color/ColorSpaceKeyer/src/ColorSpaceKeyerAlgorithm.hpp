@@ -1,11 +1,90 @@
 #ifndef _TUTTLE_PLUGIN_COLORSPACEKEYER_ALGORITHM_HPP_
 #define _TUTTLE_PLUGIN_COLORSPACEKEYER_ALGORITHM_HPP_
 
+#include "GeodesicForm.hpp"
+
+#include <cmath>
+
 namespace tuttle {
 namespace plugin {
 namespace colorSpaceKeyer {
 
+/**
+ * @brief Compute the selection value of a color (1 into the color form, 0 outside the spill form
+ *        and a linear transition between the two forms).
+ * @warning Geodesic forms are modified (current intersection), so it can't be used by multiple threads.
+ */
+inline double computeSelection( GeodesicForm& dataColor, GeodesicForm& dataSpill, const Ofx3DPointD& testPoint )
+{
+	double alpha = 0.0;			//define current pixel alpha (0 by default)
+
+	if(dataSpill.isIntoBoundingBox(testPoint))						//if current pixel is into spill bounding box
+	{
+		if(dataColor.isIntoBoundingBox(testPoint))					//bounding box test (process optimization)
+		{
+			if(dataColor.isPointIntoGeodesicForm(testPoint))		//if current pixel is into the color geodesic form
+			{
+				alpha = 1.0;										//change alpha to 1
+			}
+		}
+		if(alpha != 1.0 && dataSpill.isPointIntoGeodesicForm(testPoint))
+		{
+			//intersections test
+			if(dataColor.testIntersection2(testPoint,false,true)) //normal intersection
+			{
+				//computes vectors
+				Ofx3DPointD vectMax;
+				Ofx3DPointD vectMin;
+				//compute min vector
+				vectMin.x = testPoint.x - dataColor._intersectionPoint.x; //x value
+				vectMin.y = testPoint.y - dataColor._intersectionPoint.y; //y value
+				vectMin.z = testPoint.z - dataColor._intersectionPoint.z;	//z value
+				//compute max vector
+				vectMax.x = dataSpill._intersectionPoint.x - dataColor._intersectionPoint.x; //x value
+				vectMax.y = dataSpill._intersectionPoint.y - dataColor._intersectionPoint.y; //x value
+				vectMax.z = dataSpill._intersectionPoint.z - dataColor._intersectionPoint.z; //x value
+				//compute norms
+				double normMin,normMax;			//initialize
+				normMin  = vectMin.x*vectMin.x;	//add x*x
+				normMin += vectMin.y*vectMin.y;	//add y*y
+				normMin += vectMin.z*vectMin.z;	//add z*z
+				normMin = sqrt(normMin);		//compute norm minimal
+
+				normMax  = vectMax.x*vectMax.x;	//add x*x
+				normMax += vectMax.y*vectMax.y;	//add y*y
+				normMax += vectMax.z*vectMax.z;	//add z*z
+				normMax = sqrt(normMax);		//compute norm maximal
+
+				//compute alpha value
+				alpha = normMin/normMax;
+			}
+		}
+	}
+	return alpha;
+}
+
+/**
+ * @brief Functor used to bake computeSelection into a 3D LUT.
+ */
+struct SelectionBaker
+{
+	GeodesicForm& _dataColor;	//color geodesic form
+	GeodesicForm& _dataSpill;	//spill geodesic form
+
+	SelectionBaker( GeodesicForm& dataC, GeodesicForm& dataS )
+	: _dataColor( dataC )
+	, _dataSpill( dataS )
+	{}
 
+	void operator()( const double x, const double y, const double z, float* out )
+	{
+		Ofx3DPointD testPoint;		//initialize test point
+		testPoint.x = x;			//x == red
+		testPoint.y = y;			//y == green
+		testPoint.z = z;			//z == blue
+		out[0] = static_cast<float>( computeSelection( _dataColor, _dataSpill, testPoint ) );
+	}
+};
 
 }
 }
@@ -95,6 +95,22 @@ const static std::string kBoolSpillSelectionDisplayLabel = "Display spill select
 const static std::string kDoubleScaleGeodesicForm = "scaleGF";
 const static std::string kDoubleScaleGeodesicFormLabel = "Scale geodesic form";
 
+//Baked selection LUT size (number of nodes on each axis)
+const static std::string kIntSelectionLutSize = "selectionLutSize";
+const static std::string kIntSelectionLutSizeLabel = "Selection LUT size";
+
+//Baked selection LUT interpolation
+const static std::string kSelectionLutInterpolation = "selectionLutInterpolation";
+const static std::string kSelectionLutInterpolationLabel = "Selection LUT interpolation";
+const static std::string kSelectionLutInterpolationTrilinear = "Trilinear";
+const static std::string kSelectionLutInterpolationTetrahedral = "Tetrahedral";
+
+enum ESelectionLutInterpolation
+{
+	eSelectionLutInterpolationTrilinear = 0,
+	eSelectionLutInterpolationTetrahedral
+};
+
 //Rotation constants
 const static int KMaxDegres = 360;		//360° max for a rotation
 const static int kRotationSpeed = 5;	//mouse rotation scale
@@ -1,9 +1,11 @@
 #include "ColorSpaceKeyerPlugin.hpp"
 #include "ColorSpaceKeyerProcess.hpp"
 #include "ColorSpaceKeyerDefinitions.hpp"
+#include "ColorSpaceKeyerAlgorithm.hpp"
 #include "CloudPointData.hpp"
 
 #include <boost/gil/gil_all.hpp>
+#include <boost/functional/hash.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -31,6 +33,8 @@ ColorSpaceKeyerPlugin::ColorSpaceKeyerPlugin( OfxImageEffectHandle handle )
 		_paramDoubleScaleGF = fetchDoubleParam(kDoubleScaleGeodesicForm);				//scale geodesic form - double parameter
 		_paramBoolSeeSpillSelection = fetchBooleanParam(kBoolSpillSelectionDisplay);	//see spill selection - check box
 		_paramBoolDisplaySpillGF = fetchBooleanParam(kBoolDisplaySpillGF);				//see spill geodesic form - check box
+		_paramIntSelectionLutSize = fetchIntParam(kIntSelectionLutSize);				//selection LUT size - Int parameter
+		_paramChoiceSelectionLutInterpolation = fetchChoiceParam(kSelectionLutInterpolation); //selection LUT interpolation - Choice parameter
 		
 		//verify display Discrete enable value
 		if(_paramBoolPointCloudDisplay->getValue())	//called default value
@@ -343,6 +347,7 @@ void ColorSpaceKeyerPlugin::render( const OFX::RenderArguments &args )
 	//update process attributes
 	if(_renderAttributes.recomputeGeodesicForm || _renderAttributes.time != args.time)
 		updateProcessGeodesicForms(args);
+	updateProcessSelectionLut();	//bake the selection LUT if geodesic forms have changed
 	//call process functions
 	doGilRender<ColorSpaceKeyerProcess>( *this, args ); //launch process
 }
@@ -429,6 +434,30 @@ void ColorSpaceKeyerPlugin::updateProcessGeodesicForms(const OFX::RenderArgument
 	_renderAttributes.recomputeGeodesicForm = false;
 }
 
+/*
+ * Bake the selection (computed from the color & spill geodesic forms) into a 3D LUT.
+ * The LUT only depends on the geodesic forms and LUT size, so it is only recomputed if they have changed.
+ */
+void ColorSpaceKeyerPlugin::updateProcessSelectionLut()
+{
+	_renderAttributes.selectionLutInterpolation = static_cast<ESelectionLutInterpolation>(_paramChoiceSelectionLutInterpolation->getValue());
+	const std::size_t lutSize = _paramIntSelectionLutSize->getValue();
+	
+	std::size_t hash = _renderAttributes.geodesicFormColor.getHash();		//color form
+	boost::hash_combine( hash, _renderAttributes.geodesicFormSpill.getHash() );	//spill form
+	boost::hash_combine( hash, lutSize );									//LUT size
+	if( ! _renderAttributes.selectionLut.empty() && hash == _renderAttributes.selectionLutHash )
+		return;	//nothing has changed
+	
+	//LUT domain is the spill bounding box (selection is null outside)
+	const BoundingBox& bbox = _renderAttributes.geodesicFormSpill._boundingBox;
+	const float min[3] = { static_cast<float>(bbox.min.x), static_cast<float>(bbox.min.y), static_cast<float>(bbox.min.z) };
+	const float max[3] = { static_cast<float>(bbox.max.x), static_cast<float>(bbox.max.y), static_cast<float>(bbox.max.z) };
+	_renderAttributes.selectionLut.setDomain( min, max );
+	_renderAttributes.selectionLut.bake( SelectionBaker(_renderAttributes.geodesicFormColor, _renderAttributes.geodesicFormSpill), lutSize );
+	_renderAttributes.selectionLutHash = hash;
+}
+
 
 
 
@@ -6,6 +6,8 @@
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <terry/color/lut/lut3d.hpp>
+
 
 
 namespace tuttle {
@@ -30,6 +32,17 @@ struct CSProcessParams
 	//Create geodesic form
 	GeodesicForm geodesicFormColor;          //color form
 	GeodesicForm geodesicFormSpill;          //spill form
+	//Baked selection (depends only on geodesic forms)
+	terry::color::lut::lut3d<1> selectionLut;                     //selection LUT over the spill bounding box
+	std::size_t                 selectionLutHash;                 //hash of the data used to bake the LUT
+	ESelectionLutInterpolation  selectionLutInterpolation;        //interpolation used in process
+
+	CSProcessParams()
+	: time( 0 )
+	, recomputeGeodesicForm( true )
+	, selectionLutHash( 0 )
+	, selectionLutInterpolation( eSelectionLutInterpolationTetrahedral )
+	{}
 };
 
 
@@ -58,6 +71,8 @@ public:
 	OFX::DoubleParam*     _paramDoubleScaleGF;              // scale geodesic form - Double parameters
 	OFX::BooleanParam*    _paramBoolSeeSpillSelection;      // see spill selection on overlay - check box
 	OFX::BooleanParam*    _paramBoolDisplaySpillGF;         // see spill geodesic form on screen - check box
+	OFX::IntParam*        _paramIntSelectionLutSize;        // number of nodes of the selection LUT - Int parameter
+	OFX::ChoiceParam*     _paramChoiceSelectionLutInterpolation; // selection LUT interpolation - Choice parameter
 	
 	//Overlay data parameters
 	bool                  _updateVBO;                       // VBO data has been changed so update VBO
@@ -109,6 +124,7 @@ public:
 private:
 	void updateGeodesicForms(const OFX::InstanceChangedArgs& args);     //update color & spill geodesic forms
 	void updateProcessGeodesicForms(const OFX::RenderArguments &args);  //update color & spill geodesic forms (used in process)
+	void updateProcessSelectionLut();                                   //bake geodesic forms into the selection LUT (used in process)
 };
 
 }
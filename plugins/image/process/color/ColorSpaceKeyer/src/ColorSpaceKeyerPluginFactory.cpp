@@ -197,6 +197,24 @@ void ColorSpaceKeyerPluginFactory::describeInContext( OFX::ImageEffectDescriptor
 	scaleGF->setDisplayRange(0,2);									//set display range
 	scaleGF->setHint("Scale geodesic form");						//help
 	scaleGF->setParent(groupProcess);								//add to process group	
+	
+	//Int parameter selection LUT size (process is done with a baked LUT)
+	OFX::IntParamDescriptor* selectionLutSize = desc.defineIntParam(kIntSelectionLutSize);
+	selectionLutSize->setLabel(kIntSelectionLutSizeLabel);			//add label
+	selectionLutSize->setRange(2,129);								//value range
+	selectionLutSize->setDisplayRange(9,65);						//display range values
+	selectionLutSize->setDefault(33);								//default value
+	selectionLutSize->setHint("Number of nodes on each axis of the LUT used to compute the matte (bigger is more precise but slower to update)"); //help
+	selectionLutSize->setParent(groupProcess);						//add to process group
+	
+	//Choice parameter selection LUT interpolation
+	OFX::ChoiceParamDescriptor* selectionLutInterpolation = desc.defineChoiceParam(kSelectionLutInterpolation);
+	selectionLutInterpolation->setLabel(kSelectionLutInterpolationLabel);	//add label
+	selectionLutInterpolation->appendOption(kSelectionLutInterpolationTrilinear);
+	selectionLutInterpolation->appendOption(kSelectionLutInterpolationTetrahedral);
+	selectionLutInterpolation->setDefault(eSelectionLutInterpolationTetrahedral);
+	selectionLutInterpolation->setHint("Interpolation used between the nodes of the selection LUT"); //help
+	selectionLutInterpolation->setParent(groupProcess);						//add to process group
 }
 
 /**
@@ -5,21 +5,25 @@
 #include "GeodesicForm.hpp"
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 
+#include <terry/color/lut/lut3d.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace colorSpaceKeyer {
 
 	
+/**
+ * @brief Compute the alpha of each pixel from the selection LUT (baked from the geodesic forms).
+ */
+template<class Interpolation>
 struct Compute_alpha_pixel
 { 
-	bool _isOutputBW;		//is output black & white (or alpha channel)
-	GeodesicForm& _dataColor;	//color geodesic form
-	GeodesicForm& _dataSpill;	//spill geodesic form
+	bool _isOutputBW;						//is output black & white (or alpha channel)
+	const terry::color::lut::lut3d<1>& _selectionLut;	//selection baked over the spill bounding box
 	
-	Compute_alpha_pixel(bool isOutputBW, GeodesicForm& dataC, GeodesicForm& dataS):
+	Compute_alpha_pixel(bool isOutputBW, const terry::color::lut::lut3d<1>& selectionLut):
 	_isOutputBW(isOutputBW),
-	_dataColor(dataC),
-	_dataSpill(dataS)
+	_selectionLut(selectionLut)
 	{		
 	}
 	
@@ -28,53 +32,14 @@ struct Compute_alpha_pixel
     {
         using namespace boost::gil;
 		
-        double alpha = 0.0;			//define current pixel alpha (1 by default)
-		Ofx3DPointD testPoint;		//initialize test point 
-		testPoint.x = p[0];			//x == red
-		testPoint.y = p[1];			//y == green
-		testPoint.z = p[2];			//z == blue
+		float alpha = 0.0f;			//define current pixel alpha (0 outside of the spill bounding box)
+		const float x = p[0];		//x == red
+		const float y = p[1];		//y == green
+		const float z = p[2];		//z == blue
 		
-		if(_dataSpill.isIntoBoundingBox(testPoint))						//if current pixel is into spill bounding box
+		if(_selectionLut.contains(x,y,z))	//if current pixel is into spill bounding box
 		{
-			if(_dataColor.isIntoBoundingBox(testPoint))					//bounding box test (process optimization)
-			{
-				if(_dataColor.isPointIntoGeodesicForm(testPoint))		//if current pixel is into the color geodesic form
-				{
-					alpha = 1.0;										//change alpha to 1
-				}
-			}
-			if(alpha != 1.0 && _dataSpill.isPointIntoGeodesicForm(testPoint))
-			{
-				//intersections test
-				if(_dataColor.testIntersection2(testPoint,false,true)) //normal intersection
-				{
-					//computes vectors
-					Ofx3DPointD vectMax;
-					Ofx3DPointD vectMin;
-					//compute min vector
-					vectMin.x = testPoint.x - _dataColor._intersectionPoint.x; //x value
-					vectMin.y = testPoint.y - _dataColor._intersectionPoint.y; //y value
-					vectMin.z = testPoint.z - _dataColor._intersectionPoint.z;	//z value
-					//compute max vector
-					vectMax.x = _dataSpill._intersectionPoint.x - _dataColor._intersectionPoint.x; //x value
-					vectMax.y = _dataSpill._intersectionPoint.y - _dataColor._intersectionPoint.y; //x value
-					vectMax.z = _dataSpill._intersectionPoint.z - _dataColor._intersectionPoint.z; //x value
-					//compute norms
-					double normMin,normMax;			//initialize
-					normMin  = vectMin.x*vectMin.x;	//add x*x
-					normMin += vectMin.y*vectMin.y;	//add y*y
-					normMin += vectMin.z*vectMin.z;	//add z*z
-					normMin = sqrt(normMin);		//compute norm minimal
-
-					normMax  = vectMax.x*vectMax.x;	//add x*x
-					normMax += vectMax.y*vectMax.y;	//add y*y
-					normMax += vectMax.z*vectMax.z;	//add z*z
-					normMax = sqrt(normMax);		//compute norm maximal
-
-					//compute alpha value
-					alpha = normMin/normMax;
-				}
-			}
+			_selectionLut.evaluate<Interpolation>(x,y,z,&alpha);
 		}
 		alpha = 1-alpha;				//black is transparent and white is opaque
 		Pixel ret;						//declare returned pixel
@@ -92,7 +57,7 @@ struct Compute_alpha_pixel
 		}
 		return ret;
     }
-};	
+};
 	
 /**
  * @brief ColorSpaceKeyer process
@@ -112,6 +77,9 @@ public:
     ColorSpaceKeyerProcess( ColorSpaceKeyerPlugin& effect );
 	void setup( const OFX::RenderArguments& args );
     void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+private:
+	template<class Interpolation>
+	void processImages( const View& src, const View& dst );
 };
 
 }
@@ -39,9 +39,23 @@ void ColorSpaceKeyerProcess<View>::multiThreadProcessImages( const OfxRectI& pro
 	View dst = subimage_view( this->_dstView, procWindowOutput.x1, procWindowOutput.y1,
 							                  procWindowSize.x, procWindowSize.y );
 	
-    //Create and initialize functor 
-	Compute_alpha_pixel funct(false,_plugin._renderAttributes.geodesicFormColor, _plugin._renderAttributes.geodesicFormSpill); //Output is alpha
-	//this function is chose because of functor reference and not copy
+	switch( _plugin._renderAttributes.selectionLutInterpolation )
+	{
+		case eSelectionLutInterpolationTrilinear:
+			processImages<terry::color::lut::trilinear_interpolation>( src, dst );
+			break;
+		case eSelectionLutInterpolationTetrahedral:
+			processImages<terry::color::lut::tetrahedral_interpolation>( src, dst );
+			break;
+	}
+}
+
+template<class View>
+template<class Interpolation>
+void ColorSpaceKeyerProcess<View>::processImages( const View& src, const View& dst )
+{
+	//Create and initialize functor (the LUT is read only, so it is shared by all threads)
+	Compute_alpha_pixel<Interpolation> funct(false,_plugin._renderAttributes.selectionLut); //Output is alpha
 	terry::algorithm::transform_pixels_progress(src,dst,funct,*this);
 }
 
@@ -2,6 +2,8 @@
 
 #include <tuttle/plugin/opengl/gl.h>
 
+#include <boost/functional/hash.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace colorSpaceKeyer {
@@ -1179,6 +1181,27 @@ void GeodesicForm::scaleGeodesicForm(const double scale)
 	}
 }
 
+/*
+ * Hash of the geodesic form (points, center, radius and scale)
+ * Used to know if data computed from this form need to be updated
+ */
+std::size_t GeodesicForm::getHash() const
+{
+	std::size_t seed = 0;
+	for(unsigned int i=0; i< _points.size(); ++i)
+	{
+		boost::hash_combine( seed, _points[i].x );	//add x value
+		boost::hash_combine( seed, _points[i].y );	//add y value
+		boost::hash_combine( seed, _points[i].z );	//add z value
+	}
+	boost::hash_combine( seed, _center.x );			//add center
+	boost::hash_combine( seed, _center.y );
+	boost::hash_combine( seed, _center.z );
+	boost::hash_combine( seed, _radius );			//add radius
+	boost::hash_combine( seed, _scale );			//add scale
+	return seed;
+}
+
 
 }
 }
@@ -81,6 +81,9 @@ public:
 	//Scale geodesic form (multiplier result after extends)
 	void scaleGeodesicForm(const double scale);
 	
+	//Hash of the geodesic form (points, center, radius and scale)
+	std::size_t getHash() const;
+	
 	//test
 	void testOnePointFunction();
 	
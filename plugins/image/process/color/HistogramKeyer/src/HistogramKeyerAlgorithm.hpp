@@ -1,10 +1,46 @@
 #ifndef _TUTTLE_PLUGIN_HISTOGRAMKEYER_ALGORITHM_HPP_
 #define _TUTTLE_PLUGIN_HISTOGRAMKEYER_ALGORITHM_HPP_
 
+#include <ofxsParam.h>
+
 namespace tuttle {
 namespace plugin {
 namespace histogramKeyer {
 
+/**
+ * Functor used to bake one curve of a parametric param into a 1D LUT
+ * (the curve is read from the host only once per sample and not once per pixel).
+ */
+struct CurveBaker
+{
+	OFX::ParametricParam* _curves;	//curves param
+	int _curveIndex;				//curve to bake
+	OfxTime _time;					//current time
+	bool _clamp;					//clamp curve values in [0, 1]
+	double _multiplier;				//multiplier applied after clamp
+
+	CurveBaker( OFX::ParametricParam* curves, const int curveIndex, const OfxTime time, const bool clamp, const double multiplier )
+	: _curves( curves )
+	, _curveIndex( curveIndex )
+	, _time( time )
+	, _clamp( clamp )
+	, _multiplier( multiplier )
+	{}
+
+	double operator()( const double x ) const
+	{
+		double value = _curves->getValue( _curveIndex, _time, x );
+		//clamp mode
+		if( _clamp )
+		{
+			if( value > 1.0 )		//clamp values superior to 1
+				value = 1.0;
+			else if( value < 0.0 )	//clamp values inferior to 0
+				value = 0.0;
+		}
+		return value * _multiplier;
+	}
+};
 
 }
 }
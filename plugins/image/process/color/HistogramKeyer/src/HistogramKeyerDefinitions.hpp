@@ -15,6 +15,7 @@ const static std::size_t nbCurves = 6;
 const static std::size_t nbCurvesRGB = 3;
 const static std::size_t nbCurvesHSL = 3;
 const static std::size_t curveFromSelection = 40;
+const static std::size_t curveLutSize = 1024; //number of samples of each curve baked for process
 
 //Curves params
 const static std::string kParamRGBColorSelection = "colorRGBSelection";
@@ -1,4 +1,5 @@
 #include "HistogramKeyerPlugin.hpp"
+#include "HistogramKeyerAlgorithm.hpp"
 #include "HistogramKeyerProcess.hpp"
 
 #include <boost/gil/gil_all.hpp>
@@ -80,27 +81,32 @@ HistogramKeyerProcessParams<HistogramKeyerPlugin::Scalar> HistogramKeyerPlugin::
 {
 	HistogramKeyerProcessParams<Scalar> params;
 
-	params._paramColorRGB = _paramColorRGBSelection; //curve RGB
-	params._boolRGB[0] = _paramOverlayRSelection; //R (is channel selected?)
-	params._boolRGB[1] = _paramOverlayGSelection; //G (is channel selected?)
-	params._boolRGB[2] = _paramOverlayBSelection; //B (is channel selected?)
+	params._boolRGB[0] = _paramOverlayRSelection->getValue(); //R (is channel selected?)
+	params._boolRGB[1] = _paramOverlayGSelection->getValue(); //G (is channel selected?)
+	params._boolRGB[2] = _paramOverlayBSelection->getValue(); //B (is channel selected?)
 
-	params._paramColorHSL = _paramColorHSLSelection; //curve HSL
-	params._boolHSL[0] = _paramOverlayHSelection; //H (is channel selected?)
-	params._boolHSL[1] = _paramOverlaySSelection; //S (is channel selected?)
-	params._boolHSL[2] = _paramOverlayLSelection; //L (is channel selected?)
+	params._boolHSL[0] = _paramOverlayHSelection->getValue(); //H (is channel selected?)
+	params._boolHSL[1] = _paramOverlaySSelection->getValue(); //S (is channel selected?)
+	params._boolHSL[2] = _paramOverlayLSelection->getValue(); //L (is channel selected?)
 	
-	params._multiplierRGB[0] = _paramMutliplierR; //R multiplier
-	params._multiplierRGB[1] = _paramMutliplierG; //G multiplier
-	params._multiplierRGB[2] = _paramMutliplierB; //B multiplier
+	const boost::array<OFX::DoubleParam*, 3> multiplierRGB = {{ _paramMutliplierR, _paramMutliplierG, _paramMutliplierB }}; //RGB multipliers
+	const boost::array<OFX::DoubleParam*, 3> multiplierHSL = {{ _paramMutliplierH, _paramMutliplierS, _paramMutliplierL }}; //HSL multipliers
+	const bool clampCurveValues = _paramClampCurveValues->getValue(); //clamp curve values (Advanced group)
 	
-	params._multiplierHSL[0] = _paramMutliplierH; //H multiplier
-	params._multiplierHSL[1] = _paramMutliplierS; //S multiplier
-	params._multiplierHSL[2] = _paramMutliplierL; //L multiplier
+	//bake selected curves (curves are defined on [0, 1])
+	for( std::size_t v = 0; v < nbCurvesRGB; ++v )
+	{
+		if( params._boolRGB[v] )
+			params._curvesRGB[v].bake( CurveBaker( _paramColorRGBSelection, v, time, clampCurveValues, multiplierRGB[v]->getValue() ), curveLutSize );
+	}
+	for( std::size_t v = 0; v < nbCurvesHSL; ++v )
+	{
+		if( params._boolHSL[v] )
+			params._curvesHSL[v].bake( CurveBaker( _paramColorHSLSelection, v, time, clampCurveValues, multiplierHSL[v]->getValue() ), curveLutSize );
+	}
 	
-	params._paramOutputSetting = _paramOutputSettingSelection; //output selection (alpha channel or BW)
-	params._boolReverseMask = _paramReverseMaskSelection; //reverse mask check box
-	params._boolClampCurveValues =  _paramClampCurveValues;		//clamp curve values (Advanced group)
+	params._isOutputBW = ( _paramOutputSettingSelection->getValue() == 1 ); //output selection (alpha channel or BW)
+	params._boolReverseMask = _paramReverseMaskSelection->getValue(); //reverse mask check box
 
 	return params;
 }
@@ -3,6 +3,10 @@
 
 #include "OverlayData.hpp"
 
+#include <terry/color/lut/lut1d.hpp>
+
+#include <boost/array.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace histogramKeyer {
@@ -13,16 +17,12 @@ namespace histogramKeyer {
 template<typename Scalar>
 struct HistogramKeyerProcessParams
 {
-    OFX::ParametricParam* _paramColorRGB;		//curve RGB
-    OFX::ParametricParam* _paramColorHSL;		//curve HSL
-    OfxTime _time;								//current time
-	OFX::ChoiceParam* _paramOutputSetting;		//ouput display (BW/alpha)
-	OFX::BooleanParam* _boolReverseMask;		//is mask revert
-	boost::array<OFX::BooleanParam*, 3> _boolRGB;	//check boxes RGB selection
-	boost::array<OFX::BooleanParam*, 3> _boolHSL;	//check boxes HSL selection
-	boost::array<OFX::DoubleParam*, 3> _multiplierRGB;	//multiplier RGB channels
-	boost::array<OFX::DoubleParam*, 3> _multiplierHSL;	//multiplier HSL channels
-	OFX::BooleanParam* _boolClampCurveValues;			//clamp curve values (Advanced group)
+	boost::array<terry::color::lut::lut1d, 3> _curvesRGB;	//curves RGB baked at current time (clamp and multiplier included)
+	boost::array<terry::color::lut::lut1d, 3> _curvesHSL;	//curves HSL baked at current time (clamp and multiplier included)
+	boost::array<bool, 3> _boolRGB;	//RGB selection (is channel selected?)
+	boost::array<bool, 3> _boolHSL;	//HSL selection (is channel selected?)
+	bool _isOutputBW;				//ouput display (BW or alpha)
+	bool _boolReverseMask;			//is mask revert
 };
 
 /**
@@ -42,6 +42,8 @@ void HistogramKeyerPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	// the mattes are mostly empty or full
+	desc.setSparseOutput( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 
 	desc.setOverlayInteractDescriptor( new OFX::DefaultEffectOverlayWrap<HistogramKeyerOverlayDescriptor>() );
@@ -19,7 +19,12 @@ namespace histogramKeyer {
 struct Compute_alpha_pixel
 { 
 	bool _isOutputBW; // is output black & white (or alpha channel)
-    HistogramKeyerProcessParams<float> _params;
+    const HistogramKeyerProcessParams<float>& _params;
+
+	Compute_alpha_pixel( const HistogramKeyerProcessParams<float>& params )
+	: _isOutputBW( params._isOutputBW )
+	, _params( params )
+	{}
 	
     template< typename Pixel>
     Pixel operator()( const Pixel& p )
@@ -34,45 +39,20 @@ struct Compute_alpha_pixel
         
         double alpha = 1.0;
 
-        //RGBA
+        //RGB (curves are baked, clamp and multiplier are included)
         for( int v = 0; v < boost::gil::num_channels<Pixel>::type::value -1; ++v ) // RGB but not alpha (doesn't needed)
         {
-			if(_params._boolRGB[v]->getValue()) //if current channel check-box is active
-			{
-				double value =  _params._paramColorRGB->getValue( v, _params._time,p[v] );
-
-				//clamp mode 
-				if(_params._boolClampCurveValues->getValue())
-				{
-					if(value > 1.0)			//clamp values superior to 1
-						value = 1.0;
-					else if(value < 0.0)	//clamp values inferior to 0
-						value = 0.0;
-				}
-				value *= (double) _params._multiplierRGB[v]->getValue(); //multiplier RGB channels
-				alpha *= value;
-			}
+			if( _params._boolRGB[v] ) //if current channel check-box is active
+				alpha *= _params._curvesRGB[v]( p[v] );
         }
         //HSL
         for( int v = 0; v < boost::gil::num_channels<hsl32f_pixel_t>::type::value; ++v )
         {
-			if(_params._boolHSL[v]->getValue()) //if current channel check-box is active
-			{
-				double value = _params._paramColorHSL->getValue( v, _params._time,hsl_pix[v] );
-				//clamp mode 
-				if(_params._boolClampCurveValues->getValue())
-				{
-					if(value > 1.0)			//clamp values superior to 1
-						value = 1.0;
-					else if(value < 0.0)	//clamp values inferior to 0
-						value = 0.0;
-				}
-				value *= (double) _params._multiplierHSL[v]->getValue(); //multiplier HSL channels
-				alpha *=  value;
-			}
+			if( _params._boolHSL[v] ) //if current channel check-box is active
+				alpha *= _params._curvesHSL[v]( hsl_pix[v] );
         }
 		Pixel ret;
-		if( ! _params._boolReverseMask->getValue() ) //revert mask
+		if( ! _params._boolReverseMask ) //revert mask
 			alpha = 1-alpha;
 		
 		if( _isOutputBW ) // output is gray scale image
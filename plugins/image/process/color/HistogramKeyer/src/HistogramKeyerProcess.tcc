@@ -40,9 +40,7 @@ void HistogramKeyerProcess<View>::multiThreadProcessImages( const OfxRectI& proc
 							                  procWindowSize.x, procWindowSize.y );
 	
     //Create and initialize functor 
-	Compute_alpha_pixel funct;
-    funct._params = _params;
-	funct._isOutputBW = (_params._paramOutputSetting->getValue() == 1); // is output black and white (or alpha channel)
+	Compute_alpha_pixel funct( _params ); // baked curves are shared by all threads
 	//this function is chose because of functor reference and not copy
     terry::algorithm::transform_pixels_progress(src,dst,funct,*this);
 }
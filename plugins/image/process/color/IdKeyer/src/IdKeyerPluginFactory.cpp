@@ -32,6 +32,8 @@ void IdKeyerPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	// the mattes are mostly empty or full
+	desc.setSparseOutput( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
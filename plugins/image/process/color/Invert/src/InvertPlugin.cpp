@@ -1,7 +1,10 @@
 #include "InvertPlugin.hpp"
 #include "InvertProcess.hpp"
 
+#include <tuttle/plugin/constantImage.hpp>
+
 #include <boost/gil/gil_all.hpp>
+#include <boost/scoped_ptr.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -33,6 +36,52 @@ InvertProcessParams InvertPlugin::getProcessParams( const OfxPointD& renderScale
 	return params;
 }
 
+/**
+ * @brief Invert the color of a constant source, the output is set as a constant image.
+ * The color is inverted on a pixel of the output bit depth, like the render,
+ * so the output has the same values as a rendered image.
+ * @return false if the output needs to be rendered
+ */
+template<class Pixel>
+bool InvertPlugin::renderConstantPixel( const OFX::RenderArguments& args )
+{
+	boost::scoped_ptr<OFX::Image> src( _clipSrc->fetchImage( args.time ) );
+	boost::scoped_ptr<OFX::Image> dst( _clipDst->fetchImage( args.time ) );
+	if( ! dst.get() ||
+	    ! isConstantOver( src.get(), *dst ) ||
+	    ! isRenderingAllImage( *dst, args.renderWindow ) ||
+	    src->getPixelComponents() != dst->getPixelComponents() )
+		return false;
+
+	const InvertProcessParams params = getProcessParams( args.renderScale );
+	const bool processChannels[4] = { params._red, params._green, params._blue, params._alpha };
+	const int nbChannels = num_channels<Pixel>::value;
+
+	Pixel pixel = constantColorToPixel<Pixel>( src->getConstantColor() );
+	for( int c = 0; c < nbChannels; ++c )
+	{
+		if( nbChannels == 1 ? params._gray : processChannels[c] )
+			pixel[c] = channel_invert( pixel[c] );
+	}
+	return dst->setConstantColor( pixelToConstantColor( pixel ) );
+}
+
+template<class Layout>
+bool InvertPlugin::renderConstantImage( const OFX::RenderArguments& args, const OFX::EBitDepth bitDepth )
+{
+	switch( bitDepth )
+	{
+		case OFX::eBitDepthUByte:
+			return renderConstantPixel<pixel<bits8, Layout> >( args );
+		case OFX::eBitDepthUShort:
+			return renderConstantPixel<pixel<bits16, Layout> >( args );
+		case OFX::eBitDepthFloat:
+			return renderConstantPixel<pixel<bits32f, Layout> >( args );
+		default:
+			return false;
+	}
+}
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
@@ -47,16 +96,22 @@ void InvertPlugin::render( const OFX::RenderArguments& args )
 	{
 		case OFX::ePixelComponentRGBA:
 		{
+			if( renderConstantImage<boost::gil::rgba_layout_t>( args, bitDepth ) )
+				return;
 			doGilRender<InvertProcess, false, boost::gil::rgba_layout_t>( *this, args, bitDepth );
 			return;
 		}
 		case OFX::ePixelComponentRGB:
 		{
+			if( renderConstantImage<boost::gil::rgb_layout_t>( args, bitDepth ) )
+				return;
 			doGilRender<InvertProcess, false, boost::gil::rgb_layout_t>( *this, args, bitDepth );
 			return;
 		}
 		case OFX::ePixelComponentAlpha:
 		{
+			if( renderConstantImage<boost::gil::gray_layout_t>( args, bitDepth ) )
+				return;
 			doGilRender<InvertProcess, false, boost::gil::gray_layout_t>( *this, args, bitDepth );
 			return;
 		}
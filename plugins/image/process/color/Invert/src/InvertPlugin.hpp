@@ -32,6 +32,12 @@ public:
 
 	void render( const OFX::RenderArguments& args );
 
+private:
+	template<class Layout>
+	bool renderConstantImage( const OFX::RenderArguments& args, const OFX::EBitDepth bitDepth );
+	template<class Pixel>
+	bool renderConstantPixel( const OFX::RenderArguments& args );
+
 protected:
 	OFX::GroupParam*   _paramProcessGroup;
 	OFX::BooleanParam* _paramProcessR;
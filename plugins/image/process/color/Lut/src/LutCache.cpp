@@ -0,0 +1,166 @@
+#include "LutCache.hpp"
+#include "lutEngine/LutReader.hpp"
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tuttle {
+namespace plugin {
+namespace lut {
+
+namespace bfs = boost::filesystem;
+namespace bip = boost::interprocess;
+
+namespace {
+
+static const char kBinaryMagic[4] = { 'T', 'L', 'U', 'T' };
+static const boost::uint32_t kBinaryVersion = 1;
+
+/**
+ * @brief Binary cache file header, followed by the lut file path
+ *        (pathSize chars) and the lattice (dimSize^3 * 3 floats).
+ */
+struct BinaryHeader
+{
+	char magic[4];
+	boost::uint32_t version;
+	boost::uint32_t dimSize;
+	boost::uint32_t pathSize;
+	boost::int64_t mtime;
+	boost::uint64_t fileSize;
+};
+
+}
+
+boost::shared_ptr<const LutCache::Lut> LutCache::get( const bfs::path& filename )
+{
+	const Key key = buildFileCacheKey( filename );
+
+	boost::mutex::scoped_lock lockerMap( _mutex );
+	boost::shared_ptr<const Lut> lut = _luts[key].lock();
+	if( lut )
+		return lut;
+
+	const bfs::path binaryFile = fileCacheFilename( "lutCache", key, ".tlut" );
+	boost::shared_ptr<Lut> newLut = readBinary( binaryFile, key );
+	if( ! newLut )
+	{
+		newLut = parse( filename );
+		writeBinary( binaryFile, key, *newLut );
+	}
+	_luts[key] = newLut;
+	return newLut;
+}
+
+bfs::path LutCache::cacheDirectory()
+{
+	return fileCacheDirectory( "lutCache" );
+}
+
+boost::shared_ptr<LutCache::Lut> LutCache::parse( const bfs::path& filename )
+{
+	LutReader reader;
+	if( ! reader.read( filename ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Unable to read lut file." )
+			<< exception::filename( filename.string() ) );
+	}
+	const std::size_t dimSize = reader.steps().size();
+	if( dimSize < 2 || reader.data().size() != dimSize * dimSize * dimSize * Lut::nb_channels )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Lut file has an unexpected number of values." )
+			<< exception::filename( filename.string() ) );
+	}
+	// same layout as the file: first axis (red) varying slowest
+	boost::shared_ptr<Lut> lut = boost::make_shared<Lut>();
+	lut->resize( dimSize );
+	std::copy( reader.data().begin(), reader.data().end(), lut->data() );
+	return lut;
+}
+
+/**
+ * @return the lattice, or an empty pointer if there is no valid cache file.
+ */
+boost::shared_ptr<LutCache::Lut> LutCache::readBinary( const bfs::path& binaryFile, const Key& key )
+{
+	boost::shared_ptr<Lut> lut;
+	if( ! bfs::exists( binaryFile ) )
+		return lut;
+	try
+	{
+		const bip::file_mapping mapping( binaryFile.string().c_str(), bip::read_only );
+		const bip::mapped_region region( mapping, bip::read_only );
+		const char* it = static_cast<const char*>( region.get_address() );
+		const std::size_t size = region.get_size();
+
+		BinaryHeader header;
+		if( size < sizeof( BinaryHeader ) )
+			return lut;
+		std::memcpy( &header, it, sizeof( BinaryHeader ) );
+		if( std::memcmp( header.magic, kBinaryMagic, sizeof( kBinaryMagic ) ) != 0 ||
+		    header.version != kBinaryVersion ||
+		    header.mtime != key._mtime ||
+		    header.fileSize != key._size ||
+		    header.pathSize != key._path.size() ||
+		    header.dimSize < 2 )
+			return lut;
+		it += sizeof( BinaryHeader );
+
+		const std::size_t nbValues = std::size_t( header.dimSize ) * header.dimSize * header.dimSize * Lut::nb_channels;
+		if( size != sizeof( BinaryHeader ) + header.pathSize + nbValues * sizeof( float ) ||
+		    key._path.compare( 0, key._path.size(), it, header.pathSize ) != 0 )
+			return lut;
+		it += header.pathSize;
+
+		lut = boost::make_shared<Lut>();
+		lut->resize( header.dimSize );
+		std::memcpy( lut->data(), it, nbValues * sizeof( float ) );
+	}
+	catch( std::exception& e )
+	{
+		TUTTLE_LOG_WARNING( "Unable to read lut cache file " << binaryFile << ": " << e.what() );
+		lut.reset();
+	}
+	return lut;
+}
+
+/**
+ * @brief Write the binary cache file. Errors are only reported as warnings,
+ *        the cache is an optimization.
+ */
+void LutCache::writeBinary( const bfs::path& binaryFile, const Key& key, const Lut& lut )
+{
+	writeFileCache( binaryFile, boost::bind( &LutCache::writeBinaryContent, _1, boost::cref( key ), boost::cref( lut ) ) );
+}
+
+void LutCache::writeBinaryContent( std::ostream& file, const Key& key, const Lut& lut )
+{
+	BinaryHeader header;
+	std::memcpy( header.magic, kBinaryMagic, sizeof( kBinaryMagic ) );
+	header.version = kBinaryVersion;
+	header.dimSize = static_cast<boost::uint32_t>( lut.size() );
+	header.pathSize = static_cast<boost::uint32_t>( key._path.size() );
+	header.mtime = key._mtime;
+	header.fileSize = key._size;
+	const std::size_t nbValues = lut.size() * lut.size() * lut.size() * Lut::nb_channels;
+
+	file.write( reinterpret_cast<const char*>( &header ), sizeof( BinaryHeader ) );
+	file.write( key._path.c_str(), key._path.size() );
+	file.write( reinterpret_cast<const char*>( lut.data() ), nbValues * sizeof( float ) );
+}
+
+}
+}
+}
@@ -0,0 +1,64 @@
+#ifndef _TUTTLE_PLUGIN_LUTCACHE_HPP_
+#define _TUTTLE_PLUGIN_LUTCACHE_HPP_
+
+#include <tuttle/common/patterns/StaticSingleton.hpp>
+#include <tuttle/plugin/fileCache.hpp>
+
+#include <terry/color/lut/lut3d.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+
+namespace tuttle {
+namespace plugin {
+namespace lut {
+
+/**
+ * @brief Process-wide cache of parsed lut files.
+ *
+ * A lattice is shared by all the Lut nodes using the same file, as long
+ * as one of them is alive. Parsed files are also stored in a binary cache
+ * directory ($TUTTLE_HOME/lutCache, or <tmp>/tuttle/lutCache), which is
+ * memory-mapped by the next processes instead of parsing the text file.
+ * Entries are identified by the absolute path, the modification time and
+ * the size of the lut file.
+ */
+class LutCache : public StaticSingleton<LutCache>
+{
+	MAKE_StaticSingleton( LutCache )
+
+public:
+	typedef terry::color::lut::lut3d<3> Lut;
+	typedef FileCacheKey Key;
+
+public:
+	/**
+	 * @brief Get the lattice of a lut file.
+	 * The text file is only parsed if it is neither in memory nor in the binary cache.
+	 * @exception exception::File if the file can't be read.
+	 */
+	boost::shared_ptr<const Lut> get( const boost::filesystem::path& filename );
+
+	/// @brief Directory of the binary cache files
+	static boost::filesystem::path cacheDirectory();
+
+private:
+	static boost::shared_ptr<Lut> parse( const boost::filesystem::path& filename );
+	static boost::shared_ptr<Lut> readBinary( const boost::filesystem::path& binaryFile, const Key& key );
+	static void writeBinary( const boost::filesystem::path& binaryFile, const Key& key, const Lut& lut );
+	static void writeBinaryContent( std::ostream& file, const Key& key, const Lut& lut );
+
+private:
+	boost::mutex _mutex; ///< Mutex for the luts map.
+	std::map<Key, boost::weak_ptr<const Lut> > _luts;
+};
+
+}
+}
+}
+
+#endif
@@ -18,6 +18,12 @@ LutPlugin::LutPlugin( OfxImageEffectHandle handle )
 	: ImageEffectGilPlugin( handle )
 {
 	_sFilename = fetchStringParam( kTuttlePluginFilename );
+	_paramInterpolation = fetchChoiceParam( kParamInterpolation );
+}
+
+void LutPlugin::loadLut( const std::string& filename )
+{
+	_lut = LutCache::instance().get( filename );
 }
 
 /**
@@ -26,7 +32,7 @@ LutPlugin::LutPlugin( OfxImageEffectHandle handle )
  */
 void LutPlugin::render( const OFX::RenderArguments& args )
 {
-	if( !_lutReader.readOk() )
+	if( !_lut )
 	{
 		std::string str;
 		_sFilename->getValue( str );
@@ -35,16 +41,7 @@ void LutPlugin::render( const OFX::RenderArguments& args )
 			BOOST_THROW_EXCEPTION( exception::FileNotExist()
 				<< exception::filename(str) );
 		}
-		if( ! _lutReader.read( str ) )
-		{
-			BOOST_THROW_EXCEPTION( exception::File()
-				<< exception::user( "Unable to read lut file." ) );
-		}
-		_lut3D.reset( new TetraInterpolator(), _lutReader );
-	}
-	if( !_lutReader.readOk() )
-	{
-		BOOST_THROW_EXCEPTION( exception::Unknown() );
+		loadLut( str );
 	}
 	doGilRender<LutProcess>( *this, args );
 }
@@ -57,11 +54,7 @@ void LutPlugin::changedParam( const OFX::InstanceChangedArgs& args, const std::s
 		_sFilename->getValue( str );
 		if( bfs::exists( str ) )
 		{
-			if( ! _lutReader.read( str ) )
-			{
-				BOOST_THROW_EXCEPTION( exception::File() << exception::user( "Unable to read lut file..." ) );
-			}
-			_lut3D.reset( new TetraInterpolator(), _lutReader );
+			loadLut( str );
 		}
 	}
 }
@@ -1,11 +1,13 @@
 #ifndef _TUTTLE_PLUGIN_LUTPLUGIN_HPP_
 #define _TUTTLE_PLUGIN_LUTPLUGIN_HPP_
 
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "LutDefinitions.hpp"
+#include "LutCache.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <boost/shared_ptr.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace lut {
@@ -16,6 +18,9 @@ namespace lut {
  */
 class LutPlugin : public ImageEffectGilPlugin
 {
+public:
+	typedef LutCache::Lut Lut;
+
 public:
 	LutPlugin( OfxImageEffectHandle handle );
 
@@ -23,11 +28,15 @@ public:
 	void render( const OFX::RenderArguments& args );
 	void changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName );
 
+private:
+	/// Get the float lattice used by the process from the process-wide lut cache
+	void loadLut( const std::string& filename );
+
 public:
 	OFX::StringParam* _sFilename;    ///< Filename
+	OFX::ChoiceParam* _paramInterpolation;
 
-	LutReader _lutReader;               ///< Reader
-	Lut3D _lut3D;
+	boost::shared_ptr<const Lut> _lut; ///< Float lattice, interleaved RGB nodes, shared with the other instances
 };
 
 }
@@ -59,6 +59,13 @@ void LutPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc, OFX:
 	filename->setDefault( "" );
 	filename->setLabels( kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel );
 	filename->setStringType( OFX::eStringTypeFilePath );
+
+	OFX::ChoiceParamDescriptor* interpolation = desc.defineChoiceParam( kParamInterpolation );
+	interpolation->setLabel( kParamInterpolationLabel );
+	interpolation->appendOption( kParamInterpolationTrilinear );
+	interpolation->appendOption( kParamInterpolationTetrahedral );
+	interpolation->setDefault( eParamInterpolationTetrahedral );
+	interpolation->setHint( "Interpolation between the nodes of the 3D Lut." );
 }
 
 /**
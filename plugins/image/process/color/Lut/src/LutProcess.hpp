@@ -2,8 +2,7 @@
 #define _TUTTLE_PLUGIN_LUTPROCESS_HPP_
 
 #include "LutPlugin.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "LutDefinitions.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
@@ -13,6 +12,10 @@
 #include <ofxsMultiThread.h>
 
 #include <boost/gil/gil_all.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/mpl/bool.hpp>
+
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
@@ -20,21 +23,40 @@ namespace lut {
 
 /**
  * @brief Lut process
+ *
+ * Each row is converted into a float RGB buffer, transformed by batches
+ * with the float lattice and converted back.
  */
 template<class View>
 class LutProcess : public ImageGilFilterProcessor<View>
 {
+public:
+	typedef typename boost::gil::channel_type<View>::type Channel;
+	typedef boost::mpl::bool_<boost::is_integral<Channel>::value> is_integral_channel_t;
+
 private:
-	Lut3D* _lut3D;               ///< Lut3D
-	LutPlugin&  _plugin;        ///< Rendering plugin
+	boost::shared_ptr<const LutPlugin::Lut> _lut; ///< Float lattice
+	LutPlugin&  _plugin;             ///< Rendering plugin
+	EParamInterpolation _interpolation;
+	std::vector<float> _shaper;      ///< Integer code to lut input, only used by integer channels
 
 public:
 	LutProcess<View>( LutPlugin & instance );
 
+	void setup( const OFX::RenderArguments& args );
+
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
 	// Lut3D Transform
+	template<class Interpolation>
 	void applyLut( View& dst, View& src, const OfxRectI& procWindow );
+
+private:
+	void bakeShaper( boost::mpl::true_ );
+	void bakeShaper( boost::mpl::false_ ) {}
+
+	float toLutInput( const Channel v, boost::mpl::true_ ) const { return _shaper[v]; }
+	float toLutInput( const Channel v, boost::mpl::false_ ) const { return v; }
 };
 
 }
@@ -4,33 +4,54 @@
 
 #include "LutProcess.hpp"
 #include "LutDefinitions.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
-#include "lutEngine/TetraInterpolator.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 #include <terry/globals.hpp>
+#include <terry/color/lut/transform_lut3d.hpp>
 
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
 
 #include <boost/gil/gil_all.hpp>
-#include <boost/filesystem/fstream.hpp>
+
+#include <algorithm>
 
 namespace tuttle {
 namespace plugin {
 namespace lut {
 
-using namespace boost::filesystem;
-
 template<class View>
 LutProcess<View>::LutProcess( LutPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationIndependant )
 	, _plugin( instance )
+	, _interpolation( eParamInterpolationTetrahedral )
+{
+	_lut = _plugin._lut;
+}
+
+template<class View>
+void LutProcess<View>::setup( const OFX::RenderArguments& args )
+{
+	ImageGilFilterProcessor<View>::setup( args );
+	_interpolation = static_cast<EParamInterpolation>( _plugin._paramInterpolation->getValue() );
+	bakeShaper( is_integral_channel_t() );
+}
+
+/**
+ * @brief Prebake the conversion of each integer code into the lut input domain.
+ */
+template<class View>
+void LutProcess<View>::bakeShaper( boost::mpl::true_ )
 {
-	_lut3D = &_plugin._lut3D;
+	using namespace boost::gil;
+	const std::size_t maxValue = channel_traits<Channel>::max_value();
+	_shaper.resize( maxValue + 1 );
+	for( std::size_t i = 0; i <= maxValue; ++i )
+	{
+		_shaper[i] = i / float( maxValue );
+	}
 }
 
 /**
@@ -40,35 +61,56 @@ LutProcess<View>::LutProcess( LutPlugin& instance )
 template<class View>
 void LutProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
+	using namespace terry::color::lut;
 	OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
 
-	applyLut( this->_dstView, this->_srcView, procWindowOutput );
+	switch( _interpolation )
+	{
+		case eParamInterpolationTrilinear:
+			applyLut<trilinear_interpolation>( this->_dstView, this->_srcView, procWindowOutput );
+			return;
+		case eParamInterpolationTetrahedral:
+			applyLut<tetrahedral_interpolation>( this->_dstView, this->_srcView, procWindowOutput );
+			return;
+	}
+	BOOST_THROW_EXCEPTION( exception::Bug()
+		<< exception::user( "Unrecognized interpolation." ) );
 }
 
 template<class View>
+template<class Interpolation>
 void LutProcess<View>::applyLut( View& dst, View& src, const OfxRectI& procWindow )
 {
-	using namespace terry;
+	using namespace boost::gil;
 	typedef typename View::x_iterator vIterator;
-	typedef typename channel_type<View>::type Pixel;
+	const std::size_t nbChannels = num_channels<View>::value;
+	const std::size_t nbColors = std::min( nbChannels, std::size_t( 3 ) );
 	const OfxPointI procWindowSize = {
 		procWindow.x2 - procWindow.x1,
 		procWindow.y2 - procWindow.y1 };
+	std::vector<float> rgb( procWindowSize.x * 3 );
 
 	for( int y = procWindow.y1; y < procWindow.y2; ++y )
 	{
-		vIterator sit = src.row_begin( y );
-		vIterator dit = dst.row_begin( y );
-		for( int x = procWindow.x1; x < procWindow.x2; ++x )
+		vIterator sit = src.x_at( procWindow.x1, y );
+		float* it = &rgb.front();
+		for( int x = procWindow.x1; x < procWindow.x2; ++x, ++sit, it += 3 )
+		{
+			// gray images use the same value for the 3 inputs
+			for( std::size_t c = 0; c < 3; ++c )
+				it[c] = toLutInput( ( *sit )[ std::min( c, nbChannels - 1 ) ], is_integral_channel_t() );
+		}
+
+		terry::color::lut::transform_lut3d<Interpolation>( *_lut, &rgb.front(), 3, &rgb.front(), 3, procWindowSize.x );
+
+		vIterator dit = dst.x_at( procWindow.x1, y );
+		it = &rgb.front();
+		for( int x = procWindow.x1; x < procWindow.x2; ++x, ++dit, it += 3 )
 		{
-			tuttle::Color col = _lut3D->getColor( ( *sit )[0], ( *sit )[1], ( *sit )[2] );
-			( *dit )[0] = static_cast<Pixel>( col.x );
-			( *dit )[1] = static_cast<Pixel>( col.y );
-			( *dit )[2] = static_cast<Pixel>( col.z );
-			if( dst.num_channels() > 3 )
-				( *dit )[3] = channel_traits< typename channel_type< View >::type >::max_value();
-			++sit;
-			++dit;
+			for( std::size_t c = 0; c < nbColors; ++c )
+				( *dit )[c] = channel_convert<Channel>( bits32f( it[c] ) );
+			if( nbChannels > 3 )
+				( *dit )[3] = channel_traits<Channel>::max_value();
 		}
 		if( this->progressForward( procWindowSize.x ) )
 			return;
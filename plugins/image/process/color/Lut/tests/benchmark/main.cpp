@@ -0,0 +1,97 @@
+/**
+ * Compare the historical double precision Lut3D engine (virtual interpolator,
+ * one call per pixel) with the float batch engine used by the Lut plugin.
+ *
+ * usage: benchmark [nbPixels]
+ */
+#include "../../src/lutEngine/Lut.hpp"
+#include "../../src/lutEngine/TetraInterpolator.hpp"
+#include "../../src/lutEngine/TrilinInterpolator.hpp"
+
+#include <terry/color/lut/lut3d.hpp>
+#include <terry/color/lut/transform_lut3d.hpp>
+
+#include <boost/timer.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+namespace {
+
+/// Smooth non linear transform, to have a cube with different values on each node
+struct TestTransform
+{
+	void operator()( const double r, const double g, const double b, float* out ) const
+	{
+		out[0] = 0.8 * r * r + 0.1 * g + 0.1 * b;
+		out[1] = std::sqrt( 0.6 * g + 0.4 * r * b );
+		out[2] = 0.5 * ( b + std::sin( 1.5 * r * g ) / std::sin( 1.5 ) );
+	}
+};
+
+template<class Interpolation, class OldInterpolator>
+void run( const std::string& name, const std::size_t dimSize, const std::vector<float>& src )
+{
+	using namespace terry::color::lut;
+	const std::size_t nbPixels = src.size() / 3;
+
+	lut3d<3> lut;
+	lut.bake( TestTransform(), dimSize );
+	// the historical engine owns a copy of the lattice in double
+	double* data = new double[ dimSize * dimSize * dimSize * 3 ];
+	std::copy( lut.data(), lut.data() + dimSize * dimSize * dimSize * 3, data );
+	tuttle::Lut3D oldLut( new OldInterpolator(), dimSize, data );
+
+	std::vector<float> oldDst( src.size() );
+	boost::timer t;
+	for( std::size_t i = 0; i < nbPixels; ++i )
+	{
+		const tuttle::Color c = oldLut.getColor( src[i * 3], src[i * 3 + 1], src[i * 3 + 2] );
+		oldDst[i * 3]     = static_cast<float>( c.x );
+		oldDst[i * 3 + 1] = static_cast<float>( c.y );
+		oldDst[i * 3 + 2] = static_cast<float>( c.z );
+	}
+	const double oldTime = t.elapsed();
+
+	std::vector<float> newDst( src.size() );
+	t.restart();
+	transform_lut3d<Interpolation>( lut, &src.front(), 3, &newDst.front(), 3, nbPixels );
+	const double newTime = t.elapsed();
+
+	double maxError = 0.0;
+	for( std::size_t i = 0; i < src.size(); ++i )
+		maxError = std::max( maxError, double( std::abs( oldDst[i] - newDst[i] ) ) );
+
+	std::cout << std::setw( 12 ) << name << " " << dimSize << "^3 : "
+	          << "old " << std::setw( 7 ) << 1e9 * oldTime / nbPixels << " ns/px, "
+	          << "new " << std::setw( 7 ) << 1e9 * newTime / nbPixels << " ns/px, "
+	          << "speedup x" << ( newTime > 0.0 ? oldTime / newTime : 0.0 ) << ", "
+	          << "max diff " << maxError << std::endl;
+}
+
+}
+
+int main( int argc, char** argv )
+{
+	using namespace terry::color::lut;
+	const std::size_t nbPixels = argc > 1 ? boost::lexical_cast<std::size_t>( argv[1] ) : 4096 * 2160;
+
+	// inputs in [0, 1[, the historical engine reads outside of the cube for 1.0
+	std::vector<float> src( nbPixels * 3 );
+	std::srand( 42 );
+	for( std::vector<float>::iterator it = src.begin(), itEnd = src.end(); it != itEnd; ++it )
+		*it = std::rand() / ( RAND_MAX + 1.0f );
+
+	std::cout << nbPixels << " pixels" << std::endl;
+	const std::size_t sizes[] = { 33, 65 };
+	for( std::size_t i = 0; i < 2; ++i )
+	{
+		run<trilinear_interpolation, tuttle::TrilinInterpolator>( "trilinear", sizes[i], src );
+		run<tetrahedral_interpolation, tuttle::TetraInterpolator>( "tetrahedral", sizes[i], src );
+	}
+	return 0;
+}
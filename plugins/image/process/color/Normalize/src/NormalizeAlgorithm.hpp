@@ -7,12 +7,54 @@
 #include <terry/numeric/operations.hpp>
 #include <terry/numeric/assign.hpp>
 #include <terry/numeric/minmax.hpp>
-#include <terry/algorithm/transform_pixels_progress.hpp>
+#include <tuttle/plugin/MultiThreadLauncher.hpp>
 
 namespace tuttle {
 namespace plugin {
 namespace normalize {
 
+/**
+ * @brief Min and max of each channel of rows of a view,
+ *        models the terry::algorithm::parallel_reduce RowAccumulator concept.
+ */
+template<class View>
+struct MinMaxRowsAccumulator
+{
+	typedef terry::numeric::pixel_minmax_by_channel_t<typename View::value_type> MinMax;
+
+	View _view;
+	MinMax _minmax;
+	IProgress* _progress;
+
+	MinMaxRowsAccumulator( const View& view, IProgress& progress )
+	: _view( view )
+	, _minmax( view( 0, 0 ) )
+	, _progress( &progress )
+	{}
+
+	void operator()( const std::ptrdiff_t y )
+	{
+		typename View::x_iterator it = _view.row_begin( y );
+		for( std::ptrdiff_t x = 0; x < _view.width(); ++x, ++it )
+			_minmax( *it );
+		_progress->progressForward( _view.width() );
+	}
+
+	void merge( const MinMaxRowsAccumulator& next )
+	{
+		_minmax.merge( next._minmax );
+	}
+};
+
+/**
+ * @brief Min and max of each channel of a view, computed on all the threads.
+ */
+template<class View>
+terry::numeric::pixel_minmax_by_channel_t<typename View::value_type> analyseMinMax( const View& view, IProgress& p )
+{
+	return terry::algorithm::parallel_reduce_rows( view.height(), MinMaxRowsAccumulator<View>( view, p ), MultiThreadLauncher() )._minmax;
+}
+
 template< class View, typename LocalChannel >
 void analyseChannel( View& src, typename View::value_type& min, typename View::value_type& max, IProgress& p )
 {
@@ -22,11 +64,7 @@ void analyseChannel( View& src, typename View::value_type& min, typename View::v
 	
 	typedef channel_view_type<LocalChannel,View> LocalView;
 	typename LocalView::type localView( LocalView::make(src) );
-	pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax( localView(0,0) );
-	transform_pixels_progress(
-		localView,
-		minmax,
-		p );
+	pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax = analyseMinMax( localView, p );
 	static_fill( min, minmax.min[0] );
 	static_fill( max, minmax.max[0] );
 }
@@ -53,12 +91,7 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 	{
 		case eParamAnalyseModePerChannel:
 		{
-			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
-			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<Pixel> minmax = analyseMinMax( src, p );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -68,11 +101,7 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef pixel<typename channel_type<View>::type, gray_layout_t> PixelGray;
 			typedef typename color_converted_view_type<View, PixelGray>::type LocalView;
 			LocalView localView(src);
-			pixel_minmax_by_channel_t<typename LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<typename LocalView::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -81,11 +110,7 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 		{
 			typedef channel_view_type<red_t, View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -94,11 +119,7 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 		{
 			typedef channel_view_type<green_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -107,11 +128,7 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 		{
 			typedef channel_view_type<blue_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -120,11 +137,7 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 		{
 			typedef channel_view_type<alpha_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -145,12 +158,7 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 	{
 		case eParamAnalyseModePerChannel:
 		{
-			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
-			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				progress );
+			pixel_minmax_by_channel_t<Pixel> minmax = analyseMinMax( src, progress );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -160,11 +168,7 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef pixel<channel_type<rgb32f_view_t>::type, gray_layout_t> PixelGray;
 			typedef color_converted_view_type<rgb32f_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
-			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				progress );
+			pixel_minmax_by_channel_t<LocalView::value_type> minmax = analyseMinMax( localView, progress );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -173,11 +177,7 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 		{
 			typedef channel_view_type<red_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					progress );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, progress );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -186,11 +186,7 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 		{
 			typedef channel_view_type<green_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					progress );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, progress );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -199,11 +195,7 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 		{
 			typedef channel_view_type<blue_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					progress );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, progress );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -230,12 +222,7 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 	{
 		case eParamAnalyseModePerChannel:
 		{
-			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
-			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				progress );
+			pixel_minmax_by_channel_t<Pixel> minmax = analyseMinMax( src, progress );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -245,11 +232,7 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef pixel<channel_type<rgb16_view_t>::type, gray_layout_t> PixelGray;
 			typedef color_converted_view_type<rgb16_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
-			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				progress );
+			pixel_minmax_by_channel_t<LocalView::value_type> minmax = analyseMinMax( localView, progress );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -258,11 +241,7 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 		{
 			typedef channel_view_type<red_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					progress );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, progress );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -271,11 +250,7 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 		{
 			typedef channel_view_type<green_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					progress );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, progress );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -284,11 +259,7 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 		{
 			typedef channel_view_type<blue_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					progress );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, progress );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -315,12 +286,7 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 	{
 		case eParamAnalyseModePerChannel:
 		{
-			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
-			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<Pixel> minmax = analyseMinMax( src, p );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -330,11 +296,7 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef pixel<channel_type<rgb8_view_t>::type, gray_layout_t> PixelGray;
 			typedef color_converted_view_type<rgb8_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
-			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<LocalView::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -343,11 +305,7 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 		{
 			typedef channel_view_type<red_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -356,11 +314,7 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 		{
 			typedef channel_view_type<green_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -369,11 +323,7 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 		{
 			typedef channel_view_type<blue_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
-			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -400,12 +350,7 @@ void analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnal
 	{
 		case eParamAnalyseModePerChannel:
 		{
-			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
-			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<Pixel> minmax = analyseMinMax( src, p );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -415,11 +360,7 @@ void analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnal
 			typedef pixel<channel_type<gray32f_view_t>::type, gray_layout_t> PixelGray;
 			typedef color_converted_view_type<gray32f_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
-			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<LocalView::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -449,12 +390,7 @@ void analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnaly
 	{
 		case eParamAnalyseModePerChannel:
 		{
-			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
-			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<Pixel> minmax = analyseMinMax( src, p );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -464,11 +400,7 @@ void analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnaly
 			typedef pixel<channel_type<gray16_view_t>::type, gray_layout_t> PixelGray;
 			typedef color_converted_view_type<gray16_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
-			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<LocalView::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -498,12 +430,7 @@ void analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalys
 	{
 		case eParamAnalyseModePerChannel:
 		{
-			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
-			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<Pixel> minmax = analyseMinMax( src, p );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -513,11 +440,7 @@ void analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalys
 			typedef pixel<channel_type<gray8_view_t>::type, gray_layout_t> PixelGray;
 			typedef color_converted_view_type<gray8_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
-			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			pixel_minmax_by_channel_t<LocalView::value_type> minmax = analyseMinMax( localView, p );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -0,0 +1,118 @@
+#include "OCIOCache.hpp"
+#include "OCIOLut/OCIOLutDefinitions.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace ocio {
+
+bool OCIOCache::Key::operator<( const Key& other ) const
+{
+	if( _filename != other._filename )
+		return _filename < other._filename;
+	if( _mtime != other._mtime )
+		return _mtime < other._mtime;
+	return _options < other._options;
+}
+
+OCIOCache::Key OCIOCache::buildKey( const std::string& filename, const std::string& options )
+{
+	Key key;
+	key._filename = filename;
+	key._mtime = boost::filesystem::last_write_time( filename );
+	key._options = options;
+	return key;
+}
+
+template<class Map>
+void OCIOCache::removeOutdated( Map& map, const Key& key )
+{
+	for( typename Map::iterator it = map.begin(); it != map.end(); )
+	{
+		if( it->first._filename == key._filename && it->first._mtime != key._mtime )
+			map.erase( it++ );
+		else
+			++it;
+	}
+}
+
+OCIO::ConstConfigRcPtr OCIOCache::getConfig( const std::string& configFilename )
+{
+	const Key key = buildKey( configFilename, "" );
+
+	boost::mutex::scoped_lock lockerMap( _mutex );
+	std::map<Key, OCIO::ConstConfigRcPtr>::const_iterator it = _configs.find( key );
+	if( it != _configs.end() )
+		return it->second;
+
+	removeOutdated( _configs, key );
+	removeOutdated( _processors, key );
+	OCIO::ConstConfigRcPtr config = OCIO::Config::CreateFromFile( configFilename.c_str() );
+	_configs[key] = config;
+	return config;
+}
+
+OCIO::ConstProcessorRcPtr OCIOCache::getProcessor( const std::string& configFilename,
+                                                   const std::string& inputSpace,
+                                                   const std::string& outputSpace )
+{
+	const OCIO::ConstConfigRcPtr config = getConfig( configFilename );
+	const Key key = buildKey( configFilename, inputSpace + '\n' + outputSpace );
+
+	boost::mutex::scoped_lock lockerMap( _mutex );
+	std::map<Key, OCIO::ConstProcessorRcPtr>::const_iterator it = _processors.find( key );
+	if( it != _processors.end() )
+		return it->second;
+
+	OCIO::ConstProcessorRcPtr processor = config->getProcessor( inputSpace.c_str(), outputSpace.c_str() );
+	_processors[key] = processor;
+	return processor;
+}
+
+OCIO::ConstProcessorRcPtr OCIOCache::getFileProcessor( const std::string& lutFilename,
+                                                       const OCIO::Interpolation interpolation )
+{
+	using namespace ocio::lut;
+	const Key key = buildKey( lutFilename, boost::lexical_cast<std::string>( static_cast<int>( interpolation ) ) );
+
+	boost::mutex::scoped_lock lockerMap( _mutex );
+	std::map<Key, OCIO::ConstProcessorRcPtr>::const_iterator it = _processors.find( key );
+	if( it != _processors.end() )
+		return it->second;
+
+	removeOutdated( _processors, key );
+
+	OCIO::FileTransformRcPtr fileTransform = OCIO::FileTransform::Create();
+	fileTransform->setSrc( lutFilename.c_str() );
+	fileTransform->setInterpolation( interpolation );
+
+	//Add the file transform to the group, required by the transform process
+	OCIO::GroupTransformRcPtr groupTransform = OCIO::GroupTransform::Create();
+	groupTransform->push_back( fileTransform );
+
+	// Create the OCIO processor for the specified transform.
+	OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+	OCIO::ColorSpaceRcPtr inputColorSpace = OCIO::ColorSpace::Create();
+	inputColorSpace->setName( kOCIOInputspace.c_str() );
+	config->addColorSpace( inputColorSpace );
+
+	OCIO::ColorSpaceRcPtr outputColorSpace = OCIO::ColorSpace::Create();
+	outputColorSpace->setName( kOCIOOutputspace.c_str() );
+	outputColorSpace->setTransform( groupTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE );
+	config->addColorSpace( outputColorSpace );
+
+	TUTTLE_TLOG( TUTTLE_WARNING, "Specified Transform:" << *(groupTransform) );
+
+	OCIO::ConstProcessorRcPtr processor = config->getProcessor( kOCIOInputspace.c_str(), kOCIOOutputspace.c_str() );
+	_processors[key] = processor;
+	return processor;
+}
+
+}
+}
+}
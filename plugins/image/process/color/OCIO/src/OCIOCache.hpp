@@ -0,0 +1,71 @@
+#ifndef _TUTTLE_PLUGIN_OCIOCACHE_HPP_
+#define _TUTTLE_PLUGIN_OCIOCACHE_HPP_
+
+#include <tuttle/common/patterns/StaticSingleton.hpp>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include <ctime>
+#include <map>
+#include <string>
+
+namespace tuttle {
+namespace plugin {
+namespace ocio {
+
+namespace OCIO = OCIO_NAMESPACE;
+
+/**
+ * @brief Process-wide cache of OCIO configs and processors, shared by all
+ *        the OCIO nodes and all the render threads.
+ *
+ * Entries are keyed by the file path and its modification time, so an
+ * edited file is reloaded. OCIO processors are immutable and can be
+ * applied concurrently.
+ */
+class OCIOCache : public StaticSingleton<OCIOCache>
+{
+	MAKE_StaticSingleton( OCIOCache )
+
+public:
+	/// @brief Config loaded from an OCIO config file.
+	OCIO::ConstConfigRcPtr getConfig( const std::string& configFilename );
+
+	/// @brief Processor between two colorspaces of an OCIO config file.
+	OCIO::ConstProcessorRcPtr getProcessor( const std::string& configFilename,
+	                                        const std::string& inputSpace,
+	                                        const std::string& outputSpace );
+
+	/// @brief Processor applying a lut file (OCIO FileTransform).
+	OCIO::ConstProcessorRcPtr getFileProcessor( const std::string& lutFilename,
+	                                            const OCIO::Interpolation interpolation );
+
+private:
+	struct Key
+	{
+		std::string _filename;
+		std::time_t _mtime;
+		std::string _options; ///< colorspaces or interpolation
+
+		bool operator<( const Key& other ) const;
+	};
+
+	static Key buildKey( const std::string& filename, const std::string& options );
+
+	/// Remove the entries of an older version of the file
+	template<class Map>
+	static void removeOutdated( Map& map, const Key& key );
+
+private:
+	boost::mutex _mutex; ///< Mutex for all maps.
+	std::map<Key, OCIO::ConstConfigRcPtr> _configs;
+	std::map<Key, OCIO::ConstProcessorRcPtr> _processors;
+};
+
+}
+}
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "OCIOColorSpacePlugin.hpp"
 #include "OCIOColorSpaceProcess.hpp"
+#include "../OCIOCache.hpp"
 
 #include <tuttle/common/utils/color.hpp>
 
@@ -123,8 +124,9 @@ namespace tuttle
                   exception::FileNotExist( ) << exception::filename( str ));
             }
 
-          // Get the OCIO configuration processor.
-          params._config = OCIO::Config::CreateFromFile(str.c_str());
+          // Get the OCIO configuration, shared with the other nodes.
+          params._filename = str;
+          params._config = OCIOCache::instance().getConfig(str);
 
           int index;
           _paramInputSpace->getValue(index);
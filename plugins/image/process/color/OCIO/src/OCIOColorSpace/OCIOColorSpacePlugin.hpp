@@ -16,6 +16,7 @@ namespace tuttle
 
         struct OCIOColorSpaceProcessParams
         {
+          std::string _filename;
           OCIO_NAMESPACE::ConstConfigRcPtr _config;
           std::string _inputSpace;
           std::string _outputSpace;
@@ -1,6 +1,7 @@
 #include "OCIOColorSpacePluginFactory.hpp"
 #include "OCIOColorSpacePlugin.hpp"
 #include "OCIOColorSpaceDefinitions.hpp"
+#include "../OCIOCache.hpp"
 
 #include <tuttle/plugin/exceptions.hpp>
 
@@ -104,7 +105,7 @@ namespace tuttle
           //filename->setStringType(OFX::eStringTypeFilePath);
           filename->setDefault(file);
           //Add choices
-          OCIO::ConstConfigRcPtr config = OCIO::Config::CreateFromFile(file);
+          OCIO::ConstConfigRcPtr config = OCIOCache::instance().getConfig(file);
           for (int i = 0; i < config->getNumColorSpaces(); i++)
             {
               std::string csname = config->getColorSpaceNameByIndex(i);
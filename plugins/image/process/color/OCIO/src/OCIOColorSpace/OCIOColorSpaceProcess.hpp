@@ -35,7 +35,7 @@ namespace tuttle
             OCIOColorSpacePlugin& _plugin; ///< Rendering plugin
             OCIOColorSpaceProcessParams _params; ///< parameters
 
-            OCIO::ConstConfigRcPtr _config;
+            OCIO::ConstProcessorRcPtr _processor;
 
           public:
             OCIOColorSpaceProcess<View>(OCIOColorSpacePlugin & instance);
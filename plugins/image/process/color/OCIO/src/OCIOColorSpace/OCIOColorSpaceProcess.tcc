@@ -1,4 +1,5 @@
 #include "OCIOColorSpaceDefinitions.hpp"
+#include "../OCIOCache.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -34,11 +35,8 @@ void OCIOColorSpaceProcess<View>::setup(const OFX::RenderArguments& args)
 	
 	try
 	{
-		// Load the current config.
-		_config = _params._config;
-
-		// Try to load the processor
-		_config->getProcessor(  _params._inputSpace.c_str(),  _params._outputSpace.c_str() );
+		// Shared by all the render threads and the other nodes using the same config.
+		_processor = OCIOCache::instance().getProcessor( _params._filename, _params._inputSpace, _params._outputSpace );
 	}
 	catch(OCIO::Exception & exception)
 	{
@@ -72,42 +70,32 @@ void OCIOColorSpaceProcess<View>::multiThreadProcessImages(
 template<class View>
 void OCIOColorSpaceProcess<View>::applyLut(View& dst, View& src) {
 	using namespace boost::gil;
-	typedef typename View::x_iterator vIterator;
-	typedef typename channel_type<View>::type Pixel;
 
-	copy_pixels(src, dst);
+	if (is_planar<View>::value)
+	{
+		BOOST_THROW_EXCEPTION( exception::NotImplemented() );
+	}
+	// OCIO only applies in place
+	if( &src(0, 0) != &dst(0, 0) )
+		copy_pixels(src, dst);
 
 	try
 	{
-		OCIO::ConstProcessorRcPtr processor = _config->getProcessor( _params._inputSpace.c_str(), _params._outputSpace.c_str() );
-		
-		if (is_planar<View>::value)
-		{
-			BOOST_THROW_EXCEPTION( exception::NotImplemented() );
-		}
-		else
-		{
-			for (std::size_t y = 0; y < (unsigned int) dst.height(); ++y)
-			{
-				// Wrap the image in a light-weight ImageDescription
-				OCIO::PackedImageDesc imageDesc((float*) &(dst(0, y)[0]),
-						dst.width(), 1, num_channels<View>::type::value,
-						OCIO::AutoStride, dst.pixels().pixel_size(),
-						dst.pixels().row_size());
-				// Apply the color transformation (in place)
-				// Need normalized values
-				processor->apply(imageDesc);
-				if (this->progressForward(dst.width()))
-					return;
-			}
-		}
-		
+		// Wrap the whole tile in a light-weight ImageDescription
+		OCIO::PackedImageDesc imageDesc((float*) &(dst(0, 0)[0]),
+				dst.width(), dst.height(), num_channels<View>::type::value,
+				OCIO::AutoStride, dst.pixels().pixel_size(),
+				dst.pixels().row_size());
+		// Apply the color transformation (in place)
+		// Need normalized values
+		_processor->apply(imageDesc);
 	}
 	catch( OCIO::Exception & exception )
 	{
 		BOOST_THROW_EXCEPTION( exception::Failed()
 			<< exception::user() + "OCIO: " + exception.what() ) ;
 	}
+	this->progressForward(dst.width() * dst.height());
 }
 
 }
@@ -1,4 +1,5 @@
 #include "OCIOLutDefinitions.hpp"
+#include "../OCIOCache.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -33,33 +34,8 @@ void OCIOLutProcess<View>::setup(const OFX::RenderArguments& args)
 	_params = _plugin.getProcessParams(args.renderScale);
 	
 	try {
-		fileTransform = OCIO::FileTransform::Create();
-		fileTransform->setSrc( _params._filename.c_str() );
-		fileTransform->setInterpolation( _params._interpolationType );
-	
-		//Add the file transform to the group, required by the transform process
-		groupTransform = OCIO::GroupTransform::Create();
-		groupTransform->push_back( fileTransform );
-	
-		// Create the OCIO processor for the specified transform.
-		config = OCIO::Config::Create();
-	
-		OCIO::ColorSpaceRcPtr inputColorSpace = OCIO::ColorSpace::Create();
-		inputColorSpace->setName( kOCIOInputspace.c_str() );
-		
-		config->addColorSpace( inputColorSpace );
-		
-		OCIO::ColorSpaceRcPtr outputColorSpace = OCIO::ColorSpace::Create();
-		outputColorSpace->setName( kOCIOOutputspace.c_str()) ;
-	
-		outputColorSpace->setTransform( groupTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE );
-	
-		TUTTLE_TLOG( TUTTLE_WARNING, "Specified Transform:" << *(groupTransform) );
-	
-		config->addColorSpace( outputColorSpace );
-		
-		// Try to load the processor
-		config->getProcessor( kOCIOInputspace.c_str(), kOCIOOutputspace.c_str() );
+		// Shared by all the render threads and the other nodes using the same lut file.
+		_processor = OCIOCache::instance().getFileProcessor( _params._filename, _params._interpolationType );
 	}
 	catch(OCIO::Exception & exception)
 	{
@@ -92,40 +68,31 @@ void OCIOLutProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowR
 template<class View>
 void OCIOLutProcess<View>::applyLut(View& dst, View& src) {
 	using namespace boost::gil;
-	typedef typename View::x_iterator vIterator;
-	typedef typename channel_type<View>::type Pixel;
 
-	copy_pixels(src, dst);
+	if (is_planar<View>::value)
+	{
+		BOOST_THROW_EXCEPTION( exception::NotImplemented() );
+	}
+	// OCIO only applies in place
+	if( &src(0, 0) != &dst(0, 0) )
+		copy_pixels(src, dst);
 
 	try
 	{
-		OCIO::ConstProcessorRcPtr processor = config->getProcessor( kOCIOInputspace.c_str(), kOCIOOutputspace.c_str() );
-		
-		if (is_planar<View>::value)
-		{
-			BOOST_THROW_EXCEPTION( exception::NotImplemented() );
-		}
-		else
-		{
-			for (std::size_t y = 0; y < (unsigned int) dst.height(); ++y)
-			{
-				// Wrap the image in a light-weight ImageDescription
-				OCIO::PackedImageDesc imageDesc((float*) &(dst(0, y)[0]),
-						dst.width(), 1, num_channels<View>::type::value,
-						OCIO::AutoStride, dst.pixels().pixel_size(),
-						dst.pixels().row_size());
-				// Apply the color transformation (in place)
-				// Need normalized values
-				processor->apply(imageDesc);
-				if (this->progressForward(dst.width()))
-					return;
-			}
-		}
+		// Wrap the whole tile in a light-weight ImageDescription
+		OCIO::PackedImageDesc imageDesc((float*) &(dst(0, 0)[0]),
+				dst.width(), dst.height(), num_channels<View>::type::value,
+				OCIO::AutoStride, dst.pixels().pixel_size(),
+				dst.pixels().row_size());
+		// Apply the color transformation (in place)
+		// Need normalized values
+		_processor->apply(imageDesc);
 	}
 	catch (OCIO::Exception & exception)
 	{
 		BOOST_THROW_EXCEPTION( exception::Failed() << exception::user() + "OCIO Error: " + exception.what() );
 	}
+	this->progressForward(dst.width() * dst.height());
 }
 
 }
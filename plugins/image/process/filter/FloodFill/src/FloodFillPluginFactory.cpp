@@ -34,6 +34,8 @@ void FloodFillPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	// the mattes are mostly empty or full
+	desc.setSparseOutput( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
@@ -34,6 +34,8 @@ void ThinningPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	// the thin lines leave most of the image empty
+	desc.setSparseOutput( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
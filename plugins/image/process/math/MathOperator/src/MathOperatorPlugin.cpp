@@ -2,7 +2,12 @@
 #include "MathOperatorProcess.hpp"
 #include "MathOperatorDefinitions.hpp"
 
+#include <tuttle/plugin/constantImage.hpp>
+
 #include <boost/gil/gil_all.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <cmath>
 
 namespace tuttle {
 namespace plugin {
@@ -169,12 +174,86 @@ bool MathOperatorPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip
 	return false;
 }
 
+namespace {
+
+float applyMathOperator( const EMathOperatorMathOperator op, const float v, const float value )
+{
+	switch( op )
+	{
+		case eMathOperatorOperatorPlus     : return v + value;
+		case eMathOperatorOperatorMultiply : return v * value;
+		case eMathOperatorOperatorPow      : return std::pow( v, value );
+		case eMathOperatorOperatorSqrt     : return std::sqrt( v );
+		case eMathOperatorOperatorLog      : return std::log10( v );
+		case eMathOperatorOperatorLn       : return std::log( v );
+	}
+	return v;
+}
+
+}
+
+/**
+ * @brief Apply the operator on the color of a constant RGBA source, the output
+ *        is set as a constant image.
+ *
+ * The operator is applied on one pixel with the conversions of the process,
+ * so the output has the same values as a rendered image.
+ * @return false if the output needs to be rendered
+ */
+template<class View>
+bool MathOperatorPlugin::renderConstantImage( const OFX::RenderArguments& args )
+{
+	typedef typename View::value_type Pixel;
+	if( _clipDst->getPixelComponents() != OFX::ePixelComponentRGBA )
+		return false;
+	boost::scoped_ptr<OFX::Image> src( _clipSrc->fetchImage( args.time ) );
+	boost::scoped_ptr<OFX::Image> dst( _clipDst->fetchImage( args.time ) );
+	if( ! dst.get() ||
+	    ! isConstantOver( src.get(), *dst ) ||
+	    ! isRenderingAllImage( *dst, args.renderWindow ) ||
+	    src->getPixelComponents() != OFX::ePixelComponentRGBA )
+		return false;
+
+	const MathOperatorProcessParams<Scalar> params = getProcessParams();
+	boost::gil::rgba32f_pixel_t wpix;
+	color_convert( constantColorToPixel<Pixel>( src->getConstantColor() ), wpix );
+	if( params.bRProcess )
+		wpix[0] = applyMathOperator( params.op, wpix[0], params.iRMathOperator );
+	if( params.bGProcess )
+		wpix[1] = applyMathOperator( params.op, wpix[1], params.iGMathOperator );
+	if( params.bBProcess )
+		wpix[2] = applyMathOperator( params.op, wpix[2], params.iBMathOperator );
+	if( params.bAProcess )
+		wpix[3] = applyMathOperator( params.op, wpix[3], params.iAMathOperator );
+	Pixel result;
+	color_convert( wpix, result );
+	return dst->setConstantColor( pixelToConstantColor( result ) );
+}
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
  */
 void MathOperatorPlugin::render( const OFX::RenderArguments &args )
 {
+	bool constant = false;
+	switch( _clipDst->getPixelDepth() )
+	{
+		case OFX::eBitDepthUByte:
+			constant = renderConstantImage<boost::gil::rgba8_view_t>( args );
+			break;
+		case OFX::eBitDepthUShort:
+			constant = renderConstantImage<boost::gil::rgba16_view_t>( args );
+			break;
+		case OFX::eBitDepthFloat:
+			constant = renderConstantImage<boost::gil::rgba32f_view_t>( args );
+			break;
+		default:
+			break;
+	}
+	if( constant )
+		return;
+
 	doGilRender<MathOperatorProcess>( *this, args );
 }
 
@@ -66,6 +66,8 @@ private:
 	EMathOperatorType getMathOperatorType() const { return static_cast<EMathOperatorType>( _mathOperatorType->getValue() ); }
 	
 	void updateInterface();
+	template<class View>
+	bool renderConstantImage( const OFX::RenderArguments& args );
 	
 };
 
@@ -2,7 +2,10 @@
 #include "FadeProcess.hpp"
 #include "FadeDefinitions.hpp"
 
+#include <tuttle/plugin/constantImage.hpp>
+
 #include <boost/gil/gil_all.hpp>
+#include <boost/scoped_ptr.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -77,12 +80,82 @@ bool FadePlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& ident
 	return false;
 }
 
+/**
+ * @brief Fade constant RGBA sources (or fade completely to the color),
+ *        the output is set as a constant image.
+ *
+ * The color is computed on one pixel with the functors of the process,
+ * so the output has the same values as a rendered image.
+ * @return false if the output needs to be rendered
+ */
+template<class View>
+bool FadePlugin::renderConstantImage( const OFX::RenderArguments& args )
+{
+	typedef typename View::value_type Pixel;
+	if( _clipDst->getPixelComponents() != OFX::ePixelComponentRGBA )
+		return false;
+	boost::scoped_ptr<OFX::Image> dst( _clipDst->fetchImage( args.time ) );
+	if( ! dst.get() || ! isRenderingAllImage( *dst, args.renderWindow ) )
+		return false;
+
+	const FadeProcessParams params = getProcessParams();
+	const bool fromConnected = _clipSrcFrom->isConnected();
+	const bool toConnected = _clipSrcTo->isConnected();
+
+	Pixel color;
+	color_convert( params._color, color );
+	Pixel result = color;
+	if( fromConnected && toConnected )
+	{
+		boost::scoped_ptr<OFX::Image> srcA( _clipSrcFrom->fetchImage( args.time ) );
+		boost::scoped_ptr<OFX::Image> srcB( _clipSrcTo->fetchImage( args.time ) );
+		if( ! isConstantOver( srcA.get(), *dst ) || ! isConstantOver( srcB.get(), *dst ) ||
+		    srcA->getPixelComponents() != OFX::ePixelComponentRGBA ||
+		    srcB->getPixelComponents() != OFX::ePixelComponentRGBA )
+			return false;
+		Pixel pixelA = constantColorToPixel<Pixel>( srcA->getConstantColor() );
+		Pixel pixelB = constantColorToPixel<Pixel>( srcB->getConstantColor() );
+		const View viewA = boost::gil::interleaved_view( 1, 1, &pixelA, sizeof( Pixel ) );
+		const View viewB = boost::gil::interleaved_view( 1, 1, &pixelB, sizeof( Pixel ) );
+		View viewDst = boost::gil::interleaved_view( 1, 1, &result, sizeof( Pixel ) );
+		terry::merge_views( viewA, viewB, viewDst, FunctorFade<Pixel>( params._transition ) );
+	}
+	else if( ( fromConnected || toConnected ) && params._transition != 1.0 )
+	{
+		// only one input clip connected: fade to color
+		boost::scoped_ptr<OFX::Image> src( ( fromConnected ? _clipSrcFrom : _clipSrcTo )->fetchImage( args.time ) );
+		if( ! isConstantOver( src.get(), *dst ) ||
+		    src->getPixelComponents() != OFX::ePixelComponentRGBA )
+			return false;
+		result = FunctorFadeToColor<Pixel>( color, params._transition )( constantColorToPixel<Pixel>( src->getConstantColor() ) );
+	}
+	return dst->setConstantColor( pixelToConstantColor( result ) );
+}
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
  */
 void FadePlugin::render( const OFX::RenderArguments &args )
 {
+	bool constant = false;
+	switch( _clipDst->getPixelDepth() )
+	{
+		case OFX::eBitDepthUByte:
+			constant = renderConstantImage<boost::gil::rgba8_view_t>( args );
+			break;
+		case OFX::eBitDepthUShort:
+			constant = renderConstantImage<boost::gil::rgba16_view_t>( args );
+			break;
+		case OFX::eBitDepthFloat:
+			constant = renderConstantImage<boost::gil::rgba32f_view_t>( args );
+			break;
+		default:
+			break;
+	}
+	if( constant )
+		return;
+
 	doGilRender<FadeProcess>( *this, args );
 }
 
@@ -35,6 +35,10 @@ public:
 	bool isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime );
 
     void render( const OFX::RenderArguments &args );
+
+private:
+	template<class View>
+	bool renderConstantImage( const OFX::RenderArguments& args );
 	
 public:
     OFX::Clip* _clipDst; ///< Destination image clip
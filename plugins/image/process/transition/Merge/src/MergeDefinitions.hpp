@@ -30,6 +30,18 @@ enum EParamRod
 	eParamRodB
 };
 
+// Merge stack: "B" is the background, "A1" to "A<kMaxNbLayers>" are
+// composited over it in order.
+static const std::string kClipLayerPrefix    = "A";
+static const std::size_t kMaxNbLayers        = 15;
+
+enum EParamStackRod
+{
+	eParamStackRodIntersect = 0,
+	eParamStackRodUnion,
+	eParamStackRodB
+};
+
 // Plugin internal data
 
 enum EParamMerge
@@ -0,0 +1,210 @@
+#ifndef _TUTTLE_PLUGIN_MERGE_FUNCTIONS_HPP_
+#define _TUTTLE_PLUGIN_MERGE_FUNCTIONS_HPP_
+
+#include "MergeDefinitions.hpp"
+
+#include <terry/merge/MergeFunctors.hpp>
+
+#include <ofxsImageEffect.h>
+
+namespace tuttle {
+namespace plugin {
+namespace merge {
+
+/**
+ * @brief Instantiate the plugin render function templated with the merging
+ *        functor selected by the user.
+ * @param[in] plugin  Plugin providing a template<View, Functor> render function
+ * @param[in] merge   Merging function
+ * @param[in] args    Rendering parameters
+ */
+template< class View, class Plugin >
+void renderMergeFunction( Plugin& plugin, const EParamMerge merge, const OFX::RenderArguments& args )
+{
+	using namespace terry;
+
+	switch( merge )
+	{
+		// Functions that need alpha
+		case eParamMergeATop:
+		{
+			plugin.template render< View, FunctorATop >( args );
+			break;
+		}
+		case eParamMergeColor:
+		{
+			plugin.template render< View, FunctorColor >( args );
+			break;
+		}
+		case eParamMergeConjointOver:
+		{
+			plugin.template render< View, FunctorConjointOver >( args );
+			break;
+		}
+		case eParamMergeColorBurn:
+		{
+			plugin.template render< View, FunctorColorBurn >( args );
+			break;
+		}
+		case eParamMergeColorDodge:
+		{
+			plugin.template render< View, FunctorColorDodge >( args );
+			break;
+		}
+		case eParamMergeDisjointOver:
+		{
+			plugin.template render< View, FunctorDisjointOver >( args );
+			break;
+		}
+		case eParamMergeIn:
+		{
+			plugin.template render< View, FunctorIn >( args );
+			break;
+		}
+		case eParamMergeMask:
+		{
+			plugin.template render< View, FunctorMask >( args );
+			break;
+		}
+		case eParamMergeMatte:
+		{
+			plugin.template render< View, FunctorMatte >( args );
+			break;
+		}
+		case eParamMergeOut:
+		{
+			plugin.template render< View, FunctorOut >( args );
+			break;
+		}
+		case eParamMergeOver:
+		{
+			plugin.template render< View, FunctorOver >( args );
+			break;
+		}
+		case eParamMergeStencil:
+		{
+			plugin.template render< View, FunctorStencil >( args );
+			break;
+		}
+		case eParamMergeUnder:
+		{
+			plugin.template render< View, FunctorUnder >( args );
+			break;
+		}
+		case eParamMergeXOR:
+		{
+			plugin.template render< View, FunctorXOR >( args );
+			break;
+		}
+		// Functions that doesn't need alpha
+		case eParamMergeAverage:
+		{
+			plugin.template render< View, FunctorAverage >( args );
+			break;
+		}
+		case eParamMergeCopy:
+		{
+			plugin.template render< View, FunctorCopy >( args );
+			break;
+		}
+		case eParamMergeDifference:
+		{
+			plugin.template render< View, FunctorDifference >( args );
+			break;
+		}
+		case eParamMergeDivide:
+		{
+			plugin.template render< View, FunctorDivide >( args );
+			break;
+		}
+		case eParamMergeExclusion:
+		{
+			plugin.template render< View, FunctorExclusion >( args );
+			break;
+		}
+		case eParamMergeFrom:
+		{
+			plugin.template render< View, FunctorFrom >( args );
+			break;
+		}
+		case eParamMergeGeometric:
+		{
+			plugin.template render< View, FunctorGeometric >( args );
+			break;
+		}
+		case eParamMergeHardLight:
+		{
+			plugin.template render< View, FunctorHardLight >( args );
+			break;
+		}
+		case eParamMergeHypot:
+		{
+			plugin.template render< View, FunctorHypot >( args );
+			break;
+		}
+		case eParamMergeLighten:
+		{
+			plugin.template render< View, FunctorLighten >( args );
+			break;
+		}
+		case eParamMergeDarken:
+		{
+			plugin.template render< View, FunctorDarken >( args );
+			break;
+		}
+		case eParamMergeMinus:
+		{
+			plugin.template render< View, FunctorMinus >( args );
+			break;
+		}
+		case eParamMergeMultiply:
+		{
+			plugin.template render< View, FunctorMultiply >( args );
+			break;
+		}
+		case eParamMergeOverlay:
+		{
+			plugin.template render< View, FunctorOverlay >( args );
+			break;
+		}
+		case eParamMergePlus:
+		{
+			plugin.template render< View, FunctorPlus >( args );
+			break;
+		}
+		case eParamMergeScreen:
+		{
+			plugin.template render< View, FunctorScreen >( args );
+			break;
+		}
+		case eParamMergePinLight:
+		{
+			plugin.template render< View, FunctorPinLight >( args );
+			break;
+		}
+		case eParamMergeReflect:
+		{
+			// Quadratic mode: reflect
+			plugin.template render< View, FunctorReflect >( args );
+			break;
+		}
+		case eParamMergeFreeze:
+		{
+			// Quadratic mode: freeze
+			plugin.template render< View, FunctorFreeze >( args );
+			break;
+		}
+		case eParamMergeInterpolated:
+		{
+			// Similar to average, but smoother (and a lot slower)...
+			plugin.template render< View, FunctorInterpolated >( args );
+			break;
+		}
+	}
+}
+
+}
+}
+}
+
+#endif
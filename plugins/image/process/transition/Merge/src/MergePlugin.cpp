@@ -1,12 +1,13 @@
 #include "MergePlugin.hpp"
 #include "MergeProcess.hpp"
 #include "MergeDefinitions.hpp"
-
-#include <terry/merge/MergeFunctors.hpp>
+#include "MergeFunctions.hpp"
 
 #include <tuttle/plugin/numeric/rectOp.hpp>
+#include <tuttle/plugin/constantImage.hpp>
 
 #include <boost/gil/gil_all.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/if.hpp>
@@ -190,220 +191,54 @@ void MergePlugin::render( const OFX::RenderArguments &args )
 template< class View >
 void MergePlugin::render( const OFX::RenderArguments& args )
 {
-	using namespace boost::gil;
-	using namespace terry;
+	const EParamMerge merge = static_cast<EParamMerge>( _paramMerge->getValue() );
+	renderMergeFunction<View>( *this, merge, args );
+}
+
+/**
+ * @brief Merge the colors of two constant sources, the output is set as a constant image.
+ * @return false if the output needs to be rendered
+ */
+template< class View, template <typename> class Functor >
+bool MergePlugin::renderConstantImage( const OFX::RenderArguments& args )
+{
 	typedef typename View::value_type Pixel;
-	EParamMerge merge = static_cast<EParamMerge>(_paramMerge->getValue());
 
-//	if( ! boost::gil::contains_color<Pixel, boost::gil::alpha_t>::value )
-//	{
-//		// Functions that need alpha
-//		switch( merge )
-//		{
-//			case eParamMergeATop:
-//			case eParamMergeColor:
-//			case eParamMergeConjointOver:
-//			case eParamMergeColorBurn:
-//			case eParamMergeColorDodge:
-//			case eParamMergeDisjointOver:
-//			case eParamMergeIn:
-//			case eParamMergeMask:
-//			case eParamMergeMatte:
-//			case eParamMergeOut:
-//			case eParamMergeOver:
-//			case eParamMergeStencil:
-//			case eParamMergeUnder:
-//			case eParamMergeXOR:
-//				TUTTLE_LOG_FATAL( "Need an alpha channel for this Merge operation." );
-//				return;
-//			default:
-//				break;
-//		}
-//	}
-	switch( merge )
-	{
-		// Functions that need alpha
-		case eParamMergeATop:
-		{
-			render< View, FunctorATop >( args );
-			break;
-		}
-		case eParamMergeColor:
-		{
-			render< View, FunctorColor >( args );
-			break;
-		}
-		case eParamMergeConjointOver:
-		{
-			render< View, FunctorConjointOver >( args );
-			break;
-		}
-		case eParamMergeColorBurn:
-		{
-			render< View, FunctorColorBurn >( args );
-			break;
-		}
-		case eParamMergeColorDodge:
-		{
-			render< View, FunctorColorDodge >( args );
-			break;
-		}
-		case eParamMergeDisjointOver:
-		{
-			render< View, FunctorDisjointOver >( args );
-			break;
-		}
-		case eParamMergeIn:
-		{
-			render< View, FunctorIn >( args );
-			break;
-		}
-		case eParamMergeMask:
-		{
-			render< View, FunctorMask >( args );
-			break;
-		}
-		case eParamMergeMatte:
-		{
-			render< View, FunctorMatte >( args );
-			break;
-		}
-		case eParamMergeOut:
-		{
-			render< View, FunctorOut >( args );
-			break;
-		}
-		case eParamMergeOver:
-		{
-			render< View, FunctorOver >( args );
-			break;
-		}
-		case eParamMergeStencil:
-		{
-			render< View, FunctorStencil >( args );
-			break;
-		}
-		case eParamMergeUnder:
-		{
-			render< View, FunctorUnder >( args );
-			break;
-		}
-		case eParamMergeXOR:
-		{
-			render< View, FunctorXOR >( args );
-			break;
-		}
-		// Functions that doesn't need alpha
-		case eParamMergeAverage:
-		{
-			render< View, FunctorAverage >( args );
-			break;
-		}
-		case eParamMergeCopy:
-		{
-			render< View, FunctorCopy >( args );
-			break;
-		}
-		case eParamMergeDifference:
-		{
-			render< View, FunctorDifference >( args );
-			break;
-		}
-		case eParamMergeDivide:
-		{
-			render< View, FunctorDivide >( args );
-			break;
-		}
-		case eParamMergeExclusion:
-		{
-			render< View, FunctorExclusion >( args );
-			break;
-		}
-		case eParamMergeFrom:
-		{
-			render< View, FunctorFrom >( args );
-			break;
-		}
-		case eParamMergeGeometric:
-		{
-			render< View, FunctorGeometric >( args );
-			break;
-		}
-		case eParamMergeHardLight:
-		{
-			render< View, FunctorHardLight >( args );
-			break;
-		}
-		case eParamMergeHypot:
-		{
-			render< View, FunctorHypot >( args );
-			break;
-		}
-		case eParamMergeLighten:
-		{
-			render< View, FunctorLighten >( args );
-			break;
-		}
-		case eParamMergeDarken:
-		{
-			render< View, FunctorDarken >( args );
-			break;
-		}
-		case eParamMergeMinus:
-		{
-			render< View, FunctorMinus >( args );
-			break;
-		}
-		case eParamMergeMultiply:
-		{
-			render< View, FunctorMultiply >( args );
-			break;
-		}
-		case eParamMergeOverlay:
-		{
-			render< View, FunctorOverlay >( args );
-			break;
-		}
-		case eParamMergePlus:
-		{
-			render< View, FunctorPlus >( args );
-			break;
-		}
-		case eParamMergeScreen:
-		{
-			render< View, FunctorScreen >( args );
-			break;
-		}
-		case eParamMergePinLight:
-		{
-			render< View, FunctorPinLight >( args );
-			break;
-		}
-		case eParamMergeReflect:
-		{
-			// Quadratic mode: reflect
-			render< View, FunctorReflect >( args );
-			break;
-		}
-		case eParamMergeFreeze:
-		{
-			// Quadratic mode: freeze
-			render< View, FunctorFreeze >( args );
-			break;
-		}
-		case eParamMergeInterpolated:
-		{
-			// Similar to average, but smoother (and a lot slower)...
-			render< View, FunctorInterpolated >( args );
-			break;
-		}
-	}
+	boost::scoped_ptr<OFX::Image> srcA( _clipSrcA->fetchImage( args.time ) );
+	boost::scoped_ptr<OFX::Image> srcB( _clipSrcB->fetchImage( args.time ) );
+	boost::scoped_ptr<OFX::Image> dst( _clipDst->fetchImage( args.time ) );
+	if( ! srcA.get() || ! srcB.get() || ! dst.get() ||
+	    ! srcA->isConstant() || ! srcB->isConstant() ||
+	    ! isRenderingAllImage( *dst, args.renderWindow ) ||
+	    srcA->getPixelComponents() != dst->getPixelComponents() ||
+	    srcB->getPixelComponents() != dst->getPixelComponents() )
+		return false;
+
+	// all the output pixels are merged if the two sources cover the output
+	const MergeProcessParams<Scalar> params = getProcessParams( args.renderScale );
+	const OfxRectI dstBounds = dst->getBounds();
+	if( ! rectangleAContainsB( translateRegion( srcA->getBounds(), params._offsetA ), dstBounds ) ||
+	    ! rectangleAContainsB( translateRegion( srcB->getBounds(), params._offsetB ), dstBounds ) )
+		return false;
+
+	Pixel pixelA = constantColorToPixel<Pixel>( srcA->getConstantColor() );
+	Pixel pixelB = constantColorToPixel<Pixel>( srcB->getConstantColor() );
+	Pixel pixelDst;
+	const View viewA = boost::gil::interleaved_view( 1, 1, &pixelA, sizeof( Pixel ) );
+	const View viewB = boost::gil::interleaved_view( 1, 1, &pixelB, sizeof( Pixel ) );
+	View viewDst = boost::gil::interleaved_view( 1, 1, &pixelDst, sizeof( Pixel ) );
+	terry::merge_views( viewA, viewB, viewDst, Functor<Pixel>() );
+
+	return dst->setConstantColor( pixelToConstantColor( pixelDst ) );
 }
 
 template< class View, template <typename> class Functor >
 void MergePlugin::render_if( const OFX::RenderArguments& args, boost::mpl::true_ )
 {
 	typedef typename View::value_type Pixel;
+	if( renderConstantImage<View, Functor>( args ) )
+		return;
+
 	MergeProcess<View, Functor<Pixel> > p( *this );
 	p.setupAndProcess( args );
 }
@@ -46,12 +46,17 @@ public:
 
 	void render( const OFX::RenderArguments& args );
 
+	/// Called by renderMergeFunction() with the selected merging functor
+	template< class View, template <typename> class Functor >
+	void render( const OFX::RenderArguments& args );
+
 private:
 	template< class View >
 	void render( const OFX::RenderArguments& args );
+
 	template< class View, template <typename> class Functor >
-	void render( const OFX::RenderArguments& args );
-	
+	bool renderConstantImage( const OFX::RenderArguments& args );
+
 	template< class View, template <typename> class Functor >
 	void render_if( const OFX::RenderArguments& args, boost::mpl::false_ );
 	template< class View, template <typename> class Functor >
@@ -10,6 +10,8 @@ namespace merge {
 static const bool kSupportTiles = false;
 mDeclarePluginFactory( MergePluginFactory, {}, {} );
 
+void defineMergeFunctionParam( OFX::ImageEffectDescriptor& desc );
+
 }
 }
 }
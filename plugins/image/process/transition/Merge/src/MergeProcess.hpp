@@ -31,6 +31,7 @@ protected:
 	boost::scoped_ptr<OFX::Image> _srcB;
 	OfxRectI _srcPixelRodA;
 	OfxRectI _srcPixelRodB;
+	bool _tiledA; ///< merge A tile by tile, without its dense pixels
 
 public:
 	MergeProcess( MergePlugin& instance );
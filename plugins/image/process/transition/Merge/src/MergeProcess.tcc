@@ -4,6 +4,7 @@
 
 #include <tuttle/plugin/numeric/rectOp.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
+#include <tuttle/plugin/imageTiles.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 
 #include <ofxsImageEffect.h>
@@ -15,6 +16,8 @@
 #include <boost/gil/extension/color/hsl.hpp>
 #include <boost/gil/gil_all.hpp>
 
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace merge {
@@ -23,6 +26,7 @@ template<class View, class Functor>
 MergeProcess<View, Functor>::MergeProcess( MergePlugin& instance )
 	: ImageGilProcessor<View>( instance, eImageOrientationIndependant )
 	, _plugin( instance )
+	, _tiledA( false )
 {}
 
 template<class View, class Functor>
@@ -47,7 +51,6 @@ void MergeProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 	{
 		_srcPixelRodA = _srcA->getRegionOfDefinition();
 	}
-	this->_srcViewA = this->getView( _srcA.get(), _srcPixelRodA );
 
 	// clip B
 	_srcB.reset( _plugin._clipSrcB->fetchImage( args.time ) );
@@ -67,6 +70,17 @@ void MergeProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 	}
 	this->_srcViewB = this->getView( _srcB.get(), _srcPixelRodB );
 
+	_params = _plugin.getProcessParams( args.renderScale );
+
+	// A matte kept in tiles by the host is not expanded, if the pixels of A are
+	// only needed on the intersection.
+	// B is fetched before, A is not tiled anymore if it is the same image.
+	_tiledA = _srcA->isTiled() &&
+	          rectangleAContainsB( _srcA->getBounds(), _srcPixelRodA ) &&
+	          ( _params._rod == eParamRodIntersect || _params._rod == eParamRodB );
+	if( ! _tiledA )
+		this->_srcViewA = this->getView( _srcA.get(), _srcPixelRodA );
+
 	// Make sure bit depths are the same
 	if( _srcA->getPixelDepth() != this->_dst->getPixelDepth() ||
 	    _srcB->getPixelDepth() != this->_dst->getPixelDepth() ||
@@ -75,8 +89,6 @@ void MergeProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 	{
 		BOOST_THROW_EXCEPTION( exception::BitDepthMismatch() );
 	}
-
-	_params = _plugin.getProcessParams( args.renderScale );
 }
 
 template <typename View, typename Value> GIL_FORCEINLINE 
@@ -224,6 +236,66 @@ void fillAroundIntersection(
 	copy_pixels( viewA, procWindowSrc, dstView, procWindowOutput );
 }
 
+/**
+ * @brief Merge the tiles of A (in the pixel coordinates of A) with B.
+ */
+template<class View, class Functor>
+struct MergeTileWithB
+{
+	typedef typename View::value_type Pixel;
+
+	View _srcViewB;
+	OfxRectI _srcRodB;
+	View _dstView;
+	OfxRectI _dstPixelRod;
+	OfxPointI _offsetA;
+
+	MergeTileWithB( const View& srcViewB, const OfxRectI& srcRodB, const View& dstView, const OfxRectI& dstPixelRod, const OfxPointI& offsetA )
+		: _srcViewB( srcViewB )
+		, _srcRodB( srcRodB )
+		, _dstView( dstView )
+		, _dstPixelRod( dstPixelRod )
+		, _offsetA( offsetA )
+	{}
+
+	/// populated tile
+	void operator()( const View& tileViewA, const OfxRectI& tileBoundsA )
+	{
+		using namespace terry;
+		const OfxRectI region = translateRegion( tileBoundsA, _offsetA );
+		View srcViewB = subimageB( region, 0, region.y2 - region.y1 );
+		View dstView = subimageDst( region, 0, region.y2 - region.y1 );
+		merge_views( tileViewA, srcViewB, dstView, Functor() );
+	}
+
+	/// empty or constant tile, merged row by row
+	void operator()( const Pixel& pixelA, const OfxRectI& tileBoundsA )
+	{
+		using namespace terry;
+		using namespace boost::gil;
+		const OfxRectI region = translateRegion( tileBoundsA, _offsetA );
+		const std::ptrdiff_t width = region.x2 - region.x1;
+		std::vector<Pixel> row( width, pixelA );
+		const View rowViewA = interleaved_view( width, 1, &row[0], width * sizeof( Pixel ) );
+		for( int y = 0; y < region.y2 - region.y1; ++y )
+		{
+			View srcViewB = subimageB( region, y, 1 );
+			View dstView = subimageDst( region, y, 1 );
+			merge_views( rowViewA, srcViewB, dstView, Functor() );
+		}
+	}
+
+private:
+	View subimageB( const OfxRectI& region, const int y, const int height ) const
+	{
+		return subimage_view( _srcViewB, region.x1 - _srcRodB.x1, region.y1 + y - _srcRodB.y1, region.x2 - region.x1, height );
+	}
+	View subimageDst( const OfxRectI& region, const int y, const int height ) const
+	{
+		return subimage_view( _dstView, region.x1 - _dstPixelRod.x1, region.y1 + y - _dstPixelRod.y1, region.x2 - region.x1, height );
+	}
+};
+
 /**
  * @brief Function called by rendering thread each time a process must be done.
  * @param[in] procWindowRoW  Processing window in RoW
@@ -286,6 +358,17 @@ void MergeProcess<View, Functor>::multiThreadProcessImages( const OfxRectI& proc
 		}
 	}
 
+	if( _tiledA )
+	{
+		const OfxPointI offsetA = { static_cast<int>( _params._offsetA.x ), static_cast<int>( _params._offsetA.y ) };
+		const OfxPointI invOffsetA = { -offsetA.x, -offsetA.y };
+		const OfxRectI procIntersectA = translateRegion( procIntersect, invOffsetA );
+		MergeTileWithB<View, Functor> mergeTile( this->_srcViewB, srcRodB, this->_dstView, this->_dstPixelRod, offsetA );
+		forEachPopulatedTile<View>( *_srcA, procIntersectA, mergeTile );
+		forEachConstantTile<Pixel>( *_srcA, procIntersectA, mergeTile );
+		return;
+	}
+
 	View srcViewA_inter = subimage_view(	this->_srcViewA,
 						procIntersect.x1 - srcRodA.x1,
 						procIntersect.y1 - srcRodA.y1,
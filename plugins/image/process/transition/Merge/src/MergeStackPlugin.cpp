@@ -0,0 +1,221 @@
+#include "MergeStackPlugin.hpp"
+#include "MergeStackProcess.hpp"
+#include "MergeDefinitions.hpp"
+#include "MergeFunctions.hpp"
+
+#include <tuttle/plugin/numeric/rectOp.hpp>
+
+#include <boost/gil/gil_all.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace merge {
+
+MergeStackPlugin::MergeStackPlugin( OfxImageEffectHandle handle )
+	: OFX::ImageEffect( handle )
+{
+	_clipSrcB = fetchClip( kParamSourceB );
+	for( std::size_t i = 1; i <= kMaxNbLayers; ++i )
+	{
+		_clipLayers.push_back( fetchClip( kClipLayerPrefix + boost::lexical_cast<std::string>( i ) ) );
+	}
+	_clipDst = fetchClip( kOfxImageEffectOutputClipName );
+
+	_paramMerge = fetchChoiceParam( kParamFunction );
+	_paramRod = fetchChoiceParam( kParamRod );
+}
+
+MergeStackProcessParams MergeStackPlugin::getProcessParams() const
+{
+	MergeStackProcessParams params;
+
+	params._rod = static_cast<EParamStackRod>( _paramRod->getValue() );
+
+	params._layers.push_back( _clipSrcB );
+	for( std::vector<OFX::Clip*>::const_iterator it = _clipLayers.begin(), itEnd = _clipLayers.end();
+	     it != itEnd;
+	     ++it )
+	{
+		if( (*it)->isConnected() )
+			params._layers.push_back( *it );
+	}
+	return params;
+}
+
+bool MergeStackPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
+{
+	MergeStackProcessParams params = getProcessParams();
+
+	rod = _clipSrcB->getCanonicalRod( args.time );
+	if( params._rod == eParamStackRodB )
+		return true;
+
+	for( std::vector<OFX::Clip*>::const_iterator it = params._layers.begin() + 1, itEnd = params._layers.end();
+	     it != itEnd;
+	     ++it )
+	{
+		const OfxRectD layerRod = (*it)->getCanonicalRod( args.time );
+		switch( params._rod )
+		{
+			case eParamStackRodIntersect:
+			{
+				rod = rectanglesIntersection( rod, layerRod );
+				break;
+			}
+			case eParamStackRodUnion:
+			{
+				rod = rectanglesBoundingBox( rod, layerRod );
+				break;
+			}
+			case eParamStackRodB:
+				break;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief The overridden render function
+ * @param[in]   args     Rendering parameters
+ */
+void MergeStackPlugin::render( const OFX::RenderArguments &args )
+{
+	using namespace boost::gil;
+	// instantiate the render code based on the pixel depth of the dst clip
+	OFX::EBitDepth bitDepth = _clipDst->getPixelDepth( );
+	OFX::EPixelComponent components = _clipDst->getPixelComponents( );
+
+	switch( components )
+	{
+		case OFX::ePixelComponentRGBA:
+		{
+			switch( bitDepth )
+			{
+				case OFX::eBitDepthUByte:
+				{
+					render<rgba8_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthUShort:
+				{
+					render<rgba16_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthFloat:
+				{
+					render<rgba32f_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthCustom:
+				case OFX::eBitDepthNone:
+				{
+					BOOST_THROW_EXCEPTION( exception::Unsupported()
+						<< exception::user() + "Bit depth (" + mapBitDepthEnumToString(bitDepth) + ") not recognized by the plugin." );
+				}
+			}
+		}
+		case OFX::ePixelComponentRGB:
+		{
+			switch( bitDepth )
+			{
+				case OFX::eBitDepthUByte:
+				{
+					render<rgb8_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthUShort:
+				{
+					render<rgb16_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthFloat:
+				{
+					render<rgb32f_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthCustom:
+				case OFX::eBitDepthNone:
+				{
+					BOOST_THROW_EXCEPTION( exception::Unsupported()
+						<< exception::user() + "Bit depth (" + mapBitDepthEnumToString(bitDepth) + ") not recognized by the plugin." );
+				}
+			}
+		}
+		case OFX::ePixelComponentAlpha:
+		{
+			switch( bitDepth )
+			{
+				case OFX::eBitDepthUByte :
+				{
+					render<gray8_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthUShort :
+				{
+					render<gray16_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthFloat :
+				{
+					render<gray32f_view_t>(args);
+					return;
+				}
+				case OFX::eBitDepthCustom:
+				case OFX::eBitDepthNone:
+				{
+					BOOST_THROW_EXCEPTION( exception::Unsupported()
+						<< exception::user() + "Bit depth (" + mapBitDepthEnumToString(bitDepth) + ") not recognized by the plugin." );
+				}
+			}
+		}
+		case OFX::ePixelComponentCustom:
+		case OFX::ePixelComponentNone:
+		{
+			BOOST_THROW_EXCEPTION( exception::Unsupported()
+				<< exception::user() + "Pixel components (" + mapPixelComponentEnumToString(components) + ") not supported by the plugin." );
+		}
+	}
+	BOOST_THROW_EXCEPTION( exception::Unknown() );
+}
+
+template< class View >
+void MergeStackPlugin::render( const OFX::RenderArguments& args )
+{
+	const EParamMerge merge = static_cast<EParamMerge>( _paramMerge->getValue() );
+	renderMergeFunction<View>( *this, merge, args );
+}
+
+template< class View, template <typename> class Functor >
+void MergeStackPlugin::render_if( const OFX::RenderArguments& args, boost::mpl::true_ )
+{
+	typedef typename View::value_type Pixel;
+	MergeStackProcess<View, Functor<Pixel> > p( *this );
+	p.setupAndProcess( args );
+}
+
+template< class View, template <typename> class Functor >
+void MergeStackPlugin::render_if( const OFX::RenderArguments& args, boost::mpl::false_ )
+{
+	BOOST_THROW_EXCEPTION( exception::Unsupported()
+		<< exception::user() + "Need an alpha channel for this Merge operation." );
+}
+
+template< class View, template <typename> class Functor >
+void MergeStackPlugin::render( const OFX::RenderArguments& args )
+{
+	typedef typename View::value_type Pixel;
+	typedef typename boost::gil::contains_color< typename View::value_type, boost::gil::alpha_t>::type has_alpha_t;
+	typedef typename boost::is_same<typename Functor<Pixel>::operating_mode_t, terry::merge_per_channel_with_alpha>::type merge_need_alpha_t;
+	typedef typename boost::mpl::if_<merge_need_alpha_t, has_alpha_t, boost::mpl::true_>::type render_condition_t;
+
+	render_if<View, Functor>( args, render_condition_t() );
+}
+
+}
+}
+}
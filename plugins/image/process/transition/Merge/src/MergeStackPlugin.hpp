@@ -0,0 +1,67 @@
+#ifndef _TUTTLE_PLUGIN_MERGESTACKPLUGIN_HPP_
+#define _TUTTLE_PLUGIN_MERGESTACKPLUGIN_HPP_
+
+#include "MergeDefinitions.hpp"
+
+#include <boost/gil/color_convert.hpp> // included first, to use the hack version
+#include <tuttle/plugin/ImageEffectGilPlugin.hpp>
+
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace merge {
+
+struct MergeStackProcessParams
+{
+	EParamStackRod _rod;
+	std::vector<OFX::Clip*> _layers; ///< connected clips, from the background to the top layer
+};
+
+/**
+ * @brief Merge a variable number of layers in a single pass.
+ *
+ * All the layers are merged with the same functor, from the bottom (B) to the top (A<n>).
+ */
+class MergeStackPlugin : public OFX::ImageEffect
+{
+public:
+	typedef float Scalar;
+
+public:
+	MergeStackPlugin( OfxImageEffectHandle handle );
+
+public:
+	MergeStackProcessParams getProcessParams() const;
+
+	bool getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod );
+
+	void render( const OFX::RenderArguments& args );
+
+	/// Called by renderMergeFunction() with the selected merging functor
+	template< class View, template <typename> class Functor >
+	void render( const OFX::RenderArguments& args );
+
+private:
+	template< class View >
+	void render( const OFX::RenderArguments& args );
+
+	template< class View, template <typename> class Functor >
+	void render_if( const OFX::RenderArguments& args, boost::mpl::false_ );
+	template< class View, template <typename> class Functor >
+	void render_if( const OFX::RenderArguments& args, boost::mpl::true_ );
+
+public:
+	OFX::Clip* _clipSrcB;                ///< Background clip
+	std::vector<OFX::Clip*> _clipLayers; ///< Optional layer clips A1, A2, ...
+	OFX::Clip* _clipDst;                 ///< Destination image clip
+
+	OFX::ChoiceParam* _paramMerge;   ///< Functor structure
+	OFX::ChoiceParam* _paramRod;
+};
+
+}
+}
+}
+
+#endif
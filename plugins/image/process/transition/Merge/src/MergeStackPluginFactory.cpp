@@ -0,0 +1,102 @@
+#include "MergeStackPluginFactory.hpp"
+#include "MergePluginFactory.hpp"
+#include "MergeStackPlugin.hpp"
+#include "MergeDefinitions.hpp"
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <ofxsImageEffect.h>
+#include <ofxsMultiThread.h>
+
+#include <boost/lexical_cast.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace merge {
+
+/**
+ * @brief Function called to describe the plugin main features.
+ * @param[in, out]   desc     Effect descriptor
+ */
+void MergeStackPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
+{
+	desc.setLabels( "TuttleMergeStack", "MergeStack",
+	                "Merge a stack of images" );
+	desc.setPluginGrouping( "tuttle/image/process/transition" );
+
+	desc.setDescription( "Clip merging\n"
+	                     "Plugin is used to merge a stack of clips in a single pass.\n"
+	                     "The layers A1, A2, ... are successively merged over the background B, "
+	                     "without any intermediate image.\n"
+	                     "Outside of the background, the stack is merged over transparent black." );
+
+	// add the supported contexts
+	desc.addSupportedContext( OFX::eContextGeneral );
+
+	// add supported pixel depths
+	desc.addSupportedBitDepth( OFX::eBitDepthUByte );
+	desc.addSupportedBitDepth( OFX::eBitDepthUShort );
+	desc.addSupportedBitDepth( OFX::eBitDepthFloat );
+
+	// plugin flags
+	desc.setSupportsTiles( kSupportTiles );
+	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
+}
+
+/**
+ * @brief Function called to describe the plugin controls and features.
+ * @param[in, out]   desc       Effect descriptor
+ * @param[in]        context    Application context
+ */
+void MergeStackPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
+                                                 OFX::EContext               context )
+{
+	OFX::ClipDescriptor* srcClipB = desc.defineClip( kParamSourceB );
+	srcClipB->addSupportedComponent( OFX::ePixelComponentRGBA );
+	srcClipB->addSupportedComponent( OFX::ePixelComponentRGB );
+	srcClipB->addSupportedComponent( OFX::ePixelComponentAlpha );
+	srcClipB->setSupportsTiles( kSupportTiles );
+	srcClipB->setOptional( false );
+
+	for( std::size_t i = 1; i <= kMaxNbLayers; ++i )
+	{
+		OFX::ClipDescriptor* srcClip = desc.defineClip( kClipLayerPrefix + boost::lexical_cast<std::string>( i ) );
+		srcClip->addSupportedComponent( OFX::ePixelComponentRGBA );
+		srcClip->addSupportedComponent( OFX::ePixelComponentRGB );
+		srcClip->addSupportedComponent( OFX::ePixelComponentAlpha );
+		srcClip->setSupportsTiles( kSupportTiles );
+		srcClip->setOptional( true );
+	}
+
+	// Create the mandated output clip
+	OFX::ClipDescriptor* dstClip = desc.defineClip( kOfxImageEffectOutputClipName );
+	dstClip->addSupportedComponent( OFX::ePixelComponentRGBA );
+	dstClip->addSupportedComponent( OFX::ePixelComponentRGB );
+	dstClip->addSupportedComponent( OFX::ePixelComponentAlpha );
+	dstClip->setSupportsTiles( kSupportTiles );
+
+	defineMergeFunctionParam( desc );
+
+	OFX::ChoiceParamDescriptor* rod = desc.defineChoiceParam( kParamRod );
+	rod->appendOption( kParamRodIntersect );
+	rod->appendOption( kParamRodUnion );
+	rod->appendOption( kParamRodB );
+	rod->setDefault( eParamStackRodB );
+}
+
+/**
+ * @brief Function called to create a plugin effect instance
+ * @param[in] handle  effect handle
+ * @param[in] context    Application context
+ * @return  plugin instance
+ */
+OFX::ImageEffect* MergeStackPluginFactory::createInstance( OfxImageEffectHandle handle,
+                                                           OFX::EContext        context )
+{
+	return new MergeStackPlugin( handle );
+}
+
+}
+}
+}
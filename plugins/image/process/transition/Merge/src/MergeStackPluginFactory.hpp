@@ -0,0 +1,16 @@
+#ifndef _TUTTLE_PLUGIN_MERGESTACKPLUGINFACTORY_HPP_
+#define _TUTTLE_PLUGIN_MERGESTACKPLUGINFACTORY_HPP_
+
+#include <ofxsImageEffect.h>
+
+namespace tuttle {
+namespace plugin {
+namespace merge {
+
+mDeclarePluginFactory( MergeStackPluginFactory, {}, {} );
+
+}
+}
+}
+
+#endif
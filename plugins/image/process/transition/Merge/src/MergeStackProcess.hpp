@@ -0,0 +1,58 @@
+#ifndef _TUTTLE_PLUGIN_MERGESTACK_PROCESS_HPP_
+#define _TUTTLE_PLUGIN_MERGESTACK_PROCESS_HPP_
+
+#include <tuttle/plugin/ImageGilProcessor.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace merge {
+
+/**
+ * @brief Merge stack process
+ *
+ * Each tile is processed row by row: the background row is copied into the
+ * destination, then every layer covering this row is merged over it in place.
+ * Layers which don't intersect the tile are skipped. Outside of the background,
+ * the destination is considered as transparent black.
+ */
+template<class View, class Functor>
+class MergeStackProcess : public ImageGilProcessor<View>
+{
+public:
+	typedef typename View::value_type Pixel;
+
+	struct Layer
+	{
+		View _view;        ///< Source view
+		OfxRectI _rod;     ///< Source pixel RoD
+	};
+
+protected:
+	MergeStackPlugin& _plugin; ///< Rendering plugin
+
+	MergeStackProcessParams _params;
+
+	boost::ptr_vector<OFX::Image> _srcs;
+	std::vector<Layer> _layers; ///< from the background to the top layer
+
+public:
+	MergeStackProcess( MergeStackPlugin& instance );
+
+	void setup( const OFX::RenderArguments& args );
+
+	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+};
+
+}
+}
+}
+
+#include "MergeStackProcess.tcc"
+
+#endif
@@ -0,0 +1,159 @@
+#include "MergeStackPlugin.hpp"
+#include "MergeDefinitions.hpp"
+#include <terry/merge/ViewsMerging.hpp>
+
+#include <tuttle/plugin/numeric/rectOp.hpp>
+#include <tuttle/plugin/ImageGilProcessor.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <ofxsImageEffect.h>
+#include <ofxsMultiThread.h>
+
+#include <terry/numeric/init.hpp>
+
+#include <boost/gil/gil_all.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace merge {
+
+template<class View, class Functor>
+MergeStackProcess<View, Functor>::MergeStackProcess( MergeStackPlugin& instance )
+	: ImageGilProcessor<View>( instance, eImageOrientationIndependant )
+	, _plugin( instance )
+{}
+
+template<class View, class Functor>
+void MergeStackProcess<View, Functor>::setup( const OFX::RenderArguments& args )
+{
+	ImageGilProcessor<View>::setup( args );
+
+	_params = _plugin.getProcessParams();
+
+	_layers.clear();
+	for( std::vector<OFX::Clip*>::const_iterator it = _params._layers.begin(), itEnd = _params._layers.end();
+	     it != itEnd;
+	     ++it )
+	{
+		OFX::Clip* clip = *it;
+		OFX::Image* src = clip->fetchImage( args.time );
+		if( !src )
+			BOOST_THROW_EXCEPTION( exception::ImageNotReady()
+				<< exception::dev() + "Error on clip " + quotes( clip->name() )
+				<< exception::time( args.time ) );
+		_srcs.push_back( src );
+		if( src->getRowDistanceBytes() == 0 )
+			BOOST_THROW_EXCEPTION( exception::WrongRowBytes()
+				<< exception::dev() + "Error on clip " + quotes( clip->name() )
+				<< exception::time( args.time ) );
+
+		// Make sure bit depths are the same
+		if( src->getPixelDepth() != this->_dst->getPixelDepth() ||
+		    src->getPixelComponents() != this->_dst->getPixelComponents() )
+		{
+			BOOST_THROW_EXCEPTION( exception::BitDepthMismatch()
+				<< exception::dev() + "Error on clip " + quotes( clip->name() ) );
+		}
+
+		Layer layer;
+		if( OFX::getImageEffectHostDescription()->hostName == "uk.co.thefoundry.nuke" )
+		{
+			// bug in nuke, getRegionOfDefinition() on OFX::Image returns bounds
+			layer._rod = clip->getPixelRod( args.time, args.renderScale );
+		}
+		else
+		{
+			layer._rod = src->getRegionOfDefinition();
+		}
+		layer._view = this->getView( src, layer._rod );
+		_layers.push_back( layer );
+	}
+}
+
+/**
+ * @brief Function called by rendering thread each time a process must be done.
+ * @param[in] procWindowRoW  Processing window in RoW
+ */
+template<class View, class Functor>
+void MergeStackProcess<View, Functor>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
+{
+	using namespace boost::gil;
+	using namespace terry;
+	using namespace terry::numeric;
+
+	const Layer& background = _layers.front();
+	const OfxRectI backgroundWindow = rectanglesIntersection( procWindowRoW, background._rod );
+
+	// Only keep the layers which contribute to this tile.
+	std::vector<const Layer*> layers;
+	std::vector<OfxRectI> layerWindows;
+	for( typename std::vector<Layer>::const_iterator it = _layers.begin() + 1, itEnd = _layers.end();
+	     it != itEnd;
+	     ++it )
+	{
+		const OfxRectI layerWindow = rectanglesIntersection( procWindowRoW, it->_rod );
+		if( layerWindow.x1 == layerWindow.x2 || layerWindow.y1 == layerWindow.y2 )
+			continue;
+		layers.push_back( &(*it) );
+		layerWindows.push_back( layerWindow );
+	}
+
+	Pixel pixelZero;
+	pixel_zeros_t<Pixel>()( pixelZero );
+
+	const std::ptrdiff_t width = procWindowRoW.x2 - procWindowRoW.x1;
+	for( int y = procWindowRoW.y1; y < procWindowRoW.y2; ++y )
+	{
+		View dstRow = subimage_view( this->_dstView,
+		                             procWindowRoW.x1 - this->_dstPixelRod.x1,
+		                             y - this->_dstPixelRod.y1,
+		                             width, 1 );
+
+		// background: copy inside its RoD, and only fill the parts outside of it.
+		if( y < backgroundWindow.y1 || y >= backgroundWindow.y2 ||
+		    backgroundWindow.x1 == backgroundWindow.x2 )
+		{
+			fill_pixels( dstRow, pixelZero );
+		}
+		else
+		{
+			const std::ptrdiff_t left = backgroundWindow.x1 - procWindowRoW.x1;
+			const std::ptrdiff_t right = procWindowRoW.x2 - backgroundWindow.x2;
+			const std::ptrdiff_t backgroundWidth = backgroundWindow.x2 - backgroundWindow.x1;
+			if( left )
+				fill_pixels( subimage_view( dstRow, 0, 0, left, 1 ), pixelZero );
+			if( right )
+				fill_pixels( subimage_view( dstRow, width - right, 0, right, 1 ), pixelZero );
+			copy_pixels( subimage_view( background._view,
+			                            backgroundWindow.x1 - background._rod.x1,
+			                            y - background._rod.y1,
+			                            backgroundWidth, 1 ),
+			             subimage_view( dstRow, left, 0, backgroundWidth, 1 ) );
+		}
+
+		// layers: merge in place over the result of the previous ones.
+		for( std::size_t i = 0; i < layers.size(); ++i )
+		{
+			const OfxRectI& layerWindow = layerWindows[i];
+			if( y < layerWindow.y1 || y >= layerWindow.y2 )
+				continue;
+			const Layer& layer = *layers[i];
+			const std::ptrdiff_t layerWidth = layerWindow.x2 - layerWindow.x1;
+			View srcLayer = subimage_view( layer._view,
+			                               layerWindow.x1 - layer._rod.x1,
+			                               y - layer._rod.y1,
+			                               layerWidth, 1 );
+			View dstLayer = subimage_view( dstRow,
+			                               layerWindow.x1 - procWindowRoW.x1, 0,
+			                               layerWidth, 1 );
+			merge_views( srcLayer, dstLayer, dstLayer, Functor() );
+		}
+
+		if( this->progressForward( width ) )
+			return;
+	}
+}
+
+}
+}
+}
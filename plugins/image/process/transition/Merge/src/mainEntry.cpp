@@ -3,6 +3,7 @@
 
 #include <tuttle/plugin/Plugin.hpp>
 #include "MergePluginFactory.hpp"
+#include "MergeStackPluginFactory.hpp"
 
 namespace OFX {
 namespace Plugin {
@@ -10,6 +11,7 @@ namespace Plugin {
 void getPluginIDs( OFX::PluginFactoryArray& ids )
 {
 	mAppendPluginFactory( ids, tuttle::plugin::merge::MergePluginFactory, "tuttle.merge" );
+	mAppendPluginFactory( ids, tuttle::plugin::merge::MergeStackPluginFactory, "tuttle.mergestack" );
 }
 
 }
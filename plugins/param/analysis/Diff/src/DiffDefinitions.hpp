@@ -16,16 +16,38 @@ static const std::string kMeasureFunctionLabel = "Quality mesure function";
 static const std::string kMeasureFunctionPSNR  = "psnr (Peak Signal to Noise Ratio)";
 static const std::string kMeasureFunctionMSE   = "mse (Mean Square Error)";
 static const std::string kMeasureFunctionSSIM  = "ssim (Structural SIMilarity)";
+static const std::string kMeasureFunctionMSSSIM = "ms-ssim (Multi-Scale Structural SIMilarity)";
 
 enum EMeasureFunction {
 	eMeasureFunctionMSE = 0,
 	eMeasureFunctionPSNR,
-	eMeasureFunctionSSIM
+	eMeasureFunctionSSIM,
+	eMeasureFunctionMSSSIM
 };
 
+static const std::string kOutputImage          = "outputImage";
+static const std::string kOutputImageLabel     = "Output image";
+
+static const std::string kOutputImageMeasure      = "measure (measure of each pixel)";
+static const std::string kOutputImageTileMaxError = "tile max error (max absolute difference of each tile)";
+
+enum EOutputImage {
+	eOutputImageMeasure = 0,
+	eOutputImageTileMaxError
+};
+
+static const std::string kTileSize             = "tileSize";
+static const std::string kTileSizeLabel        = "Tile size";
+
+static const std::string kComputeMaxError      = "computeMaxError";
+static const std::string kComputeMaxErrorLabel = "Compute max error";
+
 static const std::string kOutputQualityMesure  = "quality";
 static const std::string kOutputQualityMesureLabel  = "Quality";
 
+static const std::string kOutputMaxError       = "maxError";
+static const std::string kOutputMaxErrorLabel  = "Max error";
+
 
 }
 }
@@ -16,13 +16,20 @@ DiffPlugin::DiffPlugin( OfxImageEffectHandle handle )
 	_clipDst  = fetchClip( kOfxImageEffectOutputClipName );
 
 	_measureFunction = fetchChoiceParam ( kMeasureFunction );
+	_outputImage     = fetchChoiceParam ( kOutputImage );
+	_tileSize        = fetchIntParam( kTileSize );
+	_computeMaxError = fetchBooleanParam( kComputeMaxError );
 	_qualityMesure   = fetchRGBAParam( kOutputQualityMesure );
+	_maxError        = fetchRGBAParam( kOutputMaxError );
 }
 
 DiffProcessParams DiffPlugin::getProcessParams() const
 {
 	DiffProcessParams params;
 	params.measureFunction = static_cast<EMeasureFunction>( _measureFunction->getValue() );
+	params.outputImage     = static_cast<EOutputImage>( _outputImage->getValue() );
+	params.tileSize        = _tileSize->getValue();
+	params.computeMaxError = _computeMaxError->getValue();
 
 	return params;
 }
@@ -12,6 +12,9 @@ namespace quality {
 struct DiffProcessParams
 {
 	EMeasureFunction measureFunction;
+	EOutputImage     outputImage;
+	int              tileSize;
+	bool             computeMaxError;
 };
 
 /**
@@ -38,8 +41,12 @@ public:
 	OFX::Clip* _clipDst;                ///< Destination image clip
 
 	OFX::ChoiceParam* _measureFunction;
+	OFX::ChoiceParam* _outputImage;
+	OFX::IntParam*    _tileSize;
+	OFX::BooleanParam* _computeMaxError;
 
 	OFX::RGBAParam*   _qualityMesure;
+	OFX::RGBAParam*   _maxError;
 
 
 };
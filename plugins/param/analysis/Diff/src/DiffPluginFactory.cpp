@@ -4,6 +4,8 @@
 
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 
+#include <limits>
+
 namespace tuttle {
 namespace plugin {
 namespace quality {
@@ -67,14 +69,42 @@ void DiffPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	diffFunction->setLabel( kMeasureFunctionLabel );
 	diffFunction->appendOption( kMeasureFunctionMSE );
 	diffFunction->appendOption( kMeasureFunctionPSNR );
-//	diffFunction->appendOption( kMeasureFunctionSSIM );
+	diffFunction->appendOption( kMeasureFunctionSSIM );
+	diffFunction->appendOption( kMeasureFunctionMSSSIM );
 	diffFunction->setDefault( eMeasureFunctionPSNR );
 
+	OFX::ChoiceParamDescriptor* outputImage = desc.defineChoiceParam( kOutputImage );
+	assert( outputImage );
+	outputImage->setLabel( kOutputImageLabel );
+	outputImage->appendOption( kOutputImageMeasure );
+	outputImage->appendOption( kOutputImageTileMaxError );
+	outputImage->setDefault( eOutputImageMeasure );
+
+	OFX::IntParamDescriptor* tileSize = desc.defineIntParam( kTileSize );
+	assert( tileSize );
+	tileSize->setLabel( kTileSizeLabel );
+	tileSize->setHint( "Size of the tiles of the max error output image." );
+	tileSize->setDefault( 32 );
+	tileSize->setRange( 1, std::numeric_limits<int>::max() );
+	tileSize->setDisplayRange( 1, 256 );
+
+	OFX::BooleanParamDescriptor* computeMaxError = desc.defineBooleanParam( kComputeMaxError );
+	assert( computeMaxError );
+	computeMaxError->setLabel( kComputeMaxErrorLabel );
+	computeMaxError->setHint( "Compute the max error of each channel, always done with the tile max error output image." );
+	computeMaxError->setDefault( false );
+
 	OFX::RGBAParamDescriptor* outputQualityMesure = desc.defineRGBAParam( kOutputQualityMesure );
 	assert( outputQualityMesure );
 	outputQualityMesure->setLabel( kOutputQualityMesureLabel );
 	outputQualityMesure->setEvaluateOnChange( false );
 
+	OFX::RGBAParamDescriptor* outputMaxError = desc.defineRGBAParam( kOutputMaxError );
+	assert( outputMaxError );
+	outputMaxError->setLabel( kOutputMaxErrorLabel );
+	outputMaxError->setHint( "Max absolute difference of each channel, on values normalized between 0 and 1." );
+	outputMaxError->setEvaluateOnChange( false );
+
 }
 
 /**
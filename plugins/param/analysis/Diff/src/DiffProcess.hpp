@@ -40,6 +40,10 @@ public:
 	boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >mse( const SView& v1, const SView& v2, const SView& dst, bool outputIsPsnr = false );
 	template<class SView>
 	boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >psnr( const SView& v1, const SView& v2, const SView& dst );
+	template<class SView>
+	boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >ssim( const SView& v1, const SView& v2, const SView& dst, const bool multiScale, const bool outputIsMap );
+	template<class SView>
+	boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >tileMaxError( const SView& v1, const SView& v2, const SView& dst, const std::ptrdiff_t tileSize, const bool outputIsMap );
 };
 
 }
@@ -1,10 +1,15 @@
 #include "DiffPlugin.hpp"
+#include "SsimAlgorithm.hpp"
 
 #include <climits>
 
 #include <tuttle/plugin/numeric/rectOp.hpp>
+#include <tuttle/plugin/MultiThreadLauncher.hpp>
 #include <terry/globals.hpp>
 #include <terry/basic_colors.hpp>
+#include <terry/algorithm/parallel_reduce.hpp>
+
+#include <algorithm>
 
 namespace tuttle {
 namespace plugin {
@@ -15,6 +20,7 @@ DiffProcess<View>::DiffProcess( DiffPlugin& instance )
 	: ImageGilProcessor<View>( instance, eImageOrientationIndependant )
 	, _plugin( instance )
 {
+	// the measure is computed once on the whole image, mse() uses the threads
 	this->setNoMultiThreading();
 }
 
@@ -107,6 +113,7 @@ void DiffProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW
 				      procWindowSize.y );
 
 	rgba32f_pixel_t paramRgbaValue (0,0,0,0);
+	const bool outputIsMeasure = ( _params.outputImage == eOutputImageMeasure );
 
 	switch( _params.measureFunction )
 	{
@@ -116,15 +123,30 @@ void DiffProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW
 		case eMeasureFunctionPSNR:
 			color_convert( psnr( srcViewA, srcViewB, dstView ), paramRgbaValue );
 			break;
-		case eMeasureFunctionSSIM: break;
+		case eMeasureFunctionSSIM:
+			color_convert( ssim( srcViewA, srcViewB, dstView, false, outputIsMeasure ), paramRgbaValue );
+			break;
+		case eMeasureFunctionMSSSIM:
+			color_convert( ssim( srcViewA, srcViewB, dstView, true, outputIsMeasure ), paramRgbaValue );
+			break;
 	}
-
 	_plugin._qualityMesure->setValueAtTime( this->_renderArgs.time,
 						get_color( paramRgbaValue, red_t() ),
 						get_color( paramRgbaValue, green_t() ),
 						get_color( paramRgbaValue, blue_t() ),
-						get_color( paramRgbaValue, alpha_t() )
-						);
+						get_color( paramRgbaValue, alpha_t() ) );
+
+	// the tile max error output image also gives the max error
+	if( ! outputIsMeasure || _params.computeMaxError )
+	{
+		rgba32f_pixel_t maxErrorRgbaValue (0,0,0,0);
+		color_convert( tileMaxError( srcViewA, srcViewB, dstView, std::max( _params.tileSize, 1 ), ! outputIsMeasure ), maxErrorRgbaValue );
+		_plugin._maxError->setValueAtTime( this->_renderArgs.time,
+						   get_color( maxErrorRgbaValue, red_t() ),
+						   get_color( maxErrorRgbaValue, green_t() ),
+						   get_color( maxErrorRgbaValue, blue_t() ),
+						   get_color( maxErrorRgbaValue, alpha_t() ) );
+	}
 }
 
 
@@ -152,38 +174,52 @@ DiffProcess<View>::psnr( const SView& v1, const SView& v2, const SView& dst )
 	return psnr;
 }
 
-template<class View>
+/**
+ * @brief Writes the difference of rows of two views, and sums the squared
+ *        differences of each channel,
+ *        models the terry::algorithm::parallel_reduce RowAccumulator concept.
+ */
 template<class SView>
-boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
-DiffProcess<View>::mse( const SView& v1, const SView& v2, const SView& dst, bool outputIsPsnr )
+struct DiffRowsAccumulator
 {
-	using namespace terry;
 	typedef boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> > Pixel32F;
 	typedef typename boost::gil::channel_type<Pixel32F>::type Value32F;
-	typedef typename boost::gil::channel_type<typename SView::value_type>::type SValueType;
+	BOOST_STATIC_CONSTANT( int, nbChannels = boost::gil::num_channels<Pixel32F>::type::value );
 
-	Pixel32F veqm = get_black<Pixel32F>();
-	int w         = v1.width();
-	int h         = v1.height();
+	SView _v1;
+	SView _v2;
+	SView _dst;
+	bool _outputIsPsnr;
+	float _d2;
+	IProgress* _progress;
+	double _sum[nbChannels]; ///< in double, to keep the precision on big images
 
-	size_t d      = (size_t)( std::pow( 2.0, sizeof( SValueType ) * 8.0 ) ) - 1;
-	size_t d2     = d * d;
+	DiffRowsAccumulator( const SView& v1, const SView& v2, const SView& dst, const bool outputIsPsnr, const float d2, IProgress& progress )
+	: _v1( v1 )
+	, _v2( v2 )
+	, _dst( dst )
+	, _outputIsPsnr( outputIsPsnr )
+	, _d2( d2 )
+	, _progress( &progress )
+	{
+		std::fill( _sum, _sum + nbChannels, 0.0 );
+	}
 
-	for( typename SView::y_coord_t y = 0; y < h; ++y )
+	void operator()( const std::ptrdiff_t y )
 	{
-		typename SView::x_iterator itA = v1.row_begin( y );
-		typename SView::x_iterator itB = v2.row_begin( y );
-		typename SView::x_iterator itD = dst.row_begin( y );
+		typename SView::x_iterator itA = _v1.row_begin( y );
+		typename SView::x_iterator itB = _v2.row_begin( y );
+		typename SView::x_iterator itD = _dst.row_begin( y );
 
-		for( typename SView::x_coord_t x = 0; x < w; ++x )
+		for( typename SView::x_coord_t x = 0; x < _v1.width(); ++x )
 		{
-			for( int i = 0; i < boost::gil::num_channels<Pixel32F>::type::value; ++i )
+			for( int i = 0; i < nbChannels; ++i )
 			{
 				Value32F diff = ( Value32F ) std::abs( double( ( *itA )[i] - ( *itB )[i]) );
 
-				if( outputIsPsnr )
+				if( _outputIsPsnr )
 				{
-					float p = (float)d2 / diff;
+					float p = _d2 / diff;
 					if( p > std::numeric_limits<float>::epsilon( ) )
 						( *itD )[i] = Value32F( 10.0 * std::log10( p ) );
 					else
@@ -193,22 +229,260 @@ DiffProcess<View>::mse( const SView& v1, const SView& v2, const SView& dst, bool
 				{
 					( *itD )[i] = diff;
 				}
-				veqm[i]    += diff * diff;
+				_sum[i] += double( diff ) * diff;
 			}
 			++itA;
 			++itB;
 			++itD;
 		}
-		this->progressUpdate( (float)(y+1)/h );
+		_progress->progressForward( _v1.width() );
 	}
 
-	for( int i = 0; i < boost::gil::num_channels<Pixel32F>::type::value; ++i )
+	void merge( const DiffRowsAccumulator& next )
+	{
+		for( int i = 0; i < nbChannels; ++i )
+		{
+			_sum[i] += next._sum[i];
+		}
+	}
+};
+
+template<class View>
+template<class SView>
+boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
+DiffProcess<View>::mse( const SView& v1, const SView& v2, const SView& dst, bool outputIsPsnr )
+{
+	using namespace terry;
+	typedef DiffRowsAccumulator<SView> Accumulator;
+	typedef typename Accumulator::Pixel32F Pixel32F;
+	typedef typename boost::gil::channel_type<typename SView::value_type>::type SValueType;
+
+	Pixel32F veqm = get_black<Pixel32F>();
+	const std::size_t nbPixels = v1.width() * v1.height();
+
+	size_t d      = (size_t)( std::pow( 2.0, sizeof( SValueType ) * 8.0 ) ) - 1;
+	size_t d2     = d * d;
+
+	// the partial sums are merged pairwise, in the same order whatever the number of threads
+	const Accumulator acc = terry::algorithm::parallel_reduce_rows(
+		v1.height(), Accumulator( v1, v2, dst, outputIsPsnr, (float)d2, *this ), MultiThreadLauncher() );
+
+	for( int i = 0; i < Accumulator::nbChannels; ++i )
 	{
-		veqm[i] /= ( w * h );
+		veqm[i] = acc._sum[i] / nbPixels;
 	}
 	return veqm;
 }
 
+/**
+ * @brief Copy a channel of two views in planes of normalized float values.
+ */
+template<class SView>
+struct ExtractChannel
+{
+	const SView& _v1;
+	const SView& _v2;
+	const int _channel;
+	Plane& _x;
+	Plane& _y;
+
+	ExtractChannel( const SView& v1, const SView& v2, const int channel, Plane& x, Plane& y )
+	: _v1( v1 )
+	, _v2( v2 )
+	, _channel( channel )
+	, _x( x )
+	, _y( y )
+	{}
+
+	void operator()( const unsigned int threadId, const unsigned int nbThreads ) const
+	{
+		using namespace boost::gil;
+		std::ptrdiff_t yBegin, yEnd;
+		threadRows( _v1.height(), threadId, nbThreads, yBegin, yEnd );
+		for( std::ptrdiff_t y = yBegin; y < yEnd; ++y )
+		{
+			typename SView::x_iterator itA = _v1.row_begin( y );
+			typename SView::x_iterator itB = _v2.row_begin( y );
+			float* rowX = _x.row( y );
+			float* rowY = _y.row( y );
+			for( std::ptrdiff_t x = 0; x < _v1.width(); ++x, ++itA, ++itB )
+			{
+				rowX[x] = channel_convert<bits32f>( ( *itA )[_channel] );
+				rowY[x] = channel_convert<bits32f>( ( *itB )[_channel] );
+			}
+		}
+	}
+};
+
+/**
+ * @brief Copy a plane of normalized float values in a channel of a view.
+ */
+template<class SView>
+struct WriteChannel
+{
+	typedef typename boost::gil::channel_type<SView>::type Channel;
+
+	const Plane& _plane;
+	const int _channel;
+	const SView& _dst;
+
+	WriteChannel( const Plane& plane, const int channel, const SView& dst )
+	: _plane( plane )
+	, _channel( channel )
+	, _dst( dst )
+	{}
+
+	void operator()( const unsigned int threadId, const unsigned int nbThreads ) const
+	{
+		using namespace boost::gil;
+		std::ptrdiff_t yBegin, yEnd;
+		threadRows( _dst.height(), threadId, nbThreads, yBegin, yEnd );
+		for( std::ptrdiff_t y = yBegin; y < yEnd; ++y )
+		{
+			typename SView::x_iterator itD = _dst.row_begin( y );
+			const float* row = _plane.row( y );
+			for( std::ptrdiff_t x = 0; x < _dst.width(); ++x, ++itD )
+			{
+				const bits32f v = std::min( std::max( row[x], 0.0f ), 1.0f );
+				( *itD )[_channel] = channel_convert<Channel>( v );
+			}
+		}
+	}
+};
+
+/**
+ * @brief Max absolute difference of each tile of a row of tiles,
+ *        models the terry::algorithm::parallel_reduce RowAccumulator concept (a row is a row of tiles).
+ */
+template<class SView>
+struct TileMaxErrorAccumulator
+{
+	typedef typename boost::gil::channel_type<SView>::type Channel;
+	BOOST_STATIC_CONSTANT( int, nbChannels = boost::gil::num_channels<typename SView::value_type>::type::value );
+
+	SView _v1;
+	SView _v2;
+	SView _dst;
+	std::ptrdiff_t _tileSize;
+	bool _outputIsMap;
+	float _maxError[nbChannels];
+
+	TileMaxErrorAccumulator( const SView& v1, const SView& v2, const SView& dst, const std::ptrdiff_t tileSize, const bool outputIsMap )
+	: _v1( v1 )
+	, _v2( v2 )
+	, _dst( dst )
+	, _tileSize( tileSize )
+	, _outputIsMap( outputIsMap )
+	{
+		std::fill( _maxError, _maxError + nbChannels, 0.0f );
+	}
+
+	void operator()( const std::ptrdiff_t tileY )
+	{
+		using namespace boost::gil;
+		const std::ptrdiff_t yBegin = tileY * _tileSize;
+		const std::ptrdiff_t yEnd = std::min( yBegin + _tileSize, std::ptrdiff_t( _v1.height() ) );
+		for( std::ptrdiff_t xBegin = 0; xBegin < _v1.width(); xBegin += _tileSize )
+		{
+			const std::ptrdiff_t xEnd = std::min( xBegin + _tileSize, std::ptrdiff_t( _v1.width() ) );
+			float tileMax[nbChannels];
+			std::fill( tileMax, tileMax + nbChannels, 0.0f );
+			for( std::ptrdiff_t y = yBegin; y < yEnd; ++y )
+			{
+				typename SView::x_iterator itA = _v1.x_at( xBegin, y );
+				typename SView::x_iterator itB = _v2.x_at( xBegin, y );
+				for( std::ptrdiff_t x = xBegin; x < xEnd; ++x, ++itA, ++itB )
+				{
+					for( int i = 0; i < nbChannels; ++i )
+					{
+						const float diff = std::abs( channel_convert<bits32f>( ( *itA )[i] ) - channel_convert<bits32f>( ( *itB )[i] ) );
+						tileMax[i] = std::max( tileMax[i], diff );
+					}
+				}
+			}
+			for( int i = 0; i < nbChannels; ++i )
+				_maxError[i] = std::max( _maxError[i], tileMax[i] );
+
+			if( ! _outputIsMap )
+				continue;
+			for( std::ptrdiff_t y = yBegin; y < yEnd; ++y )
+			{
+				typename SView::x_iterator itD = _dst.x_at( xBegin, y );
+				for( std::ptrdiff_t x = xBegin; x < xEnd; ++x, ++itD )
+				{
+					for( int i = 0; i < nbChannels; ++i )
+						( *itD )[i] = channel_convert<Channel>( bits32f( tileMax[i] ) );
+				}
+			}
+		}
+	}
+
+	void merge( const TileMaxErrorAccumulator& next )
+	{
+		for( int i = 0; i < nbChannels; ++i )
+			_maxError[i] = std::max( _maxError[i], next._maxError[i] );
+	}
+};
+
+/**
+ * @brief SSIM (or MS-SSIM) of each channel, on normalized values.
+ * @param[in] outputIsMap write the SSIM of each pixel in @p dst
+ */
+template<class View>
+template<class SView>
+boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
+DiffProcess<View>::ssim( const SView& v1, const SView& v2, const SView& dst, const bool multiScale, const bool outputIsMap )
+{
+	using namespace terry;
+	typedef boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> > Pixel32F;
+	static const int nbChannels = boost::gil::num_channels<Pixel32F>::type::value;
+
+	Pixel32F result = get_black<Pixel32F>();
+	const MultiThreadLauncher launcher;
+	// one channel at a time, to limit the memory used by the windowed statistics
+	Plane x( v1.width(), v1.height() );
+	Plane y( v1.width(), v1.height() );
+	Plane map;
+	for( int i = 0; i < nbChannels; ++i )
+	{
+		launcher( terry::algorithm::thread_function_t( ExtractChannel<SView>( v1, v2, i, x, y ) ) );
+		Plane* outMap = outputIsMap ? &map : NULL;
+		if( multiScale )
+			result[i] = static_cast<float>( msSsim( x, y, outMap, launcher ) );
+		else
+			result[i] = static_cast<float>( quality::ssim( x, y, outMap, launcher )._ssim );
+		if( outputIsMap )
+			launcher( terry::algorithm::thread_function_t( WriteChannel<SView>( map, i, dst ) ) );
+
+		if( this->progressForward( v1.width() * v1.height() / nbChannels ) )
+			break;
+	}
+	return result;
+}
+
+/**
+ * @brief Max absolute difference of each channel, on normalized values.
+ * @param[in] outputIsMap fill each tile of @p dst with its max difference
+ */
+template<class View>
+template<class SView>
+boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> >
+DiffProcess<View>::tileMaxError( const SView& v1, const SView& v2, const SView& dst, const std::ptrdiff_t tileSize, const bool outputIsMap )
+{
+	typedef TileMaxErrorAccumulator<SView> Accumulator;
+	typedef boost::gil::pixel<boost::gil::bits32f, boost::gil::layout<typename boost::gil::color_space_type<SView>::type> > Pixel32F;
+
+	const std::ptrdiff_t nbTileRows = ( v1.height() + tileSize - 1 ) / tileSize;
+	// one tile row per block, the tiles are written by a single thread
+	const Accumulator acc = terry::algorithm::parallel_reduce_rows(
+		nbTileRows, Accumulator( v1, v2, dst, tileSize, outputIsMap ), MultiThreadLauncher(), 1 );
+
+	Pixel32F maxError;
+	for( int i = 0; i < Accumulator::nbChannels; ++i )
+		maxError[i] = acc._maxError[i];
+	return maxError;
+}
+
 }
 }
 }
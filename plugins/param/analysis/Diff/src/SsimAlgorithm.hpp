@@ -0,0 +1,295 @@
+#ifndef _TUTTLE_PLUGIN_DIFF_SSIMALGORITHM_HPP_
+#define _TUTTLE_PLUGIN_DIFF_SSIMALGORITHM_HPP_
+
+#include <terry/algorithm/parallel_reduce.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace quality {
+
+/**
+ * @brief Single channel float image, with values normalized in [0, 1].
+ */
+struct Plane
+{
+	std::ptrdiff_t _width;
+	std::ptrdiff_t _height;
+	std::vector<float> _pixels;
+
+	Plane()
+	: _width( 0 )
+	, _height( 0 )
+	{}
+
+	Plane( const std::ptrdiff_t width, const std::ptrdiff_t height )
+	: _width( width )
+	, _height( height )
+	, _pixels( width * height )
+	{}
+
+	float* row( const std::ptrdiff_t y ) { return &_pixels[y * _width]; }
+	const float* row( const std::ptrdiff_t y ) const { return &_pixels[y * _width]; }
+};
+
+/**
+ * @brief Rows processed by a thread, when the rows are split in contiguous parts.
+ */
+inline void threadRows( const std::ptrdiff_t height, const unsigned int threadId, const unsigned int nbThreads, std::ptrdiff_t& begin, std::ptrdiff_t& end )
+{
+	begin = height * threadId / nbThreads;
+	end   = height * ( threadId + 1 ) / nbThreads;
+}
+
+/**
+ * @brief Normalized gaussian kernel of 2 * radius + 1 values.
+ */
+inline std::vector<float> gaussianKernel( const double sigma, const int radius )
+{
+	std::vector<float> kernel( 2 * radius + 1 );
+	double sum = 0.0;
+	for( int i = -radius; i <= radius; ++i )
+	{
+		const double v = std::exp( -( i * i ) / ( 2.0 * sigma * sigma ) );
+		kernel[i + radius] = static_cast<float>( v );
+		sum += v;
+	}
+	for( std::size_t i = 0; i < kernel.size(); ++i )
+		kernel[i] = static_cast<float>( kernel[i] / sum );
+	return kernel;
+}
+
+/// Gaussian window of the SSIM (Wang et al. 2004): 11x11, sigma 1.5
+static const int kSsimWindowRadius = 5;
+static const double kSsimWindowSigma = 1.5;
+/// Stabilization constants of the SSIM for a dynamic range of 1: (0.01 * L)^2 and (0.03 * L)^2
+static const double kSsimC1 = 0.0001;
+static const double kSsimC2 = 0.0009;
+
+/// Mean SSIM and mean contrast-structure term of two planes.
+struct SsimResult
+{
+	double _ssim;
+	double _contrastStructure;
+};
+
+namespace detail {
+
+/// Number of windowed statistics: x, y, x^2, y^2, xy
+static const int kSsimNbMoments = 5;
+
+/**
+ * @brief Horizontal pass of the separable gaussian window, on the moments of two planes.
+ */
+struct SsimHorizontalPass
+{
+	const Plane& _x;
+	const Plane& _y;
+	const std::vector<float>& _kernel;
+	Plane* _moments; ///< kSsimNbMoments planes
+
+	SsimHorizontalPass( const Plane& x, const Plane& y, const std::vector<float>& kernel, Plane* moments )
+	: _x( x )
+	, _y( y )
+	, _kernel( kernel )
+	, _moments( moments )
+	{}
+
+	void operator()( const unsigned int threadId, const unsigned int nbThreads ) const
+	{
+		const std::ptrdiff_t width = _x._width;
+		const std::ptrdiff_t radius = _kernel.size() / 2;
+		std::ptrdiff_t yBegin, yEnd;
+		threadRows( _x._height, threadId, nbThreads, yBegin, yEnd );
+		for( std::ptrdiff_t y = yBegin; y < yEnd; ++y )
+		{
+			const float* rowX = _x.row( y );
+			const float* rowY = _y.row( y );
+			float* out[kSsimNbMoments];
+			for( int m = 0; m < kSsimNbMoments; ++m )
+				out[m] = _moments[m].row( y );
+
+			for( std::ptrdiff_t x = 0; x < width; ++x )
+			{
+				float s[kSsimNbMoments] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+				for( std::ptrdiff_t k = -radius; k <= radius; ++k )
+				{
+					// the borders are extended
+					const std::ptrdiff_t xi = std::min( std::max( x + k, std::ptrdiff_t( 0 ) ), width - 1 );
+					const float w = _kernel[k + radius];
+					const float a = rowX[xi];
+					const float b = rowY[xi];
+					s[0] += w * a;
+					s[1] += w * b;
+					s[2] += w * a * a;
+					s[3] += w * b * b;
+					s[4] += w * a * b;
+				}
+				for( int m = 0; m < kSsimNbMoments; ++m )
+					out[m][x] = s[m];
+			}
+		}
+	}
+};
+
+/**
+ * @brief Vertical pass of the separable gaussian window and SSIM of each pixel,
+ *        models the terry::algorithm::parallel_reduce RowAccumulator concept.
+ */
+struct SsimRowsAccumulator
+{
+	const Plane* _moments; ///< kSsimNbMoments planes, filtered horizontally
+	const std::vector<float>* _kernel;
+	Plane* _map; ///< SSIM of each pixel, or NULL
+	double _ssimSum;
+	double _contrastStructureSum;
+
+	SsimRowsAccumulator( const Plane* moments, const std::vector<float>& kernel, Plane* map )
+	: _moments( moments )
+	, _kernel( &kernel )
+	, _map( map )
+	, _ssimSum( 0.0 )
+	, _contrastStructureSum( 0.0 )
+	{}
+
+	void operator()( const std::ptrdiff_t y )
+	{
+		const std::ptrdiff_t width = _moments[0]._width;
+		const std::ptrdiff_t height = _moments[0]._height;
+		const std::ptrdiff_t radius = _kernel->size() / 2;
+
+		for( std::ptrdiff_t x = 0; x < width; ++x )
+		{
+			double s[kSsimNbMoments] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+			for( std::ptrdiff_t k = -radius; k <= radius; ++k )
+			{
+				const std::ptrdiff_t yi = std::min( std::max( y + k, std::ptrdiff_t( 0 ) ), height - 1 );
+				const double w = ( *_kernel )[k + radius];
+				for( int m = 0; m < kSsimNbMoments; ++m )
+					s[m] += w * _moments[m].row( yi )[x];
+			}
+			const double muX = s[0];
+			const double muY = s[1];
+			const double sigmaX2 = s[2] - muX * muX;
+			const double sigmaY2 = s[3] - muY * muY;
+			const double sigmaXY = s[4] - muX * muY;
+
+			const double luminance = ( 2.0 * muX * muY + kSsimC1 ) / ( muX * muX + muY * muY + kSsimC1 );
+			const double contrastStructure = ( 2.0 * sigmaXY + kSsimC2 ) / ( sigmaX2 + sigmaY2 + kSsimC2 );
+			const double ssim = luminance * contrastStructure;
+
+			_ssimSum += ssim;
+			_contrastStructureSum += contrastStructure;
+			if( _map )
+				_map->row( y )[x] = static_cast<float>( ssim );
+		}
+	}
+
+	void merge( const SsimRowsAccumulator& next )
+	{
+		_ssimSum += next._ssimSum;
+		_contrastStructureSum += next._contrastStructureSum;
+	}
+};
+
+/// @brief 2x2 box filter and decimation.
+inline Plane downsample( const Plane& src )
+{
+	Plane dst( src._width / 2, src._height / 2 );
+	for( std::ptrdiff_t y = 0; y < dst._height; ++y )
+	{
+		const float* r0 = src.row( 2 * y );
+		const float* r1 = src.row( 2 * y + 1 );
+		float* d = dst.row( y );
+		for( std::ptrdiff_t x = 0; x < dst._width; ++x )
+			d[x] = 0.25f * ( r0[2 * x] + r0[2 * x + 1] + r1[2 * x] + r1[2 * x + 1] );
+	}
+	return dst;
+}
+
+}
+
+/**
+ * @brief Structural similarity of two planes of the same size,
+ *        with a gaussian window computed in two separable passes on the threads of the launcher.
+ * @param[out] map SSIM of each pixel (optional)
+ */
+template<class Launcher>
+SsimResult ssim( const Plane& x, const Plane& y, Plane* map, Launcher launcher )
+{
+	SsimResult result = { 1.0, 1.0 };
+	const std::ptrdiff_t nbPixels = x._width * x._height;
+	if( nbPixels == 0 )
+		return result;
+
+	const std::vector<float> kernel = gaussianKernel( kSsimWindowSigma, kSsimWindowRadius );
+	std::vector<Plane> moments( detail::kSsimNbMoments, Plane( x._width, x._height ) );
+	launcher( terry::algorithm::thread_function_t( detail::SsimHorizontalPass( x, y, kernel, &moments[0] ) ) );
+
+	if( map )
+		*map = Plane( x._width, x._height );
+	const detail::SsimRowsAccumulator acc = terry::algorithm::parallel_reduce_rows(
+		x._height, detail::SsimRowsAccumulator( &moments[0], kernel, map ), launcher );
+
+	result._ssim = acc._ssimSum / nbPixels;
+	result._contrastStructure = acc._contrastStructureSum / nbPixels;
+	return result;
+}
+
+/**
+ * @brief Multi-scale structural similarity (Wang et al. 2003), on 5 scales.
+ *
+ * Small images use less scales (the smallest scale keeps the size of the window),
+ * the weights of the used scales are normalized.
+ * @param[out] map SSIM of each pixel at the first scale (optional)
+ */
+template<class Launcher>
+double msSsim( const Plane& x, const Plane& y, Plane* map, Launcher launcher )
+{
+	static const double weights[] = { 0.0448, 0.2856, 0.3001, 0.2363, 0.1333 };
+	static const int maxScales = sizeof( weights ) / sizeof( double );
+	const std::ptrdiff_t windowSize = 2 * kSsimWindowRadius + 1;
+
+	int nbScales = 1;
+	double weightsSum = weights[0];
+	for( std::ptrdiff_t size = std::min( x._width, x._height ) / 2; nbScales < maxScales && size >= windowSize; size /= 2 )
+	{
+		weightsSum += weights[nbScales];
+		++nbScales;
+	}
+
+	double result = 1.0;
+	Plane scaledX, scaledY;
+	const Plane* currentX = &x;
+	const Plane* currentY = &y;
+	for( int scale = 0; scale < nbScales; ++scale )
+	{
+		const SsimResult r = ssim( *currentX, *currentY, scale == 0 ? map : NULL, launcher );
+		// luminance only at the coarsest scale
+		const double value = ( scale == nbScales - 1 ) ? r._ssim : r._contrastStructure;
+		result *= std::pow( std::max( value, 0.0 ), weights[scale] / weightsSum );
+
+		if( scale + 1 < nbScales )
+		{
+			Plane nextX = detail::downsample( *currentX );
+			Plane nextY = detail::downsample( *currentY );
+			scaledX._pixels.swap( nextX._pixels );
+			scaledY._pixels.swap( nextY._pixels );
+			scaledX._width  = scaledY._width  = nextX._width;
+			scaledX._height = scaledY._height = nextX._height;
+			currentX = &scaledX;
+			currentY = &scaledY;
+		}
+	}
+	return result;
+}
+
+}
+}
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "ImageStatisticsPlugin.hpp"
 
 #include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/MultiThreadLauncher.hpp>
 #include <terry/globals.hpp>
 #include <tuttle/plugin/param/gilColor.hpp>
 #include <terry/typedefs.hpp>
@@ -13,6 +14,7 @@
 #include <terry/numeric/init.hpp>
 #include <terry/numeric/pow.hpp>
 #include <terry/numeric/sqrt.hpp>
+#include <terry/algorithm/parallel_reduce.hpp>
 #include <boost/gil/extension/color/hsl.hpp>
 
 #include <boost/units/pow.hpp>
@@ -194,125 +196,180 @@ struct OutputParams
 	Pixel _skewness;
 };
 
+/**
+ * @brief Sums of the powers of the pixels, channel and luminosity extrema,
+ *        models the terry::algorithm::parallel_reduce PixelAccumulator concept.
+ */
 template<class View, typename CType = boost::gil::bits64f>
-struct ComputeOutputParams
+struct StatisticsAccumulator
 {
-
 	typedef typename View::value_type Pixel;
 	typedef typename boost::gil::color_space_type<View>::type Colorspace;
 	typedef boost::gil::pixel<typename boost::gil::channel_type<View>::type, boost::gil::layout<boost::gil::gray_t> > PixelGray; // grayscale pixel type (using the input channel_type)
 	typedef boost::gil::pixel<CType, boost::gil::layout<Colorspace> > CPixel; // the pixel type use for computation (using input colorspace)
 
+	Pixel _channelMin;
+	Pixel _channelMax;
+	Pixel _luminosityMin;
+	PixelGray _luminosityMinGray;
+	Pixel _luminosityMax;
+	PixelGray _luminosityMaxGray;
+
+	CPixel _sum;
+	CPixel _sum_p2;
+	CPixel _sum_p3;
+	CPixel _sum_p4;
+
+	/// @param firstPixel for initialization only
+	explicit StatisticsAccumulator( const Pixel& firstPixel )
+	: _channelMin( firstPixel )
+	, _channelMax( firstPixel )
+	, _luminosityMin( firstPixel )
+	, _luminosityMax( firstPixel )
+	{
+		using namespace terry::numeric;
+		color_convert( firstPixel, _luminosityMinGray );
+		_luminosityMaxGray = _luminosityMinGray;
+		pixel_zeros_t<CPixel>( )( _sum );
+		pixel_zeros_t<CPixel>( )( _sum_p2 );
+		pixel_zeros_t<CPixel>( )( _sum_p3 );
+		pixel_zeros_t<CPixel>( )( _sum_p4 );
+	}
+
+	void operator()( const Pixel& src )
+	{
+		using namespace terry::numeric;
+		CPixel pix;
+		pixel_assigns_t<Pixel, CPixel>( )( src, pix ); // pix = src;
+
+		CPixel pix_p2;
+		CPixel pix_p3;
+		CPixel pix_p4;
+
+		pixel_assigns_t<CPixel, CPixel>( )( pixel_pow_t<CPixel, 2>( )( pix ), pix_p2 ); // pix_p2 = pow<2>( pix );
+		pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix, pix_p2 ), pix_p3 ); // pix_p3 = pix * pix_p2;
+		pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_p2, pix_p2 ), pix_p4 ); // pix_p4 = pix_p2 * pix_p2;
+
+		pixel_plus_assign_t<CPixel, CPixel>( )( pix, _sum ); // sum += pix;
+		pixel_plus_assign_t<CPixel, CPixel>( )( pix_p2, _sum_p2 ); // sum_p2 += pix_p2;
+		pixel_plus_assign_t<CPixel, CPixel>( )( pix_p3, _sum_p3 ); // sum_p3 += pix_p3;
+		pixel_plus_assign_t<CPixel, CPixel>( )( pix_p4, _sum_p4 ); // sum_p4 += pix_p4;
+
+		// search min for each channel
+		pixel_assign_min_t<Pixel, Pixel>( )( src, _channelMin );
+		// search max for each channel
+		pixel_assign_max_t<Pixel, Pixel>( )( src, _channelMax );
+
+		PixelGray grayCurrentPixel; // current pixel in gray colorspace
+		color_convert( src, grayCurrentPixel );
+		assignLuminosityExtrema( src, grayCurrentPixel, src, grayCurrentPixel );
+	}
+
+	void merge( const StatisticsAccumulator& next )
+	{
+		using namespace terry::numeric;
+		pixel_plus_assign_t<CPixel, CPixel>( )( next._sum, _sum );
+		pixel_plus_assign_t<CPixel, CPixel>( )( next._sum_p2, _sum_p2 );
+		pixel_plus_assign_t<CPixel, CPixel>( )( next._sum_p3, _sum_p3 );
+		pixel_plus_assign_t<CPixel, CPixel>( )( next._sum_p4, _sum_p4 );
+		pixel_assign_min_t<Pixel, Pixel>( )( next._channelMin, _channelMin );
+		pixel_assign_max_t<Pixel, Pixel>( )( next._channelMax, _channelMax );
+		// strict comparisons: on equality, keep the first pixel in the rows order
+		assignLuminosityExtrema( next._luminosityMin, next._luminosityMinGray, next._luminosityMax, next._luminosityMaxGray );
+	}
+
+private:
+	void assignLuminosityExtrema( const Pixel& min, const PixelGray& minGray, const Pixel& max, const PixelGray& maxGray )
+	{
+		using namespace boost::gil;
+		// search min luminosity
+		if( get_color( minGray, gray_color_t() ) < get_color( _luminosityMinGray, gray_color_t() ) )
+		{
+			_luminosityMin     = min;
+			_luminosityMinGray = minGray;
+		}
+		// search max luminosity
+		if( get_color( maxGray, gray_color_t() ) > get_color( _luminosityMaxGray, gray_color_t() ) )
+		{
+			_luminosityMax     = max;
+			_luminosityMaxGray = maxGray;
+		}
+	}
+};
+
+/**
+ * @brief Sum of the squared differences to the average,
+ *        models the terry::algorithm::parallel_reduce PixelAccumulator concept.
+ */
+template<class View, typename CType = boost::gil::bits64f>
+struct VarianceAccumulator
+{
+	typedef typename View::value_type Pixel;
+	typedef boost::gil::pixel<CType, boost::gil::layout<typename boost::gil::color_space_type<View>::type> > CPixel;
+
+	CPixel _average;
+	CPixel _varianceSum;
+
+	explicit VarianceAccumulator( const CPixel& average )
+	: _average( average )
+	{
+		terry::numeric::pixel_zeros_t<CPixel>( )( _varianceSum );
+	}
+
+	void operator()( const Pixel& src )
+	{
+		using namespace terry::numeric;
+		CPixel pix;
+		pixel_assigns_t<Pixel, CPixel>( )( src, pix ); // pix = src;
+
+		CPixel pix_diff = pixel_minus_t<CPixel, CPixel, CPixel>( )( pix, _average ); // pix_diff = (pix - mean)
+		CPixel pix_diff2 = pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_diff, pix_diff ); // pix_diff2 = (x - mean)*(x - mean)
+
+		pixel_plus_assign_t<CPixel, CPixel>( )( pix_diff2, _varianceSum ); // varianceSum += pix_diff2;
+	}
+
+	void merge( const VarianceAccumulator& next )
+	{
+		terry::numeric::pixel_plus_assign_t<CPixel, CPixel>( )( next._varianceSum, _varianceSum );
+	}
+};
+
+template<class View, typename CType = boost::gil::bits64f>
+struct ComputeOutputParams
+{
+
+	typedef typename View::value_type Pixel;
+	typedef StatisticsAccumulator<View, CType> Statistics;
+	typedef typename Statistics::CPixel CPixel;
+
 	typedef OutputParams<CPixel> Output;
 
 	Output operator()( const View& image, ImageStatisticsPlugin& plugin )
 	{
 		using namespace terry::numeric;
+		using terry::algorithm::parallel_reduce;
 		OutputParams<CPixel> output;
 
 		const std::size_t nbPixels = image.width() * image.height();
 
-		// declare values and init
-		Pixel firstPixel = *image.begin(); // for initialization only
-		PixelGray firstPixelGray;
-		color_convert( firstPixel, firstPixelGray );
-
-		Pixel channelMin            = firstPixel;
-		Pixel channelMax            = firstPixel;
-		Pixel luminosityMin         = firstPixel;
-		PixelGray luminosityMinGray = firstPixelGray;
-		Pixel luminosityMax         = firstPixel;
-		PixelGray luminosityMaxGray = firstPixelGray;
-
-		CPixel sum;
-		CPixel varianceSum;
-		CPixel sum_p2;
-		CPixel sum_p3;
-		CPixel sum_p4;
-		pixel_zeros_t<CPixel>( )( sum );
-		pixel_zeros_t<CPixel>( )( varianceSum );
-		pixel_zeros_t<CPixel>( )( sum_p2 );
-		pixel_zeros_t<CPixel>( )( sum_p3 );
-		pixel_zeros_t<CPixel>( )( sum_p4 );
-
-		for( int y = 0; y < image.height(); ++y )
-		{
-			typename View::x_iterator src_it = image.x_at( 0, y );
-			CPixel lineAverage;
-			pixel_zeros_t<CPixel>( )( lineAverage );
+		// the partial results are merged pairwise, in the same order whatever the number of threads
+		const Statistics stats = parallel_reduce( image, Statistics( *image.begin() ), MultiThreadLauncher() );
 
-			for( int x = 0; x < image.width(); ++x, ++src_it )
-			{
-				CPixel pix;
-				pixel_assigns_t<Pixel, CPixel>( )( * src_it, pix ); // pix = src_it;
-
-				CPixel pix_p2;
-				CPixel pix_p3;
-				CPixel pix_p4;
-
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_pow_t<CPixel, 2>( )( pix ), pix_p2 ); // pix_p2 = pow<2>( pix );
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix, pix_p2 ), pix_p3 ); // pix_p3 = pix * pix_p2;
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_p2, pix_p2 ), pix_p4 ); // pix_p4 = pix_p2 * pix_p2;
-
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix, sum ); // sum += pix;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p2, sum_p2 ); // sum_p2 += pix_p2;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p3, sum_p3 ); // sum_p3 += pix_p3;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p4, sum_p4 ); // sum_p4 += pix_p4;
-
-				// search min for each channel
-				pixel_assign_min_t<Pixel, Pixel>( )( * src_it, channelMin );
-				// search max for each channel
-				pixel_assign_max_t<Pixel, Pixel>( )( * src_it, channelMax );
-
-				PixelGray grayCurrentPixel; // current pixel in gray colorspace
-				color_convert( * src_it, grayCurrentPixel );
-
-				// search min luminosity
-				if( get_color( grayCurrentPixel, gray_color_t() ) < get_color( luminosityMinGray, gray_color_t() ) )
-				{
-					luminosityMin     = *src_it;
-					luminosityMinGray = grayCurrentPixel;
-				}
-				// search max luminosity
-				if( get_color( grayCurrentPixel, gray_color_t() ) > get_color( luminosityMaxGray, gray_color_t() ) )
-				{
-					luminosityMax     = *src_it;
-					luminosityMaxGray = grayCurrentPixel;
-				}
-			}
-		}
+		output._channelMin    = stats._channelMin;
+		output._channelMax    = stats._channelMax;
+		output._luminosityMin = stats._luminosityMin;
+		output._luminosityMax = stats._luminosityMax;
 
-		output._channelMin    = channelMin;
-		output._channelMax    = channelMax;
-		output._luminosityMin = luminosityMin;
-		output._luminosityMax = luminosityMax;
+		CPixel stdDeriv = pixel_standard_deviation( stats._sum, stats._sum_p2, nbPixels );
+		output._average  = pixel_divides_scalar_t<CPixel, double>() ( stats._sum, nbPixels );
 
-		CPixel stdDeriv = pixel_standard_deviation( sum, sum_p2, nbPixels );
-		output._average  = pixel_divides_scalar_t<CPixel, double>() ( sum, nbPixels );
-		
-		for( int y = 0; y < image.height(); ++y )
-		{
-			typename View::x_iterator src_it = image.x_at( 0, y );
-			
-			for( int x = 0; x < image.width(); ++x, ++src_it )
-			{
-				CPixel pix;
-				pixel_assigns_t<Pixel, CPixel>( )( * src_it, pix ); // pix = src_it;
+		typedef VarianceAccumulator<View, CType> Variance;
+		const Variance variance = parallel_reduce( image, Variance( output._average ), MultiThreadLauncher() );
 
-				CPixel pix_diff = pix;
-				CPixel pix_diff2;
-
-				pix_diff = pixel_minus_t<CPixel, CPixel, CPixel>( )( pix, output._average ); // pix_diff = (pix - mean)
-				pix_diff2 = pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_diff, pix_diff ); // pix_diff2 = (x - mean)*(x - mean)
-				
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_diff2, varianceSum ); // varianceSum += pix_diff2;
-			}
-		}
-		
-		CPixel varianceSquare = pixel_divides_scalar_t<CPixel, double>() ( varianceSum, nbPixels );
+		CPixel varianceSquare = pixel_divides_scalar_t<CPixel, double>() ( variance._varianceSum, nbPixels );
 		output._variance = pixel_sqrt_t<CPixel, Pixel>()( varianceSquare );
-		output._kurtosis = pixel_kurtosis( output._average, stdDeriv, sum, sum_p2, sum_p3, sum_p4, nbPixels );
-		output._skewness = pixel_skewness( output._average, stdDeriv, sum, sum_p2, sum_p3, nbPixels );
+		output._kurtosis = pixel_kurtosis( output._average, stdDeriv, stats._sum, stats._sum_p2, stats._sum_p3, stats._sum_p4, nbPixels );
+		output._skewness = pixel_skewness( output._average, stdDeriv, stats._sum, stats._sum_p2, stats._sum_p3, nbPixels );
 
 		return output;
 	}
@@ -350,7 +407,6 @@ ImageStatisticsProcess<View>::ImageStatisticsProcess( ImageStatisticsPlugin& ins
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationIndependant )
 	, _plugin( instance )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>